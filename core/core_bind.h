@@ -70,11 +70,20 @@ public:
 		CACHE_MODE_REPLACE_DEEP,
 	};
 
+	enum LoadPriority {
+		LOAD_PRIORITY_LOW,
+		LOAD_PRIORITY_NORMAL,
+		LOAD_PRIORITY_HIGH,
+	};
+
 	static ResourceLoader *get_singleton() { return singleton; }
 
 	Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, CacheMode p_cache_mode = CACHE_MODE_REUSE);
 	ThreadLoadStatus load_threaded_get_status(const String &p_path, Array r_progress = Array());
 	Ref<Resource> load_threaded_get(const String &p_path);
+	Error load_threaded_set_priority(const String &p_path, LoadPriority p_priority);
+	Error load_threaded_cancel(const String &p_path);
+	Dictionary load_threaded_get_stats();
 
 	Ref<Resource> load(const String &p_path, const String &p_type_hint = "", CacheMode p_cache_mode = CACHE_MODE_REUSE);
 	Vector<String> get_recognized_extensions_for_type(const String &p_type);
@@ -604,6 +613,7 @@ public:
 } // namespace core_bind
 
 VARIANT_ENUM_CAST(core_bind::ResourceLoader::ThreadLoadStatus);
+VARIANT_ENUM_CAST(core_bind::ResourceLoader::LoadPriority);
 VARIANT_ENUM_CAST(core_bind::ResourceLoader::CacheMode);
 
 VARIANT_BITFIELD_CAST(core_bind::ResourceSaver::SaverFlags);
@@ -157,6 +157,7 @@ public:
 		resource_last_modified_time = p_resource_last_modified_time;
 		library_last_modified_time = p_library_last_modified_time;
 	}
+	uint64_t get_library_last_modified_time() const { return library_last_modified_time; }
 
 	void track_instance_binding(Object *p_object);
 	void untrack_instance_binding(Object *p_object);
@@ -31,7 +31,9 @@
 #include "compression.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/marshalls.h"
 #include "core/io/zip_io.h"
+#include "core/object/worker_thread_pool.h"
 
 #include "thirdparty/misc/fastlz.h"
 
@@ -84,6 +86,31 @@ int Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size,
 
 		} break;
 		case MODE_ZSTD: {
+			const int frame_count = _get_zstd_frame_count(p_src_size);
+			if (frame_count > 1) {
+				// Each frame goes where its bound starts, then they are moved together.
+				ZSTDFrameData data;
+				data.src = p_src;
+				data.dst = p_dst;
+				data.results.resize(frame_count);
+				for (int i = 0; i <= frame_count; i++) {
+					const int src_offset = MIN((int64_t)i * zstd_frame_size, (int64_t)p_src_size);
+					data.src_offsets.push_back(src_offset);
+					data.dst_offsets.push_back(i < frame_count ? i * ZSTD_compressBound(zstd_frame_size) : data.dst_offsets[i - 1] + ZSTD_compressBound(src_offset - data.src_offsets[i - 1]));
+				}
+
+				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&Compression::_compress_zstd_frame, &data, frame_count, -1, true, "ZSTDCompression");
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+				int total = 0;
+				for (int i = 0; i < frame_count; i++) {
+					ERR_FAIL_COND_V(data.results[i] < 0, -1);
+					memmove(p_dst + total, p_dst + data.dst_offsets[i], data.results[i]);
+					total += data.results[i];
+				}
+				return total;
+			}
+
 			ZSTD_CCtx *cctx = ZSTD_createCCtx();
 			ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, zstd_level);
 			if (zstd_long_distance_matching) {
@@ -130,6 +157,11 @@ int Compression::get_max_compressed_buffer_size(int p_src_size, Mode p_mode) {
 			return aout;
 		} break;
 		case MODE_ZSTD: {
+			const int frame_count = _get_zstd_frame_count(p_src_size);
+			if (frame_count > 1) {
+				// All frames but the last one are full.
+				return (frame_count - 1) * ZSTD_compressBound(zstd_frame_size) + ZSTD_compressBound(p_src_size - (frame_count - 1) * zstd_frame_size);
+			}
 			return ZSTD_compressBound(p_src_size);
 		} break;
 	}
@@ -187,6 +219,43 @@ int Compression::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p
 			return total;
 		} break;
 		case MODE_ZSTD: {
+			if (zstd_frame_size > 0 && p_dst_max_size >= zstd_frame_size * 2 && WorkerThreadPool::get_singleton()) {
+				// Frames written with their size can be decompressed in parallel, straight to where they belong.
+				ZSTDFrameData data;
+				data.src = p_src;
+				data.dst = p_dst;
+				int src_offset = 0;
+				int64_t dst_offset = 0;
+				while (src_offset < p_src_size && dst_offset <= p_dst_max_size) {
+					const size_t frame_size = ZSTD_findFrameCompressedSize(p_src + src_offset, p_src_size - src_offset);
+					const unsigned long long content_size = ZSTD_getFrameContentSize(p_src + src_offset, p_src_size - src_offset);
+					if (ZSTD_isError(frame_size) || content_size == ZSTD_CONTENTSIZE_UNKNOWN || content_size == ZSTD_CONTENTSIZE_ERROR) {
+						data.src_offsets.clear();
+						break;
+					}
+					data.src_offsets.push_back(src_offset);
+					data.dst_offsets.push_back(dst_offset);
+					src_offset += frame_size;
+					dst_offset += content_size;
+				}
+
+				const int frame_count = data.src_offsets.size();
+				if (frame_count > 1 && src_offset == p_src_size && dst_offset <= p_dst_max_size) {
+					data.src_offsets.push_back(src_offset);
+					data.dst_offsets.push_back(dst_offset);
+					data.results.resize(frame_count);
+
+					WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&Compression::_decompress_zstd_frame, &data, frame_count, -1, true, "ZSTDDecompression");
+					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+					for (int i = 0; i < frame_count; i++) {
+						ERR_FAIL_COND_V(data.results[i] < 0, -1);
+					}
+					return dst_offset;
+				}
+				// Otherwise, let zstd handle it and report errors.
+			}
+
 			ZSTD_DCtx *dctx = ZSTD_createDCtx();
 			if (zstd_long_distance_matching) {
 				ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, zstd_window_log_size);
@@ -349,9 +418,170 @@ int Compression::decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_s
 	}
 }
 
+int Compression::_get_zstd_frame_count(int p_src_size) {
+	// A single frame keeps long-distance matches.
+	if (zstd_frame_size <= 0 || zstd_long_distance_matching || p_src_size < zstd_frame_size * 2 || !WorkerThreadPool::get_singleton()) {
+		return 1;
+	}
+	return ((int64_t)p_src_size + zstd_frame_size - 1) / zstd_frame_size;
+}
+
+void Compression::_compress_zstd_frame(void *p_userdata, uint32_t p_index) {
+	ZSTDFrameData *data = (ZSTDFrameData *)p_userdata;
+	const int src_size = data->src_offsets[p_index + 1] - data->src_offsets[p_index];
+	const int dst_size = data->dst_offsets[p_index + 1] - data->dst_offsets[p_index];
+
+	// Writes the content size in the frame header, used to decompress frames in parallel.
+	ZSTD_CCtx *cctx = ZSTD_createCCtx();
+	size_t ret = ZSTD_compressCCtx(cctx, data->dst + data->dst_offsets[p_index], dst_size, data->src + data->src_offsets[p_index], src_size, zstd_level);
+	ZSTD_freeCCtx(cctx);
+	data->results[p_index] = ZSTD_isError(ret) ? -1 : (int)ret;
+}
+
+void Compression::_decompress_zstd_frame(void *p_userdata, uint32_t p_index) {
+	ZSTDFrameData *data = (ZSTDFrameData *)p_userdata;
+	const int src_size = data->src_offsets[p_index + 1] - data->src_offsets[p_index];
+	const int dst_size = data->dst_offsets[p_index + 1] - data->dst_offsets[p_index];
+
+	ZSTD_DCtx *dctx = ZSTD_createDCtx();
+	if (zstd_long_distance_matching) {
+		ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, zstd_window_log_size);
+	}
+	size_t ret = ZSTD_decompressDCtx(dctx, data->dst + data->dst_offsets[p_index], dst_size, data->src + data->src_offsets[p_index], src_size);
+	ZSTD_freeDCtx(dctx);
+	data->results[p_index] = (ZSTD_isError(ret) || ret != (size_t)dst_size) ? -1 : (int)ret;
+}
+
+int Compression::compress_zstd_with_dictionary(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, const Vector<uint8_t> &p_dictionary) {
+	ZSTD_CCtx *cctx = ZSTD_createCCtx();
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, zstd_level);
+	size_t ret = ZSTD_CCtx_loadDictionary(cctx, p_dictionary.ptr(), p_dictionary.size());
+	if (!ZSTD_isError(ret)) {
+		ret = ZSTD_compress2(cctx, p_dst, p_dst_max_size, p_src, p_src_size);
+	}
+	ZSTD_freeCCtx(cctx);
+	ERR_FAIL_COND_V_MSG(ZSTD_isError(ret), -1, "Zstandard compression with a dictionary failed: " + String(ZSTD_getErrorName(ret)) + ".");
+	return ret;
+}
+
+int Compression::decompress_zstd_with_dictionary(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, const Vector<uint8_t> &p_dictionary) {
+	ZSTD_DCtx *dctx = ZSTD_createDCtx();
+	size_t ret = ZSTD_DCtx_loadDictionary(dctx, p_dictionary.ptr(), p_dictionary.size());
+	if (!ZSTD_isError(ret)) {
+		ret = ZSTD_decompressDCtx(dctx, p_dst, p_dst_max_size, p_src, p_src_size);
+	}
+	ZSTD_freeDCtx(dctx);
+	ERR_FAIL_COND_V_MSG(ZSTD_isError(ret), -1, "Zstandard decompression with a dictionary failed: " + String(ZSTD_getErrorName(ret)) + ".");
+	return ret;
+}
+
+static _FORCE_INLINE_ uint32_t _hash_dictionary_dmer(const uint8_t *p_data) {
+	uint64_t value;
+	memcpy(&value, p_data, sizeof(uint64_t));
+	return (value * 0xCF1BBCDCB7A56463ULL) >> (64 - 20);
+}
+
+// Raw content starting like a trained dictionary would be read as one.
+static Vector<uint8_t> _as_raw_zstd_dictionary(const Vector<uint8_t> &p_content) {
+	if (p_content.size() >= 4 && decode_uint32(p_content.ptr()) == ZSTD_MAGIC_DICTIONARY) {
+		return p_content.slice(4);
+	}
+	return p_content;
+}
+
+// The dictionary builder of zstd isn't included, this is a simplified version of its FastCover algorithm.
+// The dictionary has the segments of the samples with the most common 8-byte sequences, as raw content.
+Vector<uint8_t> Compression::train_zstd_dictionary(const Vector<Vector<uint8_t>> &p_samples, int p_max_size) {
+	const int DMER_SIZE = 8;
+	const int SEGMENT_SIZE = 256;
+	const uint32_t NO_DMER = UINT32_MAX;
+	ERR_FAIL_COND_V(p_max_size < SEGMENT_SIZE, Vector<uint8_t>());
+
+	Vector<uint8_t> samples;
+	for (const Vector<uint8_t> &sample : p_samples) {
+		samples.append_array(sample);
+	}
+	if (samples.size() <= p_max_size) {
+		return _as_raw_zstd_dictionary(samples); // Everything fits.
+	}
+
+	// Hashes of the sequences starting at each position, and how often they appear.
+	LocalVector<uint32_t> dmers;
+	dmers.resize(samples.size());
+	LocalVector<uint32_t> frequencies;
+	frequencies.resize(1 << 20);
+	memset(frequencies.ptr(), 0, frequencies.size() * sizeof(uint32_t));
+
+	int sample_start = 0;
+	for (const Vector<uint8_t> &sample : p_samples) {
+		for (int i = 0; i < sample.size(); i++) {
+			if (i + DMER_SIZE > sample.size()) {
+				dmers[sample_start + i] = NO_DMER; // Would span two samples.
+				continue;
+			}
+			dmers[sample_start + i] = _hash_dictionary_dmer(samples.ptr() + sample_start + i);
+			frequencies[dmers[sample_start + i]]++;
+		}
+		sample_start += sample.size();
+	}
+
+	// Picks the best segment of each epoch, its sequences don't count for the next ones.
+	struct Segment {
+		int begin = 0;
+		uint64_t score = 0;
+
+		bool operator<(const Segment &p_other) const { return score < p_other.score; }
+	};
+	LocalVector<Segment> segments;
+
+	const int segment_count = p_max_size / SEGMENT_SIZE;
+	const int epoch_size = MAX(samples.size() / segment_count, SEGMENT_SIZE);
+	for (int epoch = 0; epoch + SEGMENT_SIZE <= samples.size() && (int)segments.size() < segment_count; epoch += epoch_size) {
+		const int epoch_end = MIN(epoch + epoch_size, samples.size());
+
+		Segment best;
+		uint64_t score = 0;
+		for (int i = epoch; i < epoch_end; i++) {
+			if (dmers[i] != NO_DMER) {
+				score += frequencies[dmers[i]];
+			}
+			const int begin = i - (SEGMENT_SIZE - DMER_SIZE);
+			if (begin < epoch) {
+				continue;
+			}
+			if (score > best.score && begin + SEGMENT_SIZE <= samples.size()) {
+				best.begin = begin;
+				best.score = score;
+			}
+			if (dmers[begin] != NO_DMER) {
+				score -= frequencies[dmers[begin]];
+			}
+		}
+
+		if (best.score == 0) {
+			continue;
+		}
+		segments.push_back(best);
+		for (int i = best.begin; i <= best.begin + SEGMENT_SIZE - DMER_SIZE; i++) {
+			if (dmers[i] != NO_DMER) {
+				frequencies[dmers[i]] = 0;
+			}
+		}
+	}
+
+	// The best segments go last, closer matches are cheaper.
+	segments.sort();
+	Vector<uint8_t> dictionary;
+	for (const Segment &segment : segments) {
+		dictionary.append_array(samples.slice(segment.begin, segment.begin + SEGMENT_SIZE));
+	}
+	return _as_raw_zstd_dictionary(dictionary);
+}
+
 int Compression::zlib_level = Z_DEFAULT_COMPRESSION;
 int Compression::gzip_level = Z_DEFAULT_COMPRESSION;
 int Compression::zstd_level = 3;
 bool Compression::zstd_long_distance_matching = false;
 int Compression::zstd_window_log_size = 27; // ZSTD_WINDOWLOG_LIMIT_DEFAULT
+int Compression::zstd_frame_size = 1024 * 1024;
 int Compression::gzip_chunk = 16384;
@@ -31,16 +31,29 @@
 #ifndef COMPRESSION_H
 #define COMPRESSION_H
 
+#include "core/templates/local_vector.h"
 #include "core/templates/vector.h"
 #include "core/typedefs.h"
 
 class Compression {
+	struct ZSTDFrameData {
+		const uint8_t *src = nullptr;
+		uint8_t *dst = nullptr;
+		LocalVector<int> src_offsets; // One more than frames, the last one is the end.
+		LocalVector<int> dst_offsets; // Same.
+		LocalVector<int> results;
+	};
+	static void _compress_zstd_frame(void *p_userdata, uint32_t p_index);
+	static void _decompress_zstd_frame(void *p_userdata, uint32_t p_index);
+	static int _get_zstd_frame_count(int p_src_size);
+
 public:
 	static int zlib_level;
 	static int gzip_level;
 	static int zstd_level;
 	static bool zstd_long_distance_matching;
 	static int zstd_window_log_size;
+	static int zstd_frame_size; // Larger buffers are split in frames, compressed and decompressed in parallel. 0 disables it.
 	static int gzip_chunk;
 
 	enum Mode {
@@ -55,6 +68,12 @@ public:
 	static int get_max_compressed_buffer_size(int p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_size, const uint8_t *p_src, int p_src_size, Mode p_mode);
+
+	// Zstandard with a dictionary, for many small payloads that look alike. They must be decompressed with the same dictionary.
+	// Dictionaries trained by the zstd tool can be used as well.
+	static int compress_zstd_with_dictionary(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, const Vector<uint8_t> &p_dictionary);
+	static int decompress_zstd_with_dictionary(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, const Vector<uint8_t> &p_dictionary);
+	static Vector<uint8_t> train_zstd_dictionary(const Vector<Vector<uint8_t>> &p_samples, int p_max_size = 112640);
 };
 
 #endif // COMPRESSION_H
@@ -36,6 +36,7 @@
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = {};
@@ -43,6 +44,10 @@ FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = {};
 FileAccess::FileCloseFailNotify FileAccess::close_fail_notify = nullptr;
 
 bool FileAccess::backup_save = false;
+BinaryMutex FileAccess::async_read_mutex;
+ConditionVariable FileAccess::async_read_cond;
+HashMap<FileAccess::AsyncReadID, FileAccess::AsyncRead *> FileAccess::async_reads;
+FileAccess::AsyncReadID FileAccess::last_async_read_id = 0;
 thread_local Error FileAccess::last_file_open_error = OK;
 
 Ref<FileAccess> FileAccess::create(AccessType p_access) {
@@ -499,6 +504,167 @@ Vector<uint8_t> FileAccess::get_buffer(int64_t p_length) const {
 	return data;
 }
 
+FileAccess::AsyncReadID FileAccess::read_async(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length, AsyncReadCallback p_callback, void *p_userdata) {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, INVALID_ASYNC_READ_ID);
+	ERR_FAIL_COND_V_MSG(!is_open(), INVALID_ASYNC_READ_ID, "File must be opened before use.");
+
+	AsyncRead *read = memnew(AsyncRead);
+	read->file = Ref<FileAccess>(this); // Keeps the file alive until the read is done.
+	read->offset = p_offset;
+	read->dst = p_dst;
+	read->length = p_length;
+	read->callback = p_callback;
+	read->userdata = p_userdata;
+
+	AsyncReadID id;
+	{
+		MutexLock lock(async_read_mutex);
+		id = ++last_async_read_id;
+		async_reads.insert(id, read);
+	}
+
+	async_reads_pending.increment();
+	_start_async_read(read);
+	return id;
+}
+
+void FileAccess::_start_async_read(AsyncRead *p_read) {
+#ifdef THREADS_ENABLED
+	WorkerThreadPool::get_singleton()->add_native_task(&FileAccess::_async_read_fallback_task, p_read, false, "FileAccessAsyncRead");
+#else
+	_async_read_fallback_task(p_read);
+#endif
+}
+
+Ref<FileAccess> FileAccess::_reopen_for_async_read() const {
+	const String path = get_path();
+	if (path.is_empty()) {
+		return Ref<FileAccess>();
+	}
+	return FileAccess::open(path, READ);
+}
+
+void FileAccess::_async_read_fallback_task(void *p_userdata) {
+	AsyncRead *read = (AsyncRead *)p_userdata;
+	Ref<FileAccess> f = read->file;
+
+	uint64_t read_bytes;
+	Error err;
+	Ref<FileAccess> handle = f->_reopen_for_async_read();
+	if (handle.is_valid()) {
+		handle->seek(read->offset);
+		read_bytes = handle->get_buffer(read->dst, read->length);
+		err = handle->get_error();
+	} else {
+		MutexLock lock(f->async_read_fallback_mutex);
+		uint64_t prev_pos = f->get_position();
+		f->seek(read->offset);
+		read_bytes = f->get_buffer(read->dst, read->length);
+		err = f->get_error();
+		f->seek(prev_pos);
+	}
+
+	_complete_async_read(read, err == ERR_FILE_EOF ? OK : err, read_bytes);
+}
+
+void FileAccess::_forward_async_read(AsyncRead *p_read, const Ref<FileAccess> &p_file, uint64_t p_offset, uint64_t p_length) {
+	AsyncRead *read = memnew(AsyncRead);
+	read->file = p_file;
+	read->offset = p_offset;
+	read->dst = p_read->dst;
+	read->length = p_length;
+	read->forward_to = p_read;
+
+	p_file->async_reads_pending.increment();
+	p_file->_start_async_read(read);
+}
+
+void FileAccess::_complete_async_read(AsyncRead *p_read, Error p_error, uint64_t p_read_bytes) {
+	if (p_read->forward_to) {
+		// Not registered, nobody waits for it but the file it was made from.
+		{
+			MutexLock lock(async_read_mutex);
+			p_read->file->async_reads_pending.decrement();
+		}
+		async_read_cond.notify_all();
+
+		_complete_async_read(p_read->forward_to, p_error, p_read_bytes);
+		memdelete(p_read);
+		return;
+	}
+
+	p_read->error = p_error;
+	p_read->read = p_read_bytes;
+	if (p_read->callback) {
+		p_read->callback(p_read->userdata, p_error, p_read_bytes);
+	}
+
+	// Not kept until the read is waited for, so reads never waited for don't keep their file open.
+	Ref<FileAccess> f = p_read->file;
+	{
+		MutexLock lock(async_read_mutex);
+		p_read->file.unref();
+		p_read->completed = true;
+		f->async_reads_pending.decrement();
+	}
+	async_read_cond.notify_all();
+}
+
+void FileAccess::_wait_for_async_reads() {
+	if (async_reads_pending.get() == 0) {
+		return;
+	}
+
+	MutexLock lock(async_read_mutex);
+	while (async_reads_pending.get() > 0) {
+		async_read_cond.wait(lock);
+	}
+}
+
+bool FileAccess::is_async_read_completed(AsyncReadID p_id) {
+	MutexLock lock(async_read_mutex);
+	HashMap<AsyncReadID, AsyncRead *>::Iterator E = async_reads.find(p_id);
+	ERR_FAIL_COND_V_MSG(!E, false, "Invalid or already waited for asynchronous read ID: " + itos(p_id) + ".");
+	return E->value->completed;
+}
+
+Error FileAccess::wait_for_async_read(AsyncReadID p_id, uint64_t *r_read) {
+	AsyncRead *read;
+	{
+		MutexLock lock(async_read_mutex);
+		HashMap<AsyncReadID, AsyncRead *>::Iterator E = async_reads.find(p_id);
+		ERR_FAIL_COND_V_MSG(!E, ERR_INVALID_PARAMETER, "Invalid or already waited for asynchronous read ID: " + itos(p_id) + ".");
+		read = E->value;
+		while (!read->completed) {
+			async_read_cond.wait(lock);
+		}
+		async_reads.remove(E);
+	}
+
+	Error err = read->error;
+	if (r_read) {
+		*r_read = read->read;
+	}
+	memdelete(read);
+	return err;
+}
+
+void FileAccess::cleanup_async_reads() {
+	MutexLock lock(async_read_mutex);
+	if (async_reads.is_empty()) {
+		return;
+	}
+
+	ERR_PRINT(vformat("%d asynchronous file reads were never waited for with FileAccess::wait_for_async_read().", async_reads.size()));
+	for (const KeyValue<AsyncReadID, AsyncRead *> &E : async_reads) {
+		while (!E.value->completed) {
+			async_read_cond.wait(lock);
+		}
+		memdelete(E.value);
+	}
+	async_reads.clear();
+}
+
 String FileAccess::get_as_utf8_string(bool p_skip_cr) const {
 	Vector<uint8_t> sourcef;
 	uint64_t len = get_length();
@@ -34,8 +34,12 @@
 #include "core/io/compression.h"
 #include "core/math/math_defs.h"
 #include "core/object/ref_counted.h"
+#include "core/os/condition_variable.h"
 #include "core/os/memory.h"
+#include "core/os/mutex.h"
 #include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
 #include "core/typedefs.h"
 
 /**
@@ -87,6 +91,14 @@ public:
 	typedef void (*FileCloseFailNotify)(const String &);
 
 	typedef Ref<FileAccess> (*CreateFunc)();
+
+	typedef int64_t AsyncReadID;
+	enum {
+		INVALID_ASYNC_READ_ID = -1
+	};
+	// Called from the thread that completed the read, before waiting for it returns.
+	typedef void (*AsyncReadCallback)(void *p_userdata, Error p_error, uint64_t p_read);
+
 	bool big_endian = false;
 	bool real_is_double = false;
 
@@ -109,7 +121,42 @@ protected:
 
 	static FileCloseFailNotify close_fail_notify;
 
+	struct AsyncRead {
+		Ref<FileAccess> file;
+		uint64_t offset = 0;
+		uint8_t *dst = nullptr;
+		uint64_t length = 0;
+		AsyncReadCallback callback = nullptr;
+		void *userdata = nullptr;
+		Error error = OK;
+		uint64_t read = 0;
+		bool completed = false;
+		AsyncRead *forward_to = nullptr; // Set on reads made for another file's read, see _forward_async_read().
+	};
+
+	SafeNumeric<uint32_t> async_reads_pending;
+
+	// Starts reading `p_read->length` bytes at `p_read->offset`, _complete_async_read() must be called from any thread once done.
+	// The default implementation reads from a worker thread, through a handle from _reopen_for_async_read().
+	virtual void _start_async_read(AsyncRead *p_read);
+	// Opens another handle to the same contents, so the default asynchronous reads don't move the position of this one.
+	// The default implementation opens get_path() again. Empty if that doesn't give the same contents, the reads then
+	// seek this file, one at a time.
+	virtual Ref<FileAccess> _reopen_for_async_read() const;
+	static void _complete_async_read(AsyncRead *p_read, Error p_error, uint64_t p_read_bytes);
+	// Completes `p_read` with an asynchronous read of `p_file`, for files reading from another one.
+	static void _forward_async_read(AsyncRead *p_read, const Ref<FileAccess> &p_file, uint64_t p_offset, uint64_t p_length);
+	void _wait_for_async_reads(); // Implementations reading natively must call it before closing the file.
+
 private:
+	static BinaryMutex async_read_mutex;
+	static ConditionVariable async_read_cond;
+	static HashMap<AsyncReadID, AsyncRead *> async_reads;
+	static AsyncReadID last_async_read_id;
+	Mutex async_read_fallback_mutex; // The fallback reads of a file that can't be reopened seek it, so they go one at a time.
+
+	static void _async_read_fallback_task(void *p_userdata);
+
 	static bool backup_save;
 	thread_local static Error last_file_open_error;
 
@@ -156,6 +203,21 @@ public:
 	String get_as_text(bool p_skip_cr = false) const;
 	virtual String get_as_utf8_string(bool p_skip_cr = false) const;
 
+	virtual const uint8_t *get_buffer_ptr(uint64_t p_length) const { return nullptr; } ///< get the next bytes without copying them if the file is backed by memory, advances the position like get_buffer(); nullptr if not supported or not enough data is left
+
+	virtual const uint8_t *map_region(uint64_t p_offset, uint64_t p_length) const { return nullptr; } ///< map a read-only region of the file to memory, nullptr if not supported; the mapping stays valid after closing until unmap_region() is called
+	virtual void unmap_region(const uint8_t *p_data, uint64_t p_length) const {}
+
+	// Asynchronous reads don't use or change the position of the file, and many can be in flight at once.
+	// Each one must be waited for with wait_for_async_read() to release it, even if a callback is set,
+	// reads never waited for are reported as errors on exit. The file must stay open and `p_dst` valid until then.
+	// Files that can't be reopened, see _reopen_for_async_read(), can't be used otherwise while reads are pending,
+	// unless the platform supports them natively. Writes not flushed yet may not be seen by the reads.
+	AsyncReadID read_async(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length, AsyncReadCallback p_callback = nullptr, void *p_userdata = nullptr);
+	static bool is_async_read_completed(AsyncReadID p_id);
+	static Error wait_for_async_read(AsyncReadID p_id, uint64_t *r_read = nullptr);
+	static void cleanup_async_reads(); // Releases the reads never waited for, on exit.
+
 	/**
 	 * Use this for files WRITTEN in _big_ endian machines (ie, amiga/mac)
 	 * It's not about the current CPU type but file formats.
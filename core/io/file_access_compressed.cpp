@@ -30,8 +30,12 @@
 
 #include "file_access_compressed.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 
+// Smaller reads decompress their blocks one by one.
+#define PARALLEL_DECOMPRESSION_MIN_SIZE (64 * 1024)
+
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
 	magic = (magic + "    ").substr(0, 4);
@@ -144,22 +148,28 @@ void FileAccessCompressed::_close() {
 			f->store_32(0); //compressed sizes, will update later
 		}
 
-		Vector<int> block_sizes;
-		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
+		CompressData data;
+		data.src = write_ptr;
+		data.src_size = write_max;
+		data.block_size = block_size;
+		data.mode = cmode;
+		data.blocks.resize(bc);
+		if (bc > 1 && WorkerThreadPool::get_singleton()) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&FileAccessCompressed::_compress_block_task, &data, bc, -1, true, "FileAccessCompressed");
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < bc; i++) {
+				_compress_block_task(&data, i);
+			}
+		}
 
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
+		for (uint32_t i = 0; i < bc; i++) {
+			f->store_buffer(data.blocks[i]);
 		}
 
 		f->seek(16); //ok write block sizes
 		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(block_sizes[i]);
+			f->store_32(data.blocks[i].size());
 		}
 		f->seek_end();
 		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
@@ -174,6 +184,53 @@ void FileAccessCompressed::_close() {
 	f.unref();
 }
 
+void FileAccessCompressed::_compress_block_task(void *p_userdata, uint32_t p_index) {
+	CompressData *data = (CompressData *)p_userdata;
+	const uint32_t bl = p_index == (data->blocks.size() - 1) ? data->src_size % data->block_size : data->block_size;
+
+	Vector<uint8_t> &cblock = data->blocks[p_index];
+	cblock.resize(Compression::get_max_compressed_buffer_size(bl, data->mode));
+	int s = Compression::compress(cblock.ptrw(), data->src + (uint64_t)p_index * data->block_size, bl, data->mode);
+	cblock.resize(MAX(s, 0));
+}
+
+void FileAccessCompressed::_decompress_block_task(void *p_userdata, uint32_t p_index) {
+	DecompressData *data = (DecompressData *)p_userdata;
+	const uint32_t block = data->first_block + p_index;
+	const ReadBlock &rb = data->file->read_blocks[block];
+	const uint32_t size = data->file->_get_block_size(block);
+
+	// All blocks but the last one are full.
+	int ret = Compression::decompress(data->dst + (uint64_t)p_index * data->file->block_size, size, data->src + (rb.offset - data->src_offset), rb.csize, data->file->cmode);
+	if (ret != (int)size) {
+		data->failed.set();
+	}
+}
+
+bool FileAccessCompressed::_decompress_blocks(uint32_t p_first_block, uint32_t p_count, uint8_t *p_dst) const {
+	const ReadBlock &last = read_blocks[p_first_block + p_count - 1];
+	const uint64_t from = read_blocks[p_first_block].offset;
+
+	// Leaves `f` at the next block, like reading them one by one.
+	Vector<uint8_t> src;
+	src.resize(last.offset + last.csize - from);
+	f->seek(from);
+	if (f->get_buffer(src.ptrw(), src.size()) != (uint64_t)src.size()) {
+		return false;
+	}
+
+	DecompressData data;
+	data.file = this;
+	data.src = src.ptr();
+	data.src_offset = from;
+	data.dst = p_dst;
+	data.first_block = p_first_block;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&FileAccessCompressed::_decompress_block_task, &data, p_count, -1, true, "FileAccessCompressed");
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	return !data.failed.is_set();
+}
+
 bool FileAccessCompressed::is_open() const {
 	return f.is_valid();
 }
@@ -302,32 +359,54 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		return 0;
 	}
 
-	for (uint64_t i = 0; i < p_length; i++) {
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
-		if (read_pos >= read_block_size) {
-			read_block++;
+	uint64_t read = 0;
+	while (true) {
+		const uint64_t to_copy = MIN((uint64_t)read_block_size - read_pos, p_length - read);
+		memcpy(p_dst + read, read_ptr + read_pos, to_copy);
+		read_pos += to_copy;
+		read += to_copy;
+		if (read_pos < read_block_size) {
+			return read;
+		}
 
-			if (read_block < read_block_count) {
-				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-				read_pos = 0;
-
-			} else {
-				read_block--;
-				at_end = true;
-				if (i + 1 < p_length) {
-					read_eof = true;
-				}
-				return i + 1;
+		// Whole blocks left to read are decompressed in parallel, straight to the destination.
+		uint32_t whole_blocks = 0;
+		uint64_t whole_size = 0;
+		while (read_block + 1 + whole_blocks < read_block_count && read + whole_size + _get_block_size(read_block + 1 + whole_blocks) <= p_length) {
+			whole_size += _get_block_size(read_block + 1 + whole_blocks);
+			whole_blocks++;
+		}
+		if (whole_blocks > 1 && whole_size >= PARALLEL_DECOMPRESSION_MIN_SIZE && WorkerThreadPool::get_singleton()) {
+			ERR_FAIL_COND_V_MSG(!_decompress_blocks(read_block + 1, whole_blocks, p_dst + read), -1, "Compressed file is corrupt.");
+			read += whole_size;
+			read_block += whole_blocks;
+
+			// Keep the last one as the current block, as if it was read byte by byte.
+			read_block_size = _get_block_size(read_block);
+			memcpy(read_ptr, p_dst + read - read_block_size, read_block_size);
+			read_pos = read_block_size;
+		}
+
+		if (read_block + 1 >= read_block_count) {
+			at_end = true;
+			if (read < p_length) {
+				read_eof = true;
 			}
+			return read;
 		}
-	}
 
-	return p_length;
+		//read another block of compressed data
+		read_block++;
+		f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
+		int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+		ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
+		read_block_size = _get_block_size(read_block);
+		read_pos = 0;
+
+		if (read == p_length) {
+			return read;
+		}
+	}
 }
 
 Error FileAccessCompressed::get_error() const {
@@ -33,6 +33,8 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class FileAccessCompressed : public FileAccess {
 	Compression::Mode cmode = Compression::MODE_ZSTD;
@@ -63,8 +65,35 @@ class FileAccessCompressed : public FileAccess {
 	mutable Vector<uint8_t> buffer;
 	Ref<FileAccess> f;
 
+	// Blocks are compressed, and decompressed when reading many at once, on worker threads.
+	struct CompressData {
+		const uint8_t *src = nullptr;
+		uint64_t src_size = 0;
+		uint32_t block_size = 0;
+		Compression::Mode mode = Compression::MODE_ZSTD;
+		LocalVector<Vector<uint8_t>> blocks;
+	};
+	static void _compress_block_task(void *p_userdata, uint32_t p_index);
+
+	struct DecompressData {
+		const FileAccessCompressed *file = nullptr;
+		const uint8_t *src = nullptr; // Holds the compressed blocks from `src_offset` on.
+		uint64_t src_offset = 0;
+		uint8_t *dst = nullptr;
+		uint32_t first_block = 0;
+		SafeFlag failed;
+	};
+	static void _decompress_block_task(void *p_userdata, uint32_t p_index);
+
+	_FORCE_INLINE_ uint32_t _get_block_size(uint32_t p_block) const { return p_block == read_block_count - 1 ? read_total % block_size : block_size; }
+	bool _decompress_blocks(uint32_t p_first_block, uint32_t p_count, uint8_t *p_dst) const;
+
 	void _close();
 
+protected:
+	// The path is the one of the compressed file.
+	virtual Ref<FileAccess> _reopen_for_async_read() const override { return Ref<FileAccess>(); }
+
 public:
 	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
 
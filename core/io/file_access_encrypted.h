@@ -56,6 +56,10 @@ private:
 
 	void _close();
 
+protected:
+	// The path is the one of the encrypted file.
+	virtual Ref<FileAccess> _reopen_for_async_read() const override { return Ref<FileAccess>(); }
+
 public:
 	Error open_and_parse(Ref<FileAccess> p_base, const Vector<uint8_t> &p_key, Mode p_mode, bool p_with_magic = true);
 	Error open_and_parse_password(Ref<FileAccess> p_base, const String &p_key, Mode p_mode);
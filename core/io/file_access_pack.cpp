@@ -31,7 +31,9 @@
 #include "file_access_pack.h"
 
 #include "core/io/file_access_encrypted.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/version.h"
 
@@ -47,7 +49,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed, const uint8_t *p_mapped_data, uint64_t p_mapped_size) {
 	String simplified_path = p_path.simplify_path();
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -55,6 +57,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -62,6 +65,8 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 		pf.md5[i] = p_md5[i];
 	}
 	pf.src = p_src;
+	pf.mapped_data = p_mapped_data;
+	pf.mapped_size = p_mapped_size;
 
 	if (!exists || p_replace_files) {
 		files[pmd5] = pf;
@@ -227,6 +232,22 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		file_base += pck_start_pos;
 	}
 
+	// Map the pack so reads are served from the page cache without seeking and copying through the file.
+	// Only the part from the PCK header on is mapped, so the code of a self-contained executable isn't.
+	// The mapping stays alive as long as the pack is loaded, which means the file must not be truncated
+	// or rewritten meanwhile: accessing pages that are gone raises SIGBUS instead of a read error.
+	// Use --disable-pack-mmap when packs may be modified while they are in use.
+	const uint8_t *mapped_data = nullptr;
+	uint64_t mapped_offset = pck_start_pos;
+	uint64_t mapped_length = 0;
+	if (PackedData::get_singleton()->is_memory_mapping_enabled() && f->get_length() > mapped_offset) {
+		mapped_length = f->get_length() - mapped_offset;
+		mapped_data = f->map_region(mapped_offset, mapped_length);
+		if (mapped_data) {
+			mapped_packs.push_back({ f, mapped_data, mapped_length });
+		}
+	}
+
 	if (enc_directory) {
 		Ref<FileAccessEncrypted> fae;
 		fae.instantiate();
@@ -259,7 +280,23 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		// Encrypted files have to be decrypted through the file.
+		// The stored size of compressed files is only known from their header, FileAccessPack checks it against the mapped size.
+		const uint8_t *file_data = nullptr;
+		uint64_t file_data_size = 0;
+		uint64_t file_pos = ofs + p_offset;
+		if (mapped_data && !(flags & PACK_FILE_ENCRYPTED) && file_pos >= mapped_offset && file_pos - mapped_offset < mapped_length) {
+			uint64_t mapped_pos = file_pos - mapped_offset;
+			if (flags & PACK_FILE_COMPRESSED) {
+				file_data = mapped_data + mapped_pos;
+				file_data_size = mapped_length - mapped_pos;
+			} else if (size <= mapped_length - mapped_pos) {
+				file_data = mapped_data + mapped_pos;
+				file_data_size = size;
+			}
+		}
+
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), (flags & PACK_FILE_COMPRESSED), file_data, file_data_size);
 	}
 
 	return true;
@@ -269,15 +306,141 @@ Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::Pack
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
+PackedSourcePCK::~PackedSourcePCK() {
+	for (const MappedPack &mapped_pack : mapped_packs) {
+		mapped_pack.file->unmap_region(mapped_pack.data, mapped_pack.length);
+	}
+}
+
 //////////////////////////////////////////////////////////////////
 
+bool FileAccessPack::_read_raw(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) const {
+	if (data) {
+		if (p_offset > pf.mapped_size || p_length > pf.mapped_size - p_offset) {
+			return false;
+		}
+		memcpy(p_dst, data + p_offset, p_length);
+		return true;
+	}
+
+	f->seek(off + p_offset);
+	return f->get_buffer(p_dst, p_length) == p_length;
+}
+
+bool FileAccessPack::_open_compressed() {
+	uint8_t header[12];
+	ERR_FAIL_COND_V(!_read_raw(0, header, 12), false);
+
+	uint32_t mode = decode_uint32(header);
+	block_size = decode_uint32(header + 4);
+	uint32_t block_count = decode_uint32(header + 8);
+	ERR_FAIL_COND_V(mode > Compression::MODE_BROTLI, false);
+	compression_mode = Compression::Mode(mode);
+	ERR_FAIL_COND_V(block_size == 0 || block_size > 64 * 1024 * 1024, false);
+	ERR_FAIL_COND_V(block_count != (pf.size + block_size - 1) / block_size, false);
+
+	Vector<uint8_t> table;
+	table.resize((block_count + 1) * 8);
+	ERR_FAIL_COND_V(!_read_raw(12, table.ptrw(), table.size()), false);
+
+	block_offsets.resize(block_count + 1);
+	uint64_t *offsets = block_offsets.ptrw();
+	for (uint32_t i = 0; i <= block_count; i++) {
+		offsets[i] = decode_uint64(table.ptr() + i * 8);
+	}
+
+	// Blocks are never stored larger than they are uncompressed.
+	ERR_FAIL_COND_V(offsets[0] != (uint64_t)(12 + table.size()), false);
+	for (uint32_t i = 0; i < block_count; i++) {
+		ERR_FAIL_COND_V(offsets[i + 1] < offsets[i] || offsets[i + 1] - offsets[i] > block_size, false);
+	}
+	ERR_FAIL_COND_V(data && offsets[block_count] > pf.mapped_size, false);
+
+	return true;
+}
+
+bool FileAccessPack::_decompress_block(uint64_t p_block, const uint8_t *p_src, uint8_t *p_dst) const {
+	const uint64_t stored_size = block_offsets[p_block + 1] - block_offsets[p_block];
+	const uint64_t size = MIN((uint64_t)block_size, pf.size - p_block * block_size);
+
+	if (stored_size == size) {
+		memcpy(p_dst, p_src, size); // Didn't compress well, stored as is.
+		return true;
+	}
+	return Compression::decompress(p_dst, size, p_src, stored_size, compression_mode) == (int)size;
+}
+
+void FileAccessPack::_decompress_block_task(void *p_userdata, uint32_t p_index) {
+	DecompressData *dd = (DecompressData *)p_userdata;
+	const FileAccessPack *file = dd->file;
+	const uint64_t block = dd->first_block + p_index;
+
+	const uint8_t *src = dd->src + (file->block_offsets[block] - dd->src_offset);
+	if (!file->_decompress_block(block, src, dd->dst + (uint64_t)p_index * file->block_size)) {
+		dd->failed.set();
+	}
+}
+
+bool FileAccessPack::_decompress_blocks(uint64_t p_first_block, uint64_t p_count, uint8_t *p_dst) const {
+	DecompressData dd;
+	dd.file = this;
+	dd.dst = p_dst;
+	dd.first_block = p_first_block;
+
+	// Without a mapping, fetch all the blocks with a single read.
+	Vector<uint8_t> src;
+	if (data) {
+		dd.src = data;
+	} else {
+		dd.src_offset = block_offsets[p_first_block];
+		src.resize(block_offsets[p_first_block + p_count] - dd.src_offset);
+		if (!_read_raw(dd.src_offset, src.ptrw(), src.size())) {
+			return false;
+		}
+		dd.src = src.ptr();
+	}
+
+	if (p_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&FileAccessPack::_decompress_block_task, &dd, p_count, -1, true, SNAME("PCKDecompression"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_decompress_block_task(&dd, 0);
+	}
+
+	return !dd.failed.is_set();
+}
+
+bool FileAccessPack::_read_cached(uint64_t p_from, uint8_t *p_dst, uint64_t p_length) const {
+	while (p_length > 0) {
+		const uint64_t block = p_from / block_size;
+		if (block != cached_block) {
+			block_cache.resize(block_size);
+			cached_block = UINT64_MAX;
+			if (!_decompress_blocks(block, 1, block_cache.ptrw())) {
+				return false;
+			}
+			cached_block = block;
+		}
+
+		const uint64_t block_ofs = p_from % block_size;
+		const uint64_t to_copy = MIN(p_length, block_size - block_ofs);
+		memcpy(p_dst, block_cache.ptr() + block_ofs, to_copy);
+		p_from += to_copy;
+		p_dst += to_copy;
+		p_length -= to_copy;
+	}
+	return true;
+}
+
 Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 	ERR_PRINT("Can't open pack-referenced file.");
 	return ERR_UNAVAILABLE;
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (data) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -285,7 +448,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !data, "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -293,7 +456,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (f.is_valid() && !pf.compressed) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -314,18 +479,28 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint8_t FileAccessPack::get_8() const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !data, 0, "File must be opened before use.");
 	if (pos >= pf.size) {
 		eof = true;
 		return 0;
 	}
 
+	if (pf.compressed) {
+		uint8_t byte = 0;
+		ERR_FAIL_COND_V_MSG(!_read_cached(pos, &byte, 1), 0, "Can't decompress pack-referenced file '" + String(pf.pack) + "'.");
+		pos++;
+		return byte;
+	}
+
+	if (data) {
+		return data[pos++];
+	}
 	pos++;
 	return f->get_8();
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !data, -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -338,21 +513,55 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
-	pos += to_read;
-
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (pf.compressed) {
+		// Blocks covered entirely are decompressed in parallel straight into the destination,
+		// the partial blocks at either end go through the block cache.
+		const uint64_t end = pos + to_read;
+		const uint64_t first_full = (pos + block_size - 1) / block_size;
+		const uint64_t end_full = end == pf.size ? block_offsets.size() - 1 : end / block_size;
+
+		bool ok;
+		if (end_full > first_full) {
+			const uint64_t head = first_full * block_size - pos;
+			const uint64_t tail_from = MIN(end_full * block_size, end);
+			ok = _read_cached(pos, p_dst, head) &&
+					_decompress_blocks(first_full, end_full - first_full, p_dst + head) &&
+					_read_cached(tail_from, p_dst + (tail_from - pos), end - tail_from);
+		} else {
+			ok = _read_cached(pos, p_dst, to_read);
+		}
+		ERR_FAIL_COND_V_MSG(!ok, 0, "Can't decompress pack-referenced file '" + String(pf.pack) + "'.");
+	} else if (data) {
+		memcpy(p_dst, data + pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
+	pos += to_read;
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_ptr(uint64_t p_length) const {
+	if (!data || pf.compressed || eof || pos + p_length > pf.size) {
+		return nullptr;
+	}
+
+	const uint8_t *ptr = data + pos;
+	pos += p_length;
+	return ptr;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !data, "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -378,17 +587,64 @@ bool FileAccessPack::file_exists(const String &p_name) {
 	return false;
 }
 
+void FileAccessPack::_start_async_read(AsyncRead *p_read) {
+	if (pf.compressed || pf.encrypted) {
+		FileAccess::_start_async_read(p_read); // Decompresses or decrypts through the regular reads of another handle.
+		return;
+	}
+
+	const uint64_t length = p_read->offset < pf.size ? MIN(p_read->length, pf.size - p_read->offset) : 0;
+	if (data) {
+		if (length > 0) {
+			memcpy(p_read->dst, data + p_read->offset, length);
+		}
+		_complete_async_read(p_read, OK, length);
+	} else {
+		_forward_async_read(p_read, f, off + p_read->offset, length);
+	}
+}
+
+Ref<FileAccess> FileAccessPack::_reopen_for_async_read() const {
+	Ref<FileAccessPack> file = memnew(FileAccessPack(String(), pf));
+	return file->is_open() ? file : Ref<FileAccessPack>();
+}
+
 void FileAccessPack::close() {
+	_wait_for_async_reads();
+
 	f = Ref<FileAccess>();
+	data = nullptr;
+	block_offsets.clear();
+	block_cache.clear();
+	cached_block = UINT64_MAX;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
-	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+
+	ERR_FAIL_COND_MSG(pf.compressed && pf.encrypted, "Can't open pack-referenced file '" + String(pf.pack) + "', compressed files can't be encrypted.");
+
+	if (pf.mapped_data) {
+		// Read straight from the memory-mapped pack, it outlives this file.
+		data = pf.mapped_data;
+		off = 0;
+	} else {
+		f = FileAccess::open(pf.pack, FileAccess::READ);
+		ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
-	f->seek(pf.offset);
-	off = pf.offset;
+		f->seek(pf.offset);
+		off = pf.offset;
+	}
+
+	if (pf.compressed) {
+		if (!_open_compressed()) {
+			close();
+			ERR_FAIL_MSG("Can't open compressed pack-referenced file '" + String(pf.pack) + "'.");
+		}
+		return;
+	}
 
 	if (pf.encrypted) {
 		Ref<FileAccessEncrypted> fae;
@@ -406,8 +662,6 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -31,12 +31,14 @@
 #ifndef FILE_ACCESS_PACK_H
 #define FILE_ACCESS_PACK_H
 
+#include "core/io/compression.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
 #include "core/templates/rb_map.h"
+#include "core/templates/safe_refcount.h"
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
@@ -49,9 +51,13 @@ enum PackFlags {
 };
 
 enum PackFileFlags {
-	PACK_FILE_ENCRYPTED = 1 << 0
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	PACK_FILE_COMPRESSED = 1 << 1,
 };
 
+// Uncompressed size of the blocks of compressed files, each block can be decompressed on its own.
+#define PACK_COMPRESSED_BLOCK_SIZE (128 * 1024)
+
 class PackSource;
 
 class PackedData {
@@ -67,6 +73,9 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		bool compressed = false; // Stored as blocks, `size` is the uncompressed size.
+		const uint8_t *mapped_data = nullptr; // Contents in the memory-mapped pack, if any.
+		uint64_t mapped_size = 0; // Bytes readable from `mapped_data`.
 	};
 
 private:
@@ -105,16 +114,22 @@ private:
 
 	static PackedData *singleton;
 	bool disabled = false;
+	bool memory_mapping_enabled = true;
 
 	void _free_packed_dirs(PackedDir *p_dir);
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_compressed = false, const uint8_t *p_mapped_data = nullptr, uint64_t p_mapped_size = 0); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
+	// Packs opened after this is disabled are read through regular file access.
+	// Mapped packs must not be truncated or rewritten while loaded, see PackedSourcePCK::try_open_pack().
+	void set_memory_mapping_enabled(bool p_enabled) { memory_mapping_enabled = p_enabled; }
+	_FORCE_INLINE_ bool is_memory_mapping_enabled() const { return memory_mapping_enabled; }
+
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
 
@@ -136,9 +151,19 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	struct MappedPack {
+		Ref<FileAccess> file;
+		const uint8_t *data = nullptr;
+		uint64_t length = 0;
+	};
+
+	Vector<MappedPack> mapped_packs;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
+
+	virtual ~PackedSourcePCK();
 };
 
 class FileAccessPack : public FileAccess {
@@ -149,6 +174,31 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	const uint8_t *data = nullptr; // Set instead of `f` when the pack is memory-mapped.
+
+	// Compressed files, see PCKPacker::compress_file() for the layout.
+	Compression::Mode compression_mode = Compression::MODE_ZSTD;
+	uint32_t block_size = 0;
+	Vector<uint64_t> block_offsets; // Relative to the start of the entry, the last one is the end of the last block.
+	mutable Vector<uint8_t> block_cache;
+	mutable uint64_t cached_block = UINT64_MAX;
+
+	struct DecompressData {
+		const FileAccessPack *file = nullptr;
+		const uint8_t *src = nullptr; // Holds the entry from `src_offset` on.
+		uint64_t src_offset = 0;
+		uint8_t *dst = nullptr;
+		uint64_t first_block = 0;
+		SafeFlag failed;
+	};
+	static void _decompress_block_task(void *p_userdata, uint32_t p_index);
+
+	bool _read_raw(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) const;
+	bool _open_compressed();
+	bool _decompress_block(uint64_t p_block, const uint8_t *p_src, uint8_t *p_dst) const;
+	bool _decompress_blocks(uint64_t p_first_block, uint64_t p_count, uint8_t *p_dst) const;
+	bool _read_cached(uint64_t p_from, uint8_t *p_dst, uint64_t p_length) const;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
@@ -159,6 +209,11 @@ class FileAccessPack : public FileAccess {
 	virtual bool _get_read_only_attribute(const String &p_file) override { return false; }
 	virtual Error _set_read_only_attribute(const String &p_file, bool p_ro) override { return ERR_UNAVAILABLE; }
 
+protected:
+	// Reads uncompressed, unencrypted files from the pack directly, without seeking.
+	virtual void _start_async_read(AsyncRead *p_read) override;
+	virtual Ref<FileAccess> _reopen_for_async_read() const override;
+
 public:
 	virtual bool is_open() const override;
 
@@ -172,6 +227,7 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_ptr(uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
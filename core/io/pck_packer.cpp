@@ -31,9 +31,12 @@
 #include "pck_packer.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -49,7 +52,10 @@ static int _get_pad(int p_alignment, int p_n) {
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_name", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("add_file_compressed", "pck_path", "source_path", "compression_mode"), &PCKPacker::add_file_compressed, DEFVAL(FileAccess::COMPRESSION_ZSTD));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_deduplicated_file_count"), &PCKPacker::get_deduplicated_file_count);
+	ClassDB::bind_method(D_METHOD("get_deduplicated_size"), &PCKPacker::get_deduplicated_size);
 }
 
 Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -100,13 +106,109 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	}
 	file->store_32(pack_flags); // flags
 
+	_close_spill_file();
+	spill_path = p_file + ".compressed.tmp";
+
 	files.clear();
+	content_files.clear();
+	deduplicated_files = 0;
+	deduplicated_size = 0;
 	ofs = 0;
 
 	return OK;
 }
 
+void PCKPacker::_compress_block(void *p_userdata, uint32_t p_index) {
+	CompressData *data = (CompressData *)p_userdata;
+	const uint64_t from = (uint64_t)p_index * data->block_size;
+	const int size = MIN((uint64_t)data->block_size, data->src_size - from);
+
+	Vector<uint8_t> &block = data->blocks[p_index];
+	block.resize(Compression::get_max_compressed_buffer_size(size, data->mode));
+	int compressed_size = Compression::compress(block.ptrw(), data->src + from, size, data->mode);
+	if (compressed_size < 0 || compressed_size >= size) {
+		// Store it as is, the reader knows a block is not compressed when it has its uncompressed size.
+		block.resize(size);
+		memcpy(block.ptrw(), data->src + from, size);
+	} else {
+		block.resize(compressed_size);
+	}
+}
+
+Vector<uint8_t> PCKPacker::compress_file(const uint8_t *p_data, uint64_t p_size, Compression::Mode p_mode, uint32_t p_block_size) {
+	ERR_FAIL_COND_V(p_block_size == 0, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(p_mode == Compression::MODE_BROTLI, Vector<uint8_t>(), "Only brotli decompression is supported.");
+
+	const uint32_t block_count = (p_size + p_block_size - 1) / p_block_size;
+
+	CompressData data;
+	data.src = p_data;
+	data.src_size = p_size;
+	data.block_size = p_block_size;
+	data.mode = p_mode;
+	data.blocks.resize(block_count);
+
+	if (block_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&PCKPacker::_compress_block, &data, block_count, -1, true, SNAME("PCKCompression"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (block_count == 1) {
+		_compress_block(&data, 0);
+	}
+
+	// Header: compression mode, block size and block count, followed by the seek table.
+	// The table has the offset of each block and the end of the last one, relative to the start of the entry.
+	const uint64_t header_size = 12 + (block_count + 1) * 8;
+	uint64_t entry_size = header_size;
+	for (const Vector<uint8_t> &block : data.blocks) {
+		entry_size += block.size();
+	}
+
+	Vector<uint8_t> entry;
+	entry.resize(entry_size);
+	uint8_t *w = entry.ptrw();
+	encode_uint32(p_mode, w);
+	encode_uint32(p_block_size, w + 4);
+	encode_uint32(block_count, w + 8);
+
+	uint64_t block_ofs = header_size;
+	for (uint32_t i = 0; i < block_count; i++) {
+		encode_uint64(block_ofs, w + 12 + i * 8);
+		memcpy(w + block_ofs, data.blocks[i].ptr(), data.blocks[i].size());
+		block_ofs += data.blocks[i].size();
+	}
+	encode_uint64(block_ofs, w + 12 + block_count * 8);
+
+	return entry;
+}
+
+String PCKPacker::get_content_key(const uint8_t *p_data, uint64_t p_size, uint32_t p_flags) {
+	// SHA-256, so different contents can't be mistaken for each other.
+	unsigned char hash[32];
+	CryptoCore::SHA256Context ctx;
+	ctx.start();
+	ctx.update(p_data, p_size);
+	ctx.finish(hash);
+	return String::hex_encode_buffer(hash, 32) + "_" + itos(p_size) + "_" + itos(p_flags);
+}
+
 Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt) {
+	return _add_file(p_file, p_src, p_encrypt, -1);
+}
+
+Error PCKPacker::add_file_compressed(const String &p_file, const String &p_src, FileAccess::CompressionMode p_compression_mode) {
+	ERR_FAIL_COND_V_MSG(p_compression_mode == FileAccess::COMPRESSION_BROTLI, ERR_INVALID_PARAMETER, "Only brotli decompression is supported.");
+	ERR_FAIL_COND_V_MSG(p_compression_mode < FileAccess::COMPRESSION_FASTLZ || p_compression_mode > FileAccess::COMPRESSION_GZIP, ERR_INVALID_PARAMETER, "Invalid compression mode: " + itos(p_compression_mode) + ".");
+	return _add_file(p_file, p_src, false, p_compression_mode);
+}
+
+void PCKPacker::_close_spill_file() {
+	if (spill_file.is_valid()) {
+		spill_file.unref();
+		DirAccess::remove_absolute(spill_path);
+	}
+}
+
+Error PCKPacker::_add_file(const String &p_file, const String &p_src, bool p_encrypt, int p_compression_mode) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
 	Ref<FileAccess> f = FileAccess::open(p_src, FileAccess::READ);
@@ -133,7 +235,36 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 	}
 	pf.encrypted = p_encrypt;
 
+	// Files with the same contents and storage point to the same data.
+	const String content_key = get_content_key(data.ptr(), data.size(), (p_encrypt ? PACK_FILE_ENCRYPTED : 0) | ((p_compression_mode + 1) << 8));
+	HashMap<String, int>::Iterator E = content_files.find(content_key);
+	if (E) {
+		const File &shared = files[E->value];
+		pf.ofs = shared.ofs;
+		pf.shared_with = E->value;
+		deduplicated_files++;
+		deduplicated_size += shared.stored_size;
+		files.push_back(pf);
+		return OK;
+	}
+
 	uint64_t _size = pf.size;
+	if (p_compression_mode >= 0) {
+		Vector<uint8_t> compressed_data = compress_file(data.ptr(), data.size(), Compression::Mode(p_compression_mode));
+		// Keep files that don't get smaller as they are.
+		if (!compressed_data.is_empty() && compressed_data.size() < data.size()) {
+			if (spill_file.is_null()) {
+				spill_file = FileAccess::open(spill_path, FileAccess::WRITE_READ);
+				ERR_FAIL_COND_V_MSG(spill_file.is_null(), ERR_CANT_CREATE, "Can't open file to write: " + spill_path + ".");
+			}
+			pf.compressed = true;
+			pf.spill_ofs = spill_file->get_position();
+			spill_file->store_buffer(compressed_data);
+			pf.compressed_size = compressed_data.size();
+			_size = pf.compressed_size;
+		}
+	}
+
 	if (p_encrypt) { // Add encryption overhead.
 		if (_size % 16) { // Pad to encryption block size.
 			_size += 16 - (_size % 16);
@@ -144,8 +275,10 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 	}
 
 	int pad = _get_pad(alignment, ofs + _size);
+	pf.stored_size = _size + pad;
 	ofs = ofs + _size + pad;
 
+	content_files.insert(content_key, files.size());
 	files.push_back(pf);
 
 	return OK;
@@ -191,10 +324,14 @@ Error PCKPacker::flush(bool p_verbose) {
 		fhead->store_64(files[i].size); // pay attention here, this is where file is
 		fhead->store_buffer(files[i].md5.ptr(), 16); //also save md5 for file
 
+		const File &data_file = files[i].shared_with >= 0 ? files[files[i].shared_with] : files[i];
 		uint32_t flags = 0;
-		if (files[i].encrypted) {
+		if (data_file.encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (data_file.compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -218,33 +355,49 @@ Error PCKPacker::flush(bool p_verbose) {
 
 	int count = 0;
 	for (int i = 0; i < files.size(); i++) {
-		Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
-		uint64_t to_write = files[i].size;
-
-		Ref<FileAccess> ftmp = file;
-		if (files[i].encrypted) {
-			fae.instantiate();
-			ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
-
-			Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
-			ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
-			ftmp = fae;
-		}
+		if (files[i].shared_with >= 0) {
+			// Already stored.
+		} else if (files[i].compressed) {
+			uint64_t to_write = files[i].compressed_size;
+
+			spill_file->seek(files[i].spill_ofs);
+			while (to_write > 0) {
+				uint64_t read = spill_file->get_buffer(buf, MIN(to_write, buf_max));
+				ERR_BREAK(read == 0);
+				file->store_buffer(buf, read);
+				to_write -= read;
+			}
+		} else {
+			Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
+			uint64_t to_write = files[i].size;
+
+			Ref<FileAccess> ftmp = file;
+			if (files[i].encrypted) {
+				fae.instantiate();
+				ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
+
+				Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
+				ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
+				ftmp = fae;
+			}
 
-		while (to_write > 0) {
-			uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
-			ftmp->store_buffer(buf, read);
-			to_write -= read;
-		}
+			while (to_write > 0) {
+				uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
+				ftmp->store_buffer(buf, read);
+				to_write -= read;
+			}
 
-		if (fae.is_valid()) {
-			ftmp.unref();
-			fae.unref();
+			if (fae.is_valid()) {
+				ftmp.unref();
+				fae.unref();
+			}
 		}
 
-		int pad = _get_pad(alignment, file->get_position());
-		for (int j = 0; j < pad; j++) {
-			file->store_8(0);
+		if (files[i].shared_with < 0) {
+			int pad = _get_pad(alignment, file->get_position());
+			for (int j = 0; j < pad; j++) {
+				file->store_8(0);
+			}
 		}
 
 		count += 1;
@@ -254,8 +407,17 @@ Error PCKPacker::flush(bool p_verbose) {
 		}
 	}
 
+	if (p_verbose && deduplicated_files > 0) {
+		print_line(vformat("PCKPacker flush: %d files share the data of identical files, saving %s.", deduplicated_files, String::humanize_size(deduplicated_size)));
+	}
+
 	file.unref();
+	_close_spill_file();
 	memdelete_arr(buf);
 
 	return OK;
 }
+
+PCKPacker::~PCKPacker() {
+	_close_spill_file();
+}
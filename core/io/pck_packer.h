@@ -31,9 +31,10 @@
 #ifndef PCK_PACKER_H
 #define PCK_PACKER_H
 
+#include "core/io/compression.h"
+#include "core/io/file_access_pack.h"
 #include "core/object/ref_counted.h"
-
-class FileAccess;
+#include "core/templates/local_vector.h"
 
 class PCKPacker : public RefCounted {
 	GDCLASS(PCKPacker, RefCounted);
@@ -54,15 +55,52 @@ class PCKPacker : public RefCounted {
 		uint64_t size = 0;
 		bool encrypted = false;
 		Vector<uint8_t> md5;
+		bool compressed = false; // Stored as a block-compressed entry in the spill file instead of the source file.
+		uint64_t spill_ofs = 0; // Position of the compressed entry in the spill file.
+		uint64_t compressed_size = 0;
+		uint64_t stored_size = 0; // Including encryption overhead and padding.
+		int shared_with = -1; // Index of the file with the same contents, whose data is used instead of storing it again.
 	};
 	Vector<File> files;
 
+	// Compressed entries are written here as files are added, so they don't have to be kept in memory
+	// until flush() writes the directory and copies them after it.
+	Ref<FileAccess> spill_file;
+	String spill_path;
+	void _close_spill_file();
+
+	HashMap<String, int> content_files; // Content key to the first file added with it.
+	int deduplicated_files = 0;
+	uint64_t deduplicated_size = 0;
+
+	struct CompressData {
+		const uint8_t *src = nullptr;
+		uint64_t src_size = 0;
+		uint32_t block_size = 0;
+		Compression::Mode mode = Compression::MODE_ZSTD;
+		LocalVector<Vector<uint8_t>> blocks;
+	};
+	static void _compress_block(void *p_userdata, uint32_t p_index);
+
+	Error _add_file(const String &p_file, const String &p_src, bool p_encrypt, int p_compression_mode);
+
 public:
 	Error pck_start(const String &p_file, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false);
+	Error add_file_compressed(const String &p_file, const String &p_src, FileAccess::CompressionMode p_compression_mode = FileAccess::COMPRESSION_ZSTD);
 	Error flush(bool p_verbose = false);
 
+	int get_deduplicated_file_count() const { return deduplicated_files; }
+	uint64_t get_deduplicated_size() const { return deduplicated_size; }
+
+	// Files with the same key can share their data in a pack, `p_flags` are the PackFileFlags and parameters they are stored with.
+	static String get_content_key(const uint8_t *p_data, uint64_t p_size, uint32_t p_flags);
+
+	// Returns the entry stored for a PACK_FILE_COMPRESSED file, see PackedSourcePCK for its layout.
+	static Vector<uint8_t> compress_file(const uint8_t *p_data, uint64_t p_size, Compression::Mode p_mode, uint32_t p_block_size = PACK_COMPRESSED_BLOCK_SIZE);
+
 	PCKPacker() {}
+	~PCKPacker();
 };
 
 #endif // PCK_PACKER_H
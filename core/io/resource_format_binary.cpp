@@ -33,10 +33,12 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/image.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
 //#define print_bl(m_what) print_line(m_what)
@@ -95,9 +97,12 @@ enum {
 	// Version 4: New string ID for ext/subresources, breaks forward compat.
 	// Version 5: Ability to store script class in the header.
 	// Version 6: Added PackedVector4Array Variant type.
-	FORMAT_VERSION = 6,
+	// Version 7: Aligned the contents of numeric packed arrays to PACKED_ARRAY_ALIGNMENT bytes.
+	FORMAT_VERSION = 7,
 	FORMAT_VERSION_CAN_RENAME_DEPS = 1,
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
+	FORMAT_VERSION_ALIGNED_PACKED_ARRAYS = 7,
+	PACKED_ARRAY_ALIGNMENT = 16,
 };
 
 void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
@@ -109,11 +114,25 @@ void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	}
 }
 
-static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
+// Numeric packed arrays are stored in one piece. Since version 7, they are preceded by the amount of padding
+// that aligns them in the file, so they stay aligned within (memory-mapped) packs.
+Error ResourceLoaderBinary::_read_packed_array(uint8_t *p_dst, uint64_t p_size) {
+	if (ver_format >= FORMAT_VERSION_ALIGNED_PACKED_ARRAYS) {
+		uint32_t padding = f->get_32();
+		ERR_FAIL_COND_V(padding >= PACKED_ARRAY_ALIGNMENT, ERR_FILE_CORRUPT);
+		f->seek(f->get_position() + padding);
+	}
+
+	ERR_FAIL_COND_V(f->get_buffer(p_dst, p_size) != p_size, ERR_FILE_CORRUPT);
+	return OK;
+}
+
+Error ResourceLoaderBinary::_read_reals(real_t *dst, size_t count) {
 	if (f->real_is_double) {
 		if constexpr (sizeof(real_t) == 8) {
 			// Ideal case with double-precision
-			f->get_buffer((uint8_t *)dst, count * sizeof(double));
+			Error err = _read_packed_array((uint8_t *)dst, count * sizeof(double));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *dst = (uint64_t *)dst;
@@ -124,8 +143,16 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 #endif
 		} else if constexpr (sizeof(real_t) == 4) {
 			// May be slower, but this is for compatibility. Eventually the data should be converted.
+			LocalVector<double> src;
+			src.resize(count);
+			Error err = _read_packed_array((uint8_t *)src.ptr(), count * sizeof(double));
+			ERR_FAIL_COND_V(err != OK, err);
 			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_double();
+#ifdef BIG_ENDIAN_ENABLED
+				uint64_t *src_u64 = (uint64_t *)src.ptr();
+				src_u64[i] = BSWAP64(src_u64[i]);
+#endif
+				dst[i] = src[i];
 			}
 		} else {
 			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
@@ -133,7 +160,8 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	} else {
 		if constexpr (sizeof(real_t) == 4) {
 			// Ideal case with float-precision
-			f->get_buffer((uint8_t *)dst, count * sizeof(float));
+			Error err = _read_packed_array((uint8_t *)dst, count * sizeof(float));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *dst = (uint32_t *)dst;
@@ -143,8 +171,16 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 			}
 #endif
 		} else if constexpr (sizeof(real_t) == 8) {
+			LocalVector<float> src;
+			src.resize(count);
+			Error err = _read_packed_array((uint8_t *)src.ptr(), count * sizeof(float));
+			ERR_FAIL_COND_V(err != OK, err);
 			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_float();
+#ifdef BIG_ENDIAN_ENABLED
+				uint32_t *src_u32 = (uint32_t *)src.ptr();
+				src_u32[i] = BSWAP32(src_u32[i]);
+#endif
+				dst[i] = src[i];
 			}
 		} else {
 			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
@@ -410,11 +446,13 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					}
 
 					//always use internal cache for loading internal resources
-					if (!internal_index_cache.has(path)) {
+					const HashMap<String, Ref<Resource>> &index_cache = shared_internal_index_cache ? *shared_internal_index_cache : internal_index_cache;
+					const Ref<Resource> *cached = (decoding_index < 0 || (int)index <= decoding_index) ? index_cache.getptr(path) : nullptr;
+					if (!cached) {
 						WARN_PRINT(String("Couldn't load resource (no cache): " + path).utf8().get_data());
 						r_v = Variant();
 					} else {
-						r_v = internal_index_cache[path];
+						r_v = *cached;
 					}
 				} break;
 				case OBJECT_EXTERNAL_RESOURCE: {
@@ -432,6 +470,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						path = remaps[path];
 					}
 
+					if (!external_loads_allowed) {
+						return ERR_BUSY; // Decoded again on the loading thread.
+					}
+
 					Ref<Resource> res = ResourceLoader::load(path, exttype, cache_mode_for_external);
 
 					if (res.is_null()) {
@@ -447,24 +489,15 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					if (erindex < 0 || erindex >= external_resources.size()) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
+					} else if (external_resources_completed) {
+						r_v = external_resources[erindex].resource;
 					} else {
-						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
-						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
-							Error err;
-							Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
-							if (res.is_null()) {
-								if (!ResourceLoader::is_cleaning_tasks()) {
-									if (!ResourceLoader::get_abort_on_missing_resources()) {
-										ResourceLoader::notify_dependency_error(local_path, external_resources[erindex].path, external_resources[erindex].type);
-									} else {
-										error = ERR_FILE_MISSING_DEPENDENCIES;
-										ERR_FAIL_V_MSG(error, "Can't load dependency: " + external_resources[erindex].path + ".");
-									}
-								}
-							} else {
-								r_v = res;
-							}
+						Ref<Resource> res;
+						Error err = _complete_external_resource(erindex, res);
+						if (err) {
+							return err;
 						}
+						r_v = res;
 					}
 				} break;
 				default: {
@@ -514,7 +547,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<uint8_t> array;
 			array.resize(len);
 			uint8_t *w = array.ptrw();
-			f->get_buffer(w, len);
+			const Error err = _read_packed_array(w, len);
+			ERR_FAIL_COND_V(err != OK, err);
 			_advance_padding(len);
 
 			r_v = array;
@@ -526,7 +560,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<int32_t> array;
 			array.resize(len);
 			int32_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
+			const Error err = _read_packed_array((uint8_t *)w, len * sizeof(int32_t));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -545,7 +580,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<int64_t> array;
 			array.resize(len);
 			int64_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
+			const Error err = _read_packed_array((uint8_t *)w, len * sizeof(int64_t));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *ptr = (uint64_t *)w.ptr();
@@ -564,7 +600,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<float> array;
 			array.resize(len);
 			float *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(float));
+			const Error err = _read_packed_array((uint8_t *)w, len * sizeof(float));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -583,7 +620,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<double> array;
 			array.resize(len);
 			double *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(double));
+			const Error err = _read_packed_array((uint8_t *)w, len * sizeof(double));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *ptr = (uint64_t *)w.ptr();
@@ -615,7 +653,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			array.resize(len);
 			Vector2 *w = array.ptrw();
 			static_assert(sizeof(Vector2) == 2 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 2);
+			const Error err = _read_reals(reinterpret_cast<real_t *>(w), len * 2);
 			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
@@ -628,7 +666,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			array.resize(len);
 			Vector3 *w = array.ptrw();
 			static_assert(sizeof(Vector3) == 3 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 3);
+			const Error err = _read_reals(reinterpret_cast<real_t *>(w), len * 3);
 			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
@@ -642,7 +680,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Color *w = array.ptrw();
 			// Colors always use `float` even with double-precision support enabled
 			static_assert(sizeof(Color) == 4 * sizeof(float));
-			f->get_buffer((uint8_t *)w, len * sizeof(float) * 4);
+			const Error err = _read_packed_array((uint8_t *)w, len * sizeof(float) * 4);
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -662,7 +701,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			array.resize(len);
 			Vector4 *w = array.ptrw();
 			static_assert(sizeof(Vector4) == 4 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 4);
+			const Error err = _read_reals(reinterpret_cast<real_t *>(w), len * 4);
 			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
@@ -709,187 +748,369 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
+	// Independent internal resources can only be told apart by their IDs.
+	if (use_sub_threads && using_named_scene_ids && internal_resources.size() > 2) {
+		return _load_internal_resources_parallel();
+	}
+
 	for (int i = 0; i < internal_resources.size(); i++) {
 		bool main = i == (internal_resources.size() - 1);
 
-		//maybe it is loaded already
-		String path;
-		String id;
+		if (ResourceLoader::is_current_load_canceled()) {
+			error = ERR_SKIP;
+			return error;
+		}
 
-		if (!main) {
-			path = internal_resources[i].path;
+		Ref<Resource> res;
+		MissingResource *missing_resource = nullptr;
+		error = _create_internal_resource(i, res, missing_resource);
+		if (error) {
+			return error;
+		}
+		if (res.is_null()) {
+			continue; // Already loaded.
+		}
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+		LocalVector<Pair<StringName, Variant>> properties;
+		error = _parse_properties(properties);
+		if (error) {
+			return error;
+		}
+		_set_properties(res, missing_resource, properties);
 
-				internal_resources.write[i].path = path; // Update path.
-			}
+		if (progress) {
+			*progress = (i + 1) / float(internal_resources.size());
+		}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
-				}
-			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
-			}
+		resource_cache.push_back(res);
+
+		if (main) {
+			f.unref();
+			resource = res;
+			resource->set_as_translation_remapped(translation_remapped);
+			error = OK;
+			return OK;
 		}
+	}
 
-		uint64_t offset = internal_resources[i].offset;
+	return ERR_FILE_EOF;
+}
 
-		f->seek(offset);
+// Leaves `r_res` empty if the resource was loaded already, otherwise the file is at its properties.
+Error ResourceLoaderBinary::_complete_external_resource(int p_index, Ref<Resource> &r_res) {
+	const Ref<ResourceLoader::LoadToken> &load_token = external_resources[p_index].load_token;
+	if (load_token.is_null()) {
+		return OK; // It's OK since then we know this load accepts broken dependencies.
+	}
 
-		String t = get_unicode_string();
+	Error err;
+	r_res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
+	if (r_res.is_null() && !ResourceLoader::is_cleaning_tasks()) {
+		if (!ResourceLoader::get_abort_on_missing_resources()) {
+			ResourceLoader::notify_dependency_error(local_path, external_resources[p_index].path, external_resources[p_index].type);
+		} else {
+			error = ERR_FILE_MISSING_DEPENDENCIES;
+			ERR_FAIL_V_MSG(error, "Can't load dependency: " + external_resources[p_index].path + ".");
+		}
+	}
+	return OK;
+}
 
-		Ref<Resource> res;
-		Resource *r = nullptr;
+Error ResourceLoaderBinary::_create_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource) {
+	bool main = p_index == (internal_resources.size() - 1);
 
-		MissingResource *missing_resource = nullptr;
+	//maybe it is loaded already
+	String path;
+	String id;
 
-		if (main) {
-			res = ResourceLoader::get_resource_ref_override(local_path);
-			r = res.ptr();
+	if (!main) {
+		path = internal_resources[p_index].path;
+
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
+
+			internal_resources.write[p_index].path = path; // Update path.
 		}
-		if (!r) {
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-				//use the existing one
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached->get_class() == t) {
-					cached->reset_state();
-					res = cached;
-				}
+
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				internal_index_cache[path] = cached;
+				return OK;
 			}
+		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
 
-			if (res.is_null()) {
-				//did not replace
-
-				Object *obj = ClassDB::instantiate(t);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						//create a missing resource
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(t);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource;
-					} else {
-						error = ERR_FILE_CORRUPT;
-						ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-					}
-				}
+	uint64_t offset = internal_resources[p_index].offset;
 
-				r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					String obj_class = obj->get_class();
-					error = ERR_FILE_CORRUPT;
-					memdelete(obj); //bye
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
-				}
+	f->seek(offset);
 
-				res = Ref<Resource>(r);
+	String t = get_unicode_string();
+
+	Ref<Resource> res;
+	Resource *r = nullptr;
+
+	if (main) {
+		res = ResourceLoader::get_resource_ref_override(local_path);
+		r = res.ptr();
+	}
+	if (!r) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+			//use the existing one
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached->get_class() == t) {
+				cached->reset_state();
+				res = cached;
 			}
 		}
 
-		if (r) {
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+		if (res.is_null()) {
+			//did not replace
+
+			Object *obj = ClassDB::instantiate(t);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					//create a missing resource
+					r_missing_resource = memnew(MissingResource);
+					r_missing_resource->set_original_class(t);
+					r_missing_resource->set_recording_properties(true);
+					obj = r_missing_resource;
 				} else {
-					r->set_path_cache(path);
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
 				}
 			}
-			r->set_scene_unique_id(id);
+
+			r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				String obj_class = obj->get_class();
+				memdelete(obj); //bye
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+			}
+
+			res = Ref<Resource>(r);
 		}
+	}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+	if (r) {
+		if (!path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+			} else {
+				r->set_path_cache(path);
+			}
 		}
+		r->set_scene_unique_id(id);
+	}
 
-		int pc = f->get_32();
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
 
-		//set properties
+	r_res = res;
+	return OK;
+}
 
-		Dictionary missing_resource_properties;
+Error ResourceLoaderBinary::_parse_properties(LocalVector<Pair<StringName, Variant>> &r_properties) {
+	int pc = f->get_32();
+	ERR_FAIL_COND_V(pc < 0, ERR_FILE_CORRUPT);
+	r_properties.resize(pc);
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
+		ERR_FAIL_COND_V(name == StringName(), ERR_FILE_CORRUPT);
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+		Variant value;
+		Error err = parse_variant(value);
+		if (err) {
+			return err;
+		}
 
-			Variant value;
+		r_properties[j] = Pair<StringName, Variant>(name, value);
+	}
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+	return OK;
+}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+void ResourceLoaderBinary::_set_properties(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const LocalVector<Pair<StringName, Variant>> &p_properties) {
+	Dictionary missing_resource_properties;
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+	for (const Pair<StringName, Variant> &property : p_properties) {
+		const StringName &name = property.first;
+		Variant value = property.second;
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
-			}
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && p_missing_resource != nullptr) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
 
-			if (set_valid) {
-				res->set(name, value);
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
 			}
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+		if (value.get_type() == Variant::ARRAY) {
+			Array set_array = value;
+			bool is_get_valid = false;
+			Variant get_value = p_res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+				Array get_array = get_value;
+				if (!set_array.is_same_typed(get_array)) {
+					value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
+				}
+			}
 		}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+		if (set_valid) {
+			p_res->set(name, value);
 		}
+	}
+
+	if (p_missing_resource) {
+		p_missing_resource->set_recording_properties(false);
+	}
+
+	if (!missing_resource_properties.is_empty()) {
+		p_res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
 
 #ifdef TOOLS_ENABLED
-		res->set_edited(false);
+	p_res->set_edited(false);
 #endif
+}
 
-		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+// Decodes the properties of the internal resources in parallel, each from its own copy of their part of the file.
+// Setting them can run arbitrary code (e.g. connecting signals), so it's done on the loading thread, in file order.
+Error ResourceLoaderBinary::_load_internal_resources_parallel() {
+	// The decoding threads only read the external resources, completing them would wait for other loads there.
+	for (int i = 0; i < external_resources.size(); i++) {
+		error = _complete_external_resource(i, external_resources.write[i].resource);
+		if (error) {
+			return error;
 		}
+	}
 
-		resource_cache.push_back(res);
+	LocalVector<InternalResourceDecode> decodes;
 
-		if (main) {
-			f.unref();
-			resource = res;
-			resource->set_as_translation_remapped(translation_remapped);
-			error = OK;
-			return OK;
+	// Create all resources first, so references between them can be resolved in any order.
+	for (int i = 0; i < internal_resources.size(); i++) {
+		Ref<Resource> res;
+		MissingResource *missing_resource = nullptr;
+		error = _create_internal_resource(i, res, missing_resource);
+		if (error) {
+			return error;
+		}
+		if (res.is_null()) {
+			continue; // Already loaded.
 		}
+
+		InternalResourceDecode decode;
+		decode.index = i;
+		decode.resource = res;
+		decode.missing_resource = missing_resource;
+		decode.offset = f->get_position();
+		decodes.push_back(decode);
 	}
 
-	return ERR_FILE_EOF;
+	ERR_FAIL_COND_V_MSG(decodes.is_empty() || decodes[decodes.size() - 1].index != internal_resources.size() - 1, ERR_FILE_CORRUPT, local_path + ": Main resource is missing.");
+
+	// The properties of a resource end where the next resource starts.
+	LocalVector<uint64_t> offsets;
+	for (const IntResource &int_resource : internal_resources) {
+		offsets.push_back(int_resource.offset);
+	}
+	offsets.sort();
+	const uint64_t file_length = f->get_length();
+
+	for (InternalResourceDecode &decode : decodes) {
+		uint64_t end = file_length;
+		for (uint64_t offset : offsets) {
+			if (offset >= decode.offset) {
+				end = offset;
+				break;
+			}
+		}
+		ERR_FAIL_COND_V(end < decode.offset, ERR_FILE_CORRUPT);
+
+		decode.data.resize(end - decode.offset);
+		f->seek(decode.offset);
+		ERR_FAIL_COND_V(f->get_buffer(decode.data.ptrw(), decode.data.size()) != (uint64_t)decode.data.size(), ERR_FILE_CORRUPT);
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ResourceLoaderBinary::_decode_internal_resource, &decodes, decodes.size(), -1, true, SNAME("ResourceLoaderBinaryDecode"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (InternalResourceDecode &decode : decodes) {
+		if (ResourceLoader::is_current_load_canceled()) {
+			error = ERR_SKIP;
+			return error;
+		}
+
+		if (decode.error == ERR_BUSY) {
+			// Uses the old external resource format, which loads while decoding.
+			_decode_properties(decode, true);
+		}
+		if (decode.error != OK) {
+			error = decode.error;
+			return error;
+		}
+		decode.data.clear();
+
+		_set_properties(decode.resource, decode.missing_resource, decode.properties);
+		decode.properties.clear();
+
+		if (progress) {
+			*progress = (decode.index + 1) / float(internal_resources.size());
+		}
+
+		resource_cache.push_back(decode.resource);
+	}
+
+	f.unref();
+	resource = decodes[decodes.size() - 1].resource;
+	resource->set_as_translation_remapped(translation_remapped);
+	error = OK;
+	return OK;
+}
+
+void ResourceLoaderBinary::_decode_internal_resource(uint32_t p_index, LocalVector<InternalResourceDecode> *p_decodes) {
+	_decode_properties((*p_decodes)[p_index], false);
+}
+
+void ResourceLoaderBinary::_decode_properties(InternalResourceDecode &p_decode, bool p_allow_external_loads) {
+	Ref<FileAccessMemory> fa;
+	fa.instantiate();
+	fa->open_custom(p_decode.data.ptr(), p_decode.data.size());
+	fa->real_is_double = f->real_is_double;
+
+	// Only reads the state shared with the other decoding threads.
+	ResourceLoaderBinary decoder;
+	decoder.f = fa;
+	decoder.local_path = local_path;
+	decoder.res_path = res_path;
+	decoder.ver_format = ver_format;
+	decoder.string_map = string_map;
+	decoder.using_named_scene_ids = using_named_scene_ids;
+	decoder.external_resources = external_resources;
+	decoder.internal_resources = internal_resources;
+	decoder.shared_internal_index_cache = &internal_index_cache;
+	decoder.decoding_index = p_decode.index;
+	decoder.external_resources_completed = true;
+	decoder.external_loads_allowed = p_allow_external_loads;
+	decoder.remaps = remaps;
+	decoder.cache_mode_for_external = cache_mode_for_external;
+
+	p_decode.properties.clear();
+	p_decode.error = decoder._parse_properties(p_decode.properties);
 }
 
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
@@ -1572,6 +1793,33 @@ void ResourceFormatSaverBinaryInstance::_pad_buffer(Ref<FileAccess> f, int p_byt
 	}
 }
 
+void ResourceFormatSaverBinaryInstance::_store_packed_array(Ref<FileAccess> f, const void *p_data, uint64_t p_count, uint32_t p_element_size) {
+	uint32_t padding = (PACKED_ARRAY_ALIGNMENT - (f->get_position() + 4) % PACKED_ARRAY_ALIGNMENT) % PACKED_ARRAY_ALIGNMENT;
+	f->store_32(padding);
+	for (uint32_t i = 0; i < padding; i++) {
+		f->store_8(0);
+	}
+
+#ifdef BIG_ENDIAN_ENABLED
+	// Stored as little-endian.
+	for (uint64_t i = 0; i < p_count; i++) {
+		switch (p_element_size) {
+			case 1: {
+				f->store_8(((const uint8_t *)p_data)[i]);
+			} break;
+			case 4: {
+				f->store_32(((const uint32_t *)p_data)[i]);
+			} break;
+			case 8: {
+				f->store_64(((const uint64_t *)p_data)[i]);
+			} break;
+		}
+	}
+#else
+	f->store_buffer((const uint8_t *)p_data, p_count * p_element_size);
+#endif
+}
+
 void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint) {
 	switch (p_property.get_type()) {
 		case Variant::NIL: {
@@ -1879,8 +2127,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<uint8_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const uint8_t *r = arr.ptr();
-			f->store_buffer(r, len);
+			_store_packed_array(f, arr.ptr(), len, 1);
 			_pad_buffer(f, len);
 
 		} break;
@@ -1889,10 +2136,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<int32_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const int32_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_32(r[i]);
-			}
+			_store_packed_array(f, arr.ptr(), len, sizeof(int32_t));
 
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
@@ -1900,10 +2144,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<int64_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const int64_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_64(r[i]);
-			}
+			_store_packed_array(f, arr.ptr(), len, sizeof(int64_t));
 
 		} break;
 		case Variant::PACKED_FLOAT32_ARRAY: {
@@ -1911,10 +2152,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<float> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const float *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_float(r[i]);
-			}
+			_store_packed_array(f, arr.ptr(), len, sizeof(float));
 
 		} break;
 		case Variant::PACKED_FLOAT64_ARRAY: {
@@ -1922,10 +2160,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<double> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const double *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_double(r[i]);
-			}
+			_store_packed_array(f, arr.ptr(), len, sizeof(double));
 
 		} break;
 		case Variant::PACKED_STRING_ARRAY: {
@@ -1944,11 +2179,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector2> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const Vector2 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-			}
+			_store_packed_array(f, arr.ptr(), len * 2, sizeof(real_t));
 		} break;
 
 		case Variant::PACKED_VECTOR3_ARRAY: {
@@ -1956,12 +2187,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector3> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const Vector3 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-				f->store_real(r[i].z);
-			}
+			_store_packed_array(f, arr.ptr(), len * 3, sizeof(real_t));
 		} break;
 
 		case Variant::PACKED_COLOR_ARRAY: {
@@ -1969,13 +2195,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Color> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const Color *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_float(r[i].r);
-				f->store_float(r[i].g);
-				f->store_float(r[i].b);
-				f->store_float(r[i].a);
-			}
+			_store_packed_array(f, arr.ptr(), len * 4, sizeof(float));
 
 		} break;
 		case Variant::PACKED_VECTOR4_ARRAY: {
@@ -1983,13 +2203,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector4> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const Vector4 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-				f->store_real(r[i].z);
-				f->store_real(r[i].w);
-			}
+			_store_packed_array(f, arr.ptr(), len * 4, sizeof(real_t));
 
 		} break;
 		default: {
@@ -2502,6 +2716,10 @@ void ResourceFormatSaverBinary::get_recognized_extensions(const Ref<Resource> &p
 
 ResourceFormatSaverBinary *ResourceFormatSaverBinary::singleton = nullptr;
 
+int ResourceFormatSaverBinary::get_format_version() {
+	return FORMAT_VERSION;
+}
+
 ResourceFormatSaverBinary::ResourceFormatSaverBinary() {
 	singleton = this;
 }
@@ -34,6 +34,10 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+
+class MissingResource;
 
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
@@ -61,6 +65,7 @@ class ResourceLoaderBinary {
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		Ref<ResourceLoader::LoadToken> load_token;
+		Ref<Resource> resource; // Set when completed before decoding in parallel.
 	};
 
 	bool using_named_scene_ids = false;
@@ -78,8 +83,35 @@ class ResourceLoaderBinary {
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
 
+	// Internal resources decoded on worker threads when loading with sub-threads, see _load_internal_resources_parallel().
+	struct InternalResourceDecode {
+		int index = 0;
+		Ref<Resource> resource;
+		MissingResource *missing_resource = nullptr;
+		uint64_t offset = 0; // Of the properties, which start with their count.
+		Vector<uint8_t> data;
+		LocalVector<Pair<StringName, Variant>> properties;
+		Error error = OK;
+	};
+
+	// Set on the loaders that decode the properties of a single internal resource.
+	const HashMap<String, Ref<Resource>> *shared_internal_index_cache = nullptr;
+	int decoding_index = -1; // Internal resources after this one are not loaded yet.
+	bool external_resources_completed = false;
+	bool external_loads_allowed = true;
+
+	Error _complete_external_resource(int p_index, Ref<Resource> &r_res);
+	Error _create_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource);
+	Error _parse_properties(LocalVector<Pair<StringName, Variant>> &r_properties);
+	void _set_properties(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const LocalVector<Pair<StringName, Variant>> &p_properties);
+	Error _load_internal_resources_parallel();
+	void _decode_internal_resource(uint32_t p_index, LocalVector<InternalResourceDecode> *p_decodes);
+	void _decode_properties(InternalResourceDecode &p_decode, bool p_allow_external_loads);
+
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
+	Error _read_packed_array(uint8_t *p_dst, uint64_t p_size);
+	Error _read_reals(real_t *dst, size_t count);
 
 	HashMap<String, String> remaps;
 	Error error = OK;
@@ -159,6 +191,7 @@ class ResourceFormatSaverBinaryInstance {
 	};
 
 	static void _pad_buffer(Ref<FileAccess> f, int p_bytes);
+	static void _store_packed_array(Ref<FileAccess> f, const void *p_data, uint64_t p_count, uint32_t p_element_size);
 	void _find_resources(const Variant &p_variant, bool p_main = false);
 	static void save_unicode_string(Ref<FileAccess> f, const String &p_string, bool p_bit_on_len = false);
 	int get_string_index(const String &p_string);
@@ -181,6 +214,7 @@ public:
 class ResourceFormatSaverBinary : public ResourceFormatSaver {
 public:
 	static ResourceFormatSaverBinary *singleton;
+	static int get_format_version();
 	virtual Error save(const Ref<Resource> &p_resource, const String &p_path, uint32_t p_flags = 0) override;
 	virtual Error set_uid(const String &p_path, ResourceUID::ID p_uid) override;
 	virtual bool recognize(const Ref<Resource> &p_resource) const override;
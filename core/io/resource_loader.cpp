@@ -216,6 +216,9 @@ void ResourceLoader::LoadToken::clear() {
 	if (!local_path.is_empty()) { // Empty is used for the special case where the load task is not registered.
 		DEV_ASSERT(thread_load_tasks.has(local_path));
 		ThreadLoadTask &load_task = thread_load_tasks[local_path];
+		if (load_task.queued) {
+			queued_load_tasks.erase(&load_task);
+		}
 		if (!load_task.awaited) {
 			task_to_await = load_task.task_id;
 			load_task.awaited = true;
@@ -280,6 +283,10 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 		return res;
 	}
 
+	if (r_error && *r_error == ERR_SKIP) {
+		return Ref<Resource>(); // Canceled, see is_current_load_canceled().
+	}
+
 	ERR_FAIL_COND_V_MSG(found, Ref<Resource>(),
 			vformat("Failed loading resource: %s. Make sure resources have been imported by opening the project in the editor at least once.", p_path));
 
@@ -298,6 +305,7 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	caller_task_id = load_task.task_id;
 	if (cleaning_tasks) {
 		load_task.status = THREAD_LOAD_FAILED;
+		_finish_queued_load(load_task);
 		thread_load_mutex.unlock();
 		return;
 	}
@@ -320,7 +328,19 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	// --
 
 	Error load_err = OK;
-	Ref<Resource> res = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_err, load_task.use_sub_threads, &load_task.progress);
+	Ref<Resource> res;
+	while (true) {
+		res = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_err, load_task.use_sub_threads, &load_task.progress);
+		if (load_err != ERR_SKIP) {
+			break;
+		}
+		MutexLock thread_load_lock(thread_load_mutex);
+		if (load_task.canceled) {
+			break;
+		}
+		// Requested again after the loader gave up on it.
+		load_err = OK;
+	}
 	if (MessageQueue::get_singleton() != MessageQueue::get_main_singleton()) {
 		MessageQueue::get_singleton()->flush();
 	}
@@ -336,6 +356,7 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	} else {
 		load_task.status = THREAD_LOAD_LOADED;
 	}
+	_finish_queued_load(load_task);
 
 	if (load_task.cond_var) {
 		load_task.cond_var->notify_all();
@@ -428,20 +449,23 @@ static String _validate_local_path(const String &p_path) {
 
 Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode) {
 	thread_load_mutex.lock();
+	_release_canceled_load_tokens();
 	if (user_load_tokens.has(p_path)) {
 		print_verbose("load_threaded_request(): Another threaded load for resource path '" + p_path + "' has been initiated. Not an error.");
 		user_load_tokens[p_path]->reference(); // Additional request.
+		user_load_tokens[p_path]->user_requests++;
 		thread_load_mutex.unlock();
 		return OK;
 	}
 	user_load_tokens[p_path] = nullptr;
 	thread_load_mutex.unlock();
 
-	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode);
+	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode, true);
 	if (token.is_valid()) {
 		thread_load_mutex.lock();
 		token->user_path = p_path;
 		token->reference(); // First request.
+		token->user_requests = 1;
 		user_load_tokens[p_path] = token.ptr();
 		print_lt("REQUEST: user load tokens: " + itos(user_load_tokens.size()));
 		thread_load_mutex.unlock();
@@ -468,7 +492,7 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 	return res;
 }
 
-Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode) {
+Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_queue) {
 	String local_path = _validate_local_path(p_path);
 
 	bool ignoring_cache = p_cache_mode == ResourceFormatLoader::CACHE_MODE_IGNORE || p_cache_mode == ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP;
@@ -484,6 +508,8 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 		if (!ignoring_cache && thread_load_tasks.has(local_path)) {
 			load_token = Ref<LoadToken>(thread_load_tasks[local_path].load_token);
 			if (load_token.is_valid()) {
+				// Needed again, don't let the loader give up on it.
+				thread_load_tasks[local_path].canceled = false;
 				return load_token;
 			} else {
 				// The token is dying (reached 0 on another thread).
@@ -534,6 +560,11 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 
 		if (run_on_current_thread) {
 			load_task_ptr->thread_id = Thread::get_caller_id();
+		} else if (p_queue) {
+			load_task_ptr->queued = true;
+			load_task_ptr->queued_usec = OS::get_singleton()->get_ticks_usec();
+			queued_load_tasks.push_back(load_task_ptr);
+			_dispatch_queued_loads();
 		} else {
 			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_thread_load_function, load_task_ptr);
 		}
@@ -549,6 +580,94 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 	return load_token;
 }
 
+void ResourceLoader::_start_queued_load(ThreadLoadTask *p_load_task) {
+	if (p_load_task->queued) {
+		queued_load_tasks.erase(p_load_task);
+		p_load_task->queued = false;
+	}
+
+	uint64_t wait_usec = OS::get_singleton()->get_ticks_usec() - p_load_task->queued_usec;
+	load_queue_stats.started++;
+	load_queue_stats.total_wait_usec += wait_usec;
+	load_queue_stats.max_wait_usec = MAX(load_queue_stats.max_wait_usec, wait_usec);
+
+	p_load_task->from_queue = true;
+	// High priority loads don't take the place of a low priority one, see _dispatch_queued_loads().
+	p_load_task->counts_as_running = p_load_task->priority != LOAD_PRIORITY_HIGH;
+	if (p_load_task->counts_as_running) {
+		running_queued_loads++;
+	}
+	p_load_task->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_thread_load_function, p_load_task, p_load_task->priority == LOAD_PRIORITY_HIGH);
+}
+
+void ResourceLoader::_dispatch_queued_loads() {
+	if (cleaning_tasks) {
+		return;
+	}
+
+	// Loads run as low priority tasks, so starting more than that would only move the waiting to the pool, where it can't be reordered.
+	const uint32_t max_running = MAX(1u, WorkerThreadPool::get_singleton()->get_max_low_priority_threads());
+	while (!queued_load_tasks.is_empty()) {
+		// Highest priority first, then in request order.
+		ThreadLoadTask *next = queued_load_tasks[0];
+		for (ThreadLoadTask *load_task : queued_load_tasks) {
+			if (load_task->priority > next->priority) {
+				next = load_task;
+			}
+		}
+		// High priority loads don't wait for the others, they run as high priority tasks.
+		if (next->priority != LOAD_PRIORITY_HIGH && running_queued_loads >= max_running) {
+			break;
+		}
+		_start_queued_load(next);
+	}
+}
+
+void ResourceLoader::_finish_queued_load(ThreadLoadTask &p_load_task) {
+	if (!p_load_task.from_queue) {
+		return;
+	}
+	p_load_task.from_queue = false;
+	if (p_load_task.counts_as_running) {
+		p_load_task.counts_as_running = false;
+		running_queued_loads--;
+	}
+	load_queue_stats.finished++;
+	_dispatch_queued_loads();
+}
+
+void ResourceLoader::_release_user_request(LoadToken *p_load_token) {
+	DEV_ASSERT(p_load_token->user_requests > 0);
+	p_load_token->user_requests--;
+	if (p_load_token->user_requests == 0 && !p_load_token->user_path.is_empty()) {
+		// Only loads depending on it may be left, which don't keep the path requested.
+		user_load_tokens.erase(p_load_token->user_path);
+		p_load_token->user_path.clear();
+	}
+	if (p_load_token->unreference()) {
+		memdelete(p_load_token);
+	}
+}
+
+void ResourceLoader::_release_canceled_load_tokens() {
+	uint32_t i = 0;
+	while (i < canceled_load_tokens.size()) {
+		LoadToken *load_token = canceled_load_tokens[i];
+		if (!load_token->local_path.is_empty()) {
+			const ThreadLoadTask &load_task = thread_load_tasks[load_token->local_path];
+			// If awaited elsewhere, whoever awaits holds another reference until the task is done.
+			if (load_task.status == THREAD_LOAD_IN_PROGRESS || (!load_task.awaited && !WorkerThreadPool::get_singleton()->is_task_completed(load_task.task_id))) {
+				i++;
+				continue;
+			}
+		}
+		canceled_load_tokens.remove_at_unordered(i);
+		if (load_token->unreference()) {
+			memdelete(load_token);
+		}
+	}
+}
+
 float ResourceLoader::_dependency_get_progress(const String &p_path) {
 	if (thread_load_tasks.has(p_path)) {
 		ThreadLoadTask &load_task = thread_load_tasks[p_path];
@@ -576,6 +695,7 @@ ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const
 	ThreadLoadStatus status = THREAD_LOAD_IN_PROGRESS;
 	{
 		MutexLock thread_load_lock(thread_load_mutex);
+		_release_canceled_load_tokens();
 
 		if (!user_load_tokens.has(p_path)) {
 			print_verbose("load_threaded_get_status(): No threaded load for resource path '" + p_path + "' has been initiated or its result has already been collected.");
@@ -623,6 +743,7 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 	Ref<Resource> res;
 	{
 		MutexLock thread_load_lock(thread_load_mutex);
+		_release_canceled_load_tokens();
 
 		if (!user_load_tokens.has(p_path)) {
 			print_verbose("load_threaded_get(): No threaded load for resource path '" + p_path + "' has been initiated or its result has already been collected.");
@@ -643,7 +764,10 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 
 		// Support userland requesting on the main thread before the load is reported to be complete.
 		if (Thread::is_main_thread() && !load_token->local_path.is_empty()) {
-			const ThreadLoadTask &load_task = thread_load_tasks[load_token->local_path];
+			ThreadLoadTask &load_task = thread_load_tasks[load_token->local_path];
+			if (load_task.queued) {
+				_start_queued_load(&load_task); // Needed now, skip the queue.
+			}
 			while (load_task.status == THREAD_LOAD_IN_PROGRESS) {
 				thread_load_lock.~MutexLock();
 				bool exit = !_ensure_load_progress();
@@ -656,9 +780,7 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 		}
 
 		res = _load_complete_inner(*load_token, r_error, thread_load_lock);
-		if (load_token->unreference()) {
-			memdelete(load_token);
-		}
+		_release_user_request(load_token);
 	}
 
 	print_lt("GET: user load tokens: " + itos(user_load_tokens.size()));
@@ -666,6 +788,88 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 	return res;
 }
 
+Error ResourceLoader::load_threaded_set_priority(const String &p_path, LoadPriority p_priority) {
+	ERR_FAIL_INDEX_V(p_priority, LOAD_PRIORITY_HIGH + 1, ERR_INVALID_PARAMETER);
+
+	MutexLock thread_load_lock(thread_load_mutex);
+
+	LoadToken *load_token = user_load_tokens.has(p_path) ? user_load_tokens[p_path] : nullptr;
+	if (!load_token || load_token->local_path.is_empty()) {
+		print_verbose("load_threaded_set_priority(): No threaded load for resource path '" + p_path + "' has been initiated or its result has already been collected.");
+		return ERR_INVALID_PARAMETER;
+	}
+
+	ThreadLoadTask &load_task = thread_load_tasks[load_token->local_path];
+	load_task.priority = p_priority;
+	if (load_task.queued) {
+		_dispatch_queued_loads();
+	}
+	return OK;
+}
+
+Error ResourceLoader::load_threaded_cancel(const String &p_path) {
+	MutexLock thread_load_lock(thread_load_mutex);
+	_release_canceled_load_tokens();
+
+	LoadToken *load_token = user_load_tokens.has(p_path) ? user_load_tokens[p_path] : nullptr;
+	if (!load_token) {
+		print_verbose("load_threaded_cancel(): No threaded load for resource path '" + p_path + "' has been initiated or its result has already been collected.");
+		return ERR_INVALID_PARAMETER;
+	}
+
+	// Other requests or loads depending on it still need it, just drop this request.
+	if (load_token->get_reference_count() > 1) {
+		_release_user_request(load_token);
+		return OK;
+	}
+
+	ThreadLoadTask *load_task = load_token->local_path.is_empty() ? nullptr : &thread_load_tasks[load_token->local_path];
+	if (load_task && load_task->status == THREAD_LOAD_IN_PROGRESS) {
+		load_queue_stats.canceled++;
+		if (load_task->queued) {
+			// Never started, the token takes it out of the queue.
+			load_task->status = THREAD_LOAD_FAILED;
+			load_task->error = ERR_SKIP;
+		} else {
+			// The loader gives up at its next check, the token can only go once its task is done.
+			load_task->canceled = true;
+			load_token->user_requests = 0;
+			user_load_tokens.erase(p_path);
+			load_token->user_path.clear();
+			canceled_load_tokens.push_back(load_token);
+			return OK;
+		}
+	}
+
+	_release_user_request(load_token);
+	return OK;
+}
+
+Dictionary ResourceLoader::load_threaded_get_stats() {
+	MutexLock thread_load_lock(thread_load_mutex);
+	_release_canceled_load_tokens();
+
+	Dictionary stats;
+	stats["queued"] = queued_load_tasks.size();
+	stats["running"] = running_queued_loads;
+	stats["finished"] = load_queue_stats.finished;
+	stats["canceled"] = load_queue_stats.canceled;
+	stats["canceling"] = canceled_load_tokens.size();
+	stats["average_wait_usec"] = load_queue_stats.started ? load_queue_stats.total_wait_usec / load_queue_stats.started : 0;
+	stats["max_wait_usec"] = load_queue_stats.max_wait_usec;
+	return stats;
+}
+
+bool ResourceLoader::is_current_load_canceled() {
+	if (!load_paths_stack || load_paths_stack->is_empty()) {
+		return false;
+	}
+
+	MutexLock thread_load_lock(thread_load_mutex);
+	HashMap<String, ThreadLoadTask>::Iterator E = thread_load_tasks.find(load_paths_stack->get(load_paths_stack->size() - 1));
+	return E && E->value.canceled;
+}
+
 Ref<Resource> ResourceLoader::_load_complete(LoadToken &p_load_token, Error *r_error) {
 	MutexLock thread_load_lock(thread_load_mutex);
 	return _load_complete_inner(p_load_token, r_error, thread_load_lock);
@@ -691,6 +895,9 @@ Ref<Resource> ResourceLoader::_load_complete_inner(LoadToken &p_load_token, Erro
 		ThreadLoadTask &load_task = thread_load_tasks[p_load_token.local_path];
 
 		if (load_task.status == THREAD_LOAD_IN_PROGRESS) {
+			if (load_task.queued) {
+				_start_queued_load(&load_task); // Needed now, skip the queue.
+			}
 			DEV_ASSERT((load_task.task_id == 0) != (load_task.thread_id == 0));
 
 			if ((load_task.task_id != 0 && load_task.task_id == caller_task_id) ||
@@ -1164,6 +1371,12 @@ void ResourceLoader::clear_thread_load_tasks() {
 	thread_load_mutex.lock();
 	cleaning_tasks = true;
 
+	for (ThreadLoadTask *load_task : queued_load_tasks) {
+		load_task->queued = false;
+		load_task->status = THREAD_LOAD_FAILED;
+	}
+	queued_load_tasks.clear();
+
 	while (true) {
 		bool none_running = true;
 		if (thread_load_tasks.size()) {
@@ -1186,6 +1399,13 @@ void ResourceLoader::clear_thread_load_tasks() {
 		thread_load_mutex.lock();
 	}
 
+	for (LoadToken *load_token : canceled_load_tokens) {
+		if (load_token->unreference()) {
+			memdelete(load_token);
+		}
+	}
+	canceled_load_tokens.clear();
+
 	while (user_load_tokens.begin()) {
 		// User load tokens remove themselves from the map on destruction.
 		memdelete(user_load_tokens.begin()->value);
@@ -1193,6 +1413,7 @@ void ResourceLoader::clear_thread_load_tasks() {
 	user_load_tokens.clear();
 
 	thread_load_tasks.clear();
+	running_queued_loads = 0;
 
 	cleaning_tasks = false;
 	thread_load_mutex.unlock();
@@ -1319,6 +1540,10 @@ HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_task
 bool ResourceLoader::cleaning_tasks = false;
 
 HashMap<String, ResourceLoader::LoadToken *> ResourceLoader::user_load_tokens;
+LocalVector<ResourceLoader::ThreadLoadTask *> ResourceLoader::queued_load_tasks;
+uint32_t ResourceLoader::running_queued_loads = 0;
+LocalVector<ResourceLoader::LoadToken *> ResourceLoader::canceled_load_tokens;
+ResourceLoader::LoadQueueStats ResourceLoader::load_queue_stats;
 
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
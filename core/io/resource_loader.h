@@ -118,9 +118,16 @@ public:
 		LOAD_THREAD_DISTRIBUTE,
 	};
 
+	enum LoadPriority {
+		LOAD_PRIORITY_LOW,
+		LOAD_PRIORITY_NORMAL,
+		LOAD_PRIORITY_HIGH,
+	};
+
 	struct LoadToken : public RefCounted {
 		String local_path;
 		String user_path;
+		uint32_t user_requests = 0; // References held by load_threaded_request(), the others are loads depending on it.
 		Ref<Resource> res_if_unregistered;
 
 		void clear();
@@ -130,7 +137,7 @@ public:
 
 	static const int BINARY_MUTEX_TAG = 1;
 
-	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode);
+	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_queue = false);
 	static Ref<Resource> _load_complete(LoadToken &p_load_token, Error *r_error);
 
 private:
@@ -181,10 +188,38 @@ private:
 		bool xl_remapped = false;
 		bool use_sub_threads = false;
 		HashSet<String> sub_tasks;
+		LoadPriority priority = LOAD_PRIORITY_NORMAL;
+		bool queued = false; // Requested by the user and waiting in `queued_load_tasks` for its turn.
+		bool from_queue = false; // Started from the queue.
+		bool counts_as_running = false; // Started from the queue as a low priority task, counts towards the limit of running queued loads.
+		bool canceled = false; // Loaders check it through is_current_load_canceled().
+		uint64_t queued_usec = 0;
 	};
 
 	static void _thread_load_function(void *p_userdata);
 
+	// User requests wait here, ordered by priority, so the ones started last can still be reprioritized or canceled.
+	static LocalVector<ThreadLoadTask *> queued_load_tasks;
+	static uint32_t running_queued_loads;
+	// Tokens of loads canceled while running, released once their task is done.
+	static LocalVector<LoadToken *> canceled_load_tokens;
+
+	struct LoadQueueStats {
+		uint64_t finished = 0;
+		uint64_t canceled = 0;
+		uint64_t started = 0;
+		uint64_t total_wait_usec = 0;
+		uint64_t max_wait_usec = 0;
+	};
+	static LoadQueueStats load_queue_stats;
+
+	static void _start_queued_load(ThreadLoadTask *p_load_task);
+	static void _dispatch_queued_loads();
+	static void _finish_queued_load(ThreadLoadTask &p_load_task);
+	static void _release_canceled_load_tokens();
+	// Drops one load_threaded_request() reference, the user path stays requested while others are left.
+	static void _release_user_request(LoadToken *p_load_token);
+
 	static thread_local int load_nesting;
 	static thread_local WorkerThreadPool::TaskID caller_task_id;
 	static thread_local HashMap<int, HashMap<String, Ref<Resource>>> res_ref_overrides; // Outermost key is nesting level.
@@ -203,6 +238,12 @@ public:
 	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE);
 	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = nullptr);
 	static Ref<Resource> load_threaded_get(const String &p_path, Error *r_error = nullptr);
+	static Error load_threaded_set_priority(const String &p_path, LoadPriority p_priority);
+	static Error load_threaded_cancel(const String &p_path);
+	static Dictionary load_threaded_get_stats();
+
+	// Loaders can call this between resources to give up early on loads nobody waits for anymore.
+	static bool is_current_load_canceled();
 
 	static bool is_within_load() { return load_nesting > 0; };
 
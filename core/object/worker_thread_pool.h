@@ -236,6 +236,7 @@ public:
 	void wait_for_group_task_completion(GroupID p_group);
 
 	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
+	_FORCE_INLINE_ uint32_t get_max_low_priority_threads() const { return max_low_priority_threads; }
 
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	static int get_thread_index();
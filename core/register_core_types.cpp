@@ -381,6 +381,7 @@ void unregister_core_types() {
 
 	// Destroy singletons in reverse order to ensure dependencies are not broken.
 
+	FileAccess::cleanup_async_reads(); // Before the worker threads some may still complete on are gone.
 	memdelete(worker_thread_pool);
 
 	memdelete(_engine_debugger);
@@ -1766,6 +1766,18 @@ AABB MeshStorage::multimesh_get_custom_aabb(RID p_multimesh) const {
 	return multimesh->custom_aabb;
 }
 
+void MeshStorage::multimesh_set_gpu_culling(RID p_multimesh, bool p_enable) {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL(multimesh);
+	multimesh->gpu_culling = p_enable;
+}
+
+bool MeshStorage::multimesh_is_gpu_culling_enabled(RID p_multimesh) const {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL_V(multimesh, false);
+	return multimesh->gpu_culling;
+}
+
 AABB MeshStorage::multimesh_get_aabb(RID p_multimesh) const {
 	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 	ERR_FAIL_NULL_V(multimesh, AABB());
@@ -1971,6 +1983,53 @@ void MeshStorage::multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_b
 	}
 }
 
+void MeshStorage::multimesh_set_buffer_range(RID p_multimesh, int p_from_instance, const Vector<float> &p_buffer) {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL(multimesh);
+
+	uint32_t xform_stride = multimesh->xform_format == RS::MULTIMESH_TRANSFORM_2D ? 8 : 12;
+	uint32_t stride = xform_stride + (multimesh->uses_colors ? 4 : 0) + (multimesh->uses_custom_data ? 4 : 0);
+	ERR_FAIL_COND(p_buffer.size() % stride != 0);
+
+	int instance_count = p_buffer.size() / stride;
+	ERR_FAIL_COND(p_from_instance < 0 || p_from_instance + instance_count > multimesh->instances);
+
+	// Colors and custom data are packed in the data cache, so go through the per-instance setters.
+	// They only mark the regions they touch as dirty.
+	const float *r = p_buffer.ptr();
+	for (int i = 0; i < instance_count; i++) {
+		const float *dataptr = r + i * stride;
+		int index = p_from_instance + i;
+
+		if (multimesh->xform_format == RS::MULTIMESH_TRANSFORM_3D) {
+			Transform3D xform;
+			xform.basis.rows[0] = Vector3(dataptr[0], dataptr[1], dataptr[2]);
+			xform.basis.rows[1] = Vector3(dataptr[4], dataptr[5], dataptr[6]);
+			xform.basis.rows[2] = Vector3(dataptr[8], dataptr[9], dataptr[10]);
+			xform.origin = Vector3(dataptr[3], dataptr[7], dataptr[11]);
+			multimesh_instance_set_transform(p_multimesh, index, xform);
+		} else {
+			Transform2D xform;
+			xform.columns[0][0] = dataptr[0];
+			xform.columns[1][0] = dataptr[1];
+			xform.columns[2][0] = dataptr[3];
+			xform.columns[0][1] = dataptr[4];
+			xform.columns[1][1] = dataptr[5];
+			xform.columns[2][1] = dataptr[7];
+			multimesh_instance_set_transform_2d(p_multimesh, index, xform);
+		}
+
+		uint32_t offset = xform_stride;
+		if (multimesh->uses_colors) {
+			multimesh_instance_set_color(p_multimesh, index, Color(dataptr[offset], dataptr[offset + 1], dataptr[offset + 2], dataptr[offset + 3]));
+			offset += 4;
+		}
+		if (multimesh->uses_custom_data) {
+			multimesh_instance_set_custom_data(p_multimesh, index, Color(dataptr[offset], dataptr[offset + 1], dataptr[offset + 2], dataptr[offset + 3]));
+		}
+	}
+}
+
 Vector<float> MeshStorage::multimesh_get_buffer(RID p_multimesh) const {
 	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 	ERR_FAIL_NULL_V(multimesh, Vector<float>());
@@ -192,6 +192,7 @@ struct MultiMesh {
 	AABB custom_aabb;
 	bool aabb_dirty = false;
 	bool buffer_set = false;
+	bool gpu_culling = false; // Stored only, culling is done per MultiMesh on the CPU.
 	uint32_t stride_cache = 0;
 	uint32_t color_offset_cache = 0;
 	uint32_t custom_data_offset_cache = 0;
@@ -510,11 +511,15 @@ public:
 	virtual AABB multimesh_get_custom_aabb(RID p_multimesh) const override;
 	virtual AABB multimesh_get_aabb(RID p_multimesh) const override;
 
+	virtual void multimesh_set_gpu_culling(RID p_multimesh, bool p_enable) override;
+	virtual bool multimesh_is_gpu_culling_enabled(RID p_multimesh) const override;
+
 	virtual Transform3D multimesh_instance_get_transform(RID p_multimesh, int p_index) const override;
 	virtual Transform2D multimesh_instance_get_transform_2d(RID p_multimesh, int p_index) const override;
 	virtual Color multimesh_instance_get_color(RID p_multimesh, int p_index) const override;
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const override;
 	virtual void multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_buffer) override;
+	virtual void multimesh_set_buffer_range(RID p_multimesh, int p_from_instance, const Vector<float> &p_buffer) override;
 	virtual Vector<float> multimesh_get_buffer(RID p_multimesh) const override;
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible) override;
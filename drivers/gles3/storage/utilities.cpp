@@ -467,4 +467,9 @@ Size2i Utilities::get_maximum_viewport_size() const {
 	return Size2i(config->max_viewport_size[0], config->max_viewport_size[1]);
 }
 
+Vector<String> Utilities::get_shader_cache_files() const {
+	// The GLES3 shader cache depends on the driver, so it can't be baked.
+	return Vector<String>();
+}
+
 #endif // GLES3_ENABLED
@@ -34,6 +34,10 @@
 #include "drivers/png/image_loader_png.h"
 #include "drivers/png/resource_saver_png.h"
 
+#ifdef UNIX_ENABLED
+#include "drivers/unix/file_access_unix.h"
+#endif
+
 static Ref<ImageLoaderPNG> image_loader_png;
 static Ref<ResourceSaverPNG> resource_saver_png;
 
@@ -46,6 +50,11 @@ void register_core_driver_types() {
 }
 
 void unregister_core_driver_types() {
+#ifdef UNIX_ENABLED
+	// Reads still in flight may complete on worker threads, which are gone after the core types.
+	FileAccessUnix::finalize_async_reads();
+#endif
+
 	ImageLoader::remove_image_format_loader(image_loader_png);
 	image_loader_png.unref();
 
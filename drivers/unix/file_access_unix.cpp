@@ -32,11 +32,14 @@
 
 #if defined(UNIX_ENABLED)
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 
 #include <errno.h>
 #include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -142,6 +145,8 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	_wait_for_async_reads(); // They use the descriptor.
+
 	fclose(f);
 	f = nullptr;
 
@@ -282,6 +287,34 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::map_region(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+	ERR_FAIL_COND_V(p_length == 0, nullptr);
+
+	if (flags != READ || p_length > SIZE_MAX) {
+		return nullptr;
+	}
+
+	// The offset of the mapping must be aligned to the page size.
+	const uint64_t page_size = sysconf(_SC_PAGESIZE);
+	const uint64_t delta = p_offset % page_size;
+
+	void *mapping = mmap(nullptr, p_length + delta, PROT_READ, MAP_PRIVATE, fileno(f), p_offset - delta);
+	if (mapping == MAP_FAILED) {
+		print_verbose(vformat("Can't map %d bytes of '%s' to memory: %s.", p_length, path, String::utf8(strerror(errno))));
+		return nullptr;
+	}
+	return (const uint8_t *)mapping + delta;
+}
+
+void FileAccessUnix::unmap_region(const uint8_t *p_data, uint64_t p_length) const {
+	ERR_FAIL_NULL(p_data);
+
+	const uint64_t page_size = sysconf(_SC_PAGESIZE);
+	const uint64_t delta = (uintptr_t)p_data % page_size;
+	munmap((void *)(p_data - delta), p_length + delta);
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -483,6 +516,112 @@ void FileAccessUnix::close() {
 	_close();
 }
 
+#ifdef IO_URING_ENABLED
+IOUringReader *FileAccessUnix::io_uring_reader = nullptr;
+BinaryMutex FileAccessUnix::io_uring_mutex;
+bool FileAccessUnix::io_uring_initialized = false;
+
+bool FileAccessUnix::_io_uring_read(AsyncRead *p_read) {
+	MutexLock lock(io_uring_mutex);
+	if (!io_uring_initialized) {
+		io_uring_initialized = true;
+		io_uring_reader = memnew(IOUringReader);
+		if (io_uring_reader->initialize(&FileAccessUnix::_io_uring_completed) != OK) {
+			memdelete(io_uring_reader);
+			io_uring_reader = nullptr;
+			print_verbose("io_uring is not available, asynchronous file reads will use worker threads.");
+		}
+	}
+	if (!io_uring_reader) {
+		return false;
+	}
+
+	const int fd = fileno(static_cast<FileAccessUnix *>(p_read->file.ptr())->f);
+	const uint32_t length = MIN(p_read->length - p_read->read, (uint64_t)(1 << 30));
+	return io_uring_reader->read(fd, p_read->offset + p_read->read, p_read->dst + p_read->read, length, p_read);
+}
+
+void FileAccessUnix::_io_uring_completed(void *p_userdata, int p_result) {
+	AsyncRead *read = (AsyncRead *)p_userdata;
+	if (p_result >= 0) {
+		read->read += p_result;
+		if (p_result == 0 || read->read >= read->length) {
+			_complete_async_read(read, OK, read->read);
+			return;
+		}
+		// Short read, queue the rest.
+		if (_io_uring_read(read)) {
+			return;
+		}
+	}
+
+	// Retries interrupted reads and reports errors.
+	_queue_async_read_task(read);
+}
+#endif
+
+void FileAccessUnix::_start_async_read(AsyncRead *p_read) {
+	if (flags != READ) {
+		fflush(f); // Buffered writes aren't seen through the descriptor otherwise.
+	}
+
+#ifdef IO_URING_ENABLED
+	if (_io_uring_read(p_read)) {
+		return;
+	}
+#endif
+
+	_queue_async_read_task(p_read);
+}
+
+void FileAccessUnix::_queue_async_read_task(AsyncRead *p_read) {
+#ifdef THREADS_ENABLED
+	WorkerThreadPool::get_singleton()->add_native_task(&FileAccessUnix::_async_read_task, p_read, false, "FileAccessAsyncRead");
+#else
+	_async_read_task(p_read);
+#endif
+}
+
+void FileAccessUnix::_async_read_task(void *p_userdata) {
+	AsyncRead *read = (AsyncRead *)p_userdata;
+	const int fd = fileno(static_cast<FileAccessUnix *>(read->file.ptr())->f);
+
+	// Continues from what io_uring read already, if anything.
+	Error err = OK;
+	while (read->read < read->length) {
+		ssize_t ret = pread(fd, read->dst + read->read, read->length - read->read, read->offset + read->read);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			err = ERR_FILE_CANT_READ;
+			break;
+		}
+		if (ret == 0) {
+			break; // End of file.
+		}
+		read->read += ret;
+	}
+
+	_complete_async_read(read, err, read->read);
+}
+
+void FileAccessUnix::finalize_async_reads() {
+#ifdef IO_URING_ENABLED
+	IOUringReader *reader;
+	{
+		// Not created again, later reads use worker threads.
+		MutexLock lock(io_uring_mutex);
+		reader = io_uring_reader;
+		io_uring_reader = nullptr;
+		io_uring_initialized = true;
+	}
+	if (reader) {
+		memdelete(reader); // Unlocked, completions of the reads in flight may queue more.
+	}
+#endif
+}
+
 CloseNotificationFunc FileAccessUnix::close_notification_func = nullptr;
 
 FileAccessUnix::~FileAccessUnix() {
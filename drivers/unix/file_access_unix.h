@@ -33,6 +33,7 @@
 
 #include "core/io/file_access.h"
 #include "core/os/memory.h"
+#include "drivers/unix/io_uring_reader.h"
 
 #include <stdio.h>
 
@@ -51,6 +52,22 @@ class FileAccessUnix : public FileAccess {
 
 	void _close();
 
+#ifdef IO_URING_ENABLED
+	static IOUringReader *io_uring_reader;
+	static BinaryMutex io_uring_mutex;
+	static bool io_uring_initialized;
+
+	static bool _io_uring_read(AsyncRead *p_read);
+	static void _io_uring_completed(void *p_userdata, int p_result);
+#endif
+
+	static void _queue_async_read_task(AsyncRead *p_read);
+	static void _async_read_task(void *p_userdata);
+
+protected:
+	// Reads with io_uring where available, otherwise with pread() from worker threads.
+	virtual void _start_async_read(AsyncRead *p_read) override;
+
 public:
 	static CloseNotificationFunc close_notification_func;
 
@@ -73,6 +90,9 @@ public:
 	virtual uint64_t get_64() const override;
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
 
+	virtual const uint8_t *map_region(uint64_t p_offset, uint64_t p_length) const override;
+	virtual void unmap_region(const uint8_t *p_data, uint64_t p_length) const override;
+
 	virtual Error get_error() const override; ///< get last error
 
 	virtual Error resize(int64_t p_length) override;
@@ -96,6 +116,8 @@ public:
 
 	virtual void close() override;
 
+	static void finalize_async_reads();
+
 	FileAccessUnix() {}
 	virtual ~FileAccessUnix();
 };
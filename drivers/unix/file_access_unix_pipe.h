@@ -49,6 +49,9 @@ class FileAccessUnixPipe : public FileAccess {
 
 	void _close();
 
+protected:
+	virtual Ref<FileAccess> _reopen_for_async_read() const override { return Ref<FileAccess>(); } // Would open another pipe.
+
 public:
 	Error open_existing(int p_rfd, int p_wfd);
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
@@ -0,0 +1,254 @@
+/**************************************************************************/
+/*  io_uring_reader.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "io_uring_reader.h"
+
+#ifdef IO_URING_ENABLED
+
+#include "core/error/error_macros.h"
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static int _io_uring_setup(uint32_t p_entries, io_uring_params *p_params) {
+	return (int)syscall(__NR_io_uring_setup, p_entries, p_params);
+}
+
+static int _io_uring_enter(int p_ring_fd, uint32_t p_to_submit, uint32_t p_min_complete, uint32_t p_flags) {
+	return (int)syscall(__NR_io_uring_enter, p_ring_fd, p_to_submit, p_min_complete, p_flags, nullptr, 0);
+}
+
+Error IOUringReader::initialize(CompletionFunc p_completion_func, uint32_t p_entries) {
+	ERR_FAIL_COND_V(ring_fd != -1, ERR_ALREADY_IN_USE);
+	ERR_FAIL_NULL_V(p_completion_func, ERR_INVALID_PARAMETER);
+
+	io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	ring_fd = _io_uring_setup(p_entries, &params);
+	if (ring_fd < 0) {
+		// Too old kernel, or disabled by the system (seccomp, `kernel.io_uring_disabled`).
+		ring_fd = -1;
+		return ERR_UNAVAILABLE;
+	}
+
+	if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+		// IORING_OP_READ is from the same kernel version.
+		_release();
+		return ERR_UNAVAILABLE;
+	}
+
+	sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+	sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+	cq_ring = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+	void *sqes_ptr = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+	sq_ring = sq_ring == MAP_FAILED ? nullptr : sq_ring;
+	cq_ring = cq_ring == MAP_FAILED ? nullptr : cq_ring;
+	sqes = sqes_ptr == MAP_FAILED ? nullptr : (io_uring_sqe *)sqes_ptr;
+	if (!sq_ring || !cq_ring || !sqes) {
+		_release();
+		ERR_FAIL_V_MSG(ERR_CANT_CREATE, "Cannot map the io_uring queues.");
+	}
+
+	uint8_t *sq = (uint8_t *)sq_ring;
+	sq_entries = params.sq_entries;
+	sq_mask = *(uint32_t *)(sq + params.sq_off.ring_mask);
+	sq_head = (uint32_t *)(sq + params.sq_off.head);
+	sq_tail = (uint32_t *)(sq + params.sq_off.tail);
+	sq_array = (uint32_t *)(sq + params.sq_off.array);
+
+	uint8_t *cq = (uint8_t *)cq_ring;
+	cq_mask = *(uint32_t *)(cq + params.cq_off.ring_mask);
+	cq_head = (uint32_t *)(cq + params.cq_off.head);
+	cq_tail = (uint32_t *)(cq + params.cq_off.tail);
+	cqes = (io_uring_cqe *)(cq + params.cq_off.cqes);
+
+	max_in_flight = params.cq_entries - 1; // One is left for the exit request.
+	completion_func = p_completion_func;
+	completion_thread.start(&IOUringReader::_completion_thread_func, this);
+	return OK;
+}
+
+void IOUringReader::_release() {
+	if (sqes) {
+		munmap(sqes, sqes_size);
+		sqes = nullptr;
+	}
+	if (cq_ring) {
+		munmap(cq_ring, cq_ring_size);
+		cq_ring = nullptr;
+	}
+	if (sq_ring) {
+		munmap(sq_ring, sq_ring_size);
+		sq_ring = nullptr;
+	}
+	if (ring_fd != -1) {
+		close(ring_fd);
+		ring_fd = -1;
+	}
+}
+
+void IOUringReader::finalize() {
+	if (ring_fd == -1) {
+		return;
+	}
+
+	if (completion_thread.is_started()) {
+		bool submitted = true;
+		{
+			MutexLock lock(submit_mutex);
+			if (!failed) { // Otherwise the completion thread is done already.
+				submitted = _submit(IORING_OP_NOP, -1, 0, nullptr, 0, 0);
+			}
+		}
+		ERR_FAIL_COND_MSG(!submitted, "Cannot stop the io_uring completion thread.");
+		completion_thread.wait_to_finish();
+	}
+
+	_release();
+}
+
+// Must be called with `submit_mutex` locked.
+bool IOUringReader::_submit(uint8_t p_opcode, int p_fd, uint64_t p_offset, void *p_dst, uint32_t p_length, uint64_t p_user_data) {
+	const uint32_t tail = *sq_tail; // Only written here.
+	if (tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) >= sq_entries) {
+		return false;
+	}
+
+	const uint32_t index = tail & sq_mask;
+	io_uring_sqe *sqe = &sqes[index];
+	memset(sqe, 0, sizeof(io_uring_sqe));
+	sqe->opcode = p_opcode;
+	sqe->fd = p_fd;
+	sqe->off = p_offset;
+	sqe->addr = (uint64_t)(uintptr_t)p_dst;
+	sqe->len = p_length;
+	sqe->user_data = p_user_data;
+	sq_array[index] = index;
+	__atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+	int ret;
+	do {
+		ret = _io_uring_enter(ring_fd, 1, 0, 0);
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret < 1) {
+		// Not consumed by the kernel, take it back.
+		__atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+		return false;
+	}
+	return true;
+}
+
+bool IOUringReader::read(int p_fd, uint64_t p_offset, uint8_t *p_dst, uint32_t p_length, void *p_userdata) {
+	ERR_FAIL_NULL_V(p_userdata, false); // Zero is the exit request.
+
+	MutexLock lock(submit_mutex);
+	if (ring_fd == -1 || failed || in_flight.get() >= max_in_flight) {
+		return false;
+	}
+
+	// Before submitting, the completion may come first.
+	const uint64_t user_data = (uint64_t)(uintptr_t)p_userdata;
+	in_flight.increment();
+	in_flight_reads.insert(user_data);
+	if (!_submit(IORING_OP_READ, p_fd, p_offset, p_dst, p_length, user_data)) {
+		in_flight_reads.erase(user_data);
+		in_flight.decrement();
+		return false;
+	}
+	return true;
+}
+
+// Reports the reads in flight as failed, so nothing waits for them forever.
+void IOUringReader::_fail_in_flight_reads() {
+	LocalVector<uint64_t> reads;
+	{
+		MutexLock lock(submit_mutex);
+		failed = true;
+		for (uint64_t user_data : in_flight_reads) {
+			reads.push_back(user_data);
+		}
+		in_flight_reads.clear();
+		in_flight.set(0);
+	}
+
+	for (uint64_t user_data : reads) {
+		completion_func((void *)(uintptr_t)user_data, -EIO);
+	}
+}
+
+void IOUringReader::_completion_thread_func(void *p_userdata) {
+	IOUringReader *reader = (IOUringReader *)p_userdata;
+	bool exiting = false;
+
+	while (!exiting || reader->in_flight.get() > 0) {
+		const uint32_t head = *reader->cq_head; // Only written here.
+		if (head == __atomic_load_n(reader->cq_tail, __ATOMIC_ACQUIRE)) {
+			int ret = _io_uring_enter(reader->ring_fd, 0, 1, IORING_ENTER_GETEVENTS);
+			const int err = errno;
+			if (ret < 0 && err != EINTR && err != EAGAIN && err != EBUSY) {
+				ERR_PRINT("Waiting for io_uring completions failed, errno: " + itos(err) + ".");
+				reader->_fail_in_flight_reads();
+				return;
+			}
+			continue;
+		}
+
+		const io_uring_cqe cqe = reader->cqes[head & reader->cq_mask];
+		__atomic_store_n(reader->cq_head, head + 1, __ATOMIC_RELEASE);
+
+		if (cqe.user_data == 0) {
+			exiting = true; // Finish the reads in flight first.
+			continue;
+		}
+
+		{
+			MutexLock lock(reader->submit_mutex);
+			reader->in_flight_reads.erase(cqe.user_data);
+		}
+		reader->in_flight.decrement();
+		reader->completion_func((void *)(uintptr_t)cqe.user_data, cqe.res);
+	}
+}
+
+IOUringReader::~IOUringReader() {
+	finalize();
+}
+
+#endif // IO_URING_ENABLED
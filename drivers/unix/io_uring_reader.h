@@ -0,0 +1,101 @@
+/**************************************************************************/
+/*  io_uring_reader.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef IO_URING_READER_H
+#define IO_URING_READER_H
+
+#include "core/error/error_list.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/safe_refcount.h"
+
+#if defined(__linux__) && defined(THREADS_ENABLED) && __has_include(<linux/io_uring.h>)
+#define IO_URING_ENABLED
+#endif
+
+#ifdef IO_URING_ENABLED
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+// Reads from file descriptors through a single io_uring instance, without liburing.
+// Completions are reported from a thread of its own.
+class IOUringReader {
+public:
+	// `p_result` is the amount of bytes read, or a negated `errno` value.
+	typedef void (*CompletionFunc)(void *p_userdata, int p_result);
+
+private:
+	int ring_fd = -1;
+
+	void *sq_ring = nullptr;
+	size_t sq_ring_size = 0;
+	void *cq_ring = nullptr;
+	size_t cq_ring_size = 0;
+	io_uring_sqe *sqes = nullptr;
+	size_t sqes_size = 0;
+
+	uint32_t sq_entries = 0;
+	uint32_t sq_mask = 0;
+	uint32_t *sq_head = nullptr;
+	uint32_t *sq_tail = nullptr;
+	uint32_t *sq_array = nullptr;
+	uint32_t cq_mask = 0;
+	uint32_t *cq_head = nullptr;
+	uint32_t *cq_tail = nullptr;
+	io_uring_cqe *cqes = nullptr;
+
+	CompletionFunc completion_func = nullptr;
+	BinaryMutex submit_mutex;
+	SafeNumeric<uint32_t> in_flight;
+	HashSet<uint64_t> in_flight_reads; // User data of the reads in flight, guarded by `submit_mutex`.
+	bool failed = false; // Set when completions can't be waited for anymore, no reads are accepted after.
+	uint32_t max_in_flight = 0; // Keeps the completion queue from overflowing.
+	Thread completion_thread;
+
+	void _release();
+	bool _submit(uint8_t p_opcode, int p_fd, uint64_t p_offset, void *p_dst, uint32_t p_length, uint64_t p_user_data);
+	void _fail_in_flight_reads();
+	static void _completion_thread_func(void *p_userdata);
+
+public:
+	Error initialize(CompletionFunc p_completion_func, uint32_t p_entries = 256);
+	void finalize(); // Waits for the reads in flight.
+
+	// Returns false if the read can't be queued, for instance with too many reads in flight.
+	bool read(int p_fd, uint64_t p_offset, uint8_t *p_dst, uint32_t p_length, void *p_userdata);
+
+	~IOUringReader();
+};
+
+#endif // IO_URING_ENABLED
+
+#endif // IO_URING_READER_H
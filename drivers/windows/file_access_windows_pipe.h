@@ -48,6 +48,9 @@ class FileAccessWindowsPipe : public FileAccess {
 
 	void _close();
 
+protected:
+	virtual Ref<FileAccess> _reopen_for_async_read() const override { return Ref<FileAccess>(); } // Would open another pipe.
+
 public:
 	Error open_existing(HANDLE p_rfd, HANDLE p_wfd);
 
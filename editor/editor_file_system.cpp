@@ -46,6 +46,7 @@
 #include "editor/editor_settings.h"
 #include "editor/project_settings_editor.h"
 #include "scene/resources/packed_scene.h"
+#include "scene/resources/resource_format_text.h"
 
 EditorFileSystem *EditorFileSystem::singleton = nullptr;
 //the name is the version, to keep compatibility with different versions of Godot
@@ -711,6 +712,7 @@ bool EditorFileSystem::_update_scan_actions() {
 				}
 
 				_delete_internal_files(ia.dir->files[idx]->file);
+				ResourceFormatLoaderText::remove_from_binary_cache(ia.dir->get_file_path(idx));
 				memdelete(ia.dir->files[idx]);
 				ia.dir->files.remove_at(idx);
 
@@ -810,6 +812,11 @@ bool EditorFileSystem::_update_scan_actions() {
 		revalidate_import_files = false;
 		filesystem_settings_version_for_import = ResourceFormatImporter::get_singleton()->get_import_settings_hash();
 		_save_filesystem_cache();
+
+		// Files removed while the editor was closed left their binary copies behind.
+		HashSet<String> files;
+		_get_all_files(filesystem, files);
+		ResourceFormatLoaderText::prune_binary_cache(files);
 	}
 
 	// Moving the processing of pending updates before the resources_reload event to be sure all global class names
@@ -1972,6 +1979,16 @@ void EditorFileSystem::_get_all_scenes(EditorFileSystemDirectory *p_dir, HashSet
 	}
 }
 
+void EditorFileSystem::_get_all_files(EditorFileSystemDirectory *p_dir, HashSet<String> &r_list) {
+	for (int i = 0; i < p_dir->get_file_count(); i++) {
+		r_list.insert(p_dir->get_file_path(i));
+	}
+
+	for (int i = 0; i < p_dir->get_subdir_count(); i++) {
+		_get_all_files(p_dir->get_subdir(i), r_list);
+	}
+}
+
 void EditorFileSystem::update_file(const String &p_file) {
 	ERR_FAIL_COND(p_file.is_empty());
 	update_files({ p_file });
@@ -3061,8 +3078,14 @@ EditorFileSystem::EditorFileSystem() {
 	scan_total = 0;
 	callable_mp(ResourceUID::get_singleton(), &ResourceUID::clear).call_deferred(); // Will be updated on scan.
 	ResourceSaver::set_get_resource_id_for_path(_resource_saver_get_resource_id_for_path);
+
+	// Text scenes and resources are loaded from binary copies while they are unchanged.
+	if (EDITOR_GET("filesystem/on_load/binary_cache_for_text_resources")) {
+		ResourceFormatLoaderText::set_binary_cache_dir(ProjectSettings::get_singleton()->get_project_data_path().path_join("text_resource_cache"));
+	}
 }
 
 EditorFileSystem::~EditorFileSystem() {
 	ResourceSaver::set_get_resource_id_for_path(nullptr);
+	ResourceFormatLoaderText::set_binary_cache_dir(String());
 }
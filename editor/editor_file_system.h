@@ -292,6 +292,7 @@ class EditorFileSystem : public Node {
 	void _update_scene_groups();
 	void _update_pending_scene_groups();
 	void _get_all_scenes(EditorFileSystemDirectory *p_dir, HashSet<String> &r_list);
+	void _get_all_files(EditorFileSystemDirectory *p_dir, HashSet<String> &r_list);
 
 	String _get_global_script_class(const String &p_type, const String &p_path, String *r_extends, String *r_icon_path) const;
 
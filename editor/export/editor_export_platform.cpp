@@ -35,6 +35,7 @@
 #include "core/extension/gdextension.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/pck_packer.h"
 #include "core/io/zip_io.h"
 #include "core/version.h"
 #include "editor/editor_file_system.h"
@@ -244,6 +245,23 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 		}
 	}
 
+	// Files with the same contents and storage point to the same data.
+	const String content_key = PCKPacker::get_content_key(p_data.ptr(), p_data.size(), (sd.encrypted ? PACK_FILE_ENCRYPTED : 0) | (pd->compress ? PACK_FILE_COMPRESSED : 0));
+	HashMap<String, SavedData>::Iterator E = pd->stored_contents.find(content_key);
+	if (E) {
+		sd.ofs = E->value.ofs;
+		sd.compressed = E->value.compressed;
+		sd.md5 = E->value.md5;
+		pd->file_ofs.push_back(sd);
+		pd->deduplicated_files++;
+		pd->deduplicated_size += E->value.size;
+
+		if (pd->ep->step(vformat(TTR("Storing File: %s"), p_path), 2 + p_file * 100 / p_total, false)) {
+			return ERR_SKIP;
+		}
+		return OK;
+	}
+
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> ftmp = pd->f;
 
@@ -256,8 +274,19 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 		ftmp = fae;
 	}
 
+	// Compressed files can't be encrypted as well, keep the ones that don't get smaller as they are.
+	Vector<uint8_t> compressed_data;
+	if (pd->compress && !sd.encrypted && !p_data.is_empty()) {
+		compressed_data = PCKPacker::compress_file(p_data.ptr(), p_data.size(), Compression::MODE_ZSTD);
+		sd.compressed = !compressed_data.is_empty() && compressed_data.size() < p_data.size();
+	}
+
 	// Store file content.
-	ftmp->store_buffer(p_data.ptr(), p_data.size());
+	if (sd.compressed) {
+		ftmp->store_buffer(compressed_data.ptr(), compressed_data.size());
+	} else {
+		ftmp->store_buffer(p_data.ptr(), p_data.size());
+	}
 
 	if (fae.is_valid()) {
 		ftmp.unref();
@@ -281,6 +310,10 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 
 	pd->file_ofs.push_back(sd);
 
+	SavedData stored = sd;
+	stored.size = pd->f->get_position() - sd.ofs; // Stored size, with padding.
+	pd->stored_contents.insert(content_key, stored);
+
 	// TRANSLATORS: This is an editor progress label describing the storing of a file.
 	if (pd->ep->step(vformat(TTR("Storing File: %s"), p_path), 2 + p_file * 100 / p_total, false)) {
 		return ERR_SKIP;
@@ -1569,6 +1602,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	pd.ep = &ep;
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
+	pd.compress = GLOBAL_GET("editor/export/compress_pck_files");
 
 	Error err = export_project_files(p_preset, p_debug, _save_pack_file, &pd, _add_shared_object);
 
@@ -1582,6 +1616,10 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		return err;
 	}
 
+	if (pd.deduplicated_files > 0) {
+		add_message(EXPORT_MESSAGE_INFO, TTR("Save PCK"), vformat(TTR("%d files share the data of identical files, saving %s."), pd.deduplicated_files, String::humanize_size(pd.deduplicated_size)));
+	}
+
 	pd.file_ofs.sort(); //do sort, so we can do binary search later
 
 	Ref<FileAccess> f;
@@ -1710,6 +1748,9 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		if (pd.file_ofs[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (pd.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -74,6 +74,7 @@ private:
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
 		CharString path_utf8;
 
@@ -87,6 +88,11 @@ private:
 		Vector<SavedData> file_ofs;
 		EditorProgress *ep = nullptr;
 		Vector<SharedObject> *so_files = nullptr;
+		bool compress = false;
+
+		HashMap<String, SavedData> stored_contents; // By PCKPacker::get_content_key(), files with the same key share the data.
+		int deduplicated_files = 0;
+		uint64_t deduplicated_size = 0;
 	};
 
 	struct ZipData {
@@ -0,0 +1,158 @@
+/**************************************************************************/
+/*  shader_baker_export_plugin.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#include "shader_baker_export_plugin.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+#include "scene/resources/material.h"
+#include "scene/resources/packed_scene.h"
+#include "servers/rendering_server.h"
+
+void ShaderBakerExportPlugin::_bake_variant(const Variant &p_value, HashSet<Resource *> &r_visited) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			_bake_resource(p_value, r_visited);
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				_bake_variant(array[i], r_visited);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dict = p_value;
+			List<Variant> keys;
+			dict.get_key_list(&keys);
+			for (const Variant &E : keys) {
+				_bake_variant(E, r_visited);
+				_bake_variant(dict[E], r_visited);
+			}
+		} break;
+		default: {
+		}
+	}
+}
+
+void ShaderBakerExportPlugin::_bake_resource(const Ref<Resource> &p_resource, HashSet<Resource *> &r_visited) {
+	if (p_resource.is_null() || r_visited.has(p_resource.ptr())) {
+		return;
+	}
+	r_visited.insert(p_resource.ptr());
+
+	Ref<Material> material = p_resource;
+	if (material.is_valid()) {
+		// Creating the shader compiles its variants, which stores them in the shader cache.
+		material->get_shader_rid();
+	}
+
+	Ref<Shader> shader = p_resource;
+	if (shader.is_valid()) {
+		shader->get_rid();
+	}
+
+	Ref<PackedScene> scene = p_resource;
+	if (scene.is_valid()) {
+		Ref<SceneState> state = scene->get_state();
+		for (int i = 0; i < state->get_node_count(); i++) {
+			for (int j = 0; j < state->get_node_property_count(i); j++) {
+				_bake_variant(state->get_node_property_value(i, j), r_visited);
+			}
+		}
+		return;
+	}
+
+	List<PropertyInfo> properties;
+	p_resource->get_property_list(&properties);
+	for (const PropertyInfo &E : properties) {
+		if (E.usage & PROPERTY_USAGE_STORAGE) {
+			_bake_variant(p_resource->get(E.name), r_visited);
+		}
+	}
+}
+
+void ShaderBakerExportPlugin::_add_cache_files() {
+	// Make sure pending shader creation has reached the renderer, get_shader_cache_files() then waits for
+	// the groups still compiling so their cache files are written before being packed.
+	RenderingServer::get_singleton()->sync();
+
+	Vector<String> files = RenderingServer::get_singleton()->get_shader_cache_files();
+	for (const String &path : files) {
+		// Only the project's cache is looked up at run time.
+		if (!path.begins_with(cache_dir) || added_files.has(path)) {
+			continue;
+		}
+		added_files.insert(path);
+
+		Vector<uint8_t> data = FileAccess::get_file_as_bytes(path);
+		if (data.is_empty()) {
+			continue;
+		}
+		add_file(path, data, false);
+	}
+}
+
+void ShaderBakerExportPlugin::_get_export_options(const Ref<EditorExportPlatform> &p_platform, List<EditorExportPlatform::ExportOption> *r_options) const {
+	r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::BOOL, "shader_baker/enabled"), false));
+}
+
+void ShaderBakerExportPlugin::_export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) {
+	Ref<EditorExportPreset> preset = get_export_preset();
+	ERR_FAIL_COND(preset.is_null());
+
+	// The cache can only be produced when the editor itself renders with RenderingDevice.
+	enabled = bool(get_option("shader_baker/enabled")) && !preset->is_dedicated_server() && RenderingServer::get_singleton()->get_rendering_device() != nullptr;
+	internal_shaders_added = false;
+	cache_dir = ProjectSettings::get_singleton()->get_project_data_path().path_join("shader_cache");
+	added_files.clear();
+}
+
+void ShaderBakerExportPlugin::_export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) {
+	if (!enabled) {
+		return;
+	}
+
+	bool has_shaders = ClassDB::is_parent_class(p_type, "PackedScene") || ClassDB::is_parent_class(p_type, "Material") || ClassDB::is_parent_class(p_type, "Shader") || ClassDB::is_parent_class(p_type, "Mesh");
+	if (has_shaders) {
+		Ref<Resource> res = ResourceLoader::load(p_path);
+		HashSet<Resource *> visited;
+		_bake_resource(res, visited);
+	}
+
+	if (has_shaders || !internal_shaders_added) {
+		_add_cache_files();
+		internal_shaders_added = true;
+	}
+}
+
+void ShaderBakerExportPlugin::_export_end() {
+	enabled = false;
+	added_files.clear();
+}
@@ -0,0 +1,59 @@
+/**************************************************************************/
+/*  shader_baker_export_plugin.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#ifndef SHADER_BAKER_EXPORT_PLUGIN_H
+#define SHADER_BAKER_EXPORT_PLUGIN_H
+
+#include "editor/export/editor_export.h"
+
+// Packs the shader cache into the exported project, so players don't have to
+// compile shaders on first run. Shaders used by exported resources are compiled
+// during export, internal renderer shaders are already cached by the editor.
+class ShaderBakerExportPlugin : public EditorExportPlugin {
+private:
+	bool enabled = false;
+	bool internal_shaders_added = false;
+	String cache_dir;
+	HashSet<String> added_files;
+
+	void _bake_variant(const Variant &p_value, HashSet<Resource *> &r_visited);
+	void _bake_resource(const Ref<Resource> &p_resource, HashSet<Resource *> &r_visited);
+	void _add_cache_files();
+
+protected:
+	String get_name() const override { return "ShaderBaker"; }
+
+	void _get_export_options(const Ref<EditorExportPlatform> &p_platform, List<EditorExportPlatform::ExportOption> *r_options) const override;
+
+	void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override;
+	void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override;
+	void _export_end() override;
+};
+
+#endif // SHADER_BAKER_EXPORT_PLUGIN_H
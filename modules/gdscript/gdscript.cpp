@@ -31,10 +31,12 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_sampler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_warning.h"
 
@@ -51,6 +53,7 @@
 #include "core/core_constants.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #include "scene/scene_string_names.h"
@@ -798,6 +801,25 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	if (!bytecode.is_empty()) {
+		// Exported bytecode skips parsing and compilation entirely.
+		String bytecode_error;
+		Error err = GDScriptBytecode::load(this, bytecode, &bytecode_error);
+		if (err == OK) {
+			can_run = ScriptServer::is_scripting_enabled() || is_tool();
+			if (can_run) {
+				err = _static_init();
+				if (err) {
+					return err;
+				}
+			}
+			reloading = false;
+			return OK;
+		}
+		print_verbose(vformat(R"(GDScript: Could not load bytecode of "%s", compiling from tokens instead: %s)", path, bytecode_error));
+		bytecode.clear();
+	}
+
 	valid = false;
 	GDScriptParser parser;
 	Error err;
@@ -816,6 +838,12 @@ Error GDScript::reload(bool p_keep_state) {
 		return ERR_PARSE_ERROR;
 	}
 
+	// Dependencies are parsed in parallel first, analysis and compilation below stay ordered on this thread.
+	Vector<Ref<GDScriptParserRef>> warm_parsers;
+	if (GDScriptLanguage::get_singleton()->parallel_parsing && !path.is_empty() && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		warm_parsers = GDScriptCache::warm_up_dependencies(&parser, path);
+	}
+
 	GDScriptAnalyzer analyzer(&parser);
 	err = analyzer.analyze();
 
@@ -1130,6 +1158,14 @@ Vector<uint8_t> GDScript::get_as_binary_tokens() const {
 	return tokenizer.parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE);
 }
 
+void GDScript::set_bytecode_source(const Vector<uint8_t> &p_bytecode) {
+	bytecode = p_bytecode;
+}
+
+const Vector<uint8_t> &GDScript::get_bytecode_source() const {
+	return bytecode;
+}
+
 const HashMap<StringName, GDScriptFunction *> &GDScript::debug_get_member_functions() const {
 	return member_functions;
 }
@@ -1610,6 +1646,9 @@ GDScript::~GDScript() {
 	}
 	destructing = true;
 
+	// Inline caches are keyed on the script pointer, which may be reused.
+	GDScriptFunction::_invalidate_inline_caches();
+
 	if (is_print_verbose_enabled()) {
 		MutexLock lock(func_ptrs_to_update_mutex);
 		if (!func_ptrs_to_update.is_empty()) {
@@ -2236,6 +2275,12 @@ void GDScriptLanguage::init() {
 		_add_global(E.name, E.ptr);
 	}
 
+#ifdef DEBUG_ENABLED
+	if (GLOBAL_GET("debug/gdscript/sampling_profiler/enabled") && !Engine::get_singleton()->is_editor_hint()) {
+		GDScriptSampler::start(GLOBAL_GET("debug/gdscript/sampling_profiler/interval_usec"));
+	}
+#endif
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2255,6 +2300,14 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+#ifdef DEBUG_ENABLED
+	if (GDScriptSampler::is_active()) {
+		GDScriptSampler::stop();
+		GDScriptSampler::save(GLOBAL_GET("debug/gdscript/sampling_profiler/output_path"));
+		GDScriptSampler::clear();
+	}
+#endif
+
 	_call_stack.free();
 
 	// Clear the cache before parsing the script_list
@@ -2290,6 +2343,7 @@ void GDScriptLanguage::finish() {
 	}
 	script_list.clear();
 	function_list.clear();
+	GDScriptFunction::clear_frame_pool();
 
 	finishing = false;
 }
@@ -2870,7 +2924,19 @@ GDScriptLanguage::GDScriptLanguage() {
 		_debug_max_call_stack = 0;
 	}
 
+	jit_enabled = GLOBAL_DEF("gdscript/jit/enabled", false);
+	jit_call_threshold = GLOBAL_DEF(PropertyInfo(Variant::INT, "gdscript/jit/call_threshold", PROPERTY_HINT_RANGE, "1,100000,1,or_greater"), 1000);
+	jit_loop_threshold = GLOBAL_DEF(PropertyInfo(Variant::INT, "gdscript/jit/loop_threshold", PROPERTY_HINT_RANGE, "1,1000000,1,or_greater"), 10000);
+#ifndef GDSCRIPT_JIT_ENABLED
+	jit_enabled = false; // Not available on this platform.
+#endif
+	parallel_parsing = GLOBAL_DEF("gdscript/parallel_parsing/enabled", true);
+
 #ifdef DEBUG_ENABLED
+	GLOBAL_DEF("debug/gdscript/sampling_profiler/enabled", false);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/gdscript/sampling_profiler/interval_usec", PROPERTY_HINT_RANGE, "10,100000,1,or_greater"), 1000);
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "debug/gdscript/sampling_profiler/output_path", PROPERTY_HINT_SAVE_FILE, "*.folded,*.json"), "user://gdscript_samples.folded");
+
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/exclude_addons", true);
 	for (int i = 0; i < (int)GDScriptWarning::WARNING_MAX; i++) {
@@ -84,6 +84,7 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecode;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
@@ -178,6 +179,7 @@ private:
 	//exported members
 	String source;
 	Vector<uint8_t> binary_tokens;
+	Vector<uint8_t> bytecode; // Compiled code from an exported project, see `GDScriptBytecode`.
 	String path;
 	bool path_valid = false; // False if using default path.
 	StringName local_name; // Inner class identifier or `class_name`.
@@ -307,6 +309,8 @@ public:
 	void set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens);
 	const Vector<uint8_t> &get_binary_tokens_source() const;
 	Vector<uint8_t> get_as_binary_tokens() const;
+	void set_bytecode_source(const Vector<uint8_t> &p_bytecode);
+	const Vector<uint8_t> &get_bytecode_source() const;
 
 	bool get_property_default_value(const StringName &p_property, Variant &r_value) const override;
 
@@ -468,6 +472,14 @@ class GDScriptLanguage : public ScriptLanguage {
 public:
 	int calls;
 
+	// Baseline JIT, see `GDScriptJIT`.
+	bool jit_enabled = false;
+	int jit_call_threshold = 1000;
+	int jit_loop_threshold = 10000;
+
+	// Parse script dependencies on worker threads, see `GDScriptCache::warm_up()`.
+	bool parallel_parsing = true;
+
 	bool debug_break(const String &p_error, bool p_allow_continue = true);
 	bool debug_break_parse(const String &p_file, int p_line, const String &p_error);
 
@@ -1813,9 +1813,18 @@ void GDScriptAnalyzer::resolve_function_body(GDScriptParser::FunctionNode *p_fun
 	}
 	p_function->resolved_body = true;
 
+	if (skipped_function_bodies.has(p_function)) {
+		return;
+	}
+
 	GDScriptParser::FunctionNode *previous_function = parser->current_function;
 	parser->current_function = p_function;
 
+	const GDScriptParser::FunctionNode *previous_member_usage_function = member_usage_function;
+	if (!p_is_lambda) {
+		member_usage_function = p_function;
+	}
+
 	bool previous_static_context = static_context;
 	static_context = p_function->is_static;
 
@@ -1831,9 +1840,16 @@ void GDScriptAnalyzer::resolve_function_body(GDScriptParser::FunctionNode *p_fun
 	}
 
 	parser->current_function = previous_function;
+	member_usage_function = previous_member_usage_function;
 	static_context = previous_static_context;
 }
 
+void GDScriptAnalyzer::record_member_usage(const GDScriptParser::Node *p_member) {
+	if (unlikely(member_usages != nullptr && member_usage_function != nullptr)) {
+		(*member_usages)[member_usage_function].insert(p_member);
+	}
+}
+
 void GDScriptAnalyzer::decide_suite_type(GDScriptParser::Node *p_suite, GDScriptParser::Node *p_statement) {
 	if (p_statement == nullptr) {
 		return;
@@ -3936,6 +3952,7 @@ void GDScriptAnalyzer::reduce_identifier_from_base(GDScriptParser::IdentifierNod
 						p_identifier->source = member.variable->is_static ? GDScriptParser::IdentifierNode::STATIC_VARIABLE : GDScriptParser::IdentifierNode::MEMBER_VARIABLE;
 						p_identifier->variable_source = member.variable;
 						member.variable->usages += 1;
+						record_member_usage(member.variable);
 						return;
 					}
 				} break;
@@ -3946,6 +3963,7 @@ void GDScriptAnalyzer::reduce_identifier_from_base(GDScriptParser::IdentifierNod
 						p_identifier->source = GDScriptParser::IdentifierNode::MEMBER_SIGNAL;
 						p_identifier->signal_source = member.signal;
 						member.signal->usages += 1;
+						record_member_usage(member.signal);
 						return;
 					}
 				} break;
@@ -4134,6 +4152,7 @@ void GDScriptAnalyzer::reduce_identifier(GDScriptParser::IdentifierNode *p_ident
 			break;
 		case GDScriptParser::IdentifierNode::MEMBER_SIGNAL:
 			p_identifier->signal_source->usages++;
+			record_member_usage(p_identifier->signal_source);
 			[[fallthrough]];
 		case GDScriptParser::IdentifierNode::INHERITED_VARIABLE:
 			mark_lambda_use_self();
@@ -4141,6 +4160,7 @@ void GDScriptAnalyzer::reduce_identifier(GDScriptParser::IdentifierNode *p_ident
 		case GDScriptParser::IdentifierNode::MEMBER_VARIABLE:
 			mark_lambda_use_self();
 			p_identifier->variable_source->usages++;
+			record_member_usage(p_identifier->variable_source);
 			[[fallthrough]];
 		case GDScriptParser::IdentifierNode::STATIC_VARIABLE:
 		case GDScriptParser::IdentifierNode::LOCAL_VARIABLE:
@@ -59,6 +59,11 @@ class GDScriptAnalyzer {
 	HashMap<const GDScriptParser::ClassNode *, Ref<GDScriptParserRef>> external_class_parser_cache;
 	bool static_context = false;
 
+	// Incremental analysis, see `set_skipped_function_bodies()`.
+	HashSet<const GDScriptParser::FunctionNode *> skipped_function_bodies;
+	HashMap<const GDScriptParser::FunctionNode *, HashSet<const GDScriptParser::Node *>> *member_usages = nullptr;
+	const GDScriptParser::FunctionNode *member_usage_function = nullptr;
+
 	// Tests for detecting invalid overloading of script members
 	static _FORCE_INLINE_ bool has_member_name_conflict_in_script_class(const StringName &p_name, const GDScriptParser::ClassNode *p_current_class_node, const GDScriptParser::Node *p_member);
 	static _FORCE_INLINE_ bool has_member_name_conflict_in_native_type(const StringName &p_name, const StringName &p_native_type_string);
@@ -71,6 +76,7 @@ class GDScriptAnalyzer {
 	Error resolve_class_inheritance(GDScriptParser::ClassNode *p_class, bool p_recursive);
 	GDScriptParser::DataType resolve_datatype(GDScriptParser::TypeNode *p_type);
 
+	void record_member_usage(const GDScriptParser::Node *p_member);
 	void decide_suite_type(GDScriptParser::Node *p_suite, GDScriptParser::Node *p_statement);
 
 	void resolve_annotation(GDScriptParser::AnnotationNode *p_annotation);
@@ -160,6 +166,13 @@ public:
 	Error resolve_dependencies();
 	Error analyze();
 
+	// Used by the language server to only analyze the functions which changed since a previous analysis.
+	// The bodies of skipped functions are not resolved at all, the caller is responsible for restoring
+	// what they contribute (diagnostics, and the usages of class members recorded with `set_member_usages()`).
+	void set_skipped_function_bodies(const HashSet<const GDScriptParser::FunctionNode *> &p_functions) { skipped_function_bodies = p_functions; }
+	// Records the class variables and signals used by the body of each function (including its lambdas).
+	void set_member_usages(HashMap<const GDScriptParser::FunctionNode *, HashSet<const GDScriptParser::Node *>> *r_member_usages) { member_usages = r_member_usages; }
+
 	Variant make_variable_default_value(GDScriptParser::VariableNode *p_variable);
 	static bool check_type_compatibility(const GDScriptParser::DataType &p_target, const GDScriptParser::DataType &p_source, bool p_allow_implicit_conversion = false, const GDScriptParser::Node *p_source_node = nullptr);
 
@@ -47,6 +47,7 @@ uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool
 uint32_t GDScriptByteCodeGenerator::add_local(const StringName &p_name, const GDScriptDataType &p_type) {
 	int stack_pos = locals.size() + GDScriptFunction::FIXED_ADDRESSES_MAX;
 	locals.push_back(StackSlot(p_type.builtin_type, p_type.can_contain_object()));
+	initialized_locals.erase(stack_pos);
 	add_stack_identifier(p_name, stack_pos);
 	return stack_pos;
 }
@@ -398,8 +399,12 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 	if (debug_stack) {
 		function->stack_debug = stack_debug;
 	}
+#ifdef TOOLS_ENABLED
+	function->global_index_positions = global_index_positions;
+#endif
 	function->_stack_size = GDScriptFunction::FIXED_ADDRESSES_MAX + max_locals + temporaries.size();
 	function->_instruction_args_size = instr_args_max;
+	function->_allocate_inline_caches(inline_cache_count);
 
 #ifdef DEBUG_ENABLED
 	function->operator_names = operator_names;
@@ -559,6 +564,7 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
 
+		int operator_pos = opcodes.size();
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(Address());
@@ -567,6 +573,8 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
+		last_operator_pos = operator_pos;
+		last_operator_result_type = Variant::NIL; // Only used as a condition.
 		return;
 	}
 
@@ -584,6 +592,30 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 }
 
+// Operators on two ints or two floats evaluated by the VM itself, see `OPCODE_OPERATOR_INT`.
+static bool _is_inline_numeric_operator(Variant::Operator p_operator, Variant::Type p_type) {
+	switch (p_operator) {
+		case Variant::OP_ADD:
+		case Variant::OP_SUBTRACT:
+		case Variant::OP_MULTIPLY:
+		case Variant::OP_EQUAL:
+		case Variant::OP_NOT_EQUAL:
+		case Variant::OP_LESS:
+		case Variant::OP_LESS_EQUAL:
+		case Variant::OP_GREATER:
+		case Variant::OP_GREATER_EQUAL:
+			return true;
+		case Variant::OP_DIVIDE:
+			return p_type == Variant::FLOAT; // Integer division needs a check for zero.
+		case Variant::OP_BIT_AND:
+		case Variant::OP_BIT_OR:
+		case Variant::OP_BIT_XOR:
+			return p_type == Variant::INT;
+		default:
+			return false;
+	}
+}
+
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	// Avoid validated evaluator for modulo and division when operands are int, since there's no check for division by zero.
 	if (HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand) && ((p_operator != Variant::OP_DIVIDE && p_operator != Variant::OP_MODULE) || p_left_operand.type.builtin_type != Variant::INT || p_right_operand.type.builtin_type != Variant::INT)) {
@@ -595,6 +627,21 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		int operator_pos = opcodes.size();
+
+		Variant::Type left_type = p_left_operand.type.builtin_type;
+		if ((left_type == Variant::INT || left_type == Variant::FLOAT) && left_type == p_right_operand.type.builtin_type && _is_inline_numeric_operator(p_operator, left_type)) {
+			// Same layout as the validated operator, with the operator itself instead of the function.
+			append_opcode(left_type == Variant::INT ? GDScriptFunction::OPCODE_OPERATOR_INT : GDScriptFunction::OPCODE_OPERATOR_FLOAT);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			append(p_operator);
+			last_operator_pos = operator_pos;
+			last_operator_result_type = Variant::get_operator_return_type(p_operator, left_type, left_type);
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
@@ -606,6 +653,8 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
+		last_operator_pos = operator_pos;
+		last_operator_result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 		return;
 	}
 
@@ -832,6 +881,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append(add_inline_cache());
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -850,6 +900,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append(add_inline_cache());
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -878,7 +929,86 @@ void GDScriptByteCodeGenerator::write_get_static_variable(const Address &p_targe
 	append(p_index);
 }
 
+// Peephole optimizations, applied while the instructions are written since jumps are patched with absolute addresses.
+
+bool GDScriptByteCodeGenerator::is_last_operator_result(const Address &p_address) const {
+	if (last_operator_pos < 0 || last_operator_pos + 5 != opcodes.size() || p_address.mode != Address::TEMPORARY) {
+		return false;
+	}
+	const Vector<int> &indices = temporaries[p_address.address].bytecode_indices;
+	return !indices.is_empty() && indices[indices.size() - 1] == last_operator_pos + 3;
+}
+
+// `a = b + c` makes the operator write to `a` instead of going through a temporary.
+bool GDScriptByteCodeGenerator::forward_operator_result(const Address &p_target, const Address &p_source) {
+	if (!is_last_operator_result(p_source) || !IS_BUILTIN_TYPE(p_target, last_operator_result_type) || p_target.type.has_container_element_type(0)) {
+		return false;
+	}
+	// Validated operators expect their result to already have the right type. Typed parameters are converted
+	// on call, and typed locals once they're initialized.
+	if (p_target.mode == Address::LOCAL_VARIABLE) {
+		if (!initialized_locals.has(p_target.address)) {
+			return false;
+		}
+	} else if (p_target.mode != Address::FUNCTION_PARAMETER) {
+		return false;
+	}
+
+	int target_address = address_of(p_target);
+	if (opcodes[last_operator_pos + 1] == target_address || opcodes[last_operator_pos + 2] == target_address) {
+		// Writing to an operand (as in `a += b`) is only safe when the result is computed as a plain value first.
+		switch (last_operator_result_type) {
+			case Variant::BOOL:
+			case Variant::INT:
+			case Variant::FLOAT:
+			case Variant::VECTOR2:
+			case Variant::VECTOR2I:
+			case Variant::VECTOR3:
+			case Variant::VECTOR3I:
+			case Variant::VECTOR4:
+			case Variant::VECTOR4I:
+			case Variant::COLOR:
+				break;
+			default:
+				return false;
+		}
+	}
+
+	Vector<int> &indices = temporaries.write[p_source.address].bytecode_indices;
+	indices.remove_at(indices.size() - 1);
+	opcodes.write[last_operator_pos + 3] = target_address;
+	last_operator_pos = -1;
+	return true;
+}
+
+// `if a < b:` and `while a < b:` branch in the same instruction as the comparison.
+bool GDScriptByteCodeGenerator::fuse_operator_jump_if_not(const Address &p_condition) {
+	if (!is_last_operator_result(p_condition)) {
+		return false;
+	}
+	// The result is still written, the jump target follows the operator arguments.
+	switch (opcodes[last_operator_pos]) {
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+			opcodes.write[last_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+			break;
+		case GDScriptFunction::OPCODE_OPERATOR_INT:
+			opcodes.write[last_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_INT_JUMP_IF_NOT;
+			break;
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT:
+			opcodes.write[last_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_FLOAT_JUMP_IF_NOT;
+			break;
+		default:
+			return false;
+	}
+	last_operator_pos = -1;
+	return true;
+}
+
 void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_target, const Address &p_source) {
+	if (p_target.mode == Address::LOCAL_VARIABLE) {
+		initialized_locals.insert(p_target.address);
+	}
+
 	switch (p_target.type.kind) {
 		case GDScriptDataType::BUILTIN: {
 			if (p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type(0)) {
@@ -927,6 +1057,13 @@ void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_ta
 }
 
 void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Address &p_source) {
+	if (forward_operator_result(p_target, p_source)) {
+		return;
+	}
+	if (p_target.mode == Address::LOCAL_VARIABLE) {
+		initialized_locals.insert(p_target.address);
+	}
+
 	if (p_target.type.kind == GDScriptDataType::BUILTIN && p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type(0)) {
 		const GDScriptDataType &element_type = p_target.type.get_container_element_type(0);
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY);
@@ -964,6 +1101,7 @@ void GDScriptByteCodeGenerator::write_assign_false(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_dst, const Address &p_src, bool p_use_conversion) {
+	last_operator_pos = -1; // The parameter wasn't passed, so it doesn't have its type yet.
 	if (p_use_conversion) {
 		write_assign_with_conversion(p_dst, p_src);
 	} else {
@@ -975,6 +1113,9 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
 	append_opcode(GDScriptFunction::OPCODE_STORE_GLOBAL);
 	append(p_dst);
+#ifdef TOOLS_ENABLED
+	global_index_positions.push_back(opcodes.size());
+#endif
 	append(p_global_index);
 }
 
@@ -1040,6 +1181,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1065,6 +1207,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1299,6 +1442,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1312,6 +1456,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1325,6 +1470,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1442,8 +1588,10 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	if (!fuse_operator_jump_if_not(p_condition)) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_condition);
+	}
 	if_jmp_addrs.push_back(opcodes.size());
 	append(0); // Jump destination, will be patched.
 }
@@ -1607,6 +1755,7 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 
 	// Next iteration.
 	int continue_addr = opcodes.size();
+	last_operator_pos = -1;
 	continue_addrs.push_back(continue_addr);
 	append_opcode(iterate_opcode);
 	append(counter);
@@ -1649,12 +1798,15 @@ void GDScriptByteCodeGenerator::write_endfor() {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	last_operator_pos = -1;
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	if (!fuse_operator_jump_if_not(p_condition)) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_condition);
+	}
 	while_jmp_addrs.push_back(opcodes.size());
 	append(0); // End of loop address, will be patched.
 }
@@ -1824,6 +1976,7 @@ void GDScriptByteCodeGenerator::clear_address(const Address &p_address) {
 
 	if (p_address.mode == Address::LOCAL_VARIABLE) {
 		dirty_locals.erase(p_address.address);
+		initialized_locals.insert(p_address.address);
 	}
 }
 
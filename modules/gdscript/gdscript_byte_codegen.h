@@ -85,6 +85,11 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	Vector<StackSlot> locals;
 	HashSet<int> dirty_locals;
+	HashSet<int> initialized_locals; // Locals assigned since they were declared, typed ones hold a value of their type.
+
+	// Position of the last validated operator, while it's the last instruction and nothing jumps right after it.
+	int last_operator_pos = -1;
+	Variant::Type last_operator_result_type = Variant::NIL;
 
 	Vector<StackSlot> temporaries;
 	List<int> used_temporaries;
@@ -93,11 +98,15 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	List<GDScriptFunction::StackDebug> stack_debug;
 	List<RBMap<StringName, int>> block_identifier_stack;
+#ifdef TOOLS_ENABLED
+	Vector<int> global_index_positions;
+#endif
 	RBMap<StringName, int> block_identifiers;
 
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_cache_count = 0;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -349,6 +358,11 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		return pos;
 	}
 
+	// One per untyped property access or method call, see `GDScriptFunction::InlineCache`.
+	int add_inline_cache() {
+		return inline_cache_count++;
+	}
+
 	CallTarget get_call_target(const Address &p_target, Variant::Type p_type = Variant::NIL);
 
 	int address_of(const Address &p_address) {
@@ -449,8 +463,13 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		last_operator_pos = -1; // The next instruction is a jump target, it can't be merged with the previous one.
 	}
 
+	bool is_last_operator_result(const Address &p_address) const;
+	bool forward_operator_result(const Address &p_target, const Address &p_source);
+	bool fuse_operator_jump_if_not(const Address &p_condition);
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
@@ -0,0 +1,1587 @@
+/**************************************************************************/
+/*  gdscript_bytecode.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode.h"
+
+#include "gdscript.h"
+#include "gdscript_cache.h"
+#include "gdscript_function.h"
+#include "gdscript_utility_functions.h"
+
+#ifdef TOOLS_ENABLED
+#include "gdscript_analyzer.h"
+#include "gdscript_compiler.h"
+#include "gdscript_parser.h"
+#endif
+
+#include "core/config/engine.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+
+static const int BYTECODE_HEADER_SIZE = 12; // Magic, version and size of the token buffer.
+
+enum {
+	FLAG_KEEP_STATIC_DATA = 1,
+};
+
+enum {
+	RESOURCE_REF_NONE,
+	RESOURCE_REF_OWN_CLASS, // Class in the same file, stored relative to the root class.
+	RESOURCE_REF_GDSCRIPT, // Path and fully qualified name of a class in another file.
+	RESOURCE_REF_PATH,
+};
+
+enum {
+	VARIANT_VALUE, // Anything `encode_variant()` supports without objects.
+	VARIANT_NULL_OBJECT,
+	VARIANT_RESOURCE,
+	VARIANT_NATIVE_CLASS,
+	VARIANT_SINGLETON,
+	VARIANT_ARRAY,
+	VARIANT_DICTIONARY,
+};
+
+struct GDScriptBytecode::LoadContext {
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int pos = 0;
+	bool error = false;
+	String error_message;
+
+	uint32_t flags = 0;
+	Vector<StringName> strings;
+	String root_fqcn;
+	GDScript *root = nullptr;
+
+	void fail(const String &p_message) {
+		if (!error) {
+			error = true;
+			error_message = p_message;
+		}
+	}
+
+	uint8_t get_u8() {
+		if (unlikely(pos + 1 > size)) {
+			fail("Unexpected end of file.");
+			return 0;
+		}
+		return data[pos++];
+	}
+
+	uint32_t get_u32() {
+		if (unlikely(pos + 4 > size)) {
+			fail("Unexpected end of file.");
+			return 0;
+		}
+		uint32_t value = decode_uint32(&data[pos]);
+		pos += 4;
+		return value;
+	}
+
+	int32_t get_s32() {
+		return (int32_t)get_u32();
+	}
+
+	// Counts are checked against the remaining size so corrupted files can't trigger huge allocations.
+	uint32_t get_count() {
+		uint32_t count = get_u32();
+		if (unlikely(count > (uint32_t)(size - pos))) {
+			fail("Invalid element count.");
+			return 0;
+		}
+		return count;
+	}
+
+	StringName get_string() {
+		uint32_t index = get_u32();
+		if (unlikely(index >= (uint32_t)strings.size())) {
+			fail("Invalid string index.");
+			return StringName();
+		}
+		return strings[index];
+	}
+
+	Variant::Type get_type() {
+		uint8_t type = get_u8();
+		if (unlikely(type >= Variant::VARIANT_MAX)) {
+			fail("Invalid Variant type.");
+			return Variant::NIL;
+		}
+		return (Variant::Type)type;
+	}
+};
+
+bool GDScriptBytecode::is_bytecode_buffer(const Vector<uint8_t> &p_buffer) {
+	return p_buffer.size() >= BYTECODE_HEADER_SIZE && p_buffer[0] == 'G' && p_buffer[1] == 'D' && p_buffer[2] == 'S' && p_buffer[3] == 'B';
+}
+
+Vector<uint8_t> GDScriptBytecode::get_binary_tokens(const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_COND_V(!is_bytecode_buffer(p_buffer), Vector<uint8_t>());
+
+	uint32_t token_size = decode_uint32(&p_buffer[8]);
+	ERR_FAIL_COND_V_MSG(token_size > (uint32_t)(p_buffer.size() - BYTECODE_HEADER_SIZE), Vector<uint8_t>(), "Invalid GDScript bytecode file.");
+	return p_buffer.slice(BYTECODE_HEADER_SIZE, BYTECODE_HEADER_SIZE + token_size);
+}
+
+Vector<uint8_t> GDScriptBytecode::get_compiled_code(const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_COND_V(!is_bytecode_buffer(p_buffer), Vector<uint8_t>());
+
+	if (decode_uint32(&p_buffer[4]) != BYTECODE_VERSION) {
+		return Vector<uint8_t>(); // Exported with another version, the tokens are used instead.
+	}
+	uint32_t token_size = decode_uint32(&p_buffer[8]);
+	ERR_FAIL_COND_V_MSG(token_size > (uint32_t)(p_buffer.size() - BYTECODE_HEADER_SIZE), Vector<uint8_t>(), "Invalid GDScript bytecode file.");
+	return p_buffer.slice(BYTECODE_HEADER_SIZE + token_size);
+}
+
+Error GDScriptBytecode::_read_header(LoadContext &r_ctx) {
+	// The opcodes and pointer tables depend on these, bytecode from a different build can't be used.
+	uint32_t variant_max = r_ctx.get_u32();
+	uint32_t operator_max = r_ctx.get_u32();
+	uint32_t opcode_end = r_ctx.get_u32();
+	if (r_ctx.error || variant_max != Variant::VARIANT_MAX || operator_max != Variant::OP_MAX || opcode_end != GDScriptFunction::OPCODE_END) {
+		r_ctx.fail("Bytecode was compiled by an incompatible engine version.");
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	r_ctx.flags = r_ctx.get_u32();
+
+	uint32_t string_count = r_ctx.get_count();
+	r_ctx.strings.resize(string_count);
+	StringName *strings = r_ctx.strings.ptrw();
+	for (uint32_t i = 0; i < string_count && !r_ctx.error; i++) {
+		uint32_t length = r_ctx.get_count();
+		if (r_ctx.error) {
+			break;
+		}
+		String string;
+		string.parse_utf8((const char *)&r_ctx.data[r_ctx.pos], length);
+		strings[i] = string;
+		r_ctx.pos += length;
+	}
+
+	return r_ctx.error ? ERR_FILE_CORRUPT : OK;
+}
+
+void GDScriptBytecode::_make_class(LoadContext &r_ctx, GDScript *p_script, const StringName &p_local_name) {
+	String relative_fqcn = r_ctx.get_string();
+	p_script->local_name = p_local_name;
+	p_script->fully_qualified_name = r_ctx.root_fqcn + relative_fqcn;
+	p_script->global_name = r_ctx.get_string();
+	p_script->simplified_icon_path = r_ctx.get_string();
+
+	// Keep the existing inner classes when reloading, like the compiler does.
+	HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	uint32_t subclass_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < subclass_count && !r_ctx.error; i++) {
+		StringName name = r_ctx.get_string();
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		p_script->subclasses.insert(name, subclass);
+
+		_make_class(r_ctx, subclass.ptr(), name);
+	}
+}
+
+void GDScriptBytecode::_clear_class(GDScript *p_script) {
+	p_script->clearing = true;
+
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = nullptr;
+	p_script->members.clear();
+
+	// Move things out first so destructors don't see a half cleared script, as in `GDScriptCompiler::_prepare_compilation()`.
+	HashMap<StringName, Variant> constants = p_script->constants;
+	p_script->constants.clear();
+	constants.clear();
+
+	HashMap<StringName, GDScriptFunction *> member_functions = p_script->member_functions;
+	p_script->member_functions.clear();
+	for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+		memdelete(E.value);
+	}
+
+	if (p_script->implicit_initializer) {
+		memdelete(p_script->implicit_initializer);
+	}
+	if (p_script->implicit_ready) {
+		memdelete(p_script->implicit_ready);
+	}
+	if (p_script->static_initializer) {
+		memdelete(p_script->static_initializer);
+	}
+
+	p_script->member_indices.clear();
+	p_script->static_variables_indices.clear();
+	GDScriptFunction::_invalidate_inline_caches(); // They may point into the member infos.
+	p_script->static_variables.clear();
+	p_script->_signals.clear();
+	p_script->initializer = nullptr;
+	p_script->implicit_initializer = nullptr;
+	p_script->implicit_ready = nullptr;
+	p_script->static_initializer = nullptr;
+	p_script->rpc_config.clear();
+	p_script->lambda_info.clear();
+
+	p_script->clearing = false;
+}
+
+Ref<Resource> GDScriptBytecode::_load_resource_ref(LoadContext &r_ctx) {
+	uint8_t kind = r_ctx.get_u8();
+	switch (kind) {
+		case RESOURCE_REF_NONE: {
+			return Ref<Resource>();
+		} break;
+		case RESOURCE_REF_OWN_CLASS: {
+			String relative_fqcn = r_ctx.get_string();
+			GDScript *script = r_ctx.root->find_class(relative_fqcn);
+			if (script == nullptr) {
+				r_ctx.fail(vformat(R"(Could not find inner class "%s".)", relative_fqcn));
+				return Ref<Resource>();
+			}
+			return Ref<GDScript>(script);
+		} break;
+		case RESOURCE_REF_GDSCRIPT: {
+			String path = r_ctx.get_string();
+			String fqcn = r_ctx.get_string();
+			if (r_ctx.error) {
+				return Ref<Resource>();
+			}
+
+			// The script is fully loaded later by `GDScriptCache::finish_compiling()`, as with compiled dependencies.
+			Error err = OK;
+			Ref<GDScript> script = GDScriptCache::get_shallow_script(path, err, r_ctx.root->path);
+			if (script.is_valid()) {
+				script = Ref<GDScript>(script->find_class(fqcn));
+			}
+			if (script.is_null()) {
+				r_ctx.fail(vformat(R"(Could not find class "%s" in "%s".)", fqcn, path));
+			}
+			return script;
+		} break;
+		case RESOURCE_REF_PATH: {
+			String path = r_ctx.get_string();
+			if (r_ctx.error) {
+				return Ref<Resource>();
+			}
+			Ref<Resource> resource = ResourceLoader::load(path);
+			if (resource.is_null()) {
+				r_ctx.fail(vformat(R"(Could not load resource "%s".)", path));
+			}
+			return resource;
+		} break;
+		default: {
+			r_ctx.fail("Invalid resource reference.");
+		} break;
+	}
+	return Ref<Resource>();
+}
+
+Variant GDScriptBytecode::_load_variant(LoadContext &r_ctx) {
+	uint8_t kind = r_ctx.get_u8();
+	switch (kind) {
+		case VARIANT_VALUE: {
+			uint32_t length = r_ctx.get_count();
+			if (r_ctx.error) {
+				return Variant();
+			}
+			Variant value;
+			Error err = decode_variant(value, &r_ctx.data[r_ctx.pos], length, nullptr, false);
+			if (err != OK) {
+				r_ctx.fail("Invalid constant.");
+			}
+			r_ctx.pos += length;
+			return value;
+		} break;
+		case VARIANT_NULL_OBJECT: {
+			return Variant((Object *)nullptr);
+		} break;
+		case VARIANT_RESOURCE: {
+			return _load_resource_ref(r_ctx);
+		} break;
+		case VARIANT_NATIVE_CLASS: {
+			StringName name = r_ctx.get_string();
+			const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(name);
+			if (index == nullptr) {
+				r_ctx.fail(vformat(R"(Native class "%s" not found.)", name));
+				return Variant();
+			}
+			return GDScriptLanguage::get_singleton()->get_global_array()[*index];
+		} break;
+		case VARIANT_SINGLETON: {
+			StringName name = r_ctx.get_string();
+			Object *singleton = Engine::get_singleton()->has_singleton(name) ? Engine::get_singleton()->get_singleton_object(name) : nullptr;
+			if (singleton == nullptr) {
+				r_ctx.fail(vformat(R"(Singleton "%s" not found.)", name));
+			}
+			return singleton;
+		} break;
+		case VARIANT_ARRAY: {
+			bool read_only = r_ctx.get_u8();
+			Variant::Type typed_builtin = r_ctx.get_type();
+			StringName typed_class_name = r_ctx.get_string();
+			Ref<Resource> typed_script = _load_resource_ref(r_ctx);
+			uint32_t count = r_ctx.get_count();
+
+			Array array;
+			if (typed_builtin != Variant::NIL) {
+				array.set_typed(typed_builtin, typed_class_name, typed_script);
+			}
+			for (uint32_t i = 0; i < count && !r_ctx.error; i++) {
+				array.push_back(_load_variant(r_ctx));
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			return array;
+		} break;
+		case VARIANT_DICTIONARY: {
+			bool read_only = r_ctx.get_u8();
+			uint32_t count = r_ctx.get_count();
+
+			Dictionary dictionary;
+			for (uint32_t i = 0; i < count && !r_ctx.error; i++) {
+				Variant key = _load_variant(r_ctx);
+				dictionary[key] = _load_variant(r_ctx);
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			return dictionary;
+		} break;
+		default: {
+			r_ctx.fail("Invalid constant.");
+		} break;
+	}
+	return Variant();
+}
+
+void GDScriptBytecode::_load_data_type(LoadContext &r_ctx, GDScriptDataType &r_type) {
+	r_type.has_type = r_ctx.get_u8();
+	uint8_t kind = r_ctx.get_u8();
+	if (kind > GDScriptDataType::GDSCRIPT) {
+		r_ctx.fail("Invalid data type.");
+		return;
+	}
+	r_type.kind = (GDScriptDataType::Kind)kind;
+	r_type.builtin_type = r_ctx.get_type();
+	r_type.native_type = r_ctx.get_string();
+
+	bool strong_ref = r_ctx.get_u8();
+	Ref<Script> script = _load_resource_ref(r_ctx);
+	r_type.script_type = script.ptr();
+	if (strong_ref) {
+		r_type.script_type_ref = script;
+	}
+
+	uint32_t container_count = r_ctx.get_count();
+	r_type.container_element_types.resize(container_count);
+	for (uint32_t i = 0; i < container_count && !r_ctx.error; i++) {
+		_load_data_type(r_ctx, r_type.container_element_types.write[i]);
+	}
+}
+
+PropertyInfo GDScriptBytecode::_load_property_info(LoadContext &r_ctx) {
+	PropertyInfo info;
+	info.type = r_ctx.get_type();
+	info.name = r_ctx.get_string();
+	info.class_name = r_ctx.get_string();
+	info.hint = (PropertyHint)r_ctx.get_u32();
+	info.hint_string = r_ctx.get_string();
+	info.usage = r_ctx.get_u32();
+	return info;
+}
+
+MethodInfo GDScriptBytecode::_load_method_info(LoadContext &r_ctx) {
+	MethodInfo info;
+	info.name = r_ctx.get_string();
+	info.return_val = _load_property_info(r_ctx);
+	info.flags = r_ctx.get_u32();
+	info.id = r_ctx.get_s32();
+
+	uint32_t argument_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < argument_count && !r_ctx.error; i++) {
+		info.arguments.push_back(_load_property_info(r_ctx));
+	}
+
+	uint32_t default_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < default_count && !r_ctx.error; i++) {
+		info.default_arguments.push_back(_load_variant(r_ctx));
+	}
+	return info;
+}
+
+GDScriptFunction *GDScriptBytecode::_load_function(LoadContext &r_ctx, GDScript *p_script, bool p_is_lambda) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->source = p_script->get_script_path();
+	function->name = r_ctx.get_string();
+	function->_static = r_ctx.get_u8();
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	uint32_t argument_type_count = r_ctx.get_count();
+	function->argument_types.resize(argument_type_count);
+	for (uint32_t i = 0; i < argument_type_count && !r_ctx.error; i++) {
+		_load_data_type(r_ctx, function->argument_types.write[i]);
+	}
+	_load_data_type(r_ctx, function->return_type);
+	function->method_info = _load_method_info(r_ctx);
+	function->rpc_config = _load_variant(r_ctx);
+
+	function->_initial_line = r_ctx.get_s32();
+	function->_argument_count = r_ctx.get_s32();
+	function->_stack_size = r_ctx.get_s32();
+	function->_instruction_args_size = r_ctx.get_s32();
+	int inline_cache_count = r_ctx.get_s32();
+	if (inline_cache_count < 0 || inline_cache_count > r_ctx.size - r_ctx.pos) {
+		r_ctx.fail("Invalid inline cache count.");
+	} else {
+		function->_allocate_inline_caches(inline_cache_count);
+	}
+
+	uint32_t temporary_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < temporary_count && !r_ctx.error; i++) {
+		int slot = r_ctx.get_s32();
+		function->temporary_slots[slot] = r_ctx.get_type();
+	}
+
+	uint32_t stack_debug_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < stack_debug_count && !r_ctx.error; i++) {
+		GDScriptFunction::StackDebug stack_debug;
+		stack_debug.line = r_ctx.get_s32();
+		stack_debug.pos = r_ctx.get_s32();
+		stack_debug.added = r_ctx.get_u8();
+		stack_debug.identifier = r_ctx.get_string();
+		function->stack_debug.push_back(stack_debug);
+	}
+
+	uint32_t code_size = r_ctx.get_count();
+	if (!r_ctx.error && code_size * 4 > (uint32_t)(r_ctx.size - r_ctx.pos)) {
+		r_ctx.fail("Invalid code size.");
+	}
+	if (!r_ctx.error) {
+		function->code.resize(code_size);
+		int *code = function->code.ptrw();
+		for (uint32_t i = 0; i < code_size; i++) {
+			code[i] = (int)decode_uint32(&r_ctx.data[r_ctx.pos]);
+			r_ctx.pos += 4;
+		}
+	}
+
+	// Indices into the global array depend on what is registered at runtime, so they are stored by name.
+	uint32_t global_index_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < global_index_count && !r_ctx.error; i++) {
+		uint32_t position = r_ctx.get_u32();
+		StringName global = r_ctx.get_string();
+		const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(global);
+		if (position >= code_size || index == nullptr) {
+			r_ctx.fail(vformat(R"(Global "%s" not found.)", global));
+			break;
+		}
+		function->code.write[position] = *index;
+	}
+
+	uint32_t default_argument_count = r_ctx.get_count();
+	function->default_arguments.resize(default_argument_count);
+	for (uint32_t i = 0; i < default_argument_count && !r_ctx.error; i++) {
+		function->default_arguments.write[i] = r_ctx.get_s32();
+	}
+
+	uint32_t constant_count = r_ctx.get_count();
+	function->constants.resize(constant_count);
+	for (uint32_t i = 0; i < constant_count && !r_ctx.error; i++) {
+		function->constants.write[i] = _load_variant(r_ctx);
+	}
+
+	uint32_t global_name_count = r_ctx.get_count();
+	function->global_names.resize(global_name_count);
+	for (uint32_t i = 0; i < global_name_count && !r_ctx.error; i++) {
+		function->global_names.write[i] = r_ctx.get_string();
+	}
+
+	// Pointer tables are stored as whatever was used to look them up in `GDScriptByteCodeGenerator`.
+	uint32_t operator_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < operator_count && !r_ctx.error; i++) {
+		uint8_t op = r_ctx.get_u8();
+		Variant::Type type_a = r_ctx.get_type();
+		Variant::Type type_b = r_ctx.get_type();
+		Variant::ValidatedOperatorEvaluator evaluator = op < Variant::OP_MAX ? Variant::get_validated_operator_evaluator((Variant::Operator)op, type_a, type_b) : nullptr;
+		if (evaluator == nullptr) {
+			r_ctx.fail("Operator not found.");
+			break;
+		}
+		function->operator_funcs.push_back(evaluator);
+#ifdef DEBUG_ENABLED
+		function->operator_names.push_back(Variant::get_operator_name((Variant::Operator)op));
+#endif
+	}
+
+	uint32_t setter_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < setter_count && !r_ctx.error; i++) {
+		Variant::Type type = r_ctx.get_type();
+		StringName member = r_ctx.get_string();
+		Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member);
+		if (setter == nullptr) {
+			r_ctx.fail(vformat(R"(Setter "%s" not found.)", member));
+			break;
+		}
+		function->setters.push_back(setter);
+#ifdef DEBUG_ENABLED
+		function->setter_names.push_back(member);
+#endif
+	}
+
+	uint32_t getter_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < getter_count && !r_ctx.error; i++) {
+		Variant::Type type = r_ctx.get_type();
+		StringName member = r_ctx.get_string();
+		Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member);
+		if (getter == nullptr) {
+			r_ctx.fail(vformat(R"(Getter "%s" not found.)", member));
+			break;
+		}
+		function->getters.push_back(getter);
+#ifdef DEBUG_ENABLED
+		function->getter_names.push_back(member);
+#endif
+	}
+
+	uint32_t keyed_setter_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < keyed_setter_count && !r_ctx.error; i++) {
+		function->keyed_setters.push_back(Variant::get_member_validated_keyed_setter(r_ctx.get_type()));
+	}
+
+	uint32_t keyed_getter_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < keyed_getter_count && !r_ctx.error; i++) {
+		function->keyed_getters.push_back(Variant::get_member_validated_keyed_getter(r_ctx.get_type()));
+	}
+
+	uint32_t indexed_setter_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < indexed_setter_count && !r_ctx.error; i++) {
+		function->indexed_setters.push_back(Variant::get_member_validated_indexed_setter(r_ctx.get_type()));
+	}
+
+	uint32_t indexed_getter_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < indexed_getter_count && !r_ctx.error; i++) {
+		function->indexed_getters.push_back(Variant::get_member_validated_indexed_getter(r_ctx.get_type()));
+	}
+
+	uint32_t builtin_method_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < builtin_method_count && !r_ctx.error; i++) {
+		Variant::Type type = r_ctx.get_type();
+		StringName method = r_ctx.get_string();
+		Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, method);
+		if (builtin_method == nullptr) {
+			r_ctx.fail(vformat(R"(Method "%s" not found in "%s".)", method, Variant::get_type_name(type)));
+			break;
+		}
+		function->builtin_methods.push_back(builtin_method);
+#ifdef DEBUG_ENABLED
+		function->builtin_methods_names.push_back(method);
+#endif
+	}
+
+	uint32_t constructor_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < constructor_count && !r_ctx.error; i++) {
+		Variant::Type type = r_ctx.get_type();
+		uint32_t constructor = r_ctx.get_u32();
+		if (constructor >= (uint32_t)Variant::get_constructor_count(type)) {
+			r_ctx.fail(vformat(R"(Constructor of "%s" not found.)", Variant::get_type_name(type)));
+			break;
+		}
+		function->constructors.push_back(Variant::get_validated_constructor(type, constructor));
+#ifdef DEBUG_ENABLED
+		function->constructors_names.push_back(Variant::get_type_name(type));
+#endif
+	}
+
+	uint32_t utility_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < utility_count && !r_ctx.error; i++) {
+		StringName utility_name = r_ctx.get_string();
+		Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(utility_name);
+		if (utility == nullptr) {
+			r_ctx.fail(vformat(R"(Utility function "%s" not found.)", utility_name));
+			break;
+		}
+		function->utilities.push_back(utility);
+#ifdef DEBUG_ENABLED
+		function->utilities_names.push_back(utility_name);
+#endif
+	}
+
+	uint32_t gds_utility_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < gds_utility_count && !r_ctx.error; i++) {
+		StringName utility_name = r_ctx.get_string();
+		GDScriptUtilityFunctions::FunctionPtr utility = GDScriptUtilityFunctions::get_function(utility_name);
+		if (utility == nullptr) {
+			r_ctx.fail(vformat(R"(Utility function "%s" not found.)", utility_name));
+			break;
+		}
+		function->gds_utilities.push_back(utility);
+#ifdef DEBUG_ENABLED
+		function->gds_utilities_names.push_back(utility_name);
+#endif
+	}
+
+	uint32_t method_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < method_count && !r_ctx.error; i++) {
+		StringName class_name = r_ctx.get_string();
+		StringName method_name = r_ctx.get_string();
+		MethodBind *method = ClassDB::get_method(class_name, method_name);
+		if (method == nullptr) {
+			r_ctx.fail(vformat(R"(Method "%s" not found in class "%s".)", method_name, class_name));
+			break;
+		}
+		function->methods.push_back(method);
+	}
+
+	uint32_t lambda_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < lambda_count && !r_ctx.error; i++) {
+		GDScript::LambdaInfo info;
+		info.capture_count = r_ctx.get_s32();
+		info.use_self = r_ctx.get_u8();
+		GDScriptFunction *lambda = _load_function(r_ctx, p_script, true);
+		if (lambda == nullptr) {
+			break;
+		}
+		function->lambdas.push_back(lambda);
+		p_script->lambda_info.insert(lambda, info);
+	}
+
+	if (r_ctx.error) {
+		memdelete(function);
+		return nullptr;
+	}
+
+	_update_function_pointers(function);
+
+#ifdef DEBUG_ENABLED
+	if (EngineDebugger::is_active()) {
+		String signature = p_script->get_script_path() + "::" + itos(function->_initial_line) + "::";
+		if (p_script->local_name != StringName()) {
+			signature += String(p_script->local_name) + ".";
+		}
+		signature += String(function->name);
+		if (p_is_lambda) {
+			signature += "(lambda)";
+		}
+		function->profile.signature = signature;
+	}
+#endif
+
+	return function;
+}
+
+void GDScriptBytecode::_update_function_pointers(GDScriptFunction *p_function) {
+	// Same as the end of `GDScriptByteCodeGenerator::write_end()`.
+	p_function->_code_size = p_function->code.size();
+	p_function->_code_ptr = p_function->code.is_empty() ? nullptr : p_function->code.ptrw();
+	p_function->_default_arg_count = p_function->default_arguments.is_empty() ? 0 : p_function->default_arguments.size() - 1;
+	p_function->_default_arg_ptr = p_function->default_arguments.is_empty() ? nullptr : p_function->default_arguments.ptr();
+	p_function->_constant_count = p_function->constants.size();
+	p_function->_constants_ptr = p_function->constants.is_empty() ? nullptr : p_function->constants.ptrw();
+	p_function->_global_names_count = p_function->global_names.size();
+	p_function->_global_names_ptr = p_function->global_names.is_empty() ? nullptr : p_function->global_names.ptr();
+
+#define SET_POINTER_TABLE(m_name)                                                                      \
+	p_function->_##m_name##_count = p_function->m_name.size();                                         \
+	p_function->_##m_name##_ptr = p_function->m_name.is_empty() ? nullptr : p_function->m_name.ptrw();
+
+	SET_POINTER_TABLE(operator_funcs);
+	SET_POINTER_TABLE(setters);
+	SET_POINTER_TABLE(getters);
+	SET_POINTER_TABLE(keyed_setters);
+	SET_POINTER_TABLE(keyed_getters);
+	SET_POINTER_TABLE(indexed_setters);
+	SET_POINTER_TABLE(indexed_getters);
+	SET_POINTER_TABLE(builtin_methods);
+	SET_POINTER_TABLE(constructors);
+	SET_POINTER_TABLE(utilities);
+	SET_POINTER_TABLE(gds_utilities);
+	SET_POINTER_TABLE(methods);
+	SET_POINTER_TABLE(lambdas);
+
+#undef SET_POINTER_TABLE
+}
+
+void GDScriptBytecode::_load_member_info(LoadContext &r_ctx, HashMap<StringName, GDScript::MemberInfo> &r_members) {
+	uint32_t count = r_ctx.get_count();
+	for (uint32_t i = 0; i < count && !r_ctx.error; i++) {
+		StringName name = r_ctx.get_string();
+		GDScript::MemberInfo info;
+		info.index = r_ctx.get_s32();
+		info.setter = r_ctx.get_string();
+		info.getter = r_ctx.get_string();
+		_load_data_type(r_ctx, info.data_type);
+		info.property_info = _load_property_info(r_ctx);
+		r_members.insert(name, info);
+	}
+}
+
+void GDScriptBytecode::_load_class(LoadContext &r_ctx, GDScript *p_script) {
+	_clear_class(p_script);
+
+	p_script->tool = r_ctx.get_u8();
+
+	StringName native_name = r_ctx.get_string();
+	const int *native_index = GDScriptLanguage::get_singleton()->get_global_map().getptr(native_name);
+	if (native_index == nullptr) {
+		r_ctx.fail(vformat(R"(Native class "%s" not found.)", native_name));
+		return;
+	}
+	p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[*native_index];
+
+	Ref<GDScript> base = _load_resource_ref(r_ctx);
+	p_script->base = base;
+	p_script->_base = base.ptr();
+
+	// Inherited members are stored too, so the base doesn't need to be loaded first.
+	_load_member_info(r_ctx, p_script->member_indices);
+
+	uint32_t member_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < member_count && !r_ctx.error; i++) {
+		p_script->members.insert(r_ctx.get_string());
+	}
+
+	_load_member_info(r_ctx, p_script->static_variables_indices);
+
+	uint32_t constant_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < constant_count && !r_ctx.error; i++) {
+		StringName name = r_ctx.get_string();
+		p_script->constants.insert(name, _load_variant(r_ctx));
+	}
+
+	uint32_t signal_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < signal_count && !r_ctx.error; i++) {
+		StringName name = r_ctx.get_string();
+		p_script->_signals.insert(name, _load_method_info(r_ctx));
+	}
+
+	p_script->rpc_config = _load_variant(r_ctx);
+
+	uint32_t function_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < function_count && !r_ctx.error; i++) {
+		GDScriptFunction *function = _load_function(r_ctx, p_script, false);
+		if (function != nullptr) {
+			p_script->member_functions.insert(function->name, function);
+		}
+	}
+
+	if (r_ctx.get_u8()) {
+		p_script->implicit_initializer = _load_function(r_ctx, p_script, false);
+	}
+	if (r_ctx.get_u8()) {
+		p_script->implicit_ready = _load_function(r_ctx, p_script, false);
+	}
+	if (r_ctx.get_u8()) {
+		p_script->static_initializer = _load_function(r_ctx, p_script, false);
+	}
+
+	uint32_t subclass_count = r_ctx.get_count();
+	for (uint32_t i = 0; i < subclass_count && !r_ctx.error; i++) {
+		StringName name = r_ctx.get_string();
+		Ref<GDScript> *subclass = p_script->subclasses.getptr(name);
+		if (subclass == nullptr) {
+			r_ctx.fail(vformat(R"(Inner class "%s" not found.)", name));
+			break;
+		}
+		_load_class(r_ctx, subclass->ptr());
+	}
+
+	if (r_ctx.error) {
+		return;
+	}
+
+	HashMap<StringName, GDScriptFunction *>::Iterator initializer = p_script->member_functions.find(SNAME("_init"));
+	p_script->initializer = initializer ? initializer->value : nullptr;
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+	p_script->_static_default_init();
+	p_script->valid = true;
+}
+
+Error GDScriptBytecode::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_code) {
+	ERR_FAIL_COND_V(p_code.is_empty(), ERR_INVALID_DATA);
+
+	LoadContext ctx;
+	ctx.data = p_code.ptr();
+	ctx.size = p_code.size();
+	ctx.root = p_script;
+	ctx.root_fqcn = GDScript::canonicalize_path(p_script->path);
+
+	Error err = _read_header(ctx);
+	if (err != OK) {
+		return err;
+	}
+
+	p_script->_owner = nullptr;
+	_make_class(ctx, p_script, StringName());
+	return ctx.error ? ERR_FILE_CORRUPT : OK;
+}
+
+Error GDScriptBytecode::load(GDScript *p_script, const Vector<uint8_t> &p_code, String *r_error) {
+	ERR_FAIL_COND_V(p_code.is_empty(), ERR_INVALID_DATA);
+
+	LoadContext ctx;
+	ctx.data = p_code.ptr();
+	ctx.size = p_code.size();
+	ctx.root = p_script;
+	ctx.root_fqcn = GDScript::canonicalize_path(p_script->path);
+
+	Error err = _read_header(ctx);
+	if (err == OK) {
+		p_script->_owner = nullptr;
+		_make_class(ctx, p_script, StringName());
+		_load_class(ctx, p_script);
+	}
+
+	if (ctx.error) {
+		if (r_error) {
+			*r_error = ctx.error_message;
+		}
+		return err != OK ? err : ERR_FILE_CORRUPT;
+	}
+
+	if (ctx.flags & FLAG_KEEP_STATIC_DATA) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	return GDScriptCache::finish_compiling(p_script->path);
+}
+
+#ifdef TOOLS_ENABLED
+
+// Lookup keys of the function pointers used by compiled code, built once since there are many operators.
+struct GDScriptBytecodeReverseMaps {
+	struct OperatorKey {
+		Variant::Operator op = Variant::OP_EQUAL;
+		Variant::Type type_a = Variant::NIL;
+		Variant::Type type_b = Variant::NIL;
+	};
+	struct MemberKey {
+		Variant::Type type = Variant::NIL;
+		StringName member;
+	};
+	struct ConstructorKey {
+		Variant::Type type = Variant::NIL;
+		int index = 0;
+	};
+
+	RBMap<Variant::ValidatedOperatorEvaluator, OperatorKey> operators;
+	RBMap<Variant::ValidatedSetter, MemberKey> setters;
+	RBMap<Variant::ValidatedGetter, MemberKey> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, MemberKey> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, ConstructorKey> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	GDScriptBytecodeReverseMaps() {
+		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+			Variant::Type type = (Variant::Type)i;
+
+			for (int op = 0; op < Variant::OP_MAX; op++) {
+				for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, type, (Variant::Type)j);
+					if (evaluator != nullptr && !operators.has(evaluator)) {
+						operators.insert(evaluator, { (Variant::Operator)op, type, (Variant::Type)j });
+					}
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &member : members) {
+				setters.insert(Variant::get_member_validated_setter(type, member), { type, member });
+				getters.insert(Variant::get_member_validated_getter(type, member), { type, member });
+			}
+
+			keyed_setters.insert(Variant::get_member_validated_keyed_setter(type), type);
+			keyed_getters.insert(Variant::get_member_validated_keyed_getter(type), type);
+			indexed_setters.insert(Variant::get_member_validated_indexed_setter(type), type);
+			indexed_getters.insert(Variant::get_member_validated_indexed_getter(type), type);
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &method : methods) {
+				builtin_methods.insert(Variant::get_validated_builtin_method(type, method), { type, method });
+			}
+
+			for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+				constructors.insert(Variant::get_validated_constructor(type, j), { type, j });
+			}
+		}
+
+		List<StringName> utility_functions;
+		Variant::get_utility_function_list(&utility_functions);
+		for (const StringName &utility : utility_functions) {
+			utilities.insert(Variant::get_validated_utility_function(utility), utility);
+		}
+
+		List<StringName> gds_utility_functions;
+		GDScriptUtilityFunctions::get_function_list(&gds_utility_functions);
+		for (const StringName &utility : gds_utility_functions) {
+			gds_utilities.insert(GDScriptUtilityFunctions::get_function(utility), utility);
+		}
+	}
+};
+
+struct GDScriptBytecode::SaveContext {
+	Vector<uint8_t> data;
+	bool error = false;
+	String error_message;
+
+	HashMap<StringName, uint32_t> string_map;
+	Vector<StringName> strings;
+	HashMap<int, StringName> global_names; // Reverse of `GDScriptLanguage::get_global_map()`.
+	const GDScriptBytecodeReverseMaps *maps = nullptr;
+
+	const GDScript *root = nullptr;
+	String root_fqcn;
+
+	void fail(const String &p_message) {
+		if (!error) {
+			error = true;
+			error_message = p_message;
+		}
+	}
+
+	void put_u8(uint8_t p_value) {
+		data.push_back(p_value);
+	}
+
+	void put_u32(uint32_t p_value) {
+		int pos = data.size();
+		data.resize(pos + 4);
+		encode_uint32(p_value, &data.write[pos]);
+	}
+
+	void put_s32(int32_t p_value) {
+		put_u32((uint32_t)p_value);
+	}
+
+	void put_string(const StringName &p_string) {
+		HashMap<StringName, uint32_t>::Iterator E = string_map.find(p_string);
+		if (E) {
+			put_u32(E->value);
+			return;
+		}
+		uint32_t index = strings.size();
+		string_map.insert(p_string, index);
+		strings.push_back(p_string);
+		put_u32(index);
+	}
+
+	String get_relative_fqcn(const GDScript *p_script) const {
+		String root_fqcn_of_script = GDScript::canonicalize_path(p_script->path);
+		return p_script->fully_qualified_name.trim_prefix(root_fqcn_of_script);
+	}
+};
+
+void GDScriptBytecode::_save_class_tree(SaveContext &r_ctx, const GDScript *p_script) {
+	r_ctx.put_string(r_ctx.get_relative_fqcn(p_script));
+	r_ctx.put_string(p_script->global_name);
+	r_ctx.put_string(p_script->simplified_icon_path);
+
+	r_ctx.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		r_ctx.put_string(E.key);
+		_save_class_tree(r_ctx, E.value.ptr());
+	}
+}
+
+void GDScriptBytecode::_save_resource_ref(SaveContext &r_ctx, const Object *p_object) {
+	if (p_object == nullptr) {
+		r_ctx.put_u8(RESOURCE_REF_NONE);
+		return;
+	}
+
+	const GDScript *script = Object::cast_to<GDScript>(p_object);
+	if (script != nullptr) {
+		const GDScript *root = script;
+		while (root->_owner != nullptr) {
+			root = root->_owner;
+		}
+		if (root == r_ctx.root) {
+			r_ctx.put_u8(RESOURCE_REF_OWN_CLASS);
+			r_ctx.put_string(r_ctx.get_relative_fqcn(script));
+			return;
+		}
+		if (script->path.is_empty() || script->path.contains("::")) {
+			r_ctx.fail(vformat(R"(Built-in script "%s" can't be referenced from bytecode.)", script->fully_qualified_name));
+			return;
+		}
+		r_ctx.put_u8(RESOURCE_REF_GDSCRIPT);
+		r_ctx.put_string(script->path);
+		r_ctx.put_string(r_ctx.get_relative_fqcn(script));
+		return;
+	}
+
+	const Resource *resource = Object::cast_to<Resource>(p_object);
+	if (resource == nullptr || resource->get_path().is_empty() || resource->get_path().contains("::")) {
+		r_ctx.fail(vformat(R"(Object of type "%s" can't be stored in bytecode.)", p_object->get_class()));
+		return;
+	}
+	r_ctx.put_u8(RESOURCE_REF_PATH);
+	r_ctx.put_string(resource->get_path());
+}
+
+void GDScriptBytecode::_save_variant(SaveContext &r_ctx, const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			Object *object = p_value.get_validated_object();
+			if (object == nullptr) {
+				r_ctx.put_u8(VARIANT_NULL_OBJECT);
+				return;
+			}
+
+			const GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(object);
+			if (native_class != nullptr) {
+				r_ctx.put_u8(VARIANT_NATIVE_CLASS);
+				r_ctx.put_string(native_class->get_name());
+				return;
+			}
+
+			if (Object::cast_to<Resource>(object) == nullptr) {
+				List<Engine::Singleton> singletons;
+				Engine::get_singleton()->get_singletons(&singletons);
+				for (const Engine::Singleton &singleton : singletons) {
+					if (singleton.ptr == object) {
+						r_ctx.put_u8(VARIANT_SINGLETON);
+						r_ctx.put_string(singleton.name);
+						return;
+					}
+				}
+			}
+
+			r_ctx.put_u8(VARIANT_RESOURCE);
+			_save_resource_ref(r_ctx, object);
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			r_ctx.put_u8(VARIANT_ARRAY);
+			r_ctx.put_u8(array.is_read_only());
+			r_ctx.put_u8(array.get_typed_builtin());
+			r_ctx.put_string(array.get_typed_class_name());
+			_save_resource_ref(r_ctx, array.get_typed_script().get_validated_object());
+			r_ctx.put_u32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				_save_variant(r_ctx, array[i]);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dictionary = p_value;
+			r_ctx.put_u8(VARIANT_DICTIONARY);
+			r_ctx.put_u8(dictionary.is_read_only());
+			r_ctx.put_u32(dictionary.size());
+			for (const Variant &key : dictionary.keys()) {
+				_save_variant(r_ctx, key);
+				_save_variant(r_ctx, dictionary[key]);
+			}
+		} break;
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			r_ctx.fail(vformat(R"(Constant of type "%s" can't be stored in bytecode.)", Variant::get_type_name(p_value.get_type())));
+		} break;
+		default: {
+			int length = 0;
+			Error err = encode_variant(p_value, nullptr, length, false);
+			if (err != OK) {
+				r_ctx.fail(vformat(R"(Constant of type "%s" can't be stored in bytecode.)", Variant::get_type_name(p_value.get_type())));
+				return;
+			}
+			r_ctx.put_u8(VARIANT_VALUE);
+			r_ctx.put_u32(length);
+			int pos = r_ctx.data.size();
+			r_ctx.data.resize(pos + length);
+			encode_variant(p_value, &r_ctx.data.write[pos], length, false);
+		} break;
+	}
+}
+
+void GDScriptBytecode::_save_data_type(SaveContext &r_ctx, const GDScriptDataType &p_type) {
+	r_ctx.put_u8(p_type.has_type);
+	r_ctx.put_u8(p_type.kind);
+	r_ctx.put_u8(p_type.builtin_type);
+	r_ctx.put_string(p_type.native_type);
+	r_ctx.put_u8(p_type.script_type_ref.is_valid());
+	_save_resource_ref(r_ctx, p_type.script_type);
+
+	r_ctx.put_u32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		_save_data_type(r_ctx, element_type);
+	}
+}
+
+void GDScriptBytecode::_save_property_info(SaveContext &r_ctx, const PropertyInfo &p_info) {
+	r_ctx.put_u8(p_info.type);
+	r_ctx.put_string(p_info.name);
+	r_ctx.put_string(p_info.class_name);
+	r_ctx.put_u32(p_info.hint);
+	r_ctx.put_string(p_info.hint_string);
+	r_ctx.put_u32(p_info.usage);
+}
+
+void GDScriptBytecode::_save_method_info(SaveContext &r_ctx, const MethodInfo &p_info) {
+	r_ctx.put_string(p_info.name);
+	_save_property_info(r_ctx, p_info.return_val);
+	r_ctx.put_u32(p_info.flags);
+	r_ctx.put_s32(p_info.id);
+
+	r_ctx.put_u32(p_info.arguments.size());
+	for (const PropertyInfo &argument : p_info.arguments) {
+		_save_property_info(r_ctx, argument);
+	}
+
+	r_ctx.put_u32(p_info.default_arguments.size());
+	for (const Variant &default_argument : p_info.default_arguments) {
+		_save_variant(r_ctx, default_argument);
+	}
+}
+
+template <typename K, typename V>
+static const V *_find_reverse(const RBMap<K, V> &p_map, K p_key) {
+	const typename RBMap<K, V>::Element *E = p_map.find(p_key);
+	return E ? &E->value() : nullptr;
+}
+
+void GDScriptBytecode::_save_function(SaveContext &r_ctx, const GDScriptFunction *p_function) {
+	const GDScriptBytecodeReverseMaps &maps = *r_ctx.maps;
+
+	r_ctx.put_string(p_function->name);
+	r_ctx.put_u8(p_function->_static);
+
+	r_ctx.put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		_save_data_type(r_ctx, argument_type);
+	}
+	_save_data_type(r_ctx, p_function->return_type);
+	_save_method_info(r_ctx, p_function->method_info);
+	_save_variant(r_ctx, p_function->rpc_config);
+
+	r_ctx.put_s32(p_function->_initial_line);
+	r_ctx.put_s32(p_function->_argument_count);
+	r_ctx.put_s32(p_function->_stack_size);
+	r_ctx.put_s32(p_function->_instruction_args_size);
+	r_ctx.put_s32(p_function->_inline_cache_count);
+
+	r_ctx.put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		r_ctx.put_s32(E.key);
+		r_ctx.put_u8(E.value);
+	}
+
+	r_ctx.put_u32(p_function->stack_debug.size());
+	for (const GDScriptFunction::StackDebug &stack_debug : p_function->stack_debug) {
+		r_ctx.put_s32(stack_debug.line);
+		r_ctx.put_s32(stack_debug.pos);
+		r_ctx.put_u8(stack_debug.added);
+		r_ctx.put_string(stack_debug.identifier);
+	}
+
+	r_ctx.put_u32(p_function->code.size());
+	for (int value : p_function->code) {
+		r_ctx.put_s32(value);
+	}
+
+	r_ctx.put_u32(p_function->global_index_positions.size());
+	for (int position : p_function->global_index_positions) {
+		const StringName *global = r_ctx.global_names.getptr(p_function->code[position]);
+		if (global == nullptr) {
+			r_ctx.fail("Invalid global index.");
+			return;
+		}
+		r_ctx.put_u32(position);
+		r_ctx.put_string(*global);
+	}
+
+	r_ctx.put_u32(p_function->default_arguments.size());
+	for (int default_argument : p_function->default_arguments) {
+		r_ctx.put_s32(default_argument);
+	}
+
+	r_ctx.put_u32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		_save_variant(r_ctx, constant);
+	}
+
+	r_ctx.put_u32(p_function->global_names.size());
+	for (const StringName &global_name : p_function->global_names) {
+		r_ctx.put_string(global_name);
+	}
+
+	r_ctx.put_u32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+		const GDScriptBytecodeReverseMaps::OperatorKey *key = _find_reverse(maps.operators, evaluator);
+		if (key == nullptr) {
+			r_ctx.fail("Unknown operator.");
+			return;
+		}
+		r_ctx.put_u8(key->op);
+		r_ctx.put_u8(key->type_a);
+		r_ctx.put_u8(key->type_b);
+	}
+
+	r_ctx.put_u32(p_function->setters.size());
+	for (Variant::ValidatedSetter setter : p_function->setters) {
+		const GDScriptBytecodeReverseMaps::MemberKey *key = _find_reverse(maps.setters, setter);
+		if (key == nullptr) {
+			r_ctx.fail("Unknown setter.");
+			return;
+		}
+		r_ctx.put_u8(key->type);
+		r_ctx.put_string(key->member);
+	}
+
+	r_ctx.put_u32(p_function->getters.size());
+	for (Variant::ValidatedGetter getter : p_function->getters) {
+		const GDScriptBytecodeReverseMaps::MemberKey *key = _find_reverse(maps.getters, getter);
+		if (key == nullptr) {
+			r_ctx.fail("Unknown getter.");
+			return;
+		}
+		r_ctx.put_u8(key->type);
+		r_ctx.put_string(key->member);
+	}
+
+#define SAVE_ACCESSORS(m_name)                                                    \
+	r_ctx.put_u32(p_function->m_name.size());                                     \
+	for (int i = 0; i < p_function->m_name.size(); i++) {                         \
+		const Variant::Type *type = _find_reverse(maps.m_name, p_function->m_name[i]); \
+		if (type == nullptr) {                                                    \
+			r_ctx.fail("Unknown keyed or indexed accessor.");                     \
+			return;                                                               \
+		}                                                                         \
+		r_ctx.put_u8(*type);                                                      \
+	}
+
+	SAVE_ACCESSORS(keyed_setters);
+	SAVE_ACCESSORS(keyed_getters);
+	SAVE_ACCESSORS(indexed_setters);
+	SAVE_ACCESSORS(indexed_getters);
+
+#undef SAVE_ACCESSORS
+
+	r_ctx.put_u32(p_function->builtin_methods.size());
+	for (Variant::ValidatedBuiltInMethod builtin_method : p_function->builtin_methods) {
+		const GDScriptBytecodeReverseMaps::MemberKey *key = _find_reverse(maps.builtin_methods, builtin_method);
+		if (key == nullptr) {
+			r_ctx.fail("Unknown built-in method.");
+			return;
+		}
+		r_ctx.put_u8(key->type);
+		r_ctx.put_string(key->member);
+	}
+
+	r_ctx.put_u32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+		const GDScriptBytecodeReverseMaps::ConstructorKey *key = _find_reverse(maps.constructors, constructor);
+		if (key == nullptr) {
+			r_ctx.fail("Unknown constructor.");
+			return;
+		}
+		r_ctx.put_u8(key->type);
+		r_ctx.put_u32(key->index);
+	}
+
+	r_ctx.put_u32(p_function->utilities.size());
+	for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+		const StringName *key = _find_reverse(maps.utilities, utility);
+		if (key == nullptr) {
+			r_ctx.fail("Unknown utility function.");
+			return;
+		}
+		r_ctx.put_string(*key);
+	}
+
+	r_ctx.put_u32(p_function->gds_utilities.size());
+	for (GDScriptUtilityFunctions::FunctionPtr utility : p_function->gds_utilities) {
+		const StringName *key = _find_reverse(maps.gds_utilities, utility);
+		if (key == nullptr) {
+			r_ctx.fail("Unknown utility function.");
+			return;
+		}
+		r_ctx.put_string(*key);
+	}
+
+	r_ctx.put_u32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		r_ctx.put_string(method->get_instance_class());
+		r_ctx.put_string(method->get_name());
+	}
+
+	r_ctx.put_u32(p_function->lambdas.size());
+	for (GDScriptFunction *lambda : p_function->lambdas) {
+		const GDScript::LambdaInfo *info = lambda->_script->lambda_info.getptr(lambda);
+		if (info == nullptr) {
+			r_ctx.fail("Unknown lambda.");
+			return;
+		}
+		r_ctx.put_s32(info->capture_count);
+		r_ctx.put_u8(info->use_self);
+		_save_function(r_ctx, lambda);
+	}
+}
+
+void GDScriptBytecode::_save_member_info(SaveContext &r_ctx, const HashMap<StringName, GDScript::MemberInfo> &p_members) {
+	r_ctx.put_u32(p_members.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_members) {
+		r_ctx.put_string(E.key);
+		r_ctx.put_s32(E.value.index);
+		r_ctx.put_string(E.value.setter);
+		r_ctx.put_string(E.value.getter);
+		_save_data_type(r_ctx, E.value.data_type);
+		_save_property_info(r_ctx, E.value.property_info);
+	}
+}
+
+void GDScriptBytecode::_save_class(SaveContext &r_ctx, const GDScript *p_script) {
+	r_ctx.put_u8(p_script->tool);
+	r_ctx.put_string(p_script->native.is_valid() ? p_script->native->get_name() : StringName());
+	_save_resource_ref(r_ctx, p_script->base.ptr());
+
+	_save_member_info(r_ctx, p_script->member_indices);
+
+	r_ctx.put_u32(p_script->members.size());
+	for (const StringName &member : p_script->members) {
+		r_ctx.put_string(member);
+	}
+
+	_save_member_info(r_ctx, p_script->static_variables_indices);
+
+	r_ctx.put_u32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		r_ctx.put_string(E.key);
+		_save_variant(r_ctx, E.value);
+	}
+
+	r_ctx.put_u32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		r_ctx.put_string(E.key);
+		_save_method_info(r_ctx, E.value);
+	}
+
+	_save_variant(r_ctx, p_script->rpc_config);
+
+	r_ctx.put_u32(p_script->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		_save_function(r_ctx, E.value);
+	}
+
+	const GDScriptFunction *special_functions[] = { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer };
+	for (const GDScriptFunction *function : special_functions) {
+		r_ctx.put_u8(function != nullptr);
+		if (function != nullptr) {
+			_save_function(r_ctx, function);
+		}
+	}
+
+	r_ctx.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		r_ctx.put_string(E.key);
+		_save_class(r_ctx, E.value.ptr());
+	}
+}
+
+Error GDScriptBytecode::serialize(const GDScript *p_script, bool p_keep_static_data, Vector<uint8_t> &r_code, String *r_error) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(!p_script->valid, ERR_INVALID_PARAMETER);
+
+	static const GDScriptBytecodeReverseMaps maps;
+
+	SaveContext ctx;
+	ctx.maps = &maps;
+	ctx.root = p_script;
+	for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+		ctx.global_names.insert(E.value, E.key);
+	}
+
+	_save_class_tree(ctx, p_script);
+	_save_class(ctx, p_script);
+
+	if (ctx.error) {
+		if (r_error) {
+			*r_error = ctx.error_message;
+		}
+		return ERR_UNAVAILABLE;
+	}
+
+	// The string table goes first, it's only known once everything else is written.
+	SaveContext header;
+	header.put_u32(Variant::VARIANT_MAX);
+	header.put_u32(Variant::OP_MAX);
+	header.put_u32(GDScriptFunction::OPCODE_END);
+	header.put_u32(p_keep_static_data ? FLAG_KEEP_STATIC_DATA : 0);
+	header.put_u32(ctx.strings.size());
+	for (const StringName &string : ctx.strings) {
+		CharString utf8 = String(string).utf8();
+		header.put_u32(utf8.length());
+		int pos = header.data.size();
+		header.data.resize(pos + utf8.length());
+		memcpy(header.data.ptrw() + pos, utf8.get_data(), utf8.length());
+	}
+
+	r_code = header.data;
+	r_code.append_array(ctx.data);
+	return OK;
+}
+
+Vector<uint8_t> GDScriptBytecode::compile_code_string(const String &p_code, const String &p_path, GDScriptTokenizerBuffer::CompressMode p_compress_mode, String *r_error) {
+	Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(p_code, p_compress_mode);
+	ERR_FAIL_COND_V(tokens.is_empty(), Vector<uint8_t>());
+
+	Vector<uint8_t> code;
+	String error;
+	{
+		GDScriptParser parser;
+		Error err = parser.parse(p_code, p_path, false);
+		if (err == OK) {
+			GDScriptAnalyzer analyzer(&parser);
+			err = analyzer.analyze();
+		}
+		if (err != OK) {
+			error = parser.get_errors().is_empty() ? String("Parse error.") : parser.get_errors().front()->get().message;
+		} else {
+			// Compiling registers the script in the cache, which may already hold the editor's copy.
+			Ref<GDScript> cached_full;
+			Ref<GDScript> cached_shallow;
+			HashSet<String> cached_dependencies;
+			Ref<GDScript> cached_static;
+			String fqcn = parser.get_tree()->fqcn;
+			{
+				MutexLock lock(GDScriptCache::singleton->mutex);
+				cached_full = GDScriptCache::singleton->full_gdscript_cache.has(p_path) ? GDScriptCache::singleton->full_gdscript_cache[p_path] : Ref<GDScript>();
+				cached_shallow = GDScriptCache::singleton->shallow_gdscript_cache.has(p_path) ? GDScriptCache::singleton->shallow_gdscript_cache[p_path] : Ref<GDScript>();
+				cached_dependencies = GDScriptCache::singleton->dependencies.has(p_path) ? GDScriptCache::singleton->dependencies[p_path] : HashSet<String>();
+				cached_static = GDScriptCache::singleton->static_gdscript_cache.has(fqcn) ? GDScriptCache::singleton->static_gdscript_cache[fqcn] : Ref<GDScript>();
+			}
+
+			Ref<GDScript> script;
+			script.instantiate();
+			script->path = p_path;
+			script->path_valid = true;
+
+			GDScriptCompiler compiler;
+			err = compiler.compile(&parser, script.ptr(), false);
+			if (err != OK) {
+				error = compiler.get_error();
+			} else {
+				bool has_static_initializer = false;
+				List<const GDScript *> classes;
+				classes.push_back(script.ptr());
+				while (!classes.is_empty()) {
+					const GDScript *current = classes.front()->get();
+					classes.pop_front();
+					has_static_initializer = has_static_initializer || current->static_initializer != nullptr;
+					for (const KeyValue<StringName, Ref<GDScript>> &E : current->subclasses) {
+						classes.push_back(E.value.ptr());
+					}
+				}
+				err = serialize(script.ptr(), has_static_initializer && !parser.get_tree()->annotated_static_unload, code, &error);
+			}
+
+			{
+				MutexLock lock(GDScriptCache::singleton->mutex);
+				_restore_cache_entry(GDScriptCache::singleton->full_gdscript_cache, p_path, cached_full);
+				_restore_cache_entry(GDScriptCache::singleton->shallow_gdscript_cache, p_path, cached_shallow);
+				_restore_cache_entry(GDScriptCache::singleton->static_gdscript_cache, fqcn, cached_static);
+				if (cached_dependencies.is_empty()) {
+					GDScriptCache::singleton->dependencies.erase(p_path);
+				} else {
+					GDScriptCache::singleton->dependencies[p_path] = cached_dependencies;
+				}
+			}
+
+			// The temporary script must not clear its dependencies, as `GDScript::clear()` would.
+			_clear_script(script.ptr());
+		}
+	}
+
+	Vector<uint8_t> buffer;
+	buffer.resize(BYTECODE_HEADER_SIZE);
+	uint8_t *header = buffer.ptrw();
+	header[0] = 'G';
+	header[1] = 'D';
+	header[2] = 'S';
+	header[3] = 'B';
+	encode_uint32(BYTECODE_VERSION, &header[4]);
+	encode_uint32(tokens.size(), &header[8]);
+	buffer.append_array(tokens);
+
+	if (!error.is_empty() || code.is_empty()) {
+		// Still a valid container, only the tokens will be used.
+		if (r_error) {
+			*r_error = error;
+		}
+		return buffer;
+	}
+
+	buffer.append_array(code);
+	return buffer;
+}
+
+void GDScriptBytecode::_restore_cache_entry(HashMap<String, Ref<GDScript>> &r_cache, const String &p_key, const Ref<GDScript> &p_script) {
+	if (p_script.is_valid()) {
+		r_cache[p_key] = p_script;
+	} else {
+		r_cache.erase(p_key);
+	}
+}
+
+void GDScriptBytecode::_clear_script(GDScript *p_script) {
+	for (KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		_clear_script(E.value.ptr());
+		E.value->_owner = nullptr;
+	}
+	p_script->subclasses.clear();
+	_clear_class(p_script);
+	p_script->valid = false;
+}
+
+#endif // TOOLS_ENABLED
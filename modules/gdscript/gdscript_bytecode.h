@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*  gdscript_bytecode.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_H
+#define GDSCRIPT_BYTECODE_H
+
+#include "gdscript.h"
+#include "gdscript_tokenizer_buffer.h"
+
+// Container for exported scripts holding the compiled bytecode of all classes in a file next to the binary tokens.
+// The tokens are kept so that the analyzer of other scripts can still read the interface, and as a fallback
+// when the bytecode was made by a different engine version.
+class GDScriptBytecode {
+	struct LoadContext;
+
+	static Error _read_header(LoadContext &r_ctx);
+	static void _make_class(LoadContext &r_ctx, GDScript *p_script, const StringName &p_local_name);
+	static void _clear_class(GDScript *p_script);
+	static void _load_class(LoadContext &r_ctx, GDScript *p_script);
+	static void _load_member_info(LoadContext &r_ctx, HashMap<StringName, GDScript::MemberInfo> &r_members);
+	static GDScriptFunction *_load_function(LoadContext &r_ctx, GDScript *p_script, bool p_is_lambda);
+	static void _update_function_pointers(GDScriptFunction *p_function);
+	static void _load_data_type(LoadContext &r_ctx, GDScriptDataType &r_type);
+	static Ref<Resource> _load_resource_ref(LoadContext &r_ctx);
+	static Variant _load_variant(LoadContext &r_ctx);
+	static PropertyInfo _load_property_info(LoadContext &r_ctx);
+	static MethodInfo _load_method_info(LoadContext &r_ctx);
+
+#ifdef TOOLS_ENABLED
+	struct SaveContext;
+
+	static void _save_class_tree(SaveContext &r_ctx, const GDScript *p_script);
+	static void _save_class(SaveContext &r_ctx, const GDScript *p_script);
+	static void _save_member_info(SaveContext &r_ctx, const HashMap<StringName, GDScript::MemberInfo> &p_members);
+	static void _save_function(SaveContext &r_ctx, const GDScriptFunction *p_function);
+	static void _save_data_type(SaveContext &r_ctx, const GDScriptDataType &p_type);
+	static void _save_resource_ref(SaveContext &r_ctx, const Object *p_object);
+	static void _save_variant(SaveContext &r_ctx, const Variant &p_value);
+	static void _save_property_info(SaveContext &r_ctx, const PropertyInfo &p_info);
+	static void _save_method_info(SaveContext &r_ctx, const MethodInfo &p_info);
+	static void _restore_cache_entry(HashMap<String, Ref<GDScript>> &r_cache, const String &p_key, const Ref<GDScript> &p_script);
+	static void _clear_script(GDScript *p_script);
+#endif
+
+public:
+	enum {
+		BYTECODE_VERSION = 2,
+	};
+
+	static bool is_bytecode_buffer(const Vector<uint8_t> &p_buffer);
+	static Vector<uint8_t> get_binary_tokens(const Vector<uint8_t> &p_buffer);
+	static Vector<uint8_t> get_compiled_code(const Vector<uint8_t> &p_buffer);
+
+	// Creates the inner classes without loading anything else, like `GDScriptCompiler::make_scripts()`.
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_code);
+	// Loads the compiled classes into the script, replacing parsing, analysis and compilation.
+	static Error load(GDScript *p_script, const Vector<uint8_t> &p_code, String *r_error = nullptr);
+
+#ifdef TOOLS_ENABLED
+	// Compiles the source and returns a buffer with both the tokens and the bytecode. Only the tokens are
+	// returned if the script can't be represented as bytecode, so the result can always be exported.
+	static Vector<uint8_t> compile_code_string(const String &p_code, const String &p_path, GDScriptTokenizerBuffer::CompressMode p_compress_mode, String *r_error = nullptr);
+	static Error serialize(const GDScript *p_script, bool p_keep_static_data, Vector<uint8_t> &r_code, String *r_error = nullptr);
+#endif
+};
+
+#endif // GDSCRIPT_BYTECODE_H
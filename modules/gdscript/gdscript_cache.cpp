@@ -32,10 +32,13 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/vector.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
@@ -273,7 +276,7 @@ String GDScriptCache::get_source_code(const String &p_path) {
 	return source;
 }
 
-Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
+Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path, Vector<uint8_t> *r_bytecode) {
 	Vector<uint8_t> buffer;
 	Error err = OK;
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
@@ -284,6 +287,13 @@ Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
 	uint64_t read = f->get_buffer(buffer.ptrw(), buffer.size());
 	ERR_FAIL_COND_V_MSG(read != len, Vector<uint8_t>(), "Failed to read binary GDScript file '" + p_path + "'.");
 
+	if (GDScriptBytecode::is_bytecode_buffer(buffer)) {
+		if (r_bytecode) {
+			*r_bytecode = GDScriptBytecode::get_compiled_code(buffer);
+		}
+		return GDScriptBytecode::get_binary_tokens(buffer);
+	}
+
 	return buffer;
 }
 
@@ -305,11 +315,13 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 	script.instantiate();
 	script->set_path(p_path, true);
 	if (remapped_path.get_extension().to_lower() == "gdc") {
-		Vector<uint8_t> buffer = get_binary_tokens(remapped_path);
+		Vector<uint8_t> bytecode;
+		Vector<uint8_t> buffer = get_binary_tokens(remapped_path, &bytecode);
 		if (buffer.is_empty()) {
 			r_error = ERR_FILE_CANT_READ;
 		}
 		script->set_binary_tokens_source(buffer);
+		script->set_bytecode_source(bytecode);
 	} else {
 		r_error = script->load_source_code(remapped_path);
 	}
@@ -318,6 +330,13 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
+	if (!script->get_bytecode_source().is_empty() && GDScriptBytecode::make_scripts(script.ptr(), script->get_bytecode_source()) == OK) {
+		// Inner classes come from the bytecode, no need to parse.
+		singleton->shallow_gdscript_cache[p_path] = script;
+		return script;
+	}
+	script->set_bytecode_source(Vector<uint8_t>());
+
 	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
 	if (r_error == OK) {
 		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
@@ -353,12 +372,14 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 
 	if (p_update_from_disk) {
 		if (p_path.get_extension().to_lower() == "gdc") {
-			Vector<uint8_t> buffer = get_binary_tokens(p_path);
+			Vector<uint8_t> bytecode;
+			Vector<uint8_t> buffer = get_binary_tokens(p_path, &bytecode);
 			if (buffer.is_empty()) {
 				r_error = ERR_FILE_CANT_READ;
 				return script;
 			}
 			script->set_binary_tokens_source(buffer);
+			script->set_bytecode_source(bytecode);
 		} else {
 			r_error = script->load_source_code(p_path);
 			if (r_error) {
@@ -396,6 +417,174 @@ Ref<GDScript> GDScriptCache::get_cached_script(const String &p_path) {
 	return Ref<GDScript>();
 }
 
+static void _add_dependency_path(const String &p_path, const String &p_base_dir, Vector<String> &r_paths) {
+	String path = p_path.is_relative_path() ? p_base_dir.path_join(p_path) : p_path;
+	path = path.simplify_path();
+	if (path.get_extension().to_lower() == "gd") {
+		r_paths.push_back(path);
+	}
+}
+
+// Global classes can be implemented in other languages, only GDScript files can be parsed.
+static void _add_global_class_dependency(const StringName &p_class, Vector<String> &r_paths) {
+	if (!ScriptServer::is_global_class(p_class) || ScriptServer::get_global_class_language(p_class) != GDScriptLanguage::get_singleton()->get_name()) {
+		return;
+	}
+	_add_dependency_path(ScriptServer::get_global_class_path(p_class), String(), r_paths);
+}
+
+static void _collect_type_dependencies(const GDScriptParser::TypeNode *p_type, Vector<String> &r_paths) {
+	if (p_type == nullptr) {
+		return;
+	}
+	if (!p_type->type_chain.is_empty()) {
+		_add_global_class_dependency(p_type->type_chain[0]->name, r_paths);
+	}
+	for (const GDScriptParser::TypeNode *container_type : p_type->container_types) {
+		_collect_type_dependencies(container_type, r_paths);
+	}
+}
+
+static void _collect_assignable_dependencies(const GDScriptParser::AssignableNode *p_assignable, const String &p_base_dir, Vector<String> &r_paths) {
+	_collect_type_dependencies(p_assignable->datatype_specifier, r_paths);
+
+	const GDScriptParser::ExpressionNode *initializer = p_assignable->initializer;
+	if (initializer != nullptr && initializer->type == GDScriptParser::Node::PRELOAD) {
+		const GDScriptParser::ExpressionNode *path = static_cast<const GDScriptParser::PreloadNode *>(initializer)->path;
+		if (path != nullptr && path->type == GDScriptParser::Node::LITERAL) {
+			const Variant &value = static_cast<const GDScriptParser::LiteralNode *>(path)->value;
+			if (value.get_type() == Variant::STRING) {
+				_add_dependency_path(value, p_base_dir, r_paths);
+			}
+		}
+	}
+}
+
+// Only looks at the class interfaces, which is what the analyzer needs from other scripts first.
+// Anything missed here is still parsed on demand.
+static void _collect_class_dependencies(const GDScriptParser::ClassNode *p_class, const String &p_base_dir, Vector<String> &r_paths) {
+	if (!p_class->extends_path.is_empty()) {
+		_add_dependency_path(p_class->extends_path, p_base_dir, r_paths);
+	} else if (!p_class->extends.is_empty()) {
+		_add_global_class_dependency(p_class->extends[0]->name, r_paths);
+	}
+
+	for (const GDScriptParser::ClassNode::Member &member : p_class->members) {
+		switch (member.type) {
+			case GDScriptParser::ClassNode::Member::CLASS: {
+				_collect_class_dependencies(member.m_class, p_base_dir, r_paths);
+			} break;
+			case GDScriptParser::ClassNode::Member::CONSTANT: {
+				_collect_assignable_dependencies(member.constant, p_base_dir, r_paths);
+			} break;
+			case GDScriptParser::ClassNode::Member::VARIABLE: {
+				_collect_assignable_dependencies(member.variable, p_base_dir, r_paths);
+			} break;
+			case GDScriptParser::ClassNode::Member::FUNCTION: {
+				for (const GDScriptParser::ParameterNode *parameter : member.function->parameters) {
+					_collect_assignable_dependencies(parameter, p_base_dir, r_paths);
+				}
+				_collect_type_dependencies(member.function->return_type, r_paths);
+			} break;
+			case GDScriptParser::ClassNode::Member::SIGNAL: {
+				for (const GDScriptParser::ParameterNode *parameter : member.signal->parameters) {
+					_collect_assignable_dependencies(parameter, p_base_dir, r_paths);
+				}
+			} break;
+			default: {
+			} break;
+		}
+	}
+}
+
+static void _warm_up_parse(void *p_userdata, uint32_t p_index) {
+	LocalVector<Ref<GDScriptParserRef>> &parser_refs = *static_cast<LocalVector<Ref<GDScriptParserRef>> *>(p_userdata);
+	parser_refs[p_index]->raise_status(GDScriptParserRef::PARSED);
+}
+
+// Parses the scripts and what they depend on ahead of time, one dependency level at a time. Parsing is done
+// on worker threads outside of the cache lock, the results are only added to the cache afterwards, so the
+// (ordered) analysis and compilation that follows finds them already parsed. The returned references have
+// to be kept until then.
+Vector<Ref<GDScriptParserRef>> GDScriptCache::warm_up(const Vector<String> &p_paths) {
+	Vector<Ref<GDScriptParserRef>> warm_parsers;
+	if (singleton == nullptr || WorkerThreadPool::get_singleton() == nullptr) {
+		return warm_parsers;
+	}
+
+	{
+		// Lazily initialized static data, make sure it's not done by several threads at once.
+		GDScriptParser parser;
+		GDScriptParser::get_builtin_type(StringName());
+	}
+
+	HashSet<String> visited;
+	Vector<String> paths = p_paths;
+
+	while (!paths.is_empty()) {
+		LocalVector<Ref<GDScriptParserRef>> parser_refs;
+		{
+			MutexLock lock(singleton->mutex);
+			if (singleton->cleared) {
+				break;
+			}
+			for (const String &path : paths) {
+				if (visited.has(path)) {
+					continue;
+				}
+				visited.insert(path);
+				if (singleton->parser_map.has(path) || !FileAccess::exists(ResourceLoader::path_remap(path))) {
+					continue;
+				}
+				Ref<GDScriptParserRef> parser_ref;
+				parser_ref.instantiate();
+				parser_ref->path = path;
+				parser_ref->abandoned = true; // Not in `parser_map` yet.
+				parser_ref->get_parser();
+				parser_refs.push_back(parser_ref);
+			}
+		}
+
+		if (parser_refs.is_empty()) {
+			break;
+		}
+
+		if (parser_refs.size() == 1) {
+			_warm_up_parse(&parser_refs, 0);
+		} else {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_warm_up_parse, &parser_refs, parser_refs.size(), -1, true, SNAME("GDScriptParse"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
+
+		paths.clear();
+
+		MutexLock lock(singleton->mutex);
+		if (singleton->cleared) {
+			break;
+		}
+		for (const Ref<GDScriptParserRef> &parser_ref : parser_refs) {
+			if (singleton->parser_map.has(parser_ref->path)) {
+				continue; // Parsed by someone else in the meantime.
+			}
+			parser_ref->abandoned = false;
+			singleton->parser_map[parser_ref->path] = parser_ref.ptr();
+			warm_parsers.push_back(parser_ref);
+
+			if (parser_ref->result == OK) {
+				_collect_class_dependencies(parser_ref->parser->get_tree(), parser_ref->path.get_base_dir(), paths);
+			}
+		}
+	}
+
+	return warm_parsers;
+}
+
+Vector<Ref<GDScriptParserRef>> GDScriptCache::warm_up_dependencies(const GDScriptParser *p_parser, const String &p_path) {
+	Vector<String> paths;
+	_collect_class_dependencies(p_parser->get_tree(), p_path.get_base_dir(), paths);
+	return warm_up(paths);
+}
+
 Error GDScriptCache::finish_compiling(const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 
@@ -88,6 +88,7 @@ class GDScriptCache {
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
 
 	friend class GDScript;
+	friend class GDScriptBytecode;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
 
@@ -104,10 +105,12 @@ public:
 	static bool has_parser(const String &p_path);
 	static void remove_parser(const String &p_path);
 	static String get_source_code(const String &p_path);
-	static Vector<uint8_t> get_binary_tokens(const String &p_path);
+	static Vector<uint8_t> get_binary_tokens(const String &p_path, Vector<uint8_t> *r_bytecode = nullptr);
 	static Ref<GDScript> get_shallow_script(const String &p_path, Error &r_error, const String &p_owner = String());
 	static Ref<GDScript> get_full_script(const String &p_path, Error &r_error, const String &p_owner = String(), bool p_update_from_disk = false);
 	static Ref<GDScript> get_cached_script(const String &p_path);
+	static Vector<Ref<GDScriptParserRef>> warm_up(const Vector<String> &p_paths);
+	static Vector<Ref<GDScriptParserRef>> warm_up_dependencies(const GDScriptParser *p_parser, const String &p_path);
 	static Error finish_compiling(const String &p_owner);
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
@@ -2674,6 +2674,7 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 	p_script->member_functions.clear();
 	p_script->member_indices.clear();
 	p_script->static_variables_indices.clear();
+	GDScriptFunction::_invalidate_inline_caches(); // They may point into the member infos.
 	p_script->static_variables.clear();
 	p_script->_signals.clear();
 	p_script->initializer = nullptr;
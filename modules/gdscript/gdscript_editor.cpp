@@ -3143,6 +3143,20 @@ static void _find_call_arguments(GDScriptParser::CompletionContext &p_context, c
 	r_forced = r_result.size() > 0;
 }
 
+static void _find_skippable_function_bodies(const GDScriptParser::ClassNode *p_class, int p_line, HashSet<const GDScriptParser::FunctionNode *> &r_functions) {
+	for (const GDScriptParser::ClassNode::Member &member : p_class->members) {
+		if (member.type == GDScriptParser::ClassNode::Member::CLASS) {
+			_find_skippable_function_bodies(member.m_class, p_line, r_functions);
+		} else if (member.type == GDScriptParser::ClassNode::Member::FUNCTION) {
+			const GDScriptParser::FunctionNode *function = member.function;
+			// Functions without a declared return type can be guessed from their body.
+			if (function->return_type != nullptr && (p_line < function->start_line || p_line > function->end_line)) {
+				r_functions.insert(function);
+			}
+		}
+	}
+}
+
 ::Error GDScriptLanguage::complete_code(const String &p_code, const String &p_path, Object *p_owner, List<ScriptLanguage::CodeCompletionOption> *r_options, bool &r_forced, String &r_call_hint) {
 	const String quote_style = EDITOR_GET("text_editor/completion/use_single_quotes") ? "'" : "\"";
 
@@ -3150,6 +3164,13 @@ static void _find_call_arguments(GDScriptParser::CompletionContext &p_context, c
 	GDScriptAnalyzer analyzer(&parser);
 
 	parser.parse(p_code, p_path, true);
+
+	// Only the body of the function being completed matters, the others are only needed through their signatures.
+	HashSet<const GDScriptParser::FunctionNode *> skipped_functions;
+	if (parser.get_tree() != nullptr) {
+		_find_skippable_function_bodies(parser.get_tree(), parser.get_completion_context().current_line, skipped_functions);
+	}
+	analyzer.set_skipped_function_bodies(skipped_functions);
 	analyzer.analyze();
 
 	r_forced = false;
@@ -32,16 +32,262 @@
 
 #include "gdscript.h"
 
+#include "core/core_string_names.h"
+#include "scene/scene_string_names.h"
+
+SafeNumeric<uint32_t> GDScriptFunction::inline_cache_epoch;
+
+// Only taken when publishing entries.
+static Mutex inline_cache_mutex;
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
 }
 
+void GDScriptFunction::_allocate_inline_caches(int p_count) {
+	ERR_FAIL_COND(_inline_caches != nullptr);
+	_inline_cache_count = p_count;
+	if (p_count > 0) {
+		_inline_caches = memnew_arr(InlineCache, p_count);
+	}
+}
+
+// True if the instance itself may handle the property, which means the native one can't be cached.
+bool GDScriptFunction::_script_may_handle_property(const GDScript *p_script, const StringName &p_name) {
+	const StringName &get_name = GDScriptLanguage::get_singleton()->strings._get;
+	const StringName &set_name = GDScriptLanguage::get_singleton()->strings._set;
+	for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+		if (sptr->member_indices.has(p_name) || sptr->constants.has(p_name) || sptr->static_variables_indices.has(p_name) || sptr->_signals.has(p_name) || sptr->subclasses.has(p_name)) {
+			return true;
+		}
+		if (sptr->member_functions.has(p_name) || sptr->member_functions.has(get_name) || sptr->member_functions.has(set_name)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Same lookups as `ClassDB::get_property()` and `ClassDB::set_property()`, properties with an index are not cached.
+static MethodBind *_get_native_property_getter(const ClassDB::ClassInfo *p_class, const StringName &p_name) {
+	for (const ClassDB::ClassInfo *check = p_class; check; check = check->inherits_ptr) {
+		const ClassDB::PropertySetGet *psg = check->property_setget.getptr(p_name);
+		if (psg) {
+			return psg->index < 0 ? psg->_getptr : nullptr;
+		}
+		if (check->constant_map.has(p_name) || check->method_map.has(p_name) || check->signal_map.has(p_name)) {
+			return nullptr;
+		}
+	}
+	return nullptr;
+}
+
+static MethodBind *_get_native_property_setter(const ClassDB::ClassInfo *p_class, const StringName &p_name) {
+	for (const ClassDB::ClassInfo *check = p_class; check; check = check->inherits_ptr) {
+		const ClassDB::PropertySetGet *psg = check->property_setget.getptr(p_name);
+		if (psg) {
+			return psg->index < 0 ? psg->_setptr : nullptr;
+		}
+	}
+	return nullptr;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_inline_cache_update(int p_cache, InlineCacheAccess p_access, const InlineCacheReceiver &p_receiver, const StringName &p_name) {
+	InlineCache &cache = _inline_caches[p_cache];
+	if (cache.failed_updates.get() >= InlineCache::MAX_FAILED_UPDATES) {
+		return nullptr;
+	}
+
+	const InlineCacheEntry *published = _inline_cache_resolve(cache, p_access, p_receiver, p_name);
+	if (published == nullptr) {
+		cache.failed_updates.increment();
+	}
+	return published;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_inline_cache_resolve(InlineCache &r_cache, InlineCacheAccess p_access, const InlineCacheReceiver &p_receiver, const StringName &p_name) {
+	InlineCacheEntry entry;
+	entry.epoch = inline_cache_epoch.get();
+	entry.type = p_receiver.type;
+	entry.class_key = p_receiver.class_key;
+	entry.script = p_receiver.script;
+
+	if (p_receiver.type != Variant::OBJECT) {
+		entry.kind = InlineCacheEntry::KIND_BUILTIN_MEMBER;
+		entry.builtin_member_type = Variant::get_member_type(p_receiver.type, p_name);
+		if (p_access == INLINE_CACHE_GET) {
+			entry.getter = Variant::get_member_validated_getter(p_receiver.type, p_name);
+		} else if (p_access == INLINE_CACHE_SET) {
+			entry.setter = Variant::get_member_validated_setter(p_receiver.type, p_name);
+		}
+		if (entry.getter == nullptr && entry.setter == nullptr) {
+			return nullptr;
+		}
+	} else {
+		if (p_name == CoreStringName(free_) || p_name == SceneStringName(_ready)) {
+			return nullptr; // Special cased by `Object::callp()` and `GDScriptInstance::callp()`.
+		}
+#ifdef TOOLS_ENABLED
+		if (p_access == INLINE_CACHE_SET) {
+			return nullptr; // `Object::set()` marks the object as edited.
+		}
+#endif
+
+		if (p_receiver.script) {
+			const GDScript *script = p_receiver.script;
+			if (p_access == INLINE_CACHE_CALL) {
+				for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+					if (likely(sptr->valid)) {
+						GDScriptFunction *const *function = sptr->member_functions.getptr(p_name);
+						if (function) {
+							entry.kind = InlineCacheEntry::KIND_SCRIPT_FUNCTION;
+							entry.function = *function;
+							break;
+						}
+					}
+				}
+			} else {
+				const GDScript::MemberInfo *member = script->member_indices.getptr(p_name);
+				if (member) {
+					const StringName &accessor = p_access == INLINE_CACHE_GET ? member->getter : member->setter;
+					if (accessor != StringName()) {
+						return nullptr;
+					}
+					entry.kind = InlineCacheEntry::KIND_SCRIPT_MEMBER;
+					entry.member_index = member->index;
+					entry.member_type = &member->data_type;
+				} else if (_script_may_handle_property(script, p_name)) {
+					return nullptr;
+				}
+			}
+		}
+
+		if (entry.function == nullptr && entry.member_type == nullptr) {
+			// Extension classes handle properties themselves and may be reloaded, so only core classes are cached.
+			const ClassDB::ClassInfo *class_info = ClassDB::classes.getptr(p_receiver.object->get_class_name());
+			if (class_info == nullptr || class_info->gdextension != nullptr) {
+				return nullptr;
+			}
+			entry.kind = InlineCacheEntry::KIND_METHOD_BIND;
+			switch (p_access) {
+				case INLINE_CACHE_CALL: {
+					entry.method = ClassDB::get_method(p_receiver.object->get_class_name(), p_name);
+				} break;
+				case INLINE_CACHE_GET: {
+					entry.method = _get_native_property_getter(class_info, p_name);
+				} break;
+				case INLINE_CACHE_SET: {
+					entry.method = _get_native_property_setter(class_info, p_name);
+				} break;
+			}
+			if (entry.method == nullptr) {
+				return nullptr;
+			}
+		}
+	}
+
+	MutexLock lock(inline_cache_mutex);
+	const InlineCacheEntry *published = nullptr;
+	for (int i = 0; i < InlineCache::MAX_ENTRIES; i++) {
+		const InlineCacheEntry *current = r_cache.entries[i].load(std::memory_order_relaxed);
+		if (current != nullptr && current->epoch == entry.epoch) {
+			continue;
+		}
+		// Stale entries may still be in use by other calls of this function, they are freed below once it's safe.
+		if (current != nullptr) {
+			retired_inline_cache_entries.push_back(current);
+		}
+		published = memnew(InlineCacheEntry(entry));
+		r_cache.entries[i].store(published, std::memory_order_release);
+		break;
+	}
+
+	if (published == nullptr) {
+		r_cache.failed_updates.set(InlineCache::MAX_FAILED_UPDATES);
+	}
+
+	// Entries are only read by running calls of this function, between the lookup and the call it dispatches.
+	// When the caller is the only running call (it holds no entry while resolving), nothing can read retired
+	// entries anymore: they were unpublished above, or by an earlier resolve.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (!retired_inline_cache_entries.is_empty() && running_calls.get() == 1) {
+		for (const InlineCacheEntry *retired : retired_inline_cache_entries) {
+			memdelete(const_cast<InlineCacheEntry *>(retired));
+		}
+		retired_inline_cache_entries.clear();
+	}
+
+	return published;
+}
+
 StringName GDScriptFunction::get_global_name(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, global_names.size(), "<errgname>");
 	return global_names[p_idx];
 }
 
+SpinLock GDScriptFunction::frame_pool_lock;
+uint8_t *GDScriptFunction::frame_pool[FRAME_POOL_CLASSES] = {};
+int GDScriptFunction::frame_pool_free[FRAME_POOL_CLASSES] = {};
+SafeNumeric<uint64_t> GDScriptFunction::frame_allocations;
+
+int GDScriptFunction::_get_frame_class(uint32_t p_size, uint32_t &r_capacity) {
+	r_capacity = MAX(next_power_of_2(p_size), 1u << FRAME_POOL_MIN_SHIFT);
+	return get_shift_from_power_of_2(r_capacity) - FRAME_POOL_MIN_SHIFT;
+}
+
+uint8_t *GDScriptFunction::_alloc_frame(uint32_t p_size) {
+	uint32_t capacity = 0;
+	const int frame_class = _get_frame_class(p_size, capacity);
+	if (frame_class < FRAME_POOL_CLASSES) {
+		frame_pool_lock.lock();
+		uint8_t *frame = frame_pool[frame_class];
+		if (frame) {
+			// Free frames store the next one in their first bytes.
+			frame_pool[frame_class] = *(uint8_t **)frame;
+			frame_pool_free[frame_class]--;
+		}
+		frame_pool_lock.unlock();
+		if (frame) {
+			return frame;
+		}
+	}
+
+	frame_allocations.increment();
+	return (uint8_t *)Memory::alloc_static(capacity);
+}
+
+void GDScriptFunction::_free_frame(uint8_t *p_frame, uint32_t p_size) {
+	uint32_t capacity = 0;
+	const int frame_class = _get_frame_class(p_size, capacity);
+	if (frame_class < FRAME_POOL_CLASSES) {
+		frame_pool_lock.lock();
+		if (frame_pool_free[frame_class] < FRAME_POOL_MAX_FREE) {
+			*(uint8_t **)p_frame = frame_pool[frame_class];
+			frame_pool[frame_class] = p_frame;
+			frame_pool_free[frame_class]++;
+			p_frame = nullptr;
+		}
+		frame_pool_lock.unlock();
+	}
+
+	if (p_frame) {
+		Memory::free_static(p_frame);
+	}
+}
+
+void GDScriptFunction::clear_frame_pool() {
+	frame_pool_lock.lock();
+	for (int i = 0; i < FRAME_POOL_CLASSES; i++) {
+		while (frame_pool[i]) {
+			uint8_t *frame = frame_pool[i];
+			frame_pool[i] = *(uint8_t **)frame;
+			Memory::free_static(frame);
+		}
+		frame_pool_free[i] = 0;
+	}
+	frame_pool_lock.unlock();
+}
+
 struct _GDFKC {
 	int order = 0;
 	List<int> pos;
@@ -116,6 +362,22 @@ GDScriptFunction::GDScriptFunction() {
 
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
+	_invalidate_inline_caches();
+
+	for (int i = 0; i < _inline_cache_count; i++) {
+		for (int j = 0; j < InlineCache::MAX_ENTRIES; j++) {
+			const InlineCacheEntry *entry = _inline_caches[i].entries[j].load(std::memory_order_relaxed);
+			if (entry != nullptr) {
+				memdelete(const_cast<InlineCacheEntry *>(entry));
+			}
+		}
+	}
+	for (const InlineCacheEntry *entry : retired_inline_cache_entries) {
+		memdelete(const_cast<InlineCacheEntry *>(entry));
+	}
+	if (_inline_caches) {
+		memdelete_arr(_inline_caches);
+	}
 
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
@@ -126,6 +388,12 @@ GDScriptFunction::~GDScriptFunction() {
 	}
 	return_type.script_type_ref = Ref<Script>();
 
+#ifdef GDSCRIPT_JIT_ENABLED
+	if (jit_code) {
+		GDScriptJIT::free_code(jit_code);
+	}
+#endif
+
 #ifdef DEBUG_ENABLED
 	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 	GDScriptLanguage::get_singleton()->function_list.remove(&function_list);
@@ -241,9 +509,10 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 		if (EngineDebugger::is_active()) {
 			GDScriptLanguage::get_singleton()->exit_function();
 		}
+#endif
 
+		// Release builds already freed the stack when returning, only the frame is left.
 		_clear_stack();
-#endif
 	}
 
 	return ret;
@@ -251,13 +520,17 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// The first 3 are special addresses and not copied to the state, so we skip them here.
 		for (int i = 3; i < state.stack_size; i++) {
 			stack[i].~Variant();
 		}
 		state.stack_size = 0;
 	}
+	if (state.stack) {
+		GDScriptFunction::_free_frame(state.stack, state.alloca_size);
+		state.stack = nullptr;
+	}
 }
 
 void GDScriptFunctionState::_clear_connections() {
@@ -288,4 +561,5 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+	_clear_stack();
 }
@@ -31,13 +31,17 @@
 #ifndef GDSCRIPT_FUNCTION_H
 #define GDSCRIPT_FUNCTION_H
 
+#include "gdscript_jit.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
@@ -218,6 +222,11 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
+		OPCODE_OPERATOR_INT,
+		OPCODE_OPERATOR_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_FLOAT,
+		OPCODE_OPERATOR_FLOAT_JUMP_IF_NOT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_NATIVE,
@@ -401,7 +410,13 @@ private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptBytecode;
 	friend class GDScriptLanguage;
+	friend class GDScriptFunctionState;
+#ifdef GDSCRIPT_JIT_ENABLED
+	friend class GDScriptJIT;
+	friend class GDScriptJITTranslator;
+#endif
 
 	StringName name;
 	StringName source;
@@ -440,6 +455,11 @@ private:
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
 
+#ifdef TOOLS_ENABLED
+	// Positions of global array indices in the code, which are replaced by name in exported bytecode.
+	Vector<int> global_index_positions;
+#endif
+
 	int _code_size = 0;
 	int _default_arg_count = 0;
 	int _constant_count = 0;
@@ -509,9 +529,98 @@ private:
 	} profile;
 #endif
 
+#ifdef GDSCRIPT_JIT_ENABLED
+	// Hotness counters, `jit_code` is only read once `jit_ready` is set.
+	SafeNumeric<uint32_t> jit_call_count;
+	SafeNumeric<uint32_t> jit_loop_count;
+	SafeFlag jit_attempted;
+	SafeFlag jit_ready;
+	GDScriptJIT::Code *jit_code = nullptr;
+#endif
+
+	// Inline caches of the untyped `OPCODE_GET_NAMED`, `OPCODE_SET_NAMED` and `OPCODE_CALL*` instructions,
+	// keyed on the receiver. Entries are never modified once published, so the VM reads them without locking.
+	struct InlineCacheEntry {
+		enum Kind {
+			KIND_SCRIPT_FUNCTION,
+			KIND_SCRIPT_MEMBER,
+			KIND_METHOD_BIND,
+			KIND_BUILTIN_MEMBER,
+		};
+
+		Kind kind = KIND_METHOD_BIND;
+		uint32_t epoch = 0;
+
+		// Receiver.
+		Variant::Type type = Variant::NIL;
+		const void *class_key = nullptr; // Native class name, see `StringName::data_unique_pointer()`.
+		const GDScript *script = nullptr;
+
+		GDScriptFunction *function = nullptr;
+		MethodBind *method = nullptr; // Method, or property getter or setter.
+		int member_index = -1;
+		const GDScriptDataType *member_type = nullptr;
+		Variant::Type builtin_member_type = Variant::NIL;
+		Variant::ValidatedGetter getter = nullptr;
+		Variant::ValidatedSetter setter = nullptr;
+	};
+
+	struct InlineCache {
+		static constexpr int MAX_ENTRIES = 4;
+		static constexpr uint32_t MAX_FAILED_UPDATES = 16; // Megamorphic or uncacheable, stop trying.
+		std::atomic<const InlineCacheEntry *> entries[MAX_ENTRIES] = {};
+		SafeNumeric<uint32_t> failed_updates;
+	};
+
+	struct InlineCacheReceiver {
+		Variant::Type type = Variant::NIL;
+		const void *class_key = nullptr;
+		const GDScript *script = nullptr;
+		Object *object = nullptr;
+		GDScriptInstance *instance = nullptr;
+	};
+
+	enum InlineCacheAccess {
+		INLINE_CACHE_CALL,
+		INLINE_CACHE_GET,
+		INLINE_CACHE_SET,
+	};
+
+	// Bumped whenever cached functions or member layouts may go away, which makes all entries stale.
+	static SafeNumeric<uint32_t> inline_cache_epoch;
+
+	int _inline_cache_count = 0;
+	InlineCache *_inline_caches = nullptr;
+	LocalVector<const InlineCacheEntry *> retired_inline_cache_entries; // Stale entries other calls may still be reading.
+	SafeNumeric<uint32_t> running_calls; // Calls of this function currently executing, on any thread.
+
+	static void _invalidate_inline_caches() { inline_cache_epoch.increment(); }
+	static bool _script_may_handle_property(const GDScript *p_script, const StringName &p_name);
+	void _allocate_inline_caches(int p_count);
+	const InlineCacheEntry *_inline_cache_resolve(InlineCache &r_cache, InlineCacheAccess p_access, const InlineCacheReceiver &p_receiver, const StringName &p_name);
+	const InlineCacheEntry *_inline_cache_update(int p_cache, InlineCacheAccess p_access, const InlineCacheReceiver &p_receiver, const StringName &p_name);
+	_FORCE_INLINE_ static bool _get_inline_cache_receiver(const Variant *p_base, InlineCacheReceiver &r_receiver);
+	_FORCE_INLINE_ const InlineCacheEntry *_inline_cache_find(int p_cache, const InlineCacheReceiver &p_receiver) const;
+	bool _inline_cache_call(int p_cache, const Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+	bool _inline_cache_get(int p_cache, const Variant *p_base, const StringName &p_name, Variant *r_value);
+	bool _inline_cache_set(int p_cache, Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid);
+
 	_FORCE_INLINE_ String _get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
+	// Heap frames of awaiting functions are recycled, by power of two size classes.
+	static constexpr int FRAME_POOL_MIN_SHIFT = 8;
+	static constexpr int FRAME_POOL_CLASSES = 12;
+	static constexpr int FRAME_POOL_MAX_FREE = 64;
+	static SpinLock frame_pool_lock;
+	static uint8_t *frame_pool[FRAME_POOL_CLASSES];
+	static int frame_pool_free[FRAME_POOL_CLASSES];
+	static SafeNumeric<uint64_t> frame_allocations;
+
+	static int _get_frame_class(uint32_t p_size, uint32_t &r_capacity);
+	static uint8_t *_alloc_frame(uint32_t p_size);
+	static void _free_frame(uint8_t *p_frame, uint32_t p_size);
+
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
 
@@ -522,7 +631,7 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		uint8_t *stack = nullptr; // Frame from `_alloc_frame()`, owned by the state.
 		int stack_size = 0;
 		uint32_t alloca_size = 0;
 		int ip = 0;
@@ -551,6 +660,10 @@ public:
 	void disassemble(const Vector<String> &p_code_lines) const;
 #endif
 
+	// Number of frames allocated from the heap for `await` instead of being reused.
+	static uint64_t get_frame_allocation_count() { return frame_allocations.get(); }
+	static void clear_frame_pool();
+
 	GDScriptFunction();
 	~GDScriptFunction();
 };
@@ -0,0 +1,1113 @@
+/**************************************************************************/
+/*  gdscript_jit.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_jit.h"
+
+#ifdef GDSCRIPT_JIT_ENABLED
+
+#include "gdscript.h"
+#include "gdscript_function.h"
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/variant/variant_internal.h"
+
+#include <sys/mman.h>
+
+// Runtime helpers called from generated code for the instructions that need more than a single call.
+// They do the same as the VM, the ones returning `false` make the code exit so the VM reports the error.
+
+static void _jit_assign(Variant *p_dst, const Variant *p_src) {
+	*p_dst = *p_src;
+}
+
+static void _jit_assign_null(Variant *p_dst) {
+	*p_dst = Variant();
+}
+
+static void _jit_assign_true(Variant *p_dst) {
+	*p_dst = true;
+}
+
+static void _jit_assign_false(Variant *p_dst) {
+	*p_dst = false;
+}
+
+static bool _jit_assign_typed_builtin(Variant *p_dst, const Variant *p_src, int p_type) {
+	if (p_src->get_type() != p_type) {
+		return false; // Conversion is left to the VM.
+	}
+	*p_dst = *p_src;
+	return true;
+}
+
+static bool _jit_booleanize(const Variant *p_value) {
+	return p_value->booleanize();
+}
+
+static bool _jit_get_keyed(Variant::ValidatedKeyedGetter p_getter, const Variant *p_src, const Variant *p_key, Variant *p_dst) {
+	// A temporary allows `p_src` and `p_dst` to be the same, and keeps `p_dst` intact when failing.
+	Variant ret;
+	bool valid;
+	p_getter(p_src, p_key, &ret, &valid);
+	if (valid) {
+		*p_dst = ret;
+	}
+	return valid;
+}
+
+static bool _jit_set_keyed(Variant::ValidatedKeyedSetter p_setter, Variant *p_dst, const Variant *p_key, const Variant *p_value) {
+	bool valid;
+	p_setter(p_dst, p_key, p_value, &valid);
+	return valid;
+}
+
+static bool _jit_get_indexed(Variant::ValidatedIndexedGetter p_getter, const Variant *p_src, const Variant *p_index, Variant *p_dst) {
+	bool oob;
+	p_getter(p_src, *VariantInternal::get_int(p_index), p_dst, &oob);
+	return !oob;
+}
+
+static bool _jit_set_indexed(Variant::ValidatedIndexedSetter p_setter, Variant *p_dst, const Variant *p_index, const Variant *p_value) {
+	bool oob;
+	p_setter(p_dst, *VariantInternal::get_int(p_index), p_value, &oob);
+	return !oob;
+}
+
+static bool _jit_iterate_begin_int(Variant *p_counter, const Variant *p_container, Variant *p_iterator) {
+	int64_t size = *VariantInternal::get_int(p_container);
+
+	VariantInternal::initialize(p_counter, Variant::INT);
+	*VariantInternal::get_int(p_counter) = 0;
+
+	if (size > 0) {
+		VariantInternal::initialize(p_iterator, Variant::INT);
+		*VariantInternal::get_int(p_iterator) = 0;
+		return true;
+	}
+	return false;
+}
+
+static bool _jit_iterate_int(Variant *p_counter, const Variant *p_container, Variant *p_iterator) {
+	int64_t size = *VariantInternal::get_int(p_container);
+	int64_t *count = VariantInternal::get_int(p_counter);
+
+	(*count)++;
+
+	if (*count >= size) {
+		return false;
+	}
+	*VariantInternal::get_int(p_iterator) = *count;
+	return true;
+}
+
+template <typename T>
+static void _jit_type_adjust(Variant *p_arg) {
+	VariantTypeAdjust<T>::adjust(p_arg);
+}
+
+static const void *_get_type_adjust_function(int p_opcode) {
+#define TYPE_ADJUST_CASE(m_v_type, m_c_type)          \
+	case GDScriptFunction::OPCODE_TYPE_ADJUST_##m_v_type: \
+		return (const void *)&_jit_type_adjust<m_c_type>;
+
+	switch (p_opcode) {
+		TYPE_ADJUST_CASE(BOOL, bool);
+		TYPE_ADJUST_CASE(INT, int64_t);
+		TYPE_ADJUST_CASE(FLOAT, double);
+		TYPE_ADJUST_CASE(STRING, String);
+		TYPE_ADJUST_CASE(VECTOR2, Vector2);
+		TYPE_ADJUST_CASE(VECTOR2I, Vector2i);
+		TYPE_ADJUST_CASE(RECT2, Rect2);
+		TYPE_ADJUST_CASE(RECT2I, Rect2i);
+		TYPE_ADJUST_CASE(VECTOR3, Vector3);
+		TYPE_ADJUST_CASE(VECTOR3I, Vector3i);
+		TYPE_ADJUST_CASE(TRANSFORM2D, Transform2D);
+		TYPE_ADJUST_CASE(VECTOR4, Vector4);
+		TYPE_ADJUST_CASE(VECTOR4I, Vector4i);
+		TYPE_ADJUST_CASE(PLANE, Plane);
+		TYPE_ADJUST_CASE(QUATERNION, Quaternion);
+		TYPE_ADJUST_CASE(AABB, AABB);
+		TYPE_ADJUST_CASE(BASIS, Basis);
+		TYPE_ADJUST_CASE(TRANSFORM3D, Transform3D);
+		TYPE_ADJUST_CASE(PROJECTION, Projection);
+		TYPE_ADJUST_CASE(COLOR, Color);
+		TYPE_ADJUST_CASE(STRING_NAME, StringName);
+		TYPE_ADJUST_CASE(NODE_PATH, NodePath);
+		TYPE_ADJUST_CASE(RID, RID);
+		TYPE_ADJUST_CASE(OBJECT, Object *);
+		TYPE_ADJUST_CASE(CALLABLE, Callable);
+		TYPE_ADJUST_CASE(SIGNAL, Signal);
+		TYPE_ADJUST_CASE(DICTIONARY, Dictionary);
+		TYPE_ADJUST_CASE(ARRAY, Array);
+		TYPE_ADJUST_CASE(PACKED_BYTE_ARRAY, PackedByteArray);
+		TYPE_ADJUST_CASE(PACKED_INT32_ARRAY, PackedInt32Array);
+		TYPE_ADJUST_CASE(PACKED_INT64_ARRAY, PackedInt64Array);
+		TYPE_ADJUST_CASE(PACKED_FLOAT32_ARRAY, PackedFloat32Array);
+		TYPE_ADJUST_CASE(PACKED_FLOAT64_ARRAY, PackedFloat64Array);
+		TYPE_ADJUST_CASE(PACKED_STRING_ARRAY, PackedStringArray);
+		TYPE_ADJUST_CASE(PACKED_VECTOR2_ARRAY, PackedVector2Array);
+		TYPE_ADJUST_CASE(PACKED_VECTOR3_ARRAY, PackedVector3Array);
+		TYPE_ADJUST_CASE(PACKED_COLOR_ARRAY, PackedColorArray);
+		TYPE_ADJUST_CASE(PACKED_VECTOR4_ARRAY, PackedVector4Array);
+		default:
+			return nullptr;
+	}
+
+#undef TYPE_ADJUST_CASE
+}
+
+// Both assemblers share the same interface and register roles: the entry arguments (stack, members,
+// instruction arguments and line) are kept in callee-saved registers, and up to five call arguments are
+// loaded before each call. Labels are bytecode addresses.
+
+class GDScriptJITAssemblerBase {
+protected:
+	LocalVector<uint8_t> code;
+	HashMap<int, uint32_t> labels;
+
+	struct Patch {
+		uint32_t position = 0;
+		int target = 0; // Bytecode address, or `EPILOGUE`.
+	};
+	LocalVector<Patch> patches;
+
+	const Variant *constants = nullptr;
+
+	void emit8(uint8_t p_value) {
+		code.push_back(p_value);
+	}
+
+	void emit32(uint32_t p_value) {
+		for (int i = 0; i < 4; i++) {
+			code.push_back((p_value >> (i * 8)) & 0xFF);
+		}
+	}
+
+	void emit64(uint64_t p_value) {
+		emit32(p_value & 0xFFFFFFFF);
+		emit32(p_value >> 32);
+	}
+
+	void write32(uint32_t p_position, uint32_t p_value) {
+		for (int i = 0; i < 4; i++) {
+			code[p_position + i] = (p_value >> (i * 8)) & 0xFF;
+		}
+	}
+
+	uint32_t read32(uint32_t p_position) const {
+		return code[p_position] | (code[p_position + 1] << 8) | (code[p_position + 2] << 16) | ((uint32_t)code[p_position + 3] << 24);
+	}
+
+public:
+	static constexpr int EPILOGUE = -1;
+
+	bool is_bound(int p_ip) const {
+		return labels.has(p_ip);
+	}
+
+	void bind(int p_ip) {
+		labels[p_ip] = code.size();
+	}
+
+	uint32_t get_size() const {
+		return code.size();
+	}
+
+	const LocalVector<uint8_t> &get_code() const {
+		return code;
+	}
+
+	explicit GDScriptJITAssemblerBase(const Variant *p_constants) {
+		constants = p_constants;
+	}
+};
+
+#if defined(__x86_64__)
+
+class GDScriptJITAssembler : public GDScriptJITAssemblerBase {
+	enum Register {
+		RAX = 0,
+		RCX = 1,
+		RDX = 2,
+		RBX = 3,
+		RSI = 6,
+		RDI = 7,
+		R8 = 8,
+		R12 = 12,
+		R13 = 13,
+		R14 = 14,
+		R15 = 15,
+	};
+
+	static constexpr Register STACK = RBX;
+	static constexpr Register MEMBERS = R15;
+	static constexpr Register INSTRUCTION_ARGS = R13;
+	static constexpr Register LINE = R14;
+
+	static Register _get_argument_register(int p_arg) {
+		static const Register registers[] = { RDI, RSI, RDX, RCX, R8 };
+		return registers[p_arg];
+	}
+
+	void _rex_w(int p_reg, int p_rm) {
+		emit8(0x48 | ((p_reg >> 3) << 2) | (p_rm >> 3));
+	}
+
+	void _modrm_disp32(int p_reg, int p_base, int32_t p_disp) {
+		emit8(0x80 | ((p_reg & 7) << 3) | (p_base & 7));
+		if ((p_base & 7) == 4) {
+			emit8(0x24); // SIB for RSP/R12 based addressing.
+		}
+		emit32(p_disp);
+	}
+
+	void _lea(Register p_dst, Register p_base, int32_t p_disp) {
+		_rex_w(p_dst, p_base);
+		emit8(0x8D);
+		_modrm_disp32(p_dst, p_base, p_disp);
+	}
+
+	void _mov_imm64(Register p_dst, uint64_t p_value) {
+		_rex_w(0, p_dst);
+		emit8(0xB8 + (p_dst & 7));
+		emit64(p_value);
+	}
+
+	void _mov_imm32(Register p_dst, uint32_t p_value) {
+		if (p_dst >= 8) {
+			emit8(0x41);
+		}
+		emit8(0xB8 + (p_dst & 7));
+		emit32(p_value);
+	}
+
+	void _mov(Register p_dst, Register p_src) {
+		_rex_w(p_src, p_dst);
+		emit8(0x89);
+		emit8(0xC0 | ((p_src & 7) << 3) | (p_dst & 7));
+	}
+
+	void _jump_rel32(int p_target) {
+		Patch patch;
+		patch.position = code.size();
+		patch.target = p_target;
+		patches.push_back(patch);
+		emit32(0);
+	}
+
+public:
+	void prologue() {
+		emit8(0x53); // push rbx
+		emit8(0x41); // push r12, only to keep the stack aligned.
+		emit8(0x54);
+		emit8(0x41); // push r13
+		emit8(0x55);
+		emit8(0x41); // push r14
+		emit8(0x56);
+		emit8(0x41); // push r15
+		emit8(0x57);
+		_mov(STACK, RDI);
+		_mov(MEMBERS, RSI);
+		_mov(INSTRUCTION_ARGS, RDX);
+		_mov(LINE, RCX);
+	}
+
+	void load_address(int p_arg, int p_address) {
+		Register reg = _get_argument_register(p_arg);
+		int index = p_address & GDScriptFunction::ADDR_MASK;
+		switch ((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+			case GDScriptFunction::ADDR_TYPE_STACK: {
+				_lea(reg, STACK, index * sizeof(Variant));
+			} break;
+			case GDScriptFunction::ADDR_TYPE_CONSTANT: {
+				_mov_imm64(reg, (uint64_t)&constants[index]);
+			} break;
+			case GDScriptFunction::ADDR_TYPE_MEMBER: {
+				_lea(reg, MEMBERS, index * sizeof(Variant));
+			} break;
+		}
+	}
+
+	void load_int(int p_arg, int32_t p_value) {
+		_mov_imm32(_get_argument_register(p_arg), p_value);
+	}
+
+	void load_pointer(int p_arg, const void *p_pointer) {
+		_mov_imm64(_get_argument_register(p_arg), (uint64_t)p_pointer);
+	}
+
+	void load_instruction_args(int p_arg) {
+		_mov(_get_argument_register(p_arg), INSTRUCTION_ARGS);
+	}
+
+	void store_instruction_arg(int p_slot, int p_address) {
+		// RDI is free until the arguments of the call are loaded.
+		load_address(0, p_address);
+		_rex_w(RDI, INSTRUCTION_ARGS);
+		emit8(0x89);
+		_modrm_disp32(RDI, INSTRUCTION_ARGS, p_slot * sizeof(Variant *));
+	}
+
+	void call(const void *p_function) {
+		_mov_imm64(RAX, (uint64_t)p_function);
+		emit8(0xFF); // call rax
+		emit8(0xD0);
+	}
+
+	void set_line(int p_line) {
+		emit8(0x41); // mov dword [r14], imm32
+		emit8(0xC7);
+		_modrm_disp32(0, LINE, 0);
+		emit32(p_line);
+	}
+
+	void exit(int p_ip) {
+		_mov_imm32(RAX, p_ip);
+		emit8(0xE9); // jmp epilogue
+		_jump_rel32(EPILOGUE);
+	}
+
+	void jump(int p_target_ip) {
+		emit8(0xE9);
+		_jump_rel32(p_target_ip);
+	}
+
+	// Jumps if the boolean returned by the last call matches.
+	void branch(bool p_if_true, int p_target_ip) {
+		emit8(0x84); // test al, al
+		emit8(0xC0);
+		emit8(0x0F);
+		emit8(p_if_true ? 0x85 : 0x84); // jnz/jz
+		_jump_rel32(p_target_ip);
+	}
+
+	// Exits if the boolean returned by the last call is false.
+	void exit_unless_result(int p_ip) {
+		emit8(0x84); // test al, al
+		emit8(0xC0);
+		emit8(0x0F); // jnz over the exit
+		emit8(0x85);
+		uint32_t skip = code.size();
+		emit32(0);
+		exit(p_ip);
+		write32(skip, code.size() - (skip + 4));
+	}
+
+	void exit_if_no_members(int p_ip) {
+		emit8(0x4D); // test r15, r15
+		emit8(0x85);
+		emit8(0xFF);
+		emit8(0x0F); // jnz over the exit
+		emit8(0x85);
+		uint32_t skip = code.size();
+		emit32(0);
+		exit(p_ip);
+		write32(skip, code.size() - (skip + 4));
+	}
+
+	bool finish() {
+		bind(EPILOGUE);
+		emit8(0x41); // pop r15
+		emit8(0x5F);
+		emit8(0x41); // pop r14
+		emit8(0x5E);
+		emit8(0x41); // pop r13
+		emit8(0x5D);
+		emit8(0x41); // pop r12
+		emit8(0x5C);
+		emit8(0x5B); // pop rbx
+		emit8(0xC3); // ret
+
+		for (const Patch &patch : patches) {
+			const uint32_t *target = labels.getptr(patch.target);
+			ERR_FAIL_NULL_V(target, false);
+			write32(patch.position, *target - (patch.position + 4));
+		}
+		return true;
+	}
+
+	explicit GDScriptJITAssembler(const Variant *p_constants) :
+			GDScriptJITAssemblerBase(p_constants) {}
+};
+
+#elif defined(__aarch64__)
+
+class GDScriptJITAssembler : public GDScriptJITAssemblerBase {
+	static constexpr uint32_t STACK = 19;
+	static constexpr uint32_t MEMBERS = 20;
+	static constexpr uint32_t INSTRUCTION_ARGS = 21;
+	static constexpr uint32_t LINE = 22;
+	static constexpr uint32_t SCRATCH = 9;
+	static constexpr uint32_t CALL_TARGET = 16;
+	static constexpr uint32_t SP = 31;
+
+	enum Condition {
+		COND_EQ = 0,
+		COND_NE = 1,
+	};
+
+	enum PatchKind {
+		PATCH_BRANCH = 0, // imm26.
+		PATCH_CONDITIONAL = 1, // imm19.
+	};
+
+	void _mov_imm64(uint32_t p_dst, uint64_t p_value) {
+		emit32(0xD2800000 | ((p_value & 0xFFFF) << 5) | p_dst); // movz
+		for (uint32_t hw = 1; hw < 4; hw++) {
+			uint64_t chunk = (p_value >> (hw * 16)) & 0xFFFF;
+			if (chunk) {
+				emit32(0xF2800000 | (hw << 21) | (chunk << 5) | p_dst); // movk
+			}
+		}
+	}
+
+	void _mov_imm32(uint32_t p_dst, uint32_t p_value) {
+		emit32(0x52800000 | ((p_value & 0xFFFF) << 5) | p_dst); // movz (32-bit)
+		if (p_value >> 16) {
+			emit32(0x72A00000 | ((p_value >> 16) << 5) | p_dst); // movk lsl 16 (32-bit)
+		}
+	}
+
+	void _mov(uint32_t p_dst, uint32_t p_src) {
+		emit32(0xAA0003E0 | (p_src << 16) | p_dst); // orr
+	}
+
+	void _add_offset(uint32_t p_dst, uint32_t p_base, uint32_t p_offset) {
+		if (p_offset < 4096) {
+			emit32(0x91000000 | (p_offset << 10) | (p_base << 5) | p_dst); // add (immediate)
+		} else {
+			_mov_imm64(SCRATCH, p_offset);
+			emit32(0x8B000000 | (SCRATCH << 16) | (p_base << 5) | p_dst); // add (register)
+		}
+	}
+
+	void _branch_patch(int p_target, PatchKind p_kind) {
+		Patch patch;
+		patch.position = code.size();
+		patch.target = p_target;
+		patches.push_back(patch);
+		patch_kinds.push_back(p_kind);
+	}
+
+	LocalVector<PatchKind> patch_kinds;
+
+public:
+	void prologue() {
+		emit32(0xA9800000 | ((-6 & 0x7F) << 15) | (30 << 10) | (SP << 5) | 29); // stp x29, x30, [sp, #-48]!
+		emit32(0x910003FD); // mov x29, sp
+		emit32(0xA9000000 | (2 << 15) | (MEMBERS << 10) | (SP << 5) | STACK); // stp x19, x20, [sp, #16]
+		emit32(0xA9000000 | (4 << 15) | (LINE << 10) | (SP << 5) | INSTRUCTION_ARGS); // stp x21, x22, [sp, #32]
+		_mov(STACK, 0);
+		_mov(MEMBERS, 1);
+		_mov(INSTRUCTION_ARGS, 2);
+		_mov(LINE, 3);
+	}
+
+	void load_address(int p_arg, int p_address) {
+		uint32_t index = p_address & GDScriptFunction::ADDR_MASK;
+		switch ((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+			case GDScriptFunction::ADDR_TYPE_STACK: {
+				_add_offset(p_arg, STACK, index * sizeof(Variant));
+			} break;
+			case GDScriptFunction::ADDR_TYPE_CONSTANT: {
+				_mov_imm64(p_arg, (uint64_t)&constants[index]);
+			} break;
+			case GDScriptFunction::ADDR_TYPE_MEMBER: {
+				_add_offset(p_arg, MEMBERS, index * sizeof(Variant));
+			} break;
+		}
+	}
+
+	void load_int(int p_arg, int32_t p_value) {
+		_mov_imm32(p_arg, p_value);
+	}
+
+	void load_pointer(int p_arg, const void *p_pointer) {
+		_mov_imm64(p_arg, (uint64_t)p_pointer);
+	}
+
+	void load_instruction_args(int p_arg) {
+		_mov(p_arg, INSTRUCTION_ARGS);
+	}
+
+	void store_instruction_arg(int p_slot, int p_address) {
+		// x0 is free until the arguments of the call are loaded.
+		load_address(0, p_address);
+		emit32(0xF9000000 | (p_slot << 10) | (INSTRUCTION_ARGS << 5) | 0); // str x0, [x21, #slot * 8]
+	}
+
+	void call(const void *p_function) {
+		_mov_imm64(CALL_TARGET, (uint64_t)p_function);
+		emit32(0xD63F0000 | (CALL_TARGET << 5)); // blr x16
+	}
+
+	void set_line(int p_line) {
+		_mov_imm32(SCRATCH, p_line);
+		emit32(0xB9000000 | (LINE << 5) | SCRATCH); // str w9, [x22]
+	}
+
+	void exit(int p_ip) {
+		_mov_imm32(0, p_ip);
+		_branch_patch(EPILOGUE, PATCH_BRANCH);
+		emit32(0x14000000); // b epilogue
+	}
+
+	void jump(int p_target_ip) {
+		_branch_patch(p_target_ip, PATCH_BRANCH);
+		emit32(0x14000000);
+	}
+
+	// Jumps if the boolean returned by the last call matches. Only the low byte of w0 is defined.
+	void branch(bool p_if_true, int p_target_ip) {
+		emit32(0x72001C1F); // tst w0, #0xff
+		_branch_patch(p_target_ip, PATCH_CONDITIONAL);
+		emit32(0x54000000 | (p_if_true ? COND_NE : COND_EQ));
+	}
+
+	// Exits if the boolean returned by the last call is false.
+	void exit_unless_result(int p_ip) {
+		emit32(0x72001C1F); // tst w0, #0xff
+		uint32_t skip = code.size();
+		emit32(0);
+		exit(p_ip);
+		write32(skip, 0x54000000 | (((code.size() - skip) / 4) << 5) | COND_NE); // b.ne over the exit
+	}
+
+	void exit_if_no_members(int p_ip) {
+		uint32_t skip = code.size();
+		emit32(0);
+		exit(p_ip);
+		write32(skip, 0xB5000000 | (((code.size() - skip) / 4) << 5) | MEMBERS); // cbnz x20 over the exit
+	}
+
+	bool finish() {
+		bind(EPILOGUE);
+		emit32(0xA9400000 | (4 << 15) | (LINE << 10) | (SP << 5) | INSTRUCTION_ARGS); // ldp x21, x22, [sp, #32]
+		emit32(0xA9400000 | (2 << 15) | (MEMBERS << 10) | (SP << 5) | STACK); // ldp x19, x20, [sp, #16]
+		emit32(0xA8C00000 | (6 << 15) | (30 << 10) | (SP << 5) | 29); // ldp x29, x30, [sp], #48
+		emit32(0xD65F03C0); // ret
+
+		for (uint32_t i = 0; i < patches.size(); i++) {
+			const uint32_t *target = labels.getptr(patches[i].target);
+			ERR_FAIL_NULL_V(target, false);
+			int32_t offset = ((int32_t)*target - (int32_t)patches[i].position) / 4;
+			uint32_t instruction = read32(patches[i].position);
+			if (patch_kinds[i] == PATCH_BRANCH) {
+				instruction |= offset & 0x3FFFFFF;
+			} else {
+				instruction |= (offset & 0x7FFFF) << 5;
+			}
+			write32(patches[i].position, instruction);
+		}
+		return true;
+	}
+
+	explicit GDScriptJITAssembler(const Variant *p_constants) :
+			GDScriptJITAssemblerBase(p_constants) {}
+};
+
+#endif
+
+// Conditional branches on arm64 reach 1 MiB, keep every function well below that.
+static constexpr uint32_t MAX_CODE_SIZE = 512 * 1024;
+
+class GDScriptJITTranslator {
+	const GDScriptFunction *function = nullptr;
+	GDScriptJITAssembler assembler;
+	List<int> pending;
+	int translated = 0;
+	int member_count = 0;
+
+	bool _has_space(int p_ip, int p_size) const {
+		return p_ip + p_size <= function->_code_size;
+	}
+
+	bool _is_valid_address(int p_address) const {
+		int index = p_address & GDScriptFunction::ADDR_MASK;
+		switch ((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+			case GDScriptFunction::ADDR_TYPE_STACK:
+				return index < function->_stack_size;
+			case GDScriptFunction::ADDR_TYPE_CONSTANT:
+				return index < function->_constant_count;
+			case GDScriptFunction::ADDR_TYPE_MEMBER:
+				// Checked on entry, see `Code::member_count`.
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	bool _are_valid_addresses(int p_ip, int p_from, int p_count) const {
+		for (int i = 0; i < p_count; i++) {
+			if (!_is_valid_address(function->_code_ptr[p_ip + p_from + i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool _is_valid_target(int p_target) const {
+		return p_target >= 0 && p_target < function->_code_size;
+	}
+
+	void _queue(int p_ip) {
+		if (!assembler.is_bound(p_ip)) {
+			pending.push_back(p_ip);
+		}
+	}
+
+	// Translates one instruction, returns the address of the next one or -1 when the block ends.
+	int _translate_instruction(int p_ip);
+
+	// Call-style instructions: arguments go through the instruction argument array, like in the VM.
+	int _translate_call(int p_ip);
+
+public:
+	bool translate() {
+		assembler.prologue();
+
+		for (int ip = 0; ip < function->_code_size; ip++) {
+			// A conservative scan is enough, a false positive only adds a check on entry.
+			int address = function->_code_ptr[ip];
+			if (((address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) == GDScriptFunction::ADDR_TYPE_MEMBER) {
+				member_count = MAX(member_count, (address & GDScriptFunction::ADDR_MASK) + 1);
+			}
+		}
+		if (member_count > 0) {
+			assembler.exit_if_no_members(0);
+		}
+
+		pending.push_back(0);
+		while (!pending.is_empty()) {
+			int ip = pending.front()->get();
+			pending.pop_front();
+
+			while (ip >= 0) {
+				if (assembler.is_bound(ip)) {
+					assembler.jump(ip);
+					break;
+				}
+				assembler.bind(ip);
+				if (!_is_valid_target(ip)) {
+					assembler.exit(ip);
+					break;
+				}
+				ip = _translate_instruction(ip);
+			}
+
+			if (assembler.get_size() > MAX_CODE_SIZE) {
+				return false;
+			}
+		}
+
+		return assembler.finish();
+	}
+
+	int get_translated_count() const {
+		return translated;
+	}
+
+	int get_member_count() const {
+		return member_count;
+	}
+
+	const LocalVector<uint8_t> &get_code() const {
+		return assembler.get_code();
+	}
+
+	explicit GDScriptJITTranslator(const GDScriptFunction *p_function) :
+			assembler(p_function->_constants_ptr) {
+		function = p_function;
+	}
+};
+
+int GDScriptJITTranslator::_translate_instruction(int p_ip) {
+	const int *code = function->_code_ptr;
+	int opcode = code[p_ip];
+
+	const void *type_adjust = _get_type_adjust_function(opcode);
+	if (type_adjust != nullptr) {
+		if (!_has_space(p_ip, 2) || !_are_valid_addresses(p_ip, 1, 1)) {
+			assembler.exit(p_ip);
+			return -1;
+		}
+		assembler.load_address(0, code[p_ip + 1]);
+		assembler.call(type_adjust);
+		translated++;
+		return p_ip + 2;
+	}
+
+	switch (opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+			if (!_has_space(p_ip, 5) || !_are_valid_addresses(p_ip, 1, 3) || code[p_ip + 4] < 0 || code[p_ip + 4] >= function->_operator_funcs_count) {
+				break;
+			}
+			assembler.load_address(0, code[p_ip + 1]);
+			assembler.load_address(1, code[p_ip + 2]);
+			assembler.load_address(2, code[p_ip + 3]);
+			assembler.call((const void *)function->_operator_funcs_ptr[code[p_ip + 4]]);
+			translated++;
+			return p_ip + 5;
+		}
+		case GDScriptFunction::OPCODE_OPERATOR_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_JUMP_IF_NOT: {
+			bool is_jump = opcode == GDScriptFunction::OPCODE_OPERATOR_INT_JUMP_IF_NOT || opcode == GDScriptFunction::OPCODE_OPERATOR_FLOAT_JUMP_IF_NOT;
+			if (!_has_space(p_ip, is_jump ? 6 : 5) || !_are_valid_addresses(p_ip, 1, 3) || code[p_ip + 4] < 0 || code[p_ip + 4] >= Variant::OP_MAX || (is_jump && !_is_valid_target(code[p_ip + 5]))) {
+				break;
+			}
+			// The VM evaluates these inline, here the validated evaluator for the same types does it.
+			Variant::Type type = (opcode == GDScriptFunction::OPCODE_OPERATOR_INT || opcode == GDScriptFunction::OPCODE_OPERATOR_INT_JUMP_IF_NOT) ? Variant::INT : Variant::FLOAT;
+			Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)code[p_ip + 4], type, type);
+			if (evaluator == nullptr) {
+				break;
+			}
+			assembler.load_address(0, code[p_ip + 1]);
+			assembler.load_address(1, code[p_ip + 2]);
+			assembler.load_address(2, code[p_ip + 3]);
+			assembler.call((const void *)evaluator);
+			translated++;
+			if (!is_jump) {
+				return p_ip + 5;
+			}
+			assembler.load_address(0, code[p_ip + 3]);
+			assembler.call((const void *)&_jit_booleanize);
+			assembler.branch(false, code[p_ip + 5]);
+			_queue(code[p_ip + 5]);
+			return p_ip + 6;
+		}
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+			if (!_has_space(p_ip, 6) || !_are_valid_addresses(p_ip, 1, 3) || code[p_ip + 4] < 0 || code[p_ip + 4] >= function->_operator_funcs_count || !_is_valid_target(code[p_ip + 5])) {
+				break;
+			}
+			assembler.load_address(0, code[p_ip + 1]);
+			assembler.load_address(1, code[p_ip + 2]);
+			assembler.load_address(2, code[p_ip + 3]);
+			assembler.call((const void *)function->_operator_funcs_ptr[code[p_ip + 4]]);
+			assembler.load_address(0, code[p_ip + 3]);
+			assembler.call((const void *)&_jit_booleanize);
+			assembler.branch(false, code[p_ip + 5]);
+			_queue(code[p_ip + 5]);
+			translated++;
+			return p_ip + 6;
+		}
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+			if (!_has_space(p_ip, 4) || !_are_valid_addresses(p_ip, 1, 2) || code[p_ip + 3] < 0 || code[p_ip + 3] >= function->_getters_count) {
+				break;
+			}
+			assembler.load_address(0, code[p_ip + 1]);
+			assembler.load_address(1, code[p_ip + 2]);
+			assembler.call((const void *)function->_getters_ptr[code[p_ip + 3]]);
+			translated++;
+			return p_ip + 4;
+		}
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+			if (!_has_space(p_ip, 4) || !_are_valid_addresses(p_ip, 1, 2) || code[p_ip + 3] < 0 || code[p_ip + 3] >= function->_setters_count) {
+				break;
+			}
+			assembler.load_address(0, code[p_ip + 1]);
+			assembler.load_address(1, code[p_ip + 2]);
+			assembler.call((const void *)function->_setters_ptr[code[p_ip + 3]]);
+			translated++;
+			return p_ip + 4;
+		}
+		case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+			if (!_has_space(p_ip, 5) || !_are_valid_addresses(p_ip, 1, 3) || code[p_ip + 4] < 0) {
+				break;
+			}
+			int index = code[p_ip + 4];
+			const void *accessor = nullptr;
+			const void *helper = nullptr;
+			if (opcode == GDScriptFunction::OPCODE_GET_KEYED_VALIDATED && index < function->_keyed_getters_count) {
+				accessor = (const void *)function->_keyed_getters_ptr[index];
+				helper = (const void *)&_jit_get_keyed;
+			} else if (opcode == GDScriptFunction::OPCODE_SET_KEYED_VALIDATED && index < function->_keyed_setters_count) {
+				accessor = (const void *)function->_keyed_setters_ptr[index];
+				helper = (const void *)&_jit_set_keyed;
+			} else if (opcode == GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED && index < function->_indexed_getters_count) {
+				accessor = (const void *)function->_indexed_getters_ptr[index];
+				helper = (const void *)&_jit_get_indexed;
+			} else if (opcode == GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED && index < function->_indexed_setters_count) {
+				accessor = (const void *)function->_indexed_setters_ptr[index];
+				helper = (const void *)&_jit_set_indexed;
+			}
+			if (accessor == nullptr) {
+				break;
+			}
+			// Failed accesses don't change anything, so the VM can run the instruction again to report the error.
+			assembler.load_pointer(0, accessor);
+			assembler.load_address(1, code[p_ip + 1]);
+			assembler.load_address(2, code[p_ip + 2]);
+			assembler.load_address(3, code[p_ip + 3]);
+			assembler.call(helper);
+			assembler.exit_unless_result(p_ip);
+			translated++;
+			return p_ip + 5;
+		}
+		case GDScriptFunction::OPCODE_ASSIGN: {
+			if (!_has_space(p_ip, 3) || !_are_valid_addresses(p_ip, 1, 2)) {
+				break;
+			}
+			assembler.load_address(0, code[p_ip + 1]);
+			assembler.load_address(1, code[p_ip + 2]);
+			assembler.call((const void *)&_jit_assign);
+			translated++;
+			return p_ip + 3;
+		}
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+			if (!_has_space(p_ip, 2) || !_are_valid_addresses(p_ip, 1, 1)) {
+				break;
+			}
+			assembler.load_address(0, code[p_ip + 1]);
+			if (opcode == GDScriptFunction::OPCODE_ASSIGN_NULL) {
+				assembler.call((const void *)&_jit_assign_null);
+			} else if (opcode == GDScriptFunction::OPCODE_ASSIGN_TRUE) {
+				assembler.call((const void *)&_jit_assign_true);
+			} else {
+				assembler.call((const void *)&_jit_assign_false);
+			}
+			translated++;
+			return p_ip + 2;
+		}
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+			if (!_has_space(p_ip, 4) || !_are_valid_addresses(p_ip, 1, 2)) {
+				break;
+			}
+			// Only the case without conversion, the VM takes over otherwise.
+			assembler.load_address(0, code[p_ip + 1]);
+			assembler.load_address(1, code[p_ip + 2]);
+			assembler.load_int(2, code[p_ip + 3]);
+			assembler.call((const void *)&_jit_assign_typed_builtin);
+			assembler.exit_unless_result(p_ip);
+			translated++;
+			return p_ip + 4;
+		}
+		case GDScriptFunction::OPCODE_JUMP: {
+			if (!_has_space(p_ip, 2) || !_is_valid_target(code[p_ip + 1])) {
+				break;
+			}
+			assembler.jump(code[p_ip + 1]);
+			_queue(code[p_ip + 1]);
+			translated++;
+			return -1;
+		}
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+			if (!_has_space(p_ip, 3) || !_are_valid_addresses(p_ip, 1, 1) || !_is_valid_target(code[p_ip + 2])) {
+				break;
+			}
+			assembler.load_address(0, code[p_ip + 1]);
+			assembler.call((const void *)&_jit_booleanize);
+			assembler.branch(opcode == GDScriptFunction::OPCODE_JUMP_IF, code[p_ip + 2]);
+			_queue(code[p_ip + 2]);
+			translated++;
+			return p_ip + 3;
+		}
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT:
+		case GDScriptFunction::OPCODE_ITERATE_INT: {
+			if (!_has_space(p_ip, 5) || !_are_valid_addresses(p_ip, 1, 3) || !_is_valid_target(code[p_ip + 4])) {
+				break;
+			}
+			assembler.load_address(0, code[p_ip + 1]);
+			assembler.load_address(1, code[p_ip + 2]);
+			assembler.load_address(2, code[p_ip + 3]);
+			assembler.call(opcode == GDScriptFunction::OPCODE_ITERATE_BEGIN_INT ? (const void *)&_jit_iterate_begin_int : (const void *)&_jit_iterate_int);
+			assembler.branch(false, code[p_ip + 4]);
+			_queue(code[p_ip + 4]);
+			translated++;
+			return p_ip + 5;
+		}
+		case GDScriptFunction::OPCODE_LINE: {
+			if (!_has_space(p_ip, 2)) {
+				break;
+			}
+			// Breakpoints and stepping are never needed, compiled code doesn't run while debugging.
+			assembler.set_line(code[p_ip + 1]);
+			return p_ip + 2;
+		}
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+			return _translate_call(p_ip);
+		}
+		default: {
+		} break;
+	}
+
+	// Not supported (or not valid), the VM continues from here.
+	assembler.exit(p_ip);
+	return -1;
+}
+
+int GDScriptJITTranslator::_translate_call(int p_ip) {
+	const int *code = function->_code_ptr;
+	int opcode = code[p_ip];
+
+	if (!_has_space(p_ip, 2)) {
+		assembler.exit(p_ip);
+		return -1;
+	}
+	int instr_arg_count = code[p_ip + 1];
+	if (instr_arg_count < 0 || instr_arg_count > function->_instruction_args_size || !_has_space(p_ip, 4 + instr_arg_count) || !_are_valid_addresses(p_ip, 2, instr_arg_count)) {
+		assembler.exit(p_ip);
+		return -1;
+	}
+	int argc = code[p_ip + 2 + instr_arg_count];
+	int index = code[p_ip + 3 + instr_arg_count];
+	// The remaining instruction arguments are the base and the return value, depending on the opcode.
+	int extra_args = opcode == GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED ? 2 : 1;
+	if (argc < 0 || argc + extra_args > instr_arg_count || index < 0) {
+		assembler.exit(p_ip);
+		return -1;
+	}
+
+	const void *target = nullptr;
+	if (opcode == GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED && index < function->_constructors_count) {
+		target = (const void *)function->_constructors_ptr[index];
+	} else if (opcode == GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED && index < function->_builtin_methods_count) {
+		target = (const void *)function->_builtin_methods_ptr[index];
+	} else if (opcode == GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED && index < function->_utilities_count) {
+		target = (const void *)function->_utilities_ptr[index];
+	}
+	if (target == nullptr) {
+		assembler.exit(p_ip);
+		return -1;
+	}
+
+	for (int i = 0; i < argc; i++) {
+		assembler.store_instruction_arg(i, code[p_ip + 2 + i]);
+	}
+
+	switch (opcode) {
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+			// constructor(dst, args)
+			assembler.load_address(0, code[p_ip + 2 + argc]);
+			assembler.load_instruction_args(1);
+		} break;
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+			// method(base, args, argc, ret)
+			assembler.load_address(0, code[p_ip + 2 + argc]);
+			assembler.load_instruction_args(1);
+			assembler.load_int(2, argc);
+			assembler.load_address(3, code[p_ip + 2 + argc + 1]);
+		} break;
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+			// function(dst, args, argc)
+			assembler.load_address(0, code[p_ip + 2 + argc]);
+			assembler.load_instruction_args(1);
+			assembler.load_int(2, argc);
+		} break;
+	}
+	assembler.call(target);
+
+	translated++;
+	return p_ip + 4 + instr_arg_count;
+}
+
+static Mutex jit_mutex;
+static SafeNumeric<uint32_t> jit_compiled_functions;
+
+void GDScriptJIT::tier_up(GDScriptFunction *p_function) {
+	const GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	uint32_t calls = p_function->jit_call_count.increment();
+	if (calls < (uint32_t)language->jit_call_threshold && p_function->jit_loop_count.get() < (uint32_t)language->jit_loop_threshold) {
+		return;
+	}
+
+	MutexLock lock(jit_mutex);
+	if (p_function->jit_attempted.is_set()) {
+		return;
+	}
+	p_function->jit_attempted.set();
+
+	Code *code = compile(p_function);
+	if (code == nullptr) {
+		return;
+	}
+	p_function->jit_code = code;
+	p_function->jit_ready.set(); // Publishes `jit_code` to other threads.
+	jit_compiled_functions.increment();
+
+	print_verbose(vformat("GDScript JIT: Compiled \"%s\" (%d of its instructions, %d bytes).", p_function->get_name(), code->instructions, (int64_t)code->size));
+}
+
+uint32_t GDScriptJIT::get_compiled_function_count() {
+	return jit_compiled_functions.get();
+}
+
+GDScriptJIT::Code *GDScriptJIT::compile(const GDScriptFunction *p_function) {
+	ERR_FAIL_NULL_V(p_function, nullptr);
+	if (p_function->_code_ptr == nullptr || p_function->_default_arg_count > 0) {
+		return nullptr; // Starts by jumping to the default arguments, which the VM does better.
+	}
+
+	GDScriptJITTranslator translator(p_function);
+	if (!translator.translate() || translator.get_translated_count() == 0) {
+		return nullptr;
+	}
+
+	const LocalVector<uint8_t> &native_code = translator.get_code();
+	size_t size = native_code.size();
+	void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	ERR_FAIL_COND_V_MSG(memory == MAP_FAILED, nullptr, "GDScript JIT: Could not allocate memory for native code.");
+
+	memcpy(memory, native_code.ptr(), size);
+	if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0) {
+		munmap(memory, size);
+		ERR_FAIL_V_MSG(nullptr, "GDScript JIT: Could not make native code executable.");
+	}
+	__builtin___clear_cache((char *)memory, (char *)memory + size);
+
+	Code *code = memnew(Code);
+	code->entry = (Entry)memory;
+	code->memory = memory;
+	code->size = size;
+	code->instructions = translator.get_translated_count();
+	code->member_count = translator.get_member_count();
+	return code;
+}
+
+void GDScriptJIT::free_code(Code *p_code) {
+	ERR_FAIL_NULL(p_code);
+	munmap(p_code->memory, p_code->size);
+	memdelete(p_code);
+}
+
+#endif // GDSCRIPT_JIT_ENABLED
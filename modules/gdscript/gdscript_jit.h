@@ -0,0 +1,71 @@
+/**************************************************************************/
+/*  gdscript_jit.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_JIT_H
+#define GDSCRIPT_JIT_H
+
+#include "core/typedefs.h"
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define GDSCRIPT_JIT_ENABLED
+#endif
+
+#ifdef GDSCRIPT_JIT_ENABLED
+
+class GDScriptFunction;
+class Variant;
+
+// Baseline tier for hot functions. The validated bytecode is translated instruction by instruction into
+// native calls to the same evaluators the VM uses, removing dispatch and operand decoding. Anything that
+// can't be translated (calls into scripts, returns, awaits, errors) exits to the VM at that instruction.
+class GDScriptJIT {
+public:
+	// Runs from the start of the function and returns the instruction pointer where the VM must continue.
+	typedef int (*Entry)(Variant *p_stack, Variant *p_members, Variant **p_instruction_args, int *r_line);
+
+	struct Code {
+		Entry entry = nullptr;
+		void *memory = nullptr;
+		size_t size = 0;
+		int instructions = 0; // Number of translated instructions.
+		int member_count = 0; // Members the instance needs, otherwise `nullptr` must be passed as `p_members`.
+	};
+
+	// Counts a call to a function that isn't compiled yet, compiling it when it becomes hot.
+	static void tier_up(GDScriptFunction *p_function);
+	static Code *compile(const GDScriptFunction *p_function);
+	// Functions compiled by `tier_up()` so far.
+	static uint32_t get_compiled_function_count();
+	static void free_code(Code *p_code);
+};
+
+#endif // GDSCRIPT_JIT_ENABLED
+
+#endif // GDSCRIPT_JIT_H
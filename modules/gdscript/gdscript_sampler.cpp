@@ -0,0 +1,252 @@
+/**************************************************************************/
+/*  gdscript_sampler.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampler.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "gdscript_function.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/object/method_bind.h"
+#include "core/os/os.h"
+
+thread_local GDScriptSampler::ThreadState GDScriptSampler::thread_state;
+SafeFlag GDScriptSampler::active;
+SafeNumeric<uint32_t> GDScriptSampler::tick;
+SafeNumeric<uint32_t> GDScriptSampler::session;
+Thread GDScriptSampler::thread;
+int GDScriptSampler::interval_usec = 1000;
+
+Mutex GDScriptSampler::mutex;
+LocalVector<GDScriptSampler::StackNode> GDScriptSampler::nodes;
+HashMap<GDScriptSampler::StackKey, int, GDScriptSampler::StackKeyHasher> GDScriptSampler::node_map;
+HashMap<String, int> GDScriptSampler::native_node_map;
+LocalVector<GDScriptSampler::Sample> GDScriptSampler::samples;
+uint64_t GDScriptSampler::start_time = 0;
+
+void GDScriptSampler::_thread_func(void *p_userdata) {
+	while (active.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		tick.increment();
+	}
+}
+
+void GDScriptSampler::_record(const MethodBind *p_native_method) {
+	ThreadState &state = thread_state;
+	uint32_t current_tick = tick.get();
+	uint32_t weight = current_tick - state.last_tick;
+	state.last_tick = current_tick;
+
+	if (state.session != session.get()) {
+		// Started while this thread was already running scripts, the elapsed ticks are meaningless.
+		state.session = session.get();
+		return;
+	}
+	if (state.frames.is_empty() || !active.is_set()) {
+		return;
+	}
+
+	MutexLock lock(mutex);
+
+	int node = -1;
+	for (const Frame &frame : state.frames) {
+		StackKey key;
+		key.parent = node;
+		key.source = frame.function->get_source();
+		key.function = frame.function->get_name();
+		key.line = frame.line ? *frame.line : 0;
+
+		HashMap<StackKey, int, StackKeyHasher>::Iterator E = node_map.find(key);
+		if (E) {
+			node = E->value;
+		} else {
+			StackNode stack_node;
+			stack_node.parent = node;
+			stack_node.name = vformat("%s (%s:%d)", key.function, key.source, key.line);
+			node = nodes.size();
+			nodes.push_back(stack_node);
+			node_map.insert(key, node);
+		}
+	}
+
+	if (p_native_method) {
+		// Native frames are keyed by name, their parent is part of the key.
+		String name = vformat("%s.%s", p_native_method->get_instance_class(), p_native_method->get_name());
+		String key = itos(node) + "/" + name;
+		HashMap<String, int>::Iterator E = native_node_map.find(key);
+		if (E) {
+			node = E->value;
+		} else {
+			StackNode stack_node;
+			stack_node.parent = node;
+			stack_node.name = name;
+			node = nodes.size();
+			nodes.push_back(stack_node);
+			native_node_map.insert(key, node);
+		}
+	}
+
+	Sample sample;
+	sample.time = OS::get_singleton()->get_ticks_usec() - start_time;
+	sample.thread_id = Thread::get_caller_id();
+	sample.node = node;
+	sample.weight = weight;
+	samples.push_back(sample);
+}
+
+String GDScriptSampler::_get_stack_name(int p_node) {
+	String name;
+	for (int node = p_node; node >= 0; node = nodes[node].parent) {
+		// Semicolons separate frames in the collapsed format.
+		String frame = nodes[node].name.replace(";", ":");
+		name = name.is_empty() ? frame : frame + ";" + name;
+	}
+	return name;
+}
+
+void GDScriptSampler::start(int p_interval_usec) {
+	ERR_FAIL_COND_MSG(active.is_set(), "The GDScript sampling profiler is already running.");
+	ERR_FAIL_COND(p_interval_usec <= 0);
+
+	interval_usec = p_interval_usec;
+	{
+		MutexLock lock(mutex);
+		start_time = OS::get_singleton()->get_ticks_usec();
+	}
+	session.increment();
+	active.set();
+	thread.start(&GDScriptSampler::_thread_func, nullptr);
+}
+
+void GDScriptSampler::stop() {
+	if (!active.is_set()) {
+		return;
+	}
+	active.clear();
+	thread.wait_to_finish();
+}
+
+void GDScriptSampler::clear() {
+	MutexLock lock(mutex);
+	nodes.clear();
+	node_map.clear();
+	native_node_map.clear();
+	samples.clear();
+}
+
+String GDScriptSampler::get_collapsed_stacks() {
+	MutexLock lock(mutex);
+
+	HashMap<int, uint64_t> weights;
+	for (const Sample &sample : samples) {
+		if (HashMap<int, uint64_t>::Iterator E = weights.find(sample.node)) {
+			E->value += sample.weight;
+		} else {
+			weights.insert(sample.node, sample.weight);
+		}
+	}
+
+	Vector<String> lines;
+	for (const KeyValue<int, uint64_t> &E : weights) {
+		lines.push_back(_get_stack_name(E.key) + " " + itos(E.value));
+	}
+	lines.sort();
+
+	String result;
+	for (const String &line : lines) {
+		result += line + "\n";
+	}
+	return result;
+}
+
+String GDScriptSampler::get_chrome_trace() {
+	MutexLock lock(mutex);
+
+	Dictionary stack_frames;
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		Dictionary frame;
+		frame["name"] = nodes[i].name;
+		frame["category"] = "gdscript";
+		if (nodes[i].parent >= 0) {
+			frame["parent"] = itos(nodes[i].parent);
+		}
+		stack_frames[itos(i)] = frame;
+	}
+
+	Array trace_events;
+	Array sample_events;
+	HashSet<Thread::ID> threads;
+	for (const Sample &sample : samples) {
+		if (!threads.has(sample.thread_id)) {
+			threads.insert(sample.thread_id);
+			Dictionary thread_name;
+			thread_name["ph"] = "M";
+			thread_name["name"] = "thread_name";
+			thread_name["pid"] = 1;
+			thread_name["tid"] = sample.thread_id;
+			Dictionary args;
+			args["name"] = sample.thread_id == Thread::get_main_id() ? String("Main Thread") : vformat("Thread %d", sample.thread_id);
+			thread_name["args"] = args;
+			trace_events.push_back(thread_name);
+		}
+
+		Dictionary event;
+		event["cat"] = "gdscript";
+		event["name"] = "sample";
+		event["ph"] = "P";
+		event["pid"] = 1;
+		event["tid"] = sample.thread_id;
+		event["ts"] = sample.time;
+		event["sf"] = itos(sample.node);
+		event["weight"] = sample.weight;
+		sample_events.push_back(event);
+	}
+
+	Dictionary trace;
+	trace["traceEvents"] = trace_events;
+	trace["stackFrames"] = stack_frames;
+	trace["samples"] = sample_events;
+	trace["displayTimeUnit"] = "ms";
+	return JSON::stringify(trace, "", false);
+}
+
+Error GDScriptSampler::save(const String &p_path) {
+	String data = p_path.get_extension().to_lower() == "json" ? get_chrome_trace() : get_collapsed_stacks();
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Cannot save GDScript samples to "%s".)", p_path));
+	f->store_string(data);
+	return OK;
+}
+
+#endif // DEBUG_ENABLED
@@ -0,0 +1,159 @@
+/**************************************************************************/
+/*  gdscript_sampler.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLER_H
+#define GDSCRIPT_SAMPLER_H
+
+#ifdef DEBUG_ENABLED
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class GDScriptFunction;
+class MethodBind;
+
+// Low overhead alternative to the instrumenting profiler. A background thread advances a tick counter at a
+// fixed interval and the VM records its call stack at the next line (or native call return) after a tick,
+// weighted by the number of ticks elapsed. Results can be exported as collapsed stacks (for flame graphs)
+// or in the Chrome trace event format.
+class GDScriptSampler {
+	struct Frame {
+		const GDScriptFunction *function = nullptr;
+		const int *line = nullptr;
+	};
+
+	struct ThreadState {
+		LocalVector<Frame> frames;
+		uint32_t last_tick = 0;
+		uint32_t session = 0;
+	};
+
+	struct StackNode {
+		int parent = -1;
+		String name;
+	};
+
+	struct StackKey {
+		int parent = -1;
+		StringName source;
+		StringName function;
+		int line = 0;
+
+		bool operator==(const StackKey &p_other) const {
+			return parent == p_other.parent && line == p_other.line && function == p_other.function && source == p_other.source;
+		}
+	};
+
+	struct StackKeyHasher {
+		static uint32_t hash(const StackKey &p_key) {
+			uint32_t h = hash_murmur3_one_32(p_key.parent);
+			h = hash_murmur3_one_32(p_key.source.hash(), h);
+			h = hash_murmur3_one_32(p_key.function.hash(), h);
+			h = hash_murmur3_one_32(p_key.line, h);
+			return hash_fmix32(h);
+		}
+	};
+
+	struct Sample {
+		uint64_t time = 0;
+		Thread::ID thread_id = 0;
+		int node = -1;
+		uint32_t weight = 0;
+	};
+
+	static thread_local ThreadState thread_state;
+	static SafeFlag active;
+	static SafeNumeric<uint32_t> tick;
+	static SafeNumeric<uint32_t> session;
+	static Thread thread;
+	static int interval_usec;
+
+	static Mutex mutex;
+	static LocalVector<StackNode> nodes;
+	static HashMap<StackKey, int, StackKeyHasher> node_map;
+	static HashMap<String, int> native_node_map;
+	static LocalVector<Sample> samples;
+	static uint64_t start_time;
+
+	static void _thread_func(void *p_userdata);
+	static String _get_stack_name(int p_node);
+	static void _record(const MethodBind *p_native_method);
+
+public:
+	_FORCE_INLINE_ static bool is_active() { return active.is_set(); }
+
+	// Called by the VM around function bodies while sampling is active.
+	_FORCE_INLINE_ static void enter_function(const GDScriptFunction *p_function, const int *p_line) {
+		ThreadState &state = thread_state;
+		if (state.frames.is_empty()) {
+			// Don't count time spent outside of scripts.
+			state.last_tick = tick.get();
+			state.session = session.get();
+		}
+		state.frames.push_back({ p_function, p_line });
+	}
+
+	_FORCE_INLINE_ static void exit_function() {
+		ThreadState &state = thread_state;
+		if (!state.frames.is_empty()) {
+			state.frames.resize(state.frames.size() - 1);
+		}
+	}
+
+	// Safepoints, record a sample if a tick happened since the last one of this thread.
+	_FORCE_INLINE_ static void poll() {
+		if (unlikely(thread_state.last_tick != tick.get())) {
+			_record(nullptr);
+		}
+	}
+
+	_FORCE_INLINE_ static void poll_native(const MethodBind *p_method) {
+		if (unlikely(thread_state.last_tick != tick.get())) {
+			_record(p_method);
+		}
+	}
+
+	static void start(int p_interval_usec = 1000);
+	static void stop();
+	static void clear();
+
+	static String get_collapsed_stacks();
+	static String get_chrome_trace();
+	// Saves in the Chrome trace format if the extension is `json`, as collapsed stacks otherwise.
+	static Error save(const String &p_path);
+};
+
+#endif // DEBUG_ENABLED
+
+#endif // GDSCRIPT_SAMPLER_H
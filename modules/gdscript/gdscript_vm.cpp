@@ -31,6 +31,7 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampler.h"
 
 #include "core/os/os.h"
 
@@ -168,6 +169,228 @@ String GDScriptFunction::_get_call_error(const Callable::CallError &p_err, const
 	return err_text;
 }
 
+// Operators emitted as `OPCODE_OPERATOR_INT` and `OPCODE_OPERATOR_FLOAT`. Like validated operators, they work on the
+// values of typed locals and temporaries in place, but without calling through a function pointer.
+template <typename T>
+static _FORCE_INLINE_ void _evaluate_numeric_operator(Variant::Operator p_operator, const T p_left, const T p_right, Variant *r_dst) {
+	switch (p_operator) {
+		case Variant::OP_ADD:
+			*VariantGetInternalPtr<T>::get_ptr(r_dst) = p_left + p_right;
+			break;
+		case Variant::OP_SUBTRACT:
+			*VariantGetInternalPtr<T>::get_ptr(r_dst) = p_left - p_right;
+			break;
+		case Variant::OP_MULTIPLY:
+			*VariantGetInternalPtr<T>::get_ptr(r_dst) = p_left * p_right;
+			break;
+		case Variant::OP_EQUAL:
+			*VariantInternal::get_bool(r_dst) = p_left == p_right;
+			break;
+		case Variant::OP_NOT_EQUAL:
+			*VariantInternal::get_bool(r_dst) = p_left != p_right;
+			break;
+		case Variant::OP_LESS:
+			*VariantInternal::get_bool(r_dst) = p_left < p_right;
+			break;
+		case Variant::OP_LESS_EQUAL:
+			*VariantInternal::get_bool(r_dst) = p_left <= p_right;
+			break;
+		case Variant::OP_GREATER:
+			*VariantInternal::get_bool(r_dst) = p_left > p_right;
+			break;
+		case Variant::OP_GREATER_EQUAL:
+			*VariantInternal::get_bool(r_dst) = p_left >= p_right;
+			break;
+		default:
+			break;
+	}
+}
+
+static _FORCE_INLINE_ void _evaluate_int_operator(Variant::Operator p_operator, const Variant *p_left, const Variant *p_right, Variant *r_dst) {
+	const int64_t left = *VariantInternal::get_int(p_left);
+	const int64_t right = *VariantInternal::get_int(p_right);
+
+	switch (p_operator) {
+		case Variant::OP_BIT_AND:
+			*VariantInternal::get_int(r_dst) = left & right;
+			break;
+		case Variant::OP_BIT_OR:
+			*VariantInternal::get_int(r_dst) = left | right;
+			break;
+		case Variant::OP_BIT_XOR:
+			*VariantInternal::get_int(r_dst) = left ^ right;
+			break;
+		default:
+			_evaluate_numeric_operator<int64_t>(p_operator, left, right, r_dst);
+			break;
+	}
+}
+
+static _FORCE_INLINE_ void _evaluate_float_operator(Variant::Operator p_operator, const Variant *p_left, const Variant *p_right, Variant *r_dst) {
+	const double left = *VariantInternal::get_float(p_left);
+	const double right = *VariantInternal::get_float(p_right);
+
+	if (p_operator == Variant::OP_DIVIDE) {
+		*VariantInternal::get_float(r_dst) = left / right;
+	} else {
+		_evaluate_numeric_operator<double>(p_operator, left, right, r_dst);
+	}
+}
+
+bool GDScriptFunction::_get_inline_cache_receiver(const Variant *p_base, InlineCacheReceiver &r_receiver) {
+	r_receiver.type = p_base->get_type();
+	if (r_receiver.type != Variant::OBJECT) {
+		return true;
+	}
+
+	Object *object = p_base->get_validated_object();
+	if (unlikely(object == nullptr)) {
+		return false; // Let the regular path report the error.
+	}
+
+	ScriptInstance *script_instance = object->get_script_instance();
+	if (script_instance) {
+		if (script_instance->get_language() != GDScriptLanguage::get_singleton() || script_instance->is_placeholder()) {
+			return false;
+		}
+		r_receiver.instance = static_cast<GDScriptInstance *>(script_instance);
+		r_receiver.script = r_receiver.instance->script.ptr();
+	}
+	r_receiver.object = object;
+	r_receiver.class_key = object->get_class_name().data_unique_pointer();
+	return true;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_inline_cache_find(int p_cache, const InlineCacheReceiver &p_receiver) const {
+	const InlineCache &cache = _inline_caches[p_cache];
+	const uint32_t epoch = inline_cache_epoch.get();
+	for (int i = 0; i < InlineCache::MAX_ENTRIES; i++) {
+		const InlineCacheEntry *entry = cache.entries[i].load(std::memory_order_acquire);
+		if (entry == nullptr) {
+			break;
+		}
+		if (entry->type == p_receiver.type && entry->class_key == p_receiver.class_key && entry->script == p_receiver.script && entry->epoch == epoch) {
+			return entry;
+		}
+	}
+	return nullptr;
+}
+
+// The functions below return false when the instruction has to take the regular path instead.
+
+bool GDScriptFunction::_inline_cache_call(int p_cache, const Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	InlineCacheReceiver receiver;
+	if (p_base->get_type() != Variant::OBJECT || !_get_inline_cache_receiver(p_base, receiver)) {
+		return false;
+	}
+
+	const InlineCacheEntry *entry = _inline_cache_find(p_cache, receiver);
+	if (unlikely(entry == nullptr)) {
+		entry = _inline_cache_update(p_cache, INLINE_CACHE_CALL, receiver, p_method);
+		if (entry == nullptr) {
+			return false;
+		}
+	}
+
+#ifdef DEBUG_ENABLED
+	// Taken by `Object::callp()` as well, so the object can't free itself during the call.
+	_ObjectDebugLock debug_lock(receiver.object);
+#endif
+
+	if (entry->kind == InlineCacheEntry::KIND_SCRIPT_FUNCTION) {
+		r_ret = entry->function->call(receiver.instance, p_args, p_argcount, r_err);
+	} else {
+		r_ret = entry->method->call(receiver.object, p_args, p_argcount, r_err);
+	}
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_get(int p_cache, const Variant *p_base, const StringName &p_name, Variant *r_value) {
+	if (unlikely(p_base == r_value)) {
+		return false;
+	}
+
+	InlineCacheReceiver receiver;
+	if (!_get_inline_cache_receiver(p_base, receiver)) {
+		return false;
+	}
+
+	const InlineCacheEntry *entry = _inline_cache_find(p_cache, receiver);
+	if (unlikely(entry == nullptr)) {
+		entry = _inline_cache_update(p_cache, INLINE_CACHE_GET, receiver, p_name);
+		if (entry == nullptr) {
+			return false;
+		}
+	}
+
+	switch (entry->kind) {
+		case InlineCacheEntry::KIND_SCRIPT_MEMBER: {
+			if (unlikely(entry->member_index >= receiver.instance->members.size())) {
+				return false;
+			}
+			*r_value = receiver.instance->members[entry->member_index];
+		} break;
+		case InlineCacheEntry::KIND_METHOD_BIND: {
+			Callable::CallError ce;
+			*r_value = entry->method->call(receiver.object, nullptr, 0, ce);
+		} break;
+		case InlineCacheEntry::KIND_BUILTIN_MEMBER: {
+			if (r_value->get_type() != entry->builtin_member_type) {
+				VariantInternal::clear(r_value);
+				VariantInternal::initialize(r_value, entry->builtin_member_type);
+			}
+			entry->getter(p_base, r_value);
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_set(int p_cache, Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid) {
+	InlineCacheReceiver receiver;
+	if (!_get_inline_cache_receiver(p_base, receiver)) {
+		return false;
+	}
+
+	const InlineCacheEntry *entry = _inline_cache_find(p_cache, receiver);
+	if (unlikely(entry == nullptr)) {
+		entry = _inline_cache_update(p_cache, INLINE_CACHE_SET, receiver, p_name);
+		if (entry == nullptr) {
+			return false;
+		}
+	}
+
+	switch (entry->kind) {
+		case InlineCacheEntry::KIND_SCRIPT_MEMBER: {
+			// Conversions are left to `GDScriptInstance::set()`.
+			if (unlikely(entry->member_index >= receiver.instance->members.size()) || !entry->member_type->is_type(*p_value)) {
+				return false;
+			}
+			receiver.instance->members.write[entry->member_index] = *p_value;
+			r_valid = true;
+		} break;
+		case InlineCacheEntry::KIND_METHOD_BIND: {
+			const Variant *args[1] = { p_value };
+			Callable::CallError ce;
+			entry->method->call(receiver.object, args, 1, ce);
+			r_valid = ce.error == Callable::CallError::CALL_OK;
+		} break;
+		case InlineCacheEntry::KIND_BUILTIN_MEMBER: {
+			if (p_value->get_type() != entry->builtin_member_type) {
+				return false;
+			}
+			entry->setter(p_base, p_value);
+			r_valid = true;
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
 void (*type_init_function_table[])(Variant *) = {
 	nullptr, // NIL (shouldn't be called).
 	&VariantInitializer<bool>::init, // BOOL.
@@ -215,6 +438,11 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,         \
+		&&OPCODE_OPERATOR_INT,                           \
+		&&OPCODE_OPERATOR_INT_JUMP_IF_NOT,               \
+		&&OPCODE_OPERATOR_FLOAT,                         \
+		&&OPCODE_OPERATOR_FLOAT_JUMP_IF_NOT,             \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_NATIVE,                       \
@@ -445,6 +673,19 @@ void (*type_init_function_table[])(Variant *) = {
 #define METHOD_CALL_ON_NULL_VALUE_ERROR(method_pointer) "Cannot call method '" + (method_pointer)->get_name() + "' on a null value."
 #define METHOD_CALL_ON_FREED_INSTANCE_ERROR(method_pointer) "Cannot call method '" + (method_pointer)->get_name() + "' on a previously freed instance."
 
+// Counts the running calls of a function for as long as the scope lives.
+struct RunningCallScope {
+	SafeNumeric<uint32_t> &running_calls;
+
+	RunningCallScope(SafeNumeric<uint32_t> &p_running_calls) :
+			running_calls(p_running_calls) {
+		running_calls.increment();
+	}
+	~RunningCallScope() {
+		running_calls.decrement();
+	}
+};
+
 Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state) {
 	OPCODES_TABLE;
 
@@ -454,6 +695,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	r_err.error = Callable::CallError::CALL_OK;
 
+	// Stale inline cache entries are only freed when this is the only running call, see `_inline_cache_resolve()`.
+	RunningCallScope running_call_scope(running_calls);
+
 	static thread_local int call_depth = 0;
 	if (unlikely(++call_depth > MAX_CALL_DEPTH)) {
 		call_depth--;
@@ -499,11 +743,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->alloca_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -603,6 +847,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		GDScriptLanguage::get_singleton()->enter_function(p_instance, this, stack, &ip, &line);
 	}
 
+	const bool sampled = GDScriptSampler::is_active();
+	if (unlikely(sampled)) {
+		GDScriptSampler::enter_function(this, &line);
+	}
+
 #define GD_ERR_BREAK(m_cond)                                                                                           \
 	{                                                                                                                  \
 		if (unlikely(m_cond)) {                                                                                        \
@@ -677,9 +926,29 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool awaited = false;
 	int variant_address_limits[ADDR_TYPE_MAX] = { _stack_size, _constant_count, p_instance ? (int)p_instance->members.size() : 0 };
 #endif
+	bool stack_moved = false;
 
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptrw() : nullptr };
 
+#ifdef GDSCRIPT_JIT_ENABLED
+	int jit_backward_jumps = 0;
+	if (!p_state && GDScriptLanguage::get_singleton()->jit_enabled) {
+		if (!jit_ready.is_set() && !jit_attempted.is_set()) {
+			GDScriptJIT::tier_up(this);
+		}
+#ifdef DEBUG_ENABLED
+		const bool jit_allowed = !EngineDebugger::is_active() && !GDScriptLanguage::get_singleton()->profiling && !sampled;
+#else
+		const bool jit_allowed = true;
+#endif
+		if (jit_allowed && jit_ready.is_set()) {
+			// Runs the function until the first instruction that the compiled code can't handle.
+			Variant *members = p_instance && p_instance->members.size() >= jit_code->member_count ? p_instance->members.ptrw() : nullptr;
+			ip = jit_code->entry(stack, members, instruction_args, &line);
+		}
+	}
+#endif
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
@@ -792,6 +1061,93 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_INT) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				_evaluate_int_operator((Variant::Operator)_code_ptr[ip + 4], a, b, dst);
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_INT_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				_evaluate_int_operator((Variant::Operator)_code_ptr[ip + 4], a, b, dst);
+
+				if (!dst->booleanize()) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_FLOAT) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				_evaluate_float_operator((Variant::Operator)_code_ptr[ip + 4], a, b, dst);
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_FLOAT_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				_evaluate_float_operator((Variant::Operator)_code_ptr[ip + 4], a, b, dst);
+
+				if (!dst->booleanize()) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (!dst->booleanize()) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1106,7 +1462,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1116,8 +1472,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int inline_cache = _code_ptr[ip + 4];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= _inline_cache_count);
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				if (!_inline_cache_set(inline_cache, dst, *index, value, valid)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1138,7 +1499,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1158,7 +1519,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1168,6 +1529,14 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int inline_cache = _code_ptr[ip + 4];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= _inline_cache_count);
+
+				if (_inline_cache_get(inline_cache, src, *index, dst)) {
+					ip += 5;
+					DISPATCH_OPCODE;
+				}
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
@@ -1183,7 +1552,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1719,7 +2088,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1730,6 +2099,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int inline_cache = _code_ptr[ip + 3];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= _inline_cache_count);
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1747,7 +2119,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					if (!_inline_cache_call(inline_cache, base, *methodname, (const Variant **)argptrs, argc, *ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					}
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
 						if (base_type == Variant::OBJECT) {
@@ -1777,7 +2151,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				} else {
 					Variant ret;
-					base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					if (!_inline_cache_call(inline_cache, base, *methodname, (const Variant **)argptrs, argc, ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					}
 				}
 #ifdef DEBUG_ENABLED
 
@@ -1827,7 +2203,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -1883,6 +2259,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					_profile_native_call(t_taken, method->get_name(), method->get_instance_class());
 					function_call_time += t_taken;
 				}
+				if (unlikely(GDScriptSampler::is_active())) {
+					GDScriptSampler::poll_native(method);
+				}
 
 				if (err.error != Callable::CallError::CALL_OK) {
 					String methodstr = method->get_name();
@@ -1980,6 +2359,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					_profile_native_call(t_taken, method->get_name(), method->get_instance_class());
 					function_call_time += t_taken;
 				}
+				if (unlikely(GDScriptSampler::is_active())) {
+					GDScriptSampler::poll_native(method);
+				}
 #endif
 
 				if (err.error != Callable::CallError::CALL_OK) {
@@ -2021,6 +2403,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					_profile_native_call(t_taken, method->get_name(), method->get_instance_class());
 					function_call_time += t_taken;
 				}
+				if (unlikely(GDScriptSampler::is_active())) {
+					GDScriptSampler::poll_native(method);
+				}
 #endif
 
 				ip += 3;
@@ -2057,6 +2442,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					_profile_native_call(t_taken, method->get_name(), method->get_instance_class());
 					function_call_time += t_taken;
 				}
+				if (unlikely(GDScriptSampler::is_active())) {
+					GDScriptSampler::poll_native(method);
+				}
 #endif
 
 				ip += 3;
@@ -2109,6 +2497,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					_profile_native_call(t_taken, method->get_name(), method->get_instance_class());
 					function_call_time += t_taken;
 				}
+				if (unlikely(GDScriptSampler::is_active())) {
+					GDScriptSampler::poll_native(method);
+				}
 #endif
 
 				ip += 3;
@@ -2159,6 +2550,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					_profile_native_call(t_taken, method->get_name(), method->get_instance_class());
 					function_call_time += t_taken;
 				}
+				if (unlikely(GDScriptSampler::is_active())) {
+					GDScriptSampler::poll_native(method);
+				}
 #endif
 
 				ip += 3;
@@ -2391,12 +2785,18 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
-
-					// First 3 stack addresses are special, so we just skip them here.
-					for (int i = 3; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+					if (p_state) {
+						// Resumed functions already run on a heap frame, hand it over instead of copying it.
+						gdfs->state.stack = p_state->stack;
+						p_state->stack = nullptr;
+						p_state->stack_size = 0;
+					} else {
+						gdfs->state.stack = _alloc_frame(alloca_size);
+						// First 3 stack addresses are special, so we just skip them here.
+						// Variants don't point into themselves, so they are moved by copying their bytes.
+						memcpy(&gdfs->state.stack[sizeof(Variant) * 3], (void *)&stack[3], sizeof(Variant) * (_stack_size - 3));
 					}
+					stack_moved = true;
 					gdfs->state.stack_size = _stack_size;
 					gdfs->state.alloca_size = alloca_size;
 					gdfs->state.ip = ip + 2;
@@ -2520,6 +2920,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				int to = _code_ptr[ip + 1];
 
 				GD_ERR_BREAK(to < 0 || to > _code_size);
+#ifdef GDSCRIPT_JIT_ENABLED
+				if (to < ip) {
+					jit_backward_jumps++;
+				}
+#endif
 				ip = to;
 			}
 			DISPATCH_OPCODE;
@@ -3588,6 +3993,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_LINE) {
 				CHECK_SPACE(2);
 
+#ifdef DEBUG_ENABLED
+				if (unlikely(GDScriptSampler::is_active())) {
+					GDScriptSampler::poll(); // Before moving on, the elapsed time belongs to the previous line.
+				}
+#endif
+
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
@@ -3684,6 +4095,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		}
 	}
 
+	if (unlikely(sampled)) {
+		GDScriptSampler::exit_function();
+	}
+
 	// Check if this is not the last time it was interrupted by `await` or if it's the first time executing.
 	// If that is the case then we exit the function as normal. Otherwise we postpone it until the last `await` is completed.
 	// This ensures the call stack can be properly shown when using `await`, showing what resumed the function.
@@ -3693,9 +4108,14 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		}
 #endif
 
-		// Free stack, except reserved addresses.
-		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-			stack[i].~Variant();
+		// Free stack, except reserved addresses. After an await, they belong to the function state.
+		if (!stack_moved) {
+			for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+				stack[i].~Variant();
+			}
+			if (p_state) {
+				p_state->stack_size = 0;
+			}
 		}
 #ifdef DEBUG_ENABLED
 	}
@@ -3706,6 +4126,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		stack[i].~Variant();
 	}
 
+#ifdef GDSCRIPT_JIT_ENABLED
+	if (jit_backward_jumps > 0 && !jit_attempted.is_set()) {
+		jit_loop_count.add(jit_backward_jumps);
+	}
+#endif
+
 	call_depth--;
 
 	return retvalue;
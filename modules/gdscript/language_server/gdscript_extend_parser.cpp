@@ -32,6 +32,7 @@
 
 #include "../gdscript.h"
 #include "../gdscript_analyzer.h"
+#include "../gdscript_cache.h"
 #include "editor/editor_settings.h"
 #include "gdscript_language_protocol.h"
 #include "gdscript_workspace.h"
@@ -120,6 +121,16 @@ GodotRange GodotRange::from_lsp(const lsp::Range &p_range, const Vector<String>
 	return GodotRange(start, end);
 }
 
+static void shift_symbol(lsp::DocumentSymbol &r_symbol, int p_offset) {
+	r_symbol.range.start.line += p_offset;
+	r_symbol.range.end.line += p_offset;
+	r_symbol.selectionRange.start.line += p_offset;
+	r_symbol.selectionRange.end.line += p_offset;
+	for (lsp::DocumentSymbol &child : r_symbol.children) {
+		shift_symbol(child, p_offset);
+	}
+}
+
 void ExtendGDScriptParser::update_diagnostics() {
 	diagnostics.clear();
 
@@ -163,6 +174,29 @@ void ExtendGDScriptParser::update_diagnostics() {
 		diagnostic.range = range;
 		diagnostics.push_back(diagnostic);
 	}
+
+	if (reused_functions.is_empty()) {
+		return;
+	}
+
+	// Replace the diagnostics of functions which weren't analyzed by the ones from the previous parse.
+	for (int i = diagnostics.size() - 1; i >= 0; i--) {
+		for (const KeyValue<const FunctionNode *, CachedFunction> &E : reused_functions) {
+			int line = diagnostics[i].range.start.line;
+			if (line >= LINE_NUMBER_TO_INDEX(E.key->start_line) && line <= LINE_NUMBER_TO_INDEX(E.key->end_line)) {
+				diagnostics.remove_at(i);
+				break;
+			}
+		}
+	}
+	for (const KeyValue<const FunctionNode *, CachedFunction> &E : reused_functions) {
+		int offset = E.key->start_line - E.value.start_line;
+		for (lsp::Diagnostic diagnostic : E.value.diagnostics) {
+			diagnostic.range.start.line += offset;
+			diagnostic.range.end.line += offset;
+			diagnostics.push_back(diagnostic);
+		}
+	}
 }
 
 void ExtendGDScriptParser::update_symbols() {
@@ -446,7 +480,13 @@ void ExtendGDScriptParser::parse_class_symbol(const GDScriptParser::ClassNode *p
 			} break;
 			case ClassNode::Member::FUNCTION: {
 				lsp::DocumentSymbol symbol;
-				parse_function_symbol(m.function, symbol);
+				if (const CachedFunction *cached = reused_functions.getptr(m.function)) {
+					// Its body wasn't analyzed, so the types of locals are only known from the previous parse.
+					symbol = cached->symbol;
+					shift_symbol(symbol, m.function->start_line - cached->start_line);
+				} else {
+					parse_function_symbol(m.function, symbol);
+				}
 				r_symbol.children.push_back(symbol);
 			} break;
 			case ClassNode::Member::CLASS: {
@@ -1013,18 +1053,219 @@ Dictionary ExtendGDScriptParser::generate_api() const {
 	return api;
 }
 
-Error ExtendGDScriptParser::parse(const String &p_code, const String &p_path) {
+void ExtendGDScriptParser::collect_functions(const ClassNode *p_class, const String &p_class_key, HashMap<const FunctionNode *, String> &r_functions, HashMap<String, const ClassNode *> &r_classes) const {
+	r_classes.insert(p_class_key, p_class);
+	for (const ClassNode::Member &member : p_class->members) {
+		if (member.type == ClassNode::Member::FUNCTION) {
+			r_functions.insert(member.function, p_class_key + "." + member.function->identifier->name);
+		} else if (member.type == ClassNode::Member::CLASS) {
+			collect_functions(member.m_class, p_class_key + "/" + member.m_class->identifier->name, r_functions, r_classes);
+		}
+	}
+}
+
+String ExtendGDScriptParser::get_function_text(const FunctionNode *p_function) const {
+	String text;
+	for (int i = LINE_NUMBER_TO_INDEX(p_function->start_line); i <= LINE_NUMBER_TO_INDEX(p_function->end_line) && i < lines.size(); i++) {
+		text += lines[i] + "\n";
+	}
+	return text;
+}
+
+void ExtendGDScriptParser::reuse_functions(const ExtendGDScriptParser *p_previous, const HashMap<const FunctionNode *, String> &p_functions, const HashMap<String, const ClassNode *> &p_classes, const String &p_interface_text) {
+	if (p_previous == nullptr || !p_previous->analysis_cache.valid || p_previous->analysis_cache.interface_text != p_interface_text) {
+		return;
+	}
+
+	// The bodies were analyzed against these scripts, the cached results are wrong if any of them changed.
+	for (const KeyValue<String, uint32_t> &E : p_previous->analysis_cache.dependencies) {
+		Error err = OK;
+		Ref<GDScriptParserRef> parser_ref = GDScriptCache::get_parser(E.key, GDScriptParserRef::PARSED, err, path);
+		if (parser_ref.is_null() || parser_ref->get_source_hash() != E.value) {
+			return;
+		}
+	}
+
+	for (const KeyValue<const FunctionNode *, String> &E : p_functions) {
+		const CachedFunction *cached = p_previous->analysis_cache.functions.getptr(E.value);
+		if (cached == nullptr || cached->text != get_function_text(E.key)) {
+			continue;
+		}
+		if (cached->has_inferred_return_type && E.key->return_type == nullptr) {
+			continue; // Its return type comes from the body and other functions may depend on it.
+		}
+		reused_functions.insert(E.key, *cached);
+
+		// Restore what the body contributes to the rest of the analysis.
+		for (const Pair<String, StringName> &usage : cached->member_usages) {
+			const ClassNode *const *class_node = p_classes.getptr(usage.first);
+			if (class_node == nullptr || !(*class_node)->has_member(usage.second)) {
+				continue;
+			}
+			const ClassNode::Member &member = (*class_node)->get_member(usage.second);
+			if (member.type == ClassNode::Member::VARIABLE) {
+				member.variable->usages++;
+			} else if (member.type == ClassNode::Member::SIGNAL) {
+				member.signal->usages++;
+			}
+		}
+	}
+}
+
+void ExtendGDScriptParser::collect_dependencies(GDScriptParser *p_parser, HashMap<String, uint32_t> &r_dependencies) const {
+	for (const KeyValue<String, Ref<GDScriptParserRef>> &E : p_parser->get_depended_parsers()) {
+		if (E.key == path || r_dependencies.has(E.key) || E.value.is_null() || E.value->get_status() == GDScriptParserRef::EMPTY) {
+			continue;
+		}
+		r_dependencies.insert(E.key, E.value->get_source_hash());
+		collect_dependencies(E.value->get_parser(), r_dependencies);
+	}
+}
+
+void ExtendGDScriptParser::update_analysis_cache(const HashMap<const FunctionNode *, String> &p_functions, const HashMap<String, const ClassNode *> &p_classes, const String &p_interface_text, const HashMap<const FunctionNode *, HashSet<const Node *>> &p_member_usages) {
+	HashMap<const Node *, Pair<String, StringName>> members_by_node;
+	for (const KeyValue<String, const ClassNode *> &E : p_classes) {
+		for (const ClassNode::Member &member : E.value->members) {
+			if (member.type == ClassNode::Member::VARIABLE) {
+				members_by_node.insert(member.variable, Pair<String, StringName>(E.key, member.variable->identifier->name));
+			} else if (member.type == ClassNode::Member::SIGNAL) {
+				members_by_node.insert(member.signal, Pair<String, StringName>(E.key, member.signal->identifier->name));
+			}
+		}
+	}
+
+	// Find the symbol of each function, through the symbols of the classes it's in.
+	HashMap<const FunctionNode *, const lsp::DocumentSymbol *> symbols;
+	for (const KeyValue<const FunctionNode *, String> &E : p_functions) {
+		const lsp::DocumentSymbol *class_symbol_ptr = &class_symbol;
+		String class_key = E.value.get_slice(".", 0);
+		Vector<String> class_path = class_key.split("/");
+		for (int i = 1; i < class_path.size() && class_symbol_ptr != nullptr; i++) {
+			const lsp::DocumentSymbol *inner = nullptr;
+			for (const lsp::DocumentSymbol &child : class_symbol_ptr->children) {
+				if (child.kind == lsp::SymbolKind::Class && child.name == class_path[i]) {
+					inner = &child;
+					break;
+				}
+			}
+			class_symbol_ptr = inner;
+		}
+		if (class_symbol_ptr == nullptr) {
+			continue;
+		}
+		for (const lsp::DocumentSymbol &child : class_symbol_ptr->children) {
+			if ((child.kind == lsp::SymbolKind::Method || child.kind == lsp::SymbolKind::Function) && child.name == String(E.key->identifier->name)) {
+				symbols.insert(E.key, &child);
+				break;
+			}
+		}
+	}
+
+	analysis_cache = AnalysisCache();
+	analysis_cache.interface_text = p_interface_text;
+	collect_dependencies(this, analysis_cache.dependencies);
+
+	for (const KeyValue<const FunctionNode *, String> &E : p_functions) {
+		if (!E.key->resolved_body) {
+			continue; // Analysis stopped before, the results are incomplete.
+		}
+		const lsp::DocumentSymbol *const *symbol = symbols.getptr(E.key);
+		if (symbol == nullptr) {
+			continue;
+		}
+
+		CachedFunction cached;
+		cached.text = get_function_text(E.key);
+		cached.start_line = E.key->start_line;
+		cached.symbol = **symbol;
+		for (const lsp::Diagnostic &diagnostic : diagnostics) {
+			if (diagnostic.range.start.line >= LINE_NUMBER_TO_INDEX(E.key->start_line) && diagnostic.range.start.line <= LINE_NUMBER_TO_INDEX(E.key->end_line)) {
+				cached.diagnostics.push_back(diagnostic);
+			}
+		}
+
+		if (const CachedFunction *reused = reused_functions.getptr(E.key)) {
+			cached.has_inferred_return_type = reused->has_inferred_return_type;
+			cached.member_usages = reused->member_usages;
+		} else {
+			cached.has_inferred_return_type = E.key->return_type == nullptr && E.key->body->get_datatype().is_set();
+			if (const HashSet<const Node *> *usages = p_member_usages.getptr(E.key)) {
+				for (const Node *member : *usages) {
+					if (const Pair<String, StringName> *usage = members_by_node.getptr(member)) {
+						cached.member_usages.push_back(*usage);
+					}
+				}
+			}
+		}
+
+		analysis_cache.functions.insert(E.value, cached);
+	}
+	analysis_cache.valid = true;
+}
+
+Error ExtendGDScriptParser::parse(const String &p_code, const String &p_path, const ExtendGDScriptParser *p_previous) {
 	path = p_path;
 	lines = p_code.split("\n");
 
 	Error err = GDScriptParser::parse(p_code, p_path, false);
 	GDScriptAnalyzer analyzer(this);
 
+	HashMap<const FunctionNode *, String> functions;
+	HashMap<String, const ClassNode *> classes;
+	String interface_text;
+	HashMap<const FunctionNode *, HashSet<const Node *>> member_usages;
+
 	if (err == OK) {
+		collect_functions(get_tree(), String(), functions, classes);
+
+		Vector<bool> in_function;
+		in_function.resize(lines.size());
+		in_function.fill(false);
+		for (const KeyValue<const FunctionNode *, String> &E : functions) {
+			// The signature ends on the line of the body's colon and stays in the interface, since callers are analyzed against it.
+			int body_start = E.key->body != nullptr ? E.key->body->start_line : E.key->start_line;
+			for (int i = LINE_NUMBER_TO_INDEX(body_start) + 1; i <= LINE_NUMBER_TO_INDEX(E.key->end_line) && i < lines.size(); i++) {
+				in_function.write[i] = true;
+			}
+		}
+		for (int i = 0; i < lines.size(); i++) {
+			if (!in_function[i]) {
+				interface_text += lines[i] + "\n";
+			}
+		}
+
+		reuse_functions(p_previous, functions, classes, interface_text);
+
+		HashSet<const FunctionNode *> skipped_functions;
+		for (const KeyValue<const FunctionNode *, CachedFunction> &E : reused_functions) {
+			skipped_functions.insert(E.key);
+		}
+		analyzer.set_skipped_function_bodies(skipped_functions);
+		analyzer.set_member_usages(&member_usages);
+
 		err = analyzer.analyze();
+	} else if (p_previous != nullptr) {
+		// Keep the results of the last analysis for when the script parses again.
+		analysis_cache = p_previous->analysis_cache;
 	}
 	update_diagnostics();
 	update_symbols();
 	update_document_links(p_code);
+
+	if (!functions.is_empty() || !classes.is_empty()) {
+		update_analysis_cache(functions, classes, interface_text, member_usages);
+	}
+
+	if (err == OK) {
+		for (const KeyValue<const FunctionNode *, CachedFunction> &E : reused_functions) {
+			for (const lsp::Diagnostic &diagnostic : E.value.diagnostics) {
+				if (diagnostic.severity == lsp::DiagnosticSeverity::Error) {
+					err = ERR_PARSE_ERROR; // Same result as if the function had been analyzed.
+				}
+			}
+		}
+	}
+	reused_functions.clear();
+
 	return err;
 }
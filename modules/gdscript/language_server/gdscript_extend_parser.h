@@ -34,6 +34,7 @@
 #include "../gdscript_parser.h"
 #include "godot_lsp.h"
 
+#include "core/templates/pair.h"
 #include "core/variant/variant.h"
 
 #ifndef LINE_NUMBER_TO_INDEX
@@ -137,6 +138,32 @@ class ExtendGDScriptParser : public GDScriptParser {
 
 	Array member_completions;
 
+	// Analysis results of each function, to only analyze again the functions that changed in the next parse of the script.
+	struct CachedFunction {
+		String text;
+		int start_line = 0;
+		bool has_inferred_return_type = false;
+		Vector<lsp::Diagnostic> diagnostics;
+		lsp::DocumentSymbol symbol;
+		Vector<Pair<String, StringName>> member_usages; // Class and name of the variables and signals used in the body.
+	};
+
+	struct AnalysisCache {
+		bool valid = false;
+		String interface_text; // Everything outside of function bodies (signatures included), these can only be reused if it didn't change.
+		HashMap<String, uint32_t> dependencies; // Source hash of the scripts used by the analysis, directly or not.
+		HashMap<String, CachedFunction> functions;
+	};
+
+	AnalysisCache analysis_cache;
+	HashMap<const FunctionNode *, CachedFunction> reused_functions;
+
+	void collect_functions(const ClassNode *p_class, const String &p_class_key, HashMap<const FunctionNode *, String> &r_functions, HashMap<String, const ClassNode *> &r_classes) const;
+	String get_function_text(const FunctionNode *p_function) const;
+	void reuse_functions(const ExtendGDScriptParser *p_previous, const HashMap<const FunctionNode *, String> &p_functions, const HashMap<String, const ClassNode *> &p_classes, const String &p_interface_text);
+	void update_analysis_cache(const HashMap<const FunctionNode *, String> &p_functions, const HashMap<String, const ClassNode *> &p_classes, const String &p_interface_text, const HashMap<const FunctionNode *, HashSet<const Node *>> &p_member_usages);
+	void collect_dependencies(GDScriptParser *p_parser, HashMap<String, uint32_t> &r_dependencies) const;
+
 public:
 	_FORCE_INLINE_ const String &get_path() const { return path; }
 	_FORCE_INLINE_ const Vector<String> &get_lines() const { return lines; }
@@ -167,7 +194,9 @@ public:
 	const Array &get_member_completions();
 	Dictionary generate_api() const;
 
-	Error parse(const String &p_code, const String &p_path);
+	// Passing the previous parse of the same script only analyzes the functions that changed since then.
+	// It must have been parsed right before, as changes in other scripts aren't tracked.
+	Error parse(const String &p_code, const String &p_path, const ExtendGDScriptParser *p_previous = nullptr);
 };
 
 #endif // GDSCRIPT_EXTEND_PARSER_H
@@ -421,11 +421,20 @@ Error GDScriptWorkspace::initialize() {
 }
 
 Error GDScriptWorkspace::parse_script(const String &p_path, const String &p_content) {
-	ExtendGDScriptParser *parser = memnew(ExtendGDScriptParser);
-	Error err = parser->parse(p_content, p_path);
 	HashMap<String, ExtendGDScriptParser *>::Iterator last_parser = parse_results.find(p_path);
 	HashMap<String, ExtendGDScriptParser *>::Iterator last_script = scripts.find(p_path);
 
+	// Only the functions that changed are analyzed again while the same script is being edited.
+	// Any other script being parsed in between may have changed what it depends on.
+	const ExtendGDScriptParser *previous_parser = nullptr;
+	if (last_parser && last_parsed_path == p_path) {
+		previous_parser = last_parser->value;
+	}
+	last_parsed_path = p_path;
+
+	ExtendGDScriptParser *parser = memnew(ExtendGDScriptParser);
+	Error err = parser->parse(p_content, p_path, previous_parser);
+
 	if (err == OK) {
 		remove_cache_parser(p_path);
 		parse_results[p_path] = parser;
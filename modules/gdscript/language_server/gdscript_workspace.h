@@ -50,6 +50,7 @@ protected:
 	void remove_cache_parser(const String &p_path);
 	bool initialized = false;
 	HashMap<StringName, lsp::DocumentSymbol> native_symbols;
+	String last_parsed_path;
 
 	const lsp::DocumentSymbol *get_native_symbol(const String &p_class, const String &p_member = "") const;
 	const lsp::DocumentSymbol *get_script_symbol(const String &p_path) const;
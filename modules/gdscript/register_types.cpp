@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode.h"
 #include "gdscript_cache.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_tokenizer_buffer.h"
@@ -107,8 +108,16 @@ protected:
 
 		String source;
 		source.parse_utf8(reinterpret_cast<const char *>(file.ptr()), file.size());
-		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
-		file = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_BYTECODE) {
+			String error;
+			file = GDScriptBytecode::compile_code_string(source, p_path, GDScriptTokenizerBuffer::COMPRESS_ZSTD, &error);
+			if (!error.is_empty()) {
+				WARN_PRINT(vformat(R"(Could not compile "%s" to bytecode, it will be compiled when loaded: %s)", p_path, error));
+			}
+		} else {
+			GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
+			file = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
+		}
 		if (file.is_empty()) {
 			return;
 		}
@@ -33,7 +33,20 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_bytecode.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_function.h"
+#include "../gdscript_jit.h"
+#include "../gdscript_sampler.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/thread.h"
+#include "core/os/time.h"
+#include "scene/main/node.h"
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace GDScriptTests {
 
@@ -43,11 +56,50 @@ TEST_SUITE("[Modules][GDScript]") {
 	TEST_CASE("Script compilation and runtime") {
 		bool print_filenames = OS::get_singleton()->get_cmdline_args().find("--print-filenames") != nullptr;
 		bool use_binary_tokens = OS::get_singleton()->get_cmdline_args().find("--use-binary-tokens") != nullptr;
+		// Compiles every function on its first call, to compare the time with the interpreter.
+		bool use_jit = OS::get_singleton()->get_cmdline_args().find("--gdscript-jit") != nullptr;
+		GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+		bool jit_enabled = language->jit_enabled;
+		int jit_call_threshold = language->jit_call_threshold;
+		if (use_jit) {
+			language->jit_enabled = true;
+			language->jit_call_threshold = 1;
+		}
+		uint64_t start_time = OS::get_singleton()->get_ticks_usec();
 		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, print_filenames, use_binary_tokens);
 		int fail_count = runner.run_tests();
+		MESSAGE(vformat("GDScript tests ran in %d ms%s.", (OS::get_singleton()->get_ticks_usec() - start_time) / 1000, use_jit ? " with the JIT" : ""));
+		language->jit_enabled = jit_enabled;
+		language->jit_call_threshold = jit_call_threshold;
 		INFO("Make sure `*.out` files have expected results.");
 		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass.");
 	}
+
+#ifdef GDSCRIPT_JIT_ENABLED
+	TEST_CASE("Runtime features with the JIT") {
+		// The `*.out` files hold the output of the interpreter, checked by the test case above.
+		GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+		bool jit_enabled = language->jit_enabled;
+		int jit_call_threshold = language->jit_call_threshold;
+		language->jit_enabled = true;
+		language->jit_call_threshold = 0;
+		uint32_t compiled_functions = GDScriptJIT::get_compiled_function_count();
+
+		init_language("modules/gdscript/tests/scripts");
+		int fail_count = 0;
+		{
+			GDScriptTestRunner runner("modules/gdscript/tests/scripts/runtime/features", false);
+			fail_count = runner.run_tests();
+		}
+		finish_language();
+
+		language->jit_enabled = jit_enabled;
+		language->jit_call_threshold = jit_call_threshold;
+		CHECK_MESSAGE(GDScriptJIT::get_compiled_function_count() > compiled_functions, "Functions should be compiled on their first call.");
+		INFO("Compiled functions must print the same as the interpreter.");
+		REQUIRE_MESSAGE(fail_count == 0, "All runtime feature tests should pass with the JIT.");
+	}
+#endif // GDSCRIPT_JIT_ENABLED
 }
 
 TEST_CASE("[Modules][GDScript] Load source code dynamically and run it") {
@@ -70,6 +122,300 @@ func _init():
 	ref_counted->set_script(gdscript);
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
+
+TEST_CASE("[Modules][GDScript] Sample call stacks") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func busy_loop(p_usec: int) -> int:
+	var end := Time.get_ticks_usec() + p_usec
+	var count := 0
+	while Time.get_ticks_usec() < end:
+		count += 1
+	return count
+
+func _init():
+	set_meta("result", busy_loop(50000))
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	GDScriptSampler::clear();
+	GDScriptSampler::start(100);
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	GDScriptSampler::stop();
+
+	CHECK(int(ref_counted->get_meta("result")) > 0);
+
+	const String collapsed = GDScriptSampler::get_collapsed_stacks();
+	CHECK_MESSAGE(collapsed.contains("_init ("), "Samples should contain the caller.");
+	CHECK_MESSAGE(collapsed.contains(";busy_loop ("), "Samples should contain the callee below the caller.");
+
+	Dictionary trace = JSON::parse_string(GDScriptSampler::get_chrome_trace());
+	CHECK(Array(trace["samples"]).size() > 0);
+	CHECK(Dictionary(trace["stackFrames"]).size() > 0);
+
+	GDScriptSampler::clear();
+	CHECK(GDScriptSampler::get_collapsed_stacks().is_empty());
+}
+
+TEST_CASE("[Modules][GDScript] Reuse frames of awaiting functions") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+signal tick
+
+var completed := 0
+
+func worker(p_value: int) -> void:
+	var values := [p_value, p_value * 2]
+	await tick
+	values.push_back(p_value * 3)
+	await tick
+	completed += values.size()
+
+func spawn(p_count: int) -> void:
+	for i in p_count:
+		worker(i)
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	const int workers = 32;
+	const int rounds = 500;
+	// The first round fills the pool.
+	ref_counted->call("spawn", workers);
+	ref_counted->emit_signal("tick");
+	ref_counted->emit_signal("tick");
+	REQUIRE(int(ref_counted->get("completed")) == workers * 3);
+
+	const uint64_t allocations = GDScriptFunction::get_frame_allocation_count();
+	const uint64_t begin = Time::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < rounds; i++) {
+		ref_counted->call("spawn", workers);
+		ref_counted->emit_signal("tick");
+		ref_counted->emit_signal("tick");
+	}
+	const uint64_t usec = Time::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(int(ref_counted->get("completed")) == workers * 3 * (rounds + 1));
+	CHECK_MESSAGE(GDScriptFunction::get_frame_allocation_count() == allocations, "Frames of finished functions should be reused.");
+	MESSAGE(vformat("%d awaits in %d usec.", workers * 2 * rounds, usec));
+}
+
+static Ref<GDScript> load_bytecode_script(const String &p_path, const Vector<uint8_t> &p_buffer) {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_path(p_path, true);
+	gdscript->set_binary_tokens_source(GDScriptBytecode::get_binary_tokens(p_buffer));
+	gdscript->set_bytecode_source(GDScriptBytecode::get_compiled_code(p_buffer));
+	return gdscript;
+}
+
+static void remove_cached_script(const String &p_path) {
+	// Loading puts the script in the cache, which would keep it alive and return it for the next load.
+	GDScriptCache::remove_script(p_path);
+	GDScriptCache::remove_static_script(p_path);
+}
+
+TEST_CASE("[Modules][GDScript] Load exported bytecode and run it") {
+	const String path = "res://test_bytecode_load.gd";
+	const String code = R"(
+extends RefCounted
+
+const OFFSETS: Array[int] = [1, 2, 3]
+static var counter := 0
+
+class Inner:
+	var value := 10
+	func scaled(p_factor: float) -> float:
+		return value * p_factor
+
+func _init():
+	counter += 1
+	var inner := Inner.new()
+	var sum := 0
+	for offset in OFFSETS:
+		sum += offset
+	var add := func(a, b): return a + b
+	var text := "%d-%d" % [sum, int(inner.scaled(1.5))]
+	set_meta("result", [add.call(sum, 36), text.to_upper(), Vector2(3, 4).length(), absi(-counter), Node.NOTIFICATION_READY])
+)";
+
+	String error;
+	Vector<uint8_t> buffer = GDScriptBytecode::compile_code_string(code, path, GDScriptTokenizerBuffer::COMPRESS_ZSTD, &error);
+	CHECK_MESSAGE(error.is_empty(), "The script should be compiled to bytecode.");
+	REQUIRE(GDScriptBytecode::is_bytecode_buffer(buffer));
+	REQUIRE_FALSE(GDScriptBytecode::get_compiled_code(buffer).is_empty());
+
+	SUBCASE("Bytecode is loaded without parsing") {
+		Ref<GDScript> gdscript = load_bytecode_script(path, buffer);
+		CHECK(gdscript->reload() == OK);
+		remove_cached_script(path);
+		CHECK_MESSAGE(!gdscript->get_bytecode_source().is_empty(), "The bytecode should have been used.");
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		Array result = ref_counted->get_meta("result");
+		REQUIRE(result.size() == 5);
+		CHECK(int(result[0]) == 42);
+		CHECK(String(result[1]) == "6-15");
+		CHECK(double(result[2]) == doctest::Approx(5.0));
+		CHECK(int(result[3]) == 1);
+		CHECK(int(result[4]) == Node::NOTIFICATION_READY);
+	}
+
+	SUBCASE("Tokens are used when the bytecode is incompatible") {
+		// Pretend the file comes from another engine version.
+		buffer.write[4] = GDScriptBytecode::BYTECODE_VERSION + 1;
+		CHECK(GDScriptBytecode::get_compiled_code(buffer).is_empty());
+
+		Ref<GDScript> gdscript = load_bytecode_script(path, buffer);
+		CHECK(gdscript->reload() == OK);
+		remove_cached_script(path);
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		Array result = ref_counted->get_meta("result");
+		REQUIRE(result.size() == 5);
+		CHECK(int(result[0]) == 42);
+	}
+}
+
+TEST_CASE_BENCHMARK("[Modules][GDScript][Benchmark] Loading bytecode against binary tokens") {
+	String code = "extends RefCounted\n";
+	for (int i = 0; i < 200; i++) {
+		code += vformat("\nfunc method_%d(p_value: int) -> int:\n\tvar values := [p_value, %d]\n\tfor value in values:\n\t\tp_value += value * 2\n\treturn p_value if p_value > 0 else -p_value\n", i, i);
+	}
+
+	const String path = "res://test_bytecode_benchmark.gd";
+	const int iterations = 20;
+	Vector<uint8_t> buffer = GDScriptBytecode::compile_code_string(code, path, GDScriptTokenizerBuffer::COMPRESS_ZSTD);
+	REQUIRE_FALSE(GDScriptBytecode::get_compiled_code(buffer).is_empty());
+
+	uint64_t tokens_usec = 0;
+	uint64_t bytecode_usec = 0;
+	for (int i = 0; i < iterations; i++) {
+		Ref<GDScript> tokens_script = memnew(GDScript);
+		tokens_script->set_path(path, true);
+		tokens_script->set_binary_tokens_source(GDScriptBytecode::get_binary_tokens(buffer));
+		uint64_t begin = Time::get_singleton()->get_ticks_usec();
+		CHECK(tokens_script->reload() == OK);
+		tokens_usec += Time::get_singleton()->get_ticks_usec() - begin;
+		remove_cached_script(path);
+		tokens_script.unref();
+
+		Ref<GDScript> bytecode_script = load_bytecode_script(path, buffer);
+		begin = Time::get_singleton()->get_ticks_usec();
+		CHECK(bytecode_script->reload() == OK);
+		bytecode_usec += Time::get_singleton()->get_ticks_usec() - begin;
+		CHECK(!bytecode_script->get_bytecode_source().is_empty());
+		remove_cached_script(path);
+	}
+
+	MESSAGE(vformat("Loading a script with 200 functions: %d usec from binary tokens, %d usec from bytecode.", tokens_usec / iterations, bytecode_usec / iterations));
+}
+
+struct DependencyGraphFile {
+	const char *name;
+	const char *code;
+};
+
+static const DependencyGraphFile dependency_graph_files[] = {
+	{ "leaf.gd", "const NAME := \"leaf\"\n\nstatic func twice(p_value: int) -> int:\n\treturn p_value * 2\n" },
+	{ "base.gd", "extends RefCounted\n\nconst Leaf = preload(\"leaf.gd\")\n\nfunc describe() -> String:\n\treturn \"base:\" + Leaf.NAME\n" },
+	{ "middle.gd", "extends \"base.gd\"\n\nconst LeafScript = preload(\"leaf.gd\")\n\nvar value: int = LeafScript.twice(21)\n\nfunc describe() -> String:\n\treturn super() + \",middle:\" + str(value)\n" },
+	{ "other.gd", "const Leaf = preload(\"leaf.gd\")\n\nstatic func make() -> String:\n\treturn \"other:\" + str(Leaf.twice(2))\n" },
+	{ "main.gd", "extends RefCounted\n\nconst Middle = preload(\"middle.gd\")\nconst Other = preload(\"other.gd\")\n\nfunc run() -> String:\n\treturn Middle.new().describe() + \",\" + Other.make()\n" },
+};
+
+static String write_dependency_graph(const String &p_dir) {
+	DirAccess::make_dir_recursive_absolute(p_dir);
+	for (const DependencyGraphFile &file : dependency_graph_files) {
+		Ref<FileAccess> f = FileAccess::open(p_dir.path_join(file.name), FileAccess::WRITE);
+		f->store_string(file.code);
+	}
+	return p_dir.path_join("main.gd");
+}
+
+static String run_dependency_graph(const String &p_main_path) {
+	Error err = OK;
+	Ref<GDScript> gdscript = GDScriptCache::get_full_script(p_main_path, err);
+	String result;
+	if (err == OK && gdscript.is_valid()) {
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		result = ref_counted->call("run");
+	}
+	for (const DependencyGraphFile &file : dependency_graph_files) {
+		remove_cached_script(p_main_path.get_base_dir().path_join(file.name));
+	}
+	return result;
+}
+
+struct ConcurrentParse {
+	String path;
+	Ref<GDScriptParserRef> parser_ref;
+};
+
+static void concurrent_parse(void *p_userdata) {
+	ConcurrentParse *data = static_cast<ConcurrentParse *>(p_userdata);
+	Error err = OK;
+	data->parser_ref = GDScriptCache::get_parser(data->path, GDScriptParserRef::PARSED, err);
+}
+
+TEST_CASE("[Modules][GDScript] Parse dependencies in parallel") {
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	const bool parallel_parsing = language->parallel_parsing;
+	const String base_dir = TestUtils::get_temp_path("gdscript_parallel_parsing");
+	const String expected = "base:leaf,middle:42,other:4";
+
+	language->parallel_parsing = false;
+	const String sequential_result = run_dependency_graph(write_dependency_graph(base_dir.path_join("sequential")));
+	CHECK(sequential_result == expected);
+
+	SUBCASE("Warming up parses the whole graph") {
+		const String main_path = write_dependency_graph(base_dir.path_join("warm_up"));
+		Vector<Ref<GDScriptParserRef>> warm_parsers = GDScriptCache::warm_up({ main_path });
+		CHECK(warm_parsers.size() == 5);
+		for (const Ref<GDScriptParserRef> &parser_ref : warm_parsers) {
+			CHECK(parser_ref->get_status() >= GDScriptParserRef::PARSED);
+		}
+		warm_parsers.clear();
+	}
+
+	SUBCASE("Loading gives the same result as a sequential load") {
+		language->parallel_parsing = true;
+		const String main_path = write_dependency_graph(base_dir.path_join("parallel"));
+		CHECK(run_dependency_graph(main_path) == sequential_result);
+	}
+
+	SUBCASE("Loading while a dependency is parsed elsewhere") {
+		language->parallel_parsing = true;
+		const String main_path = write_dependency_graph(base_dir.path_join("concurrent"));
+		ConcurrentParse data;
+		data.path = main_path.get_base_dir().path_join("leaf.gd");
+		Thread thread;
+		thread.start(concurrent_parse, &data);
+		const String result = run_dependency_graph(main_path);
+		thread.wait_to_finish();
+		CHECK(result == sequential_result);
+		REQUIRE(data.parser_ref.is_valid());
+		CHECK(data.parser_ref->get_status() >= GDScriptParserRef::PARSED);
+		data.parser_ref.unref();
+	}
+
+	language->parallel_parsing = parallel_parsing;
+}
 #endif // TOOLS_ENABLED
 
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
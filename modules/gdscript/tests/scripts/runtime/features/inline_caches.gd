@@ -0,0 +1,67 @@
+# Untyped property accesses and method calls on changing receivers, which go through the inline caches.
+
+class A:
+	var value = 1
+	var typed: float = 0.5
+	func describe():
+		return "A %s" % value
+
+class B extends A:
+	var other = "b"
+	var with_setter = 0:
+		set(v):
+			with_setter = v * 10
+	func describe():
+		return "B %s %s" % [value, other]
+
+class Dynamic:
+	func _get(property):
+		if property == &"value":
+			return "dynamic"
+		return null
+
+class C:
+	var value = 3
+	func describe():
+		return "C"
+
+class D:
+	var value = 4
+	func describe():
+		return "D"
+
+func read_value(object):
+	return object.value
+
+func test():
+	var receivers = [A.new(), B.new(), A.new(), B.new()]
+	for _i in 2:
+		for receiver in receivers:
+			receiver.value = receiver.value + 1
+			print(receiver.describe())
+
+	var b = B.new()
+	for i in 2:
+		b.with_setter = i + 1
+		print(b.with_setter)
+		b.typed = i + 1 # Converted to float.
+		print(var_to_str(b.typed))
+
+	var dynamic = Dynamic.new()
+	for receiver in [A.new(), dynamic, C.new(), D.new(), B.new(), dynamic]:
+		print(read_value(receiver))
+
+	var resources = [Resource.new(), Resource.new()]
+	for resource in resources:
+		resource.resource_name = "named"
+		print(resource.resource_name)
+		print(resource.get_name())
+
+	var vector = Vector2(1, 2)
+	for i in 2:
+		vector.x = vector.y + i
+		print(vector.x)
+
+	var object = Object.new()
+	object.free()
+	print(is_instance_valid(object))
@@ -0,0 +1,40 @@
+# Operators writing directly to typed locals and parameters, and comparisons fused with branches.
+
+func sum_to(n: int) -> int:
+	var total := 0
+	var i := 0
+	while i < n:
+		total += i
+		i = i + 1
+	n = n * 2
+	return total + n
+
+func concat(times: int) -> String:
+	var text := "a"
+	for i in times:
+		text = text + "b"
+		var step: int = i * 2
+		step = step + 1
+		text += str(step)
+	return text
+
+func test():
+	print(sum_to(5))
+	print(concat(3))
+
+	var v := Vector2(1, 2)
+	v = v * 2.0
+	v += Vector2(0.5, 0.5)
+	print(v)
+
+	var condition := 3
+	if condition > 2:
+		print("greater")
+	else:
+		print("not greater")
+	if condition != 3:
+		print("not three")
+
+	var untyped = 1
+	untyped = untyped + 1.5
+	print(untyped)
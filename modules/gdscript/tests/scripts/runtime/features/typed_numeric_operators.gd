@@ -0,0 +1,28 @@
+# Operators on two typed ints or two typed floats are evaluated by the VM without calling the Variant evaluator.
+
+func test():
+	var a := 12
+	var b := 5
+	print(a + b, " ", a - b, " ", a * b)
+	print(a & b, " ", a | b, " ", a ^ b)
+	print(a == b, " ", a != b, " ", a < b, " ", a <= b, " ", a > b, " ", a >= b)
+
+	var x := 7.5
+	var y := 2.5
+	print(x + y, " ", x - y, " ", x * y, " ", x / y)
+	print(x == y, " ", x != y, " ", x < y, " ", x <= y, " ", x > y, " ", x >= y)
+
+	var count := 0
+	var i := 0
+	while i < 10:
+		if (i & 1) == 0:
+			count += i
+		i += 1
+	print(count)
+
+	var t := 0.0
+	var steps := 0
+	while t < 1.0:
+		t += 0.25
+		steps += 1
+	print(steps)
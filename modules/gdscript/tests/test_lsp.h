@@ -34,6 +34,7 @@
 #ifdef TOOLS_ENABLED
 
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 #include "../language_server/gdscript_extend_parser.h"
 #include "../language_server/gdscript_language_protocol.h"
@@ -41,11 +42,14 @@
 #include "../language_server/godot_lsp.h"
 
 #include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 #include "core/io/file_access_pack.h"
 #include "core/os/os.h"
 #include "editor/editor_help.h"
 #include "editor/editor_node.h"
+#include "editor/editor_settings.h"
 #include "modules/gdscript/gdscript_analyzer.h"
+#include "modules/gdscript/gdscript_cache.h"
 #include "modules/regex/regex.h"
 
 #include "thirdparty/doctest/doctest.h"
@@ -330,6 +334,40 @@ void test_position_roundtrip(lsp::Position p_lsp, GodotPosition p_gd, const Pack
 // * Line & Char:
 //   * LSP: both 0-based
 //   * Godot: both 1-based
+static String make_large_script(int p_functions, int p_edited_function = -1) {
+	String code = "extends Node\n\nsignal used_signal\nvar _used_private := 0\nvar _unused_private := 0\n";
+	for (int i = 0; i < p_functions; i++) {
+		code += vformat("\nfunc method_%d(p_value: int) -> int:\n\tvar values := [p_value, %d]\n\tvar unused_%d := 1\n", i, i, i);
+		if (i == 0) {
+			code += "\t_used_private += 1\n\tused_signal.emit()\n";
+		}
+		if (i == p_edited_function) {
+			code += "\tvar edited := p_value * 2\n";
+		}
+		code += "\tfor value in values:\n\t\tp_value += value * 2\n\t\tif p_value > 1000:\n\t\t\tp_value -= 1000\n";
+		code += vformat("\tvar text := str(p_value).pad_zeros(%d)\n\tif text.length() > 4:\n\t\tp_value = text.to_int()\n\treturn p_value if p_value > 0 else -p_value\n", i % 8);
+	}
+	return code;
+}
+
+static PackedStringArray get_diagnostic_lines(const ExtendGDScriptParser *p_parser) {
+	PackedStringArray result;
+	for (const lsp::Diagnostic &diagnostic : p_parser->get_diagnostics()) {
+		result.push_back(vformat("%s %s", diagnostic.range.to_string(), diagnostic.message));
+	}
+	result.sort();
+	return result;
+}
+
+static bool has_error(const ExtendGDScriptParser *p_parser) {
+	for (const lsp::Diagnostic &diagnostic : p_parser->get_diagnostics()) {
+		if (diagnostic.severity == lsp::DiagnosticSeverity::Error) {
+			return true;
+		}
+	}
+	return false;
+}
+
 TEST_SUITE("[Modules][GDScript][LSP]") {
 	TEST_CASE("Can convert positions to and from Godot") {
 		String code = R"(extends Node
@@ -471,6 +509,155 @@ func f():
 		memdelete(proto);
 		finish_language();
 	}
+
+	TEST_CASE("[workspace][parse_script] Only changed functions are analyzed again") {
+		GDScriptLanguageProtocol *proto = initialize(root);
+		REQUIRE(proto);
+		Ref<GDScriptWorkspace> workspace = GDScriptLanguageProtocol::get_singleton()->get_workspace();
+
+		const String path = "res://lsp/incremental_analysis.gd";
+		const int function_count = 320; // About 5000 lines.
+		const int edited_function = function_count / 2;
+		const String code = make_large_script(function_count);
+		const String edited_code = make_large_script(function_count, edited_function);
+
+		workspace->parse_script(path, code);
+		workspace->parse_script(path, edited_code);
+		const ExtendGDScriptParser *incremental = workspace->parse_results[path];
+		REQUIRE(incremental);
+
+		ExtendGDScriptParser full;
+		full.parse(edited_code, path);
+
+		SUBCASE("Diagnostics are the same as after a full analysis") {
+			PackedStringArray incremental_diagnostics = get_diagnostic_lines(incremental);
+			CHECK(incremental_diagnostics == get_diagnostic_lines(&full));
+			CHECK(incremental_diagnostics.size() > function_count); // Unused locals in every function.
+
+			// Only used in a function which wasn't analyzed again.
+			String all_diagnostics = String("\n").join(incremental_diagnostics);
+			CHECK(all_diagnostics.contains("\"_unused_private\""));
+			CHECK_FALSE(all_diagnostics.contains("\"_used_private\""));
+		}
+
+		SUBCASE("Symbols of functions which weren't analyzed are moved") {
+			const lsp::DocumentSymbol *symbol = incremental->get_member_symbol(vformat("method_%d", function_count - 1));
+			const lsp::DocumentSymbol *expected = full.get_member_symbol(vformat("method_%d", function_count - 1));
+			REQUIRE(symbol);
+			REQUIRE(expected);
+			CHECK(symbol->range == expected->range);
+			REQUIRE(symbol->children.size() == expected->children.size());
+			for (int i = 0; i < symbol->children.size(); i++) {
+				CHECK(symbol->children[i].detail == expected->children[i].detail);
+				CHECK(symbol->children[i].selectionRange == expected->children[i].selectionRange);
+			}
+		}
+
+		SUBCASE("Benchmark analysis and completion latency") {
+			const int iterations = 10;
+			uint64_t full_usec = 0;
+			uint64_t incremental_usec = 0;
+			for (int i = 0; i < iterations; i++) {
+				workspace->parse_script("res://lsp/incremental_analysis_other.gd", code); // Forces a full analysis of the next one.
+				uint64_t begin = OS::get_singleton()->get_ticks_usec();
+				workspace->parse_script(path, i % 2 ? code : edited_code);
+				full_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+				begin = OS::get_singleton()->get_ticks_usec();
+				workspace->parse_script(path, i % 2 ? edited_code : code);
+				incremental_usec += OS::get_singleton()->get_ticks_usec() - begin;
+			}
+
+			// Complete a member of the edited function's local, as when typing.
+			EditorSettings::get_singleton()->set_setting("text_editor/completion/use_single_quotes", false);
+			ExtendGDScriptParser *parser = workspace->parse_results[path];
+			const String completed_line = "\tvar edited := p_value * 2";
+			int line = parser->get_lines().find(completed_line);
+			REQUIRE(line >= 0);
+			String completion_code = parser->get_text_for_completion(pos(line, completed_line.length()));
+			uint64_t completion_usec = 0;
+			int option_count = 0;
+			for (int i = 0; i < iterations; i++) {
+				List<ScriptLanguage::CodeCompletionOption> options;
+				String call_hint;
+				bool forced = false;
+				uint64_t begin = OS::get_singleton()->get_ticks_usec();
+				GDScriptLanguage::get_singleton()->complete_code(completion_code, path, nullptr, &options, forced, call_hint);
+				completion_usec += OS::get_singleton()->get_ticks_usec() - begin;
+				option_count = options.size();
+			}
+			CHECK(option_count > 0);
+
+			MESSAGE(vformat("Editing a %d lines script: %d usec with a full analysis, %d usec when only the changed function is analyzed, %d usec for completion.", code.get_slice_count("\n"), full_usec / iterations, incremental_usec / iterations, completion_usec / iterations));
+		}
+
+		memdelete(proto);
+		finish_language();
+	}
+
+	TEST_CASE("[workspace][parse_script] Functions are analyzed again when what they use changes") {
+		GDScriptLanguageProtocol *proto = initialize(root);
+		REQUIRE(proto);
+		Ref<GDScriptWorkspace> workspace = GDScriptLanguageProtocol::get_singleton()->get_workspace();
+
+		const String path = "res://lsp/incremental_signatures.gd";
+		// Only the callee is edited, the body of the caller stays the same.
+		const String caller = "\nfunc caller() -> void:\n\tvar result: int = callee(1)\n\tprint(result)\n";
+		const String code = "extends Node\n\nfunc callee(p_value: int) -> int:\n\treturn p_value\n" + caller;
+		String edited_code;
+
+		SUBCASE("Return type of a function of the same script") {
+			edited_code = "extends Node\n\nfunc callee(p_value: int) -> String:\n\treturn str(p_value)\n" + caller;
+		}
+		SUBCASE("Parameter type of a function of the same script") {
+			edited_code = "extends Node\n\nfunc callee(p_value: String) -> int:\n\treturn p_value.length()\n" + caller;
+		}
+		SUBCASE("Name of a function of the same script") {
+			edited_code = "extends Node\n\nfunc renamed_callee(p_value: int) -> int:\n\treturn p_value\n" + caller;
+		}
+		SUBCASE("Function of another script") {
+			const String dependency_path = TestUtils::get_temp_path("lsp_incremental_dependency.gd");
+			Ref<FileAccess> f = FileAccess::open(dependency_path, FileAccess::WRITE);
+			f->store_string("static func callee(p_value: int) -> int:\n\treturn p_value\n");
+			f.unref();
+			const String dependent_code = vformat("extends Node\n\nconst Dependency = preload(\"%s\")\n\nfunc caller() -> void:\n\tvar result: int = Dependency.callee(1)\n\tprint(result)\n", dependency_path);
+
+			workspace->parse_script(path, dependent_code);
+			CHECK_FALSE(has_error(workspace->parse_results[path]));
+
+			f = FileAccess::open(dependency_path, FileAccess::WRITE);
+			f->store_string("static func callee(p_value: int) -> String:\n\treturn str(p_value)\n");
+			f.unref();
+			GDScriptCache::remove_script(dependency_path); // As when the script is saved.
+
+			workspace->parse_script(path, dependent_code);
+			const ExtendGDScriptParser *incremental = workspace->parse_results[path];
+			REQUIRE(incremental);
+			ExtendGDScriptParser full;
+			full.parse(dependent_code, path);
+			CHECK(get_diagnostic_lines(incremental) == get_diagnostic_lines(&full));
+			CHECK(has_error(incremental));
+
+			GDScriptCache::remove_script(dependency_path);
+			DirAccess::remove_absolute(dependency_path);
+		}
+
+		if (!edited_code.is_empty()) {
+			workspace->parse_script(path, code);
+			CHECK_FALSE(has_error(workspace->parse_results[path]));
+
+			workspace->parse_script(path, edited_code);
+			const ExtendGDScriptParser *incremental = workspace->parse_results[path];
+			REQUIRE(incremental);
+			ExtendGDScriptParser full;
+			full.parse(edited_code, path);
+			CHECK(get_diagnostic_lines(incremental) == get_diagnostic_lines(&full));
+			CHECK_MESSAGE(has_error(incremental), "The unchanged caller should be analyzed against the new signature.");
+		}
+
+		memdelete(proto);
+		finish_language();
+	}
 }
 
 } // namespace GDScriptTests
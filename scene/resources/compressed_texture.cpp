@@ -296,6 +296,26 @@ void CompressedTexture2D::reload_from_file() {
 void CompressedTexture2D::_validate_property(PropertyInfo &p_property) const {
 }
 
+// Decodes the next `p_size` bytes of the file. Files backed by memory (like memory-mapped packs) are decoded in place, without copying the payload first.
+static Ref<Image> _unpack_image(const Ref<FileAccess> &p_file, uint32_t p_size, ImageMemLoadFunc p_unpacker_ptr, Ref<Image> (*p_unpacker)(const Vector<uint8_t> &p_buffer)) {
+	if (p_unpacker_ptr) {
+		const uint8_t *src = p_file->get_buffer_ptr(p_size);
+		if (src) {
+			return p_unpacker_ptr(src, p_size);
+		}
+	}
+
+	if (!p_unpacker) {
+		p_file->seek(p_file->get_position() + p_size);
+		return Ref<Image>();
+	}
+
+	Vector<uint8_t> buffer;
+	buffer.resize(p_size);
+	p_file->get_buffer(buffer.ptrw(), p_size);
+	return p_unpacker(buffer);
+}
+
 Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_size_limit) {
 	uint32_t data_format = f->get_32();
 	uint32_t w = f->get_16();
@@ -326,18 +346,11 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 				continue;
 			}
 
-			Vector<uint8_t> pv;
-			pv.resize(size);
-			{
-				uint8_t *wr = pv.ptrw();
-				f->get_buffer(wr, size);
-			}
-
 			Ref<Image> img;
-			if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
-				img = Image::png_unpacker(pv);
-			} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
-				img = Image::webp_unpacker(pv);
+			if (data_format == DATA_FORMAT_PNG) {
+				img = _unpack_image(f, size, Image::_png_mem_unpacker_func, Image::png_unpacker);
+			} else {
+				img = _unpack_image(f, size, Image::_webp_mem_loader_func, Image::webp_unpacker);
 			}
 
 			if (img.is_null() || img->is_empty()) {
@@ -404,14 +417,7 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 			f->seek(f->get_position() + size);
 			return Ref<Image>();
 		}
-		Vector<uint8_t> pv;
-		pv.resize(size);
-		{
-			uint8_t *wr = pv.ptrw();
-			f->get_buffer(wr, size);
-		}
-		Ref<Image> img;
-		img = Image::basis_universal_unpacker(pv);
+		Ref<Image> img = _unpack_image(f, size, Image::basis_universal_unpacker_ptr, Image::basis_universal_unpacker);
 		if (img.is_null() || img->is_empty()) {
 			ERR_FAIL_COND_V(img.is_null() || img->is_empty(), Ref<Image>());
 		}
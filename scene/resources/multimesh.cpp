@@ -279,6 +279,15 @@ AABB MultiMesh::get_custom_aabb() const {
 	return custom_aabb;
 }
 
+void MultiMesh::set_use_gpu_culling(bool p_enable) {
+	use_gpu_culling = p_enable;
+	RS::get_singleton()->multimesh_set_gpu_culling(multimesh, use_gpu_culling);
+}
+
+bool MultiMesh::is_using_gpu_culling() const {
+	return use_gpu_culling;
+}
+
 AABB MultiMesh::get_aabb() const {
 	return RenderingServer::get_singleton()->multimesh_get_aabb(multimesh);
 }
@@ -338,6 +347,8 @@ void MultiMesh::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_instance_custom_data", "instance"), &MultiMesh::get_instance_custom_data);
 	ClassDB::bind_method(D_METHOD("set_custom_aabb", "aabb"), &MultiMesh::set_custom_aabb);
 	ClassDB::bind_method(D_METHOD("get_custom_aabb"), &MultiMesh::get_custom_aabb);
+	ClassDB::bind_method(D_METHOD("set_use_gpu_culling", "enable"), &MultiMesh::set_use_gpu_culling);
+	ClassDB::bind_method(D_METHOD("is_using_gpu_culling"), &MultiMesh::is_using_gpu_culling);
 	ClassDB::bind_method(D_METHOD("get_aabb"), &MultiMesh::get_aabb);
 
 	ClassDB::bind_method(D_METHOD("get_buffer"), &MultiMesh::get_buffer);
@@ -351,6 +362,7 @@ void MultiMesh::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "visible_instance_count", PROPERTY_HINT_RANGE, "-1,16384,1,or_greater"), "set_visible_instance_count", "get_visible_instance_count");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "mesh", PROPERTY_HINT_RESOURCE_TYPE, "Mesh"), "set_mesh", "get_mesh");
 	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "buffer", PROPERTY_HINT_NONE), "set_buffer", "get_buffer");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_gpu_culling"), "set_use_gpu_culling", "is_using_gpu_culling");
 
 #ifndef DISABLE_DEPRECATED
 	// Kept for compatibility from 3.x to 4.0.
@@ -51,6 +51,7 @@ private:
 	AABB custom_aabb;
 	bool use_colors = false;
 	bool use_custom_data = false;
+	bool use_gpu_culling = false;
 	int instance_count = 0;
 	int visible_instance_count = -1;
 
@@ -107,6 +108,9 @@ public:
 	void set_custom_aabb(const AABB &p_custom);
 	AABB get_custom_aabb() const;
 
+	void set_use_gpu_culling(bool p_enable);
+	bool is_using_gpu_culling() const;
+
 	virtual AABB get_aabb() const;
 
 	virtual RID get_rid() const override;
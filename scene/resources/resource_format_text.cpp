@@ -31,9 +31,14 @@
 #include "resource_format_text.h"
 
 #include "core/config/project_settings.h"
+#include "core/crypto/crypto_core.h"
+#include "core/extension/gdextension_manager.h"
 #include "core/io/dir_access.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/missing_resource.h"
+#include "core/io/resource_format_binary.h"
 #include "core/object/script_language.h"
+#include "core/version.h"
 
 // Version 2: Changed names for Basis, AABB, Vectors, etc.
 // Version 3: New string ID for ext/subresources, breaks forward compat.
@@ -160,6 +165,7 @@ Error ResourceLoaderText::_parse_ext_resource(VariantParser::Stream *p_stream, R
 						err = error;
 					} else {
 						ResourceLoader::notify_dependency_error(local_path, path, type);
+						missing_dependencies = true;
 					}
 				}
 			} else {
@@ -478,6 +484,7 @@ Error ResourceLoaderText::load() {
 				return error;
 			} else {
 				ResourceLoader::notify_dependency_error(local_path, path, type);
+				missing_dependencies = true;
 			}
 		}
 
@@ -500,6 +507,11 @@ Error ResourceLoaderText::load() {
 			break;
 		}
 
+		if (ResourceLoader::is_current_load_canceled()) {
+			error = ERR_SKIP;
+			return error;
+		}
+
 		if (!next_tag.fields.has("type")) {
 			error = ERR_FILE_CORRUPT;
 			error_text = "Missing 'type' in external resource tag";
@@ -1366,8 +1378,28 @@ Ref<Resource> ResourceFormatLoaderText::load(const String &p_path, const String
 
 	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), "Cannot open file '" + p_path + "'.");
 
-	ResourceLoaderText loader;
 	String path = !p_original_path.is_empty() ? p_original_path : p_path;
+
+#ifdef TOOLS_ENABLED
+	String cache_key;
+	Vector<uint8_t> source;
+	if (!binary_cache_dir.is_empty() && !p_path.begins_with(ProjectSettings::get_singleton()->get_project_data_path())) {
+		source = f->get_buffer(f->get_length());
+		cache_key = _get_binary_cache_key(source);
+		Ref<Resource> res = _load_from_binary_cache(p_path, cache_key, path, r_error, p_use_sub_threads, r_progress, p_cache_mode);
+		if (res.is_valid()) {
+			return res;
+		}
+
+		// Parse the text already read for the key.
+		Ref<FileAccessMemory> source_file;
+		source_file.instantiate();
+		source_file->open_custom(source.ptr(), source.size());
+		f = source_file;
+	}
+#endif
+
+	ResourceLoaderText loader;
 	switch (p_cache_mode) {
 		case CACHE_MODE_IGNORE:
 		case CACHE_MODE_REUSE:
@@ -1394,6 +1426,11 @@ Ref<Resource> ResourceFormatLoaderText::load(const String &p_path, const String
 		*r_error = err;
 	}
 	if (err == OK) {
+#ifdef TOOLS_ENABLED
+		if (!cache_key.is_empty()) {
+			_save_to_binary_cache(p_path, cache_key, loader);
+		}
+#endif
 		return loader.get_resource();
 	} else {
 		return Ref<Resource>();
@@ -1541,6 +1578,163 @@ Error ResourceFormatLoaderText::rename_dependencies(const String &p_path, const
 
 ResourceFormatLoaderText *ResourceFormatLoaderText::singleton = nullptr;
 
+#ifdef TOOLS_ENABLED
+String ResourceFormatLoaderText::binary_cache_dir;
+
+void ResourceFormatLoaderText::set_binary_cache_dir(const String &p_dir) {
+	if (!p_dir.is_empty() && !DirAccess::exists(p_dir)) {
+		Error err = DirAccess::make_dir_recursive_absolute(p_dir);
+		ERR_FAIL_COND_MSG(err != OK, "Cannot create the binary cache directory for text resources: " + p_dir);
+	}
+	binary_cache_dir = p_dir;
+}
+
+String ResourceFormatLoaderText::_get_binary_cache_path(const String &p_path) {
+	return binary_cache_dir.path_join(p_path.md5_text());
+}
+
+// Copies made by another engine build or in another binary format version are not reused, nor are
+// the ones made while other global classes or GDExtension libraries were loaded, which can change
+// how the same text is instantiated.
+String ResourceFormatLoaderText::_get_binary_cache_key(const Vector<uint8_t> &p_source) {
+	unsigned char hash[16];
+	CryptoCore::md5(p_source.ptr(), p_source.size(), hash);
+
+	List<StringName> global_classes;
+	ScriptServer::get_global_class_list(&global_classes);
+	global_classes.sort_custom<StringName::AlphCompare>();
+	String environment;
+	for (const StringName &E : global_classes) {
+		environment += String(E) + ":" + ScriptServer::get_global_class_path(E) + ":" + ScriptServer::get_global_class_base(E) + "\n";
+	}
+	Vector<String> extensions = GDExtensionManager::get_singleton()->get_loaded_extensions();
+	extensions.sort();
+	for (const String &E : extensions) {
+		Ref<GDExtension> extension = GDExtensionManager::get_singleton()->get_extension(E);
+		environment += E + ":" + itos(extension->get_library_last_modified_time()) + "\n";
+	}
+
+	return String::md5(hash) + "," + environment.md5_text() + "," + VERSION_FULL_BUILD + "," + VERSION_HASH + "," + itos(ResourceFormatSaverBinary::get_format_version());
+}
+
+// The ".info" file holds the key of the source file, then the amount of scripts it uses and their
+// modification times, then the IDs of its external resources, which the text saver keeps when the
+// resource is saved again.
+Ref<Resource> ResourceFormatLoaderText::_load_from_binary_cache(const String &p_path, const String &p_key, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) {
+	const String cache_path = _get_binary_cache_path(p_path);
+	Ref<FileAccess> info = FileAccess::open(cache_path + ".info", FileAccess::READ);
+	if (info.is_null() || info->get_line() != p_key || !FileAccess::exists(cache_path + ".res")) {
+		return Ref<Resource>();
+	}
+
+	// Changed scripts can export other properties, or other defaults.
+	const int script_count = info->get_line().to_int();
+	for (int i = 0; i < script_count; i++) {
+		const String line = info->get_line();
+		const String modified_time = line.get_slice("::", 0);
+		if (line.is_empty() || FileAccess::get_modified_time(line.substr(modified_time.length() + 2)) != (uint64_t)modified_time.to_int()) {
+			return Ref<Resource>();
+		}
+	}
+
+	Ref<ResourceFormatLoaderBinary> binary_loader;
+	binary_loader.instantiate();
+	Error err = OK;
+	Ref<Resource> res = binary_loader->load(cache_path + ".res", p_original_path, &err, p_use_sub_threads, r_progress, p_cache_mode);
+	if (res.is_null()) {
+		return Ref<Resource>(); // Parse the text instead.
+	}
+
+	const String local_path = ProjectSettings::get_singleton()->localize_path(p_original_path);
+	String line = info->get_line();
+	while (!line.is_empty()) {
+		const String id = line.get_slice("::", 0);
+		Ref<Resource> ext_resource = ResourceCache::get_ref(line.substr(id.length() + 2));
+		if (ext_resource.is_valid()) {
+			ext_resource->set_id_for_path(local_path, id);
+		}
+		line = info->get_line();
+	}
+
+	if (r_error) {
+		*r_error = OK;
+	}
+	return res;
+}
+
+// Both files are written under temporary names, then renamed. The old ".info" goes first,
+// so an interrupted update leaves a miss rather than a copy paired with the wrong key.
+void ResourceFormatLoaderText::_save_to_binary_cache(const String &p_path, const String &p_key, const ResourceLoaderText &p_loader) {
+	if (p_loader.missing_dependencies) {
+		return; // They would stay missing until the source file changes.
+	}
+
+	const String cache_path = _get_binary_cache_path(p_path);
+	if (ResourceFormatSaverBinary::singleton->save(p_loader.resource, cache_path + ".res.tmp") != OK) {
+		return;
+	}
+
+	{
+		Ref<FileAccess> info = FileAccess::open(cache_path + ".info.tmp", FileAccess::WRITE);
+		ERR_FAIL_COND(info.is_null());
+		info->store_line(p_key);
+		Vector<String> scripts;
+		for (const KeyValue<String, ResourceLoaderText::ExtResource> &E : p_loader.ext_resources) {
+			if (ClassDB::is_parent_class(E.value.type, SNAME("Script"))) {
+				scripts.push_back(itos(FileAccess::get_modified_time(E.value.path)) + "::" + E.value.path);
+			}
+		}
+		info->store_line(itos(scripts.size()));
+		for (const String &E : scripts) {
+			info->store_line(E);
+		}
+		for (const KeyValue<String, ResourceLoaderText::ExtResource> &E : p_loader.ext_resources) {
+			info->store_line(E.key + "::" + E.value.path);
+		}
+	}
+
+	Ref<DirAccess> da = DirAccess::create_for_path(cache_path);
+	if (da->file_exists(cache_path + ".info")) {
+		ERR_FAIL_COND(da->remove(cache_path + ".info") != OK);
+	}
+	ERR_FAIL_COND(da->rename(cache_path + ".res.tmp", cache_path + ".res") != OK);
+	ERR_FAIL_COND(da->rename(cache_path + ".info.tmp", cache_path + ".info") != OK);
+}
+
+void ResourceFormatLoaderText::prune_binary_cache(const HashSet<String> &p_paths) {
+	if (binary_cache_dir.is_empty()) {
+		return;
+	}
+
+	HashSet<String> names;
+	for (const String &E : p_paths) {
+		names.insert(E.md5_text());
+	}
+
+	Ref<DirAccess> da = DirAccess::open(binary_cache_dir);
+	ERR_FAIL_COND(da.is_null());
+	for (const String &file : da->get_files()) {
+		// Also removes the temporary files of interrupted updates.
+		if (!names.has(file.get_slice(".", 0))) {
+			da->remove(file);
+		}
+	}
+}
+
+void ResourceFormatLoaderText::remove_from_binary_cache(const String &p_path) {
+	if (binary_cache_dir.is_empty()) {
+		return;
+	}
+
+	const String cache_path = _get_binary_cache_path(p_path);
+	Ref<DirAccess> da = DirAccess::create_for_path(cache_path);
+	if (da->file_exists(cache_path + ".info")) {
+		da->remove(cache_path + ".info");
+		da->remove(cache_path + ".res");
+	}
+}
+#endif
+
 /*****************************************************************************************************/
 
 String ResourceFormatSaverTextInstance::_write_resources(void *ud, const Ref<Resource> &p_resource) {
@@ -74,6 +74,7 @@ class ResourceLoaderText {
 
 	bool use_sub_threads = false;
 	float *progress = nullptr;
+	bool missing_dependencies = false;
 
 	mutable int lines = 0;
 
@@ -132,6 +133,16 @@ public:
 };
 
 class ResourceFormatLoaderText : public ResourceFormatLoader {
+#ifdef TOOLS_ENABLED
+	// Binary copies of text resources, loaded instead while the source file is unchanged.
+	static String binary_cache_dir;
+
+	static String _get_binary_cache_path(const String &p_path);
+	static String _get_binary_cache_key(const Vector<uint8_t> &p_source);
+	static Ref<Resource> _load_from_binary_cache(const String &p_path, const String &p_key, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode);
+	static void _save_to_binary_cache(const String &p_path, const String &p_key, const ResourceLoaderText &p_loader);
+#endif
+
 public:
 	static ResourceFormatLoaderText *singleton;
 	virtual Ref<Resource> load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr, bool p_use_sub_threads = false, float *r_progress = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE) override;
@@ -146,6 +157,14 @@ public:
 	virtual void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types = false) override;
 	virtual Error rename_dependencies(const String &p_path, const HashMap<String, String> &p_map) override;
 
+#ifdef TOOLS_ENABLED
+	// Set by the editor file system, empty disables the cache.
+	static void set_binary_cache_dir(const String &p_dir);
+	static void remove_from_binary_cache(const String &p_path);
+	// Removes the copies of files that aren't in `p_paths` anymore.
+	static void prune_binary_cache(const HashSet<String> &p_paths);
+#endif
+
 	ResourceFormatLoaderText() { singleton = this; }
 };
 
@@ -52,6 +52,7 @@ private:
 
 	struct DummyMultiMesh {
 		PackedFloat32Array buffer;
+		int stride = 0;
 	};
 
 	mutable RID_Owner<DummyMultiMesh> multimesh_owner;
@@ -150,7 +151,7 @@ public:
 	virtual void multimesh_initialize(RID p_rid) override;
 	virtual void multimesh_free(RID p_rid) override;
 
-	virtual void multimesh_allocate_data(RID p_multimesh, int p_instances, RS::MultimeshTransformFormat p_transform_format, bool p_use_colors = false, bool p_use_custom_data = false) override {}
+	virtual void multimesh_allocate_data(RID p_multimesh, int p_instances, RS::MultimeshTransformFormat p_transform_format, bool p_use_colors = false, bool p_use_custom_data = false) override;
 	virtual int multimesh_get_instance_count(RID p_multimesh) const override { return 0; }
 
 	virtual void multimesh_set_mesh(RID p_multimesh, RID p_mesh) override {}
@@ -170,10 +171,13 @@ public:
 	virtual Color multimesh_instance_get_color(RID p_multimesh, int p_index) const override { return Color(); }
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const override { return Color(); }
 	virtual void multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_buffer) override;
+	virtual void multimesh_set_buffer_range(RID p_multimesh, int p_from_instance, const Vector<float> &p_buffer) override;
 	virtual Vector<float> multimesh_get_buffer(RID p_multimesh) const override;
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible) override {}
 	virtual int multimesh_get_visible_instances(RID p_multimesh) const override { return 0; }
+	virtual void multimesh_set_gpu_culling(RID p_multimesh, bool p_enable) override {}
+	virtual bool multimesh_is_gpu_culling_enabled(RID p_multimesh) const override { return false; }
 
 	/* SKELETON API */
 
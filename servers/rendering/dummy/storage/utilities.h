@@ -125,6 +125,8 @@ public:
 	virtual String get_video_adapter_api_version() const override { return String(); }
 
 	virtual Size2i get_maximum_viewport_size() const override { return Size2i(); };
+
+	virtual Vector<String> get_shader_cache_files() const override { return Vector<String>(); }
 };
 
 } // namespace RendererDummy
@@ -462,7 +462,15 @@ void RenderForwardClustered::_render_list_template(RenderingDevice::DrawListID p
 			mesh_storage->mesh_surface_get_vertex_arrays_and_format(mesh_surface, pipeline->get_vertex_input_mask(), pipeline_motion_vectors, vertex_array_rd, vertex_format);
 		}
 
-		index_array_rd = mesh_storage->mesh_surface_get_index_array(mesh_surface, element_info.lod_index);
+		// Multimeshes culled on the GPU draw each LOD from its own buffer of visible instances.
+		bool gpu_culled = (surf->owner->base_flags & (INSTANCE_DATA_FLAG_MULTIMESH | INSTANCE_DATA_FLAG_PARTICLES)) == INSTANCE_DATA_FLAG_MULTIMESH && mesh_surface == surf->surface && mesh_storage->multimesh_is_gpu_culled(surf->owner->data->base, p_params->multimesh_gpu_cull_pass);
+
+		if (gpu_culled) {
+			xforms_uniform_set = mesh_storage->multimesh_get_gpu_cull_3d_uniform_set(surf->owner->data->base, 0, scene_shader.default_shader_rd, TRANSFORMS_UNIFORM_SET);
+			index_array_rd = mesh_storage->mesh_surface_get_index_array(mesh_surface, 0);
+		} else {
+			index_array_rd = mesh_storage->mesh_surface_get_index_array(mesh_surface, element_info.lod_index);
+		}
 
 		if (prev_vertex_array_rd != vertex_array_rd) {
 			RD::get_singleton()->draw_list_bind_vertex_array(draw_list, vertex_array_rd);
@@ -501,7 +509,7 @@ void RenderForwardClustered::_render_list_template(RenderingDevice::DrawListID p
 
 		if (surf->owner->base_flags & INSTANCE_DATA_FLAG_PARTICLES) {
 			particles_storage->particles_get_instance_buffer_motion_vectors_offsets(surf->owner->data->base, push_constant.multimesh_motion_vectors_current_offset, push_constant.multimesh_motion_vectors_previous_offset);
-		} else if (surf->owner->base_flags & INSTANCE_DATA_FLAG_MULTIMESH) {
+		} else if ((surf->owner->base_flags & INSTANCE_DATA_FLAG_MULTIMESH) && !gpu_culled) {
 			mesh_storage->_multimesh_get_motion_vectors_offsets(surf->owner->data->base, push_constant.multimesh_motion_vectors_current_offset, push_constant.multimesh_motion_vectors_previous_offset);
 		} else {
 			push_constant.multimesh_motion_vectors_current_offset = 0;
@@ -515,7 +523,33 @@ void RenderForwardClustered::_render_list_template(RenderingDevice::DrawListID p
 			instance_count /= surf->owner->trail_steps;
 		}
 
-		RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid(), instance_count);
+		if (gpu_culled) {
+			RID multimesh = surf->owner->data->base;
+			RID command_buffer = mesh_storage->multimesh_get_gpu_cull_command_buffer(multimesh);
+			uint32_t lod_count = mesh_storage->multimesh_get_gpu_cull_lod_count(multimesh);
+			uint32_t surface_lod_count = mesh_storage->mesh_surface_get_lod_count(mesh_surface);
+
+			for (uint32_t lod = 0; lod < lod_count; lod++) {
+				index_array_rd = mesh_storage->mesh_surface_get_index_array(mesh_surface, MIN(lod, surface_lod_count));
+				if (prev_index_array_rd != index_array_rd) {
+					if (index_array_rd.is_valid()) {
+						RD::get_singleton()->draw_list_bind_index_array(draw_list, index_array_rd);
+					}
+					prev_index_array_rd = index_array_rd;
+				}
+
+				xforms_uniform_set = mesh_storage->multimesh_get_gpu_cull_3d_uniform_set(multimesh, lod, scene_shader.default_shader_rd, TRANSFORMS_UNIFORM_SET);
+				if (prev_xforms_uniform_set != xforms_uniform_set) {
+					RD::get_singleton()->draw_list_bind_uniform_set(draw_list, xforms_uniform_set, TRANSFORMS_UNIFORM_SET);
+					prev_xforms_uniform_set = xforms_uniform_set;
+				}
+
+				// The instance count was written by the culling compute shader.
+				RD::get_singleton()->draw_list_draw_indirect(draw_list, index_array_rd.is_valid(), command_buffer, mesh_storage->multimesh_get_gpu_cull_command_offset(multimesh, lod, surf->surface_index));
+			}
+		} else {
+			RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid(), instance_count);
+		}
 		i += element_info.repeat - 1; //skip equal elements
 	}
 
@@ -802,6 +836,61 @@ _FORCE_INLINE_ static uint32_t _indices_to_primitives(RS::PrimitiveType p_primit
 	static const uint32_t subtractor[RS::PRIMITIVE_MAX] = { 0, 0, 1, 0, 1 };
 	return (p_indices - subtractor[p_primitive]) / divisor[p_primitive];
 }
+void RenderForwardClustered::_update_multimesh_gpu_culling(const RenderDataRD *p_render_data) {
+	RendererRD::MeshStorage *mesh_storage = RendererRD::MeshStorage::get_singleton();
+
+	// Results from previous passes (other viewports, reflection probes) are no longer valid.
+	multimesh_gpu_cull_pass++;
+	multimesh_gpu_cull_list.clear();
+
+	if (p_render_data->scene_data->view_count > 1) {
+		// Instances are culled against a single frustum.
+		return;
+	}
+
+	// Culling results are stored in the multimesh, so they would be shared by all its instances.
+	// Multimeshes used by more than one instance are drawn without GPU culling instead.
+	multimesh_gpu_cull_instances.clear();
+	for (int i = 0; i < (int)p_render_data->instances->size(); i++) {
+		GeometryInstanceForwardClustered *inst = static_cast<GeometryInstanceForwardClustered *>((*p_render_data->instances)[i]);
+		if (inst->data->base_type != RS::INSTANCE_MULTIMESH || !mesh_storage->multimesh_is_gpu_culling_enabled(inst->data->base)) {
+			continue;
+		}
+
+		int *E = multimesh_gpu_cull_instances.getptr(inst->data->base);
+		if (E) {
+			*E = -1; // Shared.
+		} else {
+			multimesh_gpu_cull_instances.insert(inst->data->base, i);
+		}
+	}
+
+	for (const KeyValue<RID, int> &E : multimesh_gpu_cull_instances) {
+		if (E.value < 0) {
+			continue;
+		}
+		GeometryInstanceForwardClustered *inst = static_cast<GeometryInstanceForwardClustered *>((*p_render_data->instances)[E.value]);
+
+		if (mesh_storage->multimesh_gpu_cull_setup(inst->data->base, multimesh_gpu_cull_pass, inst->transform, p_render_data->scene_data->cam_projection, p_render_data->scene_data->cam_transform, p_render_data->scene_data->cam_orthogonal, p_render_data->scene_data->lod_distance_multiplier, p_render_data->scene_data->screen_mesh_lod_threshold, inst->lod_bias)) {
+			multimesh_gpu_cull_list.push_back(inst->data->base);
+		}
+	}
+
+	if (multimesh_gpu_cull_list.is_empty()) {
+		return;
+	}
+
+	RD::get_singleton()->draw_command_begin_label("Cull MultiMesh Instances");
+
+	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
+	for (const RID &multimesh : multimesh_gpu_cull_list) {
+		mesh_storage->multimesh_gpu_cull_dispatch(compute_list, multimesh);
+	}
+	RD::get_singleton()->compute_list_end();
+
+	RD::get_singleton()->draw_command_end_label();
+}
+
 void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, const RenderDataRD *p_render_data, PassMode p_pass_mode, bool p_using_sdfgi, bool p_using_opaque_gi, bool p_using_motion_pass, bool p_append) {
 	RendererRD::MeshStorage *mesh_storage = RendererRD::MeshStorage::get_singleton();
 	uint64_t frame = RSG::rasterizer->get_frame_number();
@@ -1753,6 +1842,8 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 
 	RD::get_singleton()->draw_command_end_label();
 
+	_update_multimesh_gpu_culling(p_render_data);
+
 	if (!is_reflection_probe) {
 		if (using_voxelgi) {
 			depth_pass_mode = PASS_MODE_DEPTH_NORMAL_ROUGHNESS_VOXEL_GI;
@@ -1946,6 +2037,7 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 
 		bool finish_depth = using_ssao || using_ssil || using_sdfgi || using_voxelgi || ce_pre_opaque_resolved_depth || ce_post_opaque_resolved_depth;
 		RenderListParameters render_list_params(render_list[RENDER_LIST_OPAQUE].elements.ptr(), render_list[RENDER_LIST_OPAQUE].element_info.ptr(), render_list[RENDER_LIST_OPAQUE].elements.size(), reverse_cull, depth_pass_mode, 0, rb_data.is_null(), p_render_data->directional_light_soft_shadows, rp_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME, Vector2(), p_render_data->scene_data->lod_distance_multiplier, p_render_data->scene_data->screen_mesh_lod_threshold, p_render_data->scene_data->view_count, 0, spec_constant_base_flags);
+		render_list_params.multimesh_gpu_cull_pass = multimesh_gpu_cull_pass;
 		_render_list_with_draw_list(&render_list_params, depth_framebuffer, needs_pre_resolve ? RD::INITIAL_ACTION_LOAD : RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_STORE, needs_pre_resolve ? RD::INITIAL_ACTION_LOAD : RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_STORE, needs_pre_resolve ? Vector<Color>() : depth_pass_clear);
 
 		RD::get_singleton()->draw_command_end_label();
@@ -2025,6 +2117,7 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 			uint32_t opaque_color_pass_flags = using_motion_pass ? (color_pass_flags & ~COLOR_PASS_FLAG_MOTION_VECTORS) : color_pass_flags;
 			RID opaque_framebuffer = using_motion_pass ? rb_data->get_color_pass_fb(opaque_color_pass_flags) : color_framebuffer;
 			RenderListParameters render_list_params(render_list[RENDER_LIST_OPAQUE].elements.ptr(), render_list[RENDER_LIST_OPAQUE].element_info.ptr(), render_list[RENDER_LIST_OPAQUE].elements.size(), reverse_cull, PASS_MODE_COLOR, opaque_color_pass_flags, rb_data.is_null(), p_render_data->directional_light_soft_shadows, rp_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME, Vector2(), p_render_data->scene_data->lod_distance_multiplier, p_render_data->scene_data->screen_mesh_lod_threshold, p_render_data->scene_data->view_count, 0, spec_constant_base_flags);
+			render_list_params.multimesh_gpu_cull_pass = multimesh_gpu_cull_pass;
 			_render_list_with_draw_list(&render_list_params, opaque_framebuffer, load_color ? RD::INITIAL_ACTION_LOAD : RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_STORE, depth_pre_pass ? RD::INITIAL_ACTION_LOAD : RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_STORE, c, 0.0, 0);
 		}
 
@@ -2045,6 +2138,7 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 			rp_uniform_set = _setup_render_pass_uniform_set(RENDER_LIST_MOTION, p_render_data, radiance_texture, samplers, true);
 
 			RenderListParameters render_list_params(render_list[RENDER_LIST_MOTION].elements.ptr(), render_list[RENDER_LIST_MOTION].element_info.ptr(), render_list[RENDER_LIST_MOTION].elements.size(), reverse_cull, PASS_MODE_COLOR, color_pass_flags, rb_data.is_null(), p_render_data->directional_light_soft_shadows, rp_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME, Vector2(), p_render_data->scene_data->lod_distance_multiplier, p_render_data->scene_data->screen_mesh_lod_threshold, p_render_data->scene_data->view_count, 0, spec_constant_base_flags);
+			render_list_params.multimesh_gpu_cull_pass = multimesh_gpu_cull_pass;
 			_render_list_with_draw_list(&render_list_params, color_framebuffer, RD::INITIAL_ACTION_LOAD, RD::FINAL_ACTION_STORE, RD::INITIAL_ACTION_LOAD, RD::FINAL_ACTION_STORE);
 
 			RD::get_singleton()->draw_command_end_label();
@@ -2224,6 +2318,7 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 
 		RID alpha_framebuffer = rb_data.is_valid() ? rb_data->get_color_pass_fb(transparent_color_pass_flags) : color_only_framebuffer;
 		RenderListParameters render_list_params(render_list[RENDER_LIST_ALPHA].elements.ptr(), render_list[RENDER_LIST_ALPHA].element_info.ptr(), render_list[RENDER_LIST_ALPHA].elements.size(), false, PASS_MODE_COLOR, transparent_color_pass_flags, rb_data.is_null(), p_render_data->directional_light_soft_shadows, rp_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME, Vector2(), p_render_data->scene_data->lod_distance_multiplier, p_render_data->scene_data->screen_mesh_lod_threshold, p_render_data->scene_data->view_count, 0, spec_constant_base_flags);
+		render_list_params.multimesh_gpu_cull_pass = multimesh_gpu_cull_pass;
 		_render_list_with_draw_list(&render_list_params, alpha_framebuffer, RD::INITIAL_ACTION_LOAD, RD::FINAL_ACTION_STORE, RD::INITIAL_ACTION_LOAD, RD::FINAL_ACTION_STORE);
 	}
 
@@ -212,6 +212,7 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		uint32_t element_offset = 0;
 		bool use_directional_soft_shadow = false;
 		uint32_t spec_constant_base_flags = 0;
+		uint64_t multimesh_gpu_cull_pass = 0; // Non-zero if multimeshes culled on the GPU for this camera can be drawn indirectly.
 
 		RenderListParameters(GeometryInstanceSurfaceDataCache **p_elements, RenderElementInfo *p_element_info, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, uint32_t p_color_pass_flags, bool p_no_gi, bool p_use_directional_soft_shadows, RID p_render_pass_uniform_set, bool p_force_wireframe = false, const Vector2 &p_uv_offset = Vector2(), float p_lod_distance_multiplier = 0.0, float p_screen_mesh_lod_threshold = 0.0, uint32_t p_view_count = 1, uint32_t p_element_offset = 0, uint32_t p_spec_constant_base_flags = 0) {
 			elements = p_elements;
@@ -384,6 +385,11 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 	void _fill_instance_data(RenderListType p_render_list, int *p_render_info = nullptr, uint32_t p_offset = 0, int32_t p_max_elements = -1, bool p_update_buffer = true);
 	void _fill_render_list(RenderListType p_render_list, const RenderDataRD *p_render_data, PassMode p_pass_mode, bool p_using_sdfgi = false, bool p_using_opaque_gi = false, bool p_using_motion_pass = false, bool p_append = false);
 
+	uint64_t multimesh_gpu_cull_pass = 0;
+	LocalVector<RID> multimesh_gpu_cull_list;
+	HashMap<RID, int> multimesh_gpu_cull_instances; // Index in the instance list, -1 if the multimesh is used by several instances.
+	void _update_multimesh_gpu_culling(const RenderDataRD *p_render_data);
+
 	HashMap<Size2i, RID> sdfgi_framebuffer_size_cache;
 
 	struct GeometryInstanceData;
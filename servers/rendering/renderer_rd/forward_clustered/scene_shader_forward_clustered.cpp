@@ -381,6 +381,15 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 
 						RID shader_variant = shader_singleton->shader.version_get_shader(version, variant);
 						color_pipelines[i][j][l].setup(shader_variant, primitive_rd, raster_state, multisample_state, depth_stencil, blend_state, 0, singleton->default_specialization_constants);
+
+						// Lightmapped variants live in the advanced group, which compiles in the background when first needed.
+						// Meanwhile draw without baked lighting instead of stalling. Other advanced flags change the render targets.
+						if ((l & PIPELINE_COLOR_PASS_FLAG_LIGHTMAP) && !(l & (PIPELINE_COLOR_PASS_FLAG_SEPARATE_SPECULAR | PIPELINE_COLOR_PASS_FLAG_MOTION_VECTORS))) {
+							int fallback_l = l & ~PIPELINE_COLOR_PASS_FLAG_LIGHTMAP;
+							if (shader_singleton->valid_color_pass_pipelines[fallback_l]) {
+								color_pipelines[i][j][l].set_fallback(&color_pipelines[i][j][fallback_l]);
+							}
+						}
 					}
 				} else {
 					RD::PipelineColorBlendState blend_state;
@@ -30,16 +30,287 @@
 
 #include "pipeline_cache_rd.h"
 
+#include "core/io/file_access.h"
 #include "core/os/memory.h"
 
-RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+#define WARMUP_MANIFEST_VERSION 1
+
+// Shared by all the caches. Vertex and framebuffer formats are stored by description, since their IDs
+// are only stable within a run. They are created again when the manifest is loaded so runtime IDs can be
+// mapped back and forth to the stored indices.
+static struct PipelineWarmupManifest {
+	struct FramebufferFormat {
+		Vector<RD::AttachmentFormat> attachments;
+		Vector<RD::FramebufferPass> passes;
+		uint32_t view_count = 1;
+	};
+
+	struct Entry {
+		int32_t vertex_format = -1; // -1 means no vertex input.
+		int32_t framebuffer_format = -1; // -1 means the default (empty) framebuffer format.
+		uint32_t render_pass = 0;
+		bool wireframe = false;
+		uint32_t bool_specializations = 0;
+
+		bool operator==(const Entry &p_other) const {
+			return vertex_format == p_other.vertex_format && framebuffer_format == p_other.framebuffer_format && render_pass == p_other.render_pass && wireframe == p_other.wireframe && bool_specializations == p_other.bool_specializations;
+		}
+	};
+
+	Mutex mutex;
+	Vector<Vector<RD::VertexAttribute>> vertex_formats;
+	Vector<FramebufferFormat> framebuffer_formats;
+	LocalVector<RD::VertexFormatID> vertex_format_ids;
+	LocalVector<RD::FramebufferFormatID> framebuffer_format_ids;
+	HashMap<RD::VertexFormatID, int32_t> vertex_format_indices;
+	HashMap<RD::FramebufferFormatID, int32_t> framebuffer_format_indices;
+	HashMap<uint32_t, LocalVector<Entry>> entries; // Keyed by pipeline state hash.
+	bool dirty = false;
+
+	SafeNumeric<uint64_t> pending;
+	SafeNumeric<uint64_t> compiled;
+
+	bool get_vertex_format_index(RD::VertexFormatID p_id, int32_t &r_index) {
+		if (p_id == RD::INVALID_ID) {
+			r_index = -1;
+			return true;
+		}
+		const int32_t *index = vertex_format_indices.getptr(p_id);
+		if (index) {
+			r_index = *index;
+			return true;
+		}
+
+		r_index = vertex_formats.size();
+		vertex_formats.push_back(RD::get_singleton()->vertex_format_get_attributes(p_id));
+		vertex_format_ids.push_back(p_id);
+		vertex_format_indices[p_id] = r_index;
+		return true;
+	}
+
+	bool get_framebuffer_format_index(RD::FramebufferFormatID p_id, int32_t &r_index) {
+		if (p_id == RD::INVALID_ID) {
+			r_index = -1;
+			return true;
+		}
+		const int32_t *index = framebuffer_format_indices.getptr(p_id);
+		if (index) {
+			r_index = *index;
+			return true;
+		}
+
+		FramebufferFormat format;
+		if (!RD::get_singleton()->framebuffer_format_get_description(p_id, format.attachments, format.passes, format.view_count)) {
+			return false;
+		}
+		if (format.attachments.is_empty()) {
+			// Empty formats carry their sample count outside of the description, so they can't be recreated reliably.
+			return false;
+		}
+
+		r_index = framebuffer_formats.size();
+		framebuffer_formats.push_back(format);
+		framebuffer_format_ids.push_back(p_id);
+		framebuffer_format_indices[p_id] = r_index;
+		return true;
+	}
+
+	void record(uint32_t p_state_hash, RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+		MutexLock lock(mutex);
+
+		Entry entry;
+		if (!get_vertex_format_index(p_vertex_format_id, entry.vertex_format) || !get_framebuffer_format_index(p_framebuffer_format_id, entry.framebuffer_format)) {
+			return;
+		}
+		entry.render_pass = p_render_pass;
+		entry.wireframe = p_wireframe;
+		entry.bool_specializations = p_bool_specializations;
+
+		LocalVector<Entry> &state_entries = entries[p_state_hash];
+		if (state_entries.has(entry)) {
+			return;
+		}
+		state_entries.push_back(entry);
+		dirty = true;
+	}
+} warmup_manifest;
+
+String PipelineCacheRD::warmup_manifest_path;
+
+uint32_t PipelineCacheRD::_compute_state_hash() const {
+	uint32_t shader_hash = RD::get_singleton()->shader_get_bytecode_hash(shader);
+	if (shader_hash == 0) {
+		return 0; // Still a placeholder.
+	}
+
+	uint32_t h = hash_murmur3_one_32(shader_hash);
+	h = hash_murmur3_one_32(render_primitive, h);
+	h = hash_murmur3_one_32(dynamic_state_flags, h);
+
+	h = hash_murmur3_one_32(rasterization_state.enable_depth_clamp, h);
+	h = hash_murmur3_one_32(rasterization_state.discard_primitives, h);
+	h = hash_murmur3_one_32(rasterization_state.wireframe, h);
+	h = hash_murmur3_one_32(rasterization_state.cull_mode, h);
+	h = hash_murmur3_one_32(rasterization_state.front_face, h);
+	h = hash_murmur3_one_32(rasterization_state.depth_bias_enabled, h);
+	h = hash_murmur3_one_float(rasterization_state.depth_bias_constant_factor, h);
+	h = hash_murmur3_one_float(rasterization_state.depth_bias_clamp, h);
+	h = hash_murmur3_one_float(rasterization_state.depth_bias_slope_factor, h);
+	h = hash_murmur3_one_float(rasterization_state.line_width, h);
+	h = hash_murmur3_one_32(rasterization_state.patch_control_points, h);
+
+	// Sample count is taken from the framebuffer format of each version.
+	h = hash_murmur3_one_32(multisample_state.enable_sample_shading, h);
+	h = hash_murmur3_one_float(multisample_state.min_sample_shading, h);
+	for (int i = 0; i < multisample_state.sample_mask.size(); i++) {
+		h = hash_murmur3_one_32(multisample_state.sample_mask[i], h);
+	}
+	h = hash_murmur3_one_32(multisample_state.enable_alpha_to_coverage, h);
+	h = hash_murmur3_one_32(multisample_state.enable_alpha_to_one, h);
+
+	h = hash_murmur3_one_32(depth_stencil_state.enable_depth_test, h);
+	h = hash_murmur3_one_32(depth_stencil_state.enable_depth_write, h);
+	h = hash_murmur3_one_32(depth_stencil_state.depth_compare_operator, h);
+	h = hash_murmur3_one_32(depth_stencil_state.enable_depth_range, h);
+	h = hash_murmur3_one_float(depth_stencil_state.depth_range_min, h);
+	h = hash_murmur3_one_float(depth_stencil_state.depth_range_max, h);
+	h = hash_murmur3_one_32(depth_stencil_state.enable_stencil, h);
+	const RD::PipelineDepthStencilState::StencilOperationState *stencil_ops[2] = { &depth_stencil_state.front_op, &depth_stencil_state.back_op };
+	for (const RD::PipelineDepthStencilState::StencilOperationState *op : stencil_ops) {
+		h = hash_murmur3_one_32(op->fail, h);
+		h = hash_murmur3_one_32(op->pass, h);
+		h = hash_murmur3_one_32(op->depth_fail, h);
+		h = hash_murmur3_one_32(op->compare, h);
+		h = hash_murmur3_one_32(op->compare_mask, h);
+		h = hash_murmur3_one_32(op->write_mask, h);
+		h = hash_murmur3_one_32(op->reference, h);
+	}
+
+	h = hash_murmur3_one_32(blend_state.enable_logic_op, h);
+	h = hash_murmur3_one_32(blend_state.logic_op, h);
+	h = hash_murmur3_one_float(blend_state.blend_constant.r, h);
+	h = hash_murmur3_one_float(blend_state.blend_constant.g, h);
+	h = hash_murmur3_one_float(blend_state.blend_constant.b, h);
+	h = hash_murmur3_one_float(blend_state.blend_constant.a, h);
+	for (int i = 0; i < blend_state.attachments.size(); i++) {
+		const RD::PipelineColorBlendState::Attachment &a = blend_state.attachments[i];
+		h = hash_murmur3_one_32(a.enable_blend, h);
+		h = hash_murmur3_one_32(a.src_color_blend_factor, h);
+		h = hash_murmur3_one_32(a.dst_color_blend_factor, h);
+		h = hash_murmur3_one_32(a.color_blend_op, h);
+		h = hash_murmur3_one_32(a.src_alpha_blend_factor, h);
+		h = hash_murmur3_one_32(a.dst_alpha_blend_factor, h);
+		h = hash_murmur3_one_32(a.alpha_blend_op, h);
+		h = hash_murmur3_one_32(uint32_t(a.write_r) | (uint32_t(a.write_g) << 1) | (uint32_t(a.write_b) << 2) | (uint32_t(a.write_a) << 3), h);
+	}
+
+	for (int i = 0; i < base_specialization_constants.size(); i++) {
+		const RD::PipelineSpecializationConstant &sc = base_specialization_constants[i];
+		h = hash_murmur3_one_32(sc.type, h);
+		h = hash_murmur3_one_32(sc.constant_id, h);
+		h = hash_murmur3_one_32(sc.int_value, h);
+	}
+
+	h = hash_fmix32(h);
+	return h != 0 ? h : 1;
+}
+
+void PipelineCacheRD::_warmup_start() {
+	if (warmup_manifest_path.is_empty() || state_hash == 0) {
+		return;
+	}
+
+	{
+		MutexLock lock(warmup_manifest.mutex);
+		const LocalVector<PipelineWarmupManifest::Entry> *entries = warmup_manifest.entries.getptr(state_hash);
+		if (!entries) {
+			return;
+		}
+
+		warmup_versions.clear();
+		for (const PipelineWarmupManifest::Entry &E : *entries) {
+			WarmupVersion version;
+			version.vertex_id = E.vertex_format < 0 ? RD::INVALID_ID : warmup_manifest.vertex_format_ids[E.vertex_format];
+			version.framebuffer_id = E.framebuffer_format < 0 ? RD::INVALID_ID : warmup_manifest.framebuffer_format_ids[E.framebuffer_format];
+			if ((E.vertex_format >= 0 && version.vertex_id == RD::INVALID_ID) || (E.framebuffer_format >= 0 && version.framebuffer_id == RD::INVALID_ID)) {
+				continue; // Format could not be recreated on this device.
+			}
+			version.render_pass = E.render_pass;
+			version.wireframe = E.wireframe;
+			version.bool_specializations = E.bool_specializations;
+			warmup_versions.push_back(version);
+		}
+	}
+
+	if (warmup_versions.is_empty()) {
+		return;
+	}
+
+	warmup_manifest.pending.add(warmup_versions.size());
+	warmup_abort.clear();
+	warmup_task = WorkerThreadPool::get_singleton()->add_template_task(this, &PipelineCacheRD::_warmup_compile, nullptr, false, "PipelineCacheRDWarmup");
+}
+
+void PipelineCacheRD::_warmup_wait() {
+	if (warmup_task == WorkerThreadPool::INVALID_TASK_ID) {
+		return;
+	}
+	warmup_abort.set();
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(warmup_task);
+	warmup_task = WorkerThreadPool::INVALID_TASK_ID;
+}
+
+void PipelineCacheRD::_warmup_compile(void *p_userdata) {
+	for (uint32_t i = 0; i < warmup_versions.size(); i++) {
+		if (warmup_abort.is_set()) {
+			warmup_manifest.pending.sub(warmup_versions.size() - i);
+			return;
+		}
+
+		const WarmupVersion &version = warmup_versions[i];
+		const bool wireframe = version.wireframe || rasterization_state.wireframe;
+
+		// Compiled without holding the lock, so drawing doesn't spin while it runs.
+		spin_lock.lock();
+		const bool exists = _find_version(version.vertex_id, version.framebuffer_id, wireframe, version.render_pass, version.bool_specializations).is_valid();
+		spin_lock.unlock();
+
+		if (!exists) {
+			RID pipeline = _create_pipeline(version.vertex_id, version.framebuffer_id, wireframe, version.render_pass, version.bool_specializations);
+			if (pipeline.is_valid()) {
+				spin_lock.lock();
+				if (_find_version(version.vertex_id, version.framebuffer_id, wireframe, version.render_pass, version.bool_specializations).is_null()) {
+					_add_version(version.vertex_id, version.framebuffer_id, wireframe, version.render_pass, version.bool_specializations, pipeline);
+					pipeline = RID();
+				}
+				spin_lock.unlock();
+
+				if (pipeline.is_valid()) {
+					RD::get_singleton()->free(pipeline); // Created by a draw in the meantime.
+				}
+			}
+		}
+
+		warmup_manifest.pending.decrement();
+		warmup_manifest.compiled.increment();
+	}
+}
+
+RID PipelineCacheRD::_find_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) const {
+	for (uint32_t i = 0; i < version_count; i++) {
+		if (versions[i].vertex_id == p_vertex_format_id && versions[i].framebuffer_id == p_framebuffer_format_id && versions[i].wireframe == p_wireframe && versions[i].render_pass == p_render_pass && versions[i].bool_specializations == p_bool_specializations) {
+			return versions[i].pipeline;
+		}
+	}
+	return RID();
+}
+
+RID PipelineCacheRD::_create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
 	RD::PipelineMultisampleState multisample_state_version = multisample_state;
 	multisample_state_version.sample_count = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id, p_render_pass);
 
-	bool wireframe = p_wireframe;
-
 	RD::PipelineRasterizationState raster_state_version = rasterization_state;
-	raster_state_version.wireframe = wireframe;
+	raster_state_version.wireframe = p_wireframe;
 
 	Vector<RD::PipelineSpecializationConstant> specialization_constants = base_specialization_constants;
 
@@ -57,20 +328,48 @@ RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD
 		bool_index++;
 	}
 
+	// The shader may be a placeholder that is being filled in the background.
+	ShaderRD::wait_for_shader(shader);
+
 	RID pipeline = RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
 	ERR_FAIL_COND_V(pipeline.is_null(), RID());
+	return pipeline;
+}
+
+void PipelineCacheRD::_add_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations, RID p_pipeline) {
 	versions = static_cast<Version *>(memrealloc(versions, sizeof(Version) * (version_count + 1)));
 	versions[version_count].framebuffer_id = p_framebuffer_format_id;
 	versions[version_count].vertex_id = p_vertex_format_id;
-	versions[version_count].wireframe = wireframe;
-	versions[version_count].pipeline = pipeline;
+	versions[version_count].wireframe = p_wireframe;
+	versions[version_count].pipeline = p_pipeline;
 	versions[version_count].render_pass = p_render_pass;
 	versions[version_count].bool_specializations = p_bool_specializations;
 	version_count++;
+
+	if (!warmup_manifest_path.is_empty()) {
+		if (state_hash == 0) {
+			// Shader was still a placeholder at setup time.
+			state_hash = _compute_state_hash();
+			_warmup_start();
+		}
+		if (state_hash != 0) {
+			warmup_manifest.record(state_hash, p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+		}
+	}
+}
+
+RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	RID pipeline = _create_pipeline(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+	if (pipeline.is_valid()) {
+		_add_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations, pipeline);
+	}
 	return pipeline;
 }
 
 void PipelineCacheRD::_clear() {
+	_warmup_wait();
+	state_hash = 0;
+
 	// TODO: Clear should probably recompile all the variants already compiled instead to avoid stalls? Needs discussion.
 	if (versions) {
 		for (uint32_t i = 0; i < version_count; i++) {
@@ -97,10 +396,20 @@ void PipelineCacheRD::setup(RID p_shader, RD::RenderPrimitive p_primitive, const
 	blend_state = p_blend_state;
 	dynamic_state_flags = p_dynamic_state_flags;
 	base_specialization_constants = p_base_specialization_constants;
+
+	if (!warmup_manifest_path.is_empty()) {
+		state_hash = _compute_state_hash();
+		_warmup_start();
+	}
 }
 void PipelineCacheRD::update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants) {
-	base_specialization_constants = p_base_specialization_constants;
 	_clear();
+	base_specialization_constants = p_base_specialization_constants;
+
+	if (!warmup_manifest_path.is_empty() && shader.is_valid()) {
+		state_hash = _compute_state_hash();
+		_warmup_start();
+	}
 }
 
 void PipelineCacheRD::update_shader(RID p_shader) {
@@ -109,10 +418,16 @@ void PipelineCacheRD::update_shader(RID p_shader) {
 	setup(p_shader, render_primitive, rasterization_state, multisample_state, depth_stencil_state, blend_state, dynamic_state_flags);
 }
 
+void PipelineCacheRD::set_fallback(PipelineCacheRD *p_fallback) {
+	ERR_FAIL_COND(p_fallback == this);
+	fallback = p_fallback;
+}
+
 void PipelineCacheRD::clear() {
 	_clear();
 	shader = RID(); //clear shader
 	input_mask = 0;
+	fallback = nullptr;
 }
 
 PipelineCacheRD::PipelineCacheRD() {
@@ -124,3 +439,201 @@ PipelineCacheRD::PipelineCacheRD() {
 PipelineCacheRD::~PipelineCacheRD() {
 	_clear();
 }
+
+void PipelineCacheRD::set_warmup_manifest_path(const String &p_path) {
+	warmup_manifest_path = p_path;
+}
+
+void PipelineCacheRD::load_warmup_manifest() {
+	if (warmup_manifest_path.is_empty() || !FileAccess::exists(warmup_manifest_path)) {
+		return;
+	}
+
+	Ref<FileAccess> f = FileAccess::open(warmup_manifest_path, FileAccess::READ);
+	ERR_FAIL_COND(f.is_null());
+
+	uint8_t header[4];
+	f->get_buffer(header, 4);
+	if (header[0] != 'R' || header[1] != 'D' || header[2] != 'P' || header[3] != 'W' || f->get_32() != WARMUP_MANIFEST_VERSION) {
+		WARN_PRINT("Invalid pipeline warm-up manifest, ignoring: " + warmup_manifest_path);
+		return;
+	}
+	if (f->get_pascal_string() != RD::get_singleton()->shader_get_binary_cache_key()) {
+		print_verbose("Pipeline warm-up manifest was created with a different driver, ignoring: " + warmup_manifest_path);
+		return;
+	}
+
+	Vector<Vector<RD::VertexAttribute>> vertex_formats;
+	Vector<PipelineWarmupManifest::FramebufferFormat> framebuffer_formats;
+	HashMap<uint32_t, LocalVector<PipelineWarmupManifest::Entry>> entries;
+
+	uint32_t vertex_format_count = f->get_32();
+	for (uint32_t i = 0; i < vertex_format_count && !f->eof_reached(); i++) {
+		Vector<RD::VertexAttribute> attributes;
+		uint32_t attribute_count = f->get_32();
+		for (uint32_t j = 0; j < attribute_count && !f->eof_reached(); j++) {
+			RD::VertexAttribute attribute;
+			attribute.location = f->get_32();
+			attribute.offset = f->get_32();
+			attribute.format = RD::DataFormat(f->get_32());
+			attribute.stride = f->get_32();
+			attribute.frequency = RD::VertexFrequency(f->get_32());
+			ERR_FAIL_COND_MSG(attribute.format >= RD::DATA_FORMAT_MAX || attribute.frequency > RD::VERTEX_FREQUENCY_INSTANCE, "Corrupt pipeline warm-up manifest: " + warmup_manifest_path);
+			attributes.push_back(attribute);
+		}
+		vertex_formats.push_back(attributes);
+	}
+
+	uint32_t framebuffer_format_count = f->get_32();
+	for (uint32_t i = 0; i < framebuffer_format_count && !f->eof_reached(); i++) {
+		PipelineWarmupManifest::FramebufferFormat format;
+		format.view_count = f->get_32();
+		uint32_t attachment_count = f->get_32();
+		for (uint32_t j = 0; j < attachment_count && !f->eof_reached(); j++) {
+			RD::AttachmentFormat attachment;
+			attachment.format = RD::DataFormat(f->get_32());
+			attachment.samples = RD::TextureSamples(f->get_32());
+			attachment.usage_flags = f->get_32();
+			ERR_FAIL_COND_MSG(attachment.format >= RD::DATA_FORMAT_MAX || attachment.samples >= RD::TEXTURE_SAMPLES_MAX, "Corrupt pipeline warm-up manifest: " + warmup_manifest_path);
+			format.attachments.push_back(attachment);
+		}
+		uint32_t pass_count = f->get_32();
+		for (uint32_t j = 0; j < pass_count && !f->eof_reached(); j++) {
+			RD::FramebufferPass pass;
+			Vector<int32_t> *attachment_lists[4] = { &pass.color_attachments, &pass.input_attachments, &pass.resolve_attachments, &pass.preserve_attachments };
+			for (Vector<int32_t> *list : attachment_lists) {
+				uint32_t count = f->get_32();
+				for (uint32_t k = 0; k < count && !f->eof_reached(); k++) {
+					list->push_back(int32_t(f->get_32()));
+				}
+			}
+			pass.depth_attachment = int32_t(f->get_32());
+			pass.vrs_attachment = int32_t(f->get_32());
+			format.passes.push_back(pass);
+		}
+		framebuffer_formats.push_back(format);
+	}
+
+	uint32_t state_count = f->get_32();
+	for (uint32_t i = 0; i < state_count && !f->eof_reached(); i++) {
+		LocalVector<PipelineWarmupManifest::Entry> &state_entries = entries[f->get_32()];
+		uint32_t entry_count = f->get_32();
+		for (uint32_t j = 0; j < entry_count && !f->eof_reached(); j++) {
+			PipelineWarmupManifest::Entry entry;
+			entry.vertex_format = int32_t(f->get_32());
+			entry.framebuffer_format = int32_t(f->get_32());
+			entry.render_pass = f->get_32();
+			entry.wireframe = f->get_32() != 0;
+			entry.bool_specializations = f->get_32();
+			ERR_FAIL_COND_MSG(entry.vertex_format < -1 || entry.vertex_format >= vertex_formats.size() || entry.framebuffer_format < -1 || entry.framebuffer_format >= framebuffer_formats.size(), "Corrupt pipeline warm-up manifest: " + warmup_manifest_path);
+			state_entries.push_back(entry);
+		}
+	}
+
+	ERR_FAIL_COND_MSG(f->eof_reached(), "Truncated pipeline warm-up manifest: " + warmup_manifest_path);
+
+	MutexLock lock(warmup_manifest.mutex);
+	warmup_manifest.vertex_formats = vertex_formats;
+	warmup_manifest.framebuffer_formats = framebuffer_formats;
+	warmup_manifest.entries = entries;
+	warmup_manifest.dirty = false;
+
+	// Formats are deduplicated by RenderingDevice, so the renderer will get the same IDs when it creates them later.
+	warmup_manifest.vertex_format_ids.resize(vertex_formats.size());
+	warmup_manifest.vertex_format_indices.clear();
+	for (int i = 0; i < vertex_formats.size(); i++) {
+		RD::VertexFormatID id = RD::get_singleton()->vertex_format_create(vertex_formats[i]);
+		warmup_manifest.vertex_format_ids[i] = id;
+		if (id != RD::INVALID_ID) {
+			warmup_manifest.vertex_format_indices[id] = i;
+		}
+	}
+	warmup_manifest.framebuffer_format_ids.resize(framebuffer_formats.size());
+	warmup_manifest.framebuffer_format_indices.clear();
+	for (int i = 0; i < framebuffer_formats.size(); i++) {
+		const PipelineWarmupManifest::FramebufferFormat &format = framebuffer_formats[i];
+		RD::FramebufferFormatID id = RD::get_singleton()->framebuffer_format_create_multipass(format.attachments, format.passes, format.view_count);
+		warmup_manifest.framebuffer_format_ids[i] = id;
+		if (id != RD::INVALID_ID) {
+			warmup_manifest.framebuffer_format_indices[id] = i;
+		}
+	}
+
+	print_verbose(vformat("Loaded pipeline warm-up manifest with %d pipeline states.", entries.size()));
+}
+
+void PipelineCacheRD::save_warmup_manifest() {
+	if (warmup_manifest_path.is_empty()) {
+		return;
+	}
+
+	MutexLock lock(warmup_manifest.mutex);
+	if (!warmup_manifest.dirty) {
+		return;
+	}
+
+	Ref<FileAccess> f = FileAccess::open(warmup_manifest_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(f.is_null(), "Can't save pipeline warm-up manifest: " + warmup_manifest_path);
+
+	f->store_buffer((const uint8_t *)"RDPW", 4);
+	f->store_32(WARMUP_MANIFEST_VERSION);
+	f->store_pascal_string(RD::get_singleton()->shader_get_binary_cache_key());
+
+	f->store_32(warmup_manifest.vertex_formats.size());
+	for (const Vector<RD::VertexAttribute> &attributes : warmup_manifest.vertex_formats) {
+		f->store_32(attributes.size());
+		for (const RD::VertexAttribute &attribute : attributes) {
+			f->store_32(attribute.location);
+			f->store_32(attribute.offset);
+			f->store_32(attribute.format);
+			f->store_32(attribute.stride);
+			f->store_32(attribute.frequency);
+		}
+	}
+
+	f->store_32(warmup_manifest.framebuffer_formats.size());
+	for (const PipelineWarmupManifest::FramebufferFormat &format : warmup_manifest.framebuffer_formats) {
+		f->store_32(format.view_count);
+		f->store_32(format.attachments.size());
+		for (const RD::AttachmentFormat &attachment : format.attachments) {
+			f->store_32(attachment.format);
+			f->store_32(attachment.samples);
+			f->store_32(attachment.usage_flags);
+		}
+		f->store_32(format.passes.size());
+		for (const RD::FramebufferPass &pass : format.passes) {
+			const Vector<int32_t> *attachment_lists[4] = { &pass.color_attachments, &pass.input_attachments, &pass.resolve_attachments, &pass.preserve_attachments };
+			for (const Vector<int32_t> *list : attachment_lists) {
+				f->store_32(list->size());
+				for (int32_t attachment : *list) {
+					f->store_32(uint32_t(attachment));
+				}
+			}
+			f->store_32(uint32_t(pass.depth_attachment));
+			f->store_32(uint32_t(pass.vrs_attachment));
+		}
+	}
+
+	f->store_32(warmup_manifest.entries.size());
+	for (const KeyValue<uint32_t, LocalVector<PipelineWarmupManifest::Entry>> &E : warmup_manifest.entries) {
+		f->store_32(E.key);
+		f->store_32(E.value.size());
+		for (const PipelineWarmupManifest::Entry &entry : E.value) {
+			f->store_32(uint32_t(entry.vertex_format));
+			f->store_32(uint32_t(entry.framebuffer_format));
+			f->store_32(entry.render_pass);
+			f->store_32(entry.wireframe ? 1 : 0);
+			f->store_32(entry.bool_specializations);
+		}
+	}
+
+	warmup_manifest.dirty = false;
+}
+
+uint64_t PipelineCacheRD::get_warmup_pending_count() {
+	return warmup_manifest.pending.get();
+}
+
+uint64_t PipelineCacheRD::get_warmup_compiled_count() {
+	return warmup_manifest.compiled.get();
+}
@@ -31,7 +31,10 @@
 #ifndef PIPELINE_CACHE_RD_H
 #define PIPELINE_CACHE_RD_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/spin_lock.h"
+#include "core/templates/safe_refcount.h"
+#include "servers/rendering/renderer_rd/shader_rd.h"
 #include "servers/rendering/rendering_device.h"
 
 class PipelineCacheRD {
@@ -60,14 +63,51 @@ class PipelineCacheRD {
 	Version *versions = nullptr;
 	uint32_t version_count;
 
+	// Used while the shader of this cache is still being compiled in the background, see ShaderRD::enable_group().
+	PipelineCacheRD *fallback = nullptr;
+
+	// Warm-up: versions created during play are recorded in a manifest keyed by a hash of the
+	// shader bytecode and pipeline state. On later runs they are precompiled on the WorkerThreadPool
+	// as soon as the cache is set up, instead of stalling the first frame that uses them.
+	struct WarmupVersion {
+		RD::VertexFormatID vertex_id;
+		RD::FramebufferFormatID framebuffer_id;
+		uint32_t render_pass;
+		bool wireframe;
+		uint32_t bool_specializations;
+	};
+
+	uint32_t state_hash = 0; // Zero while the shader is a placeholder.
+	LocalVector<WarmupVersion> warmup_versions;
+	WorkerThreadPool::TaskID warmup_task = WorkerThreadPool::INVALID_TASK_ID;
+	SafeFlag warmup_abort;
+
+	static String warmup_manifest_path;
+
+	uint32_t _compute_state_hash() const;
+	void _warmup_start();
+	void _warmup_wait();
+	void _warmup_compile(void *p_userdata);
+
+	// Only _create_pipeline() can run without `spin_lock` locked, it doesn't use the versions.
+	RID _find_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) const;
+	RID _create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+	void _add_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations, RID p_pipeline);
 	RID _generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations = 0);
 
 	void _clear();
 
 public:
+	static void set_warmup_manifest_path(const String &p_path);
+	static void load_warmup_manifest();
+	static void save_warmup_manifest();
+	static uint64_t get_warmup_pending_count();
+	static uint64_t get_warmup_compiled_count();
+
 	void setup(RID p_shader, RD::RenderPrimitive p_primitive, const RD::PipelineRasterizationState &p_rasterization_state, RD::PipelineMultisampleState p_multisample, const RD::PipelineDepthStencilState &p_depth_stencil_state, const RD::PipelineColorBlendState &p_blend_state, int p_dynamic_state_flags = 0, const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants = Vector<RD::PipelineSpecializationConstant>());
 	void update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants);
 	void update_shader(RID p_shader);
+	void set_fallback(PipelineCacheRD *p_fallback);
 
 	_FORCE_INLINE_ RID get_render_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe = false, uint32_t p_render_pass = 0, uint32_t p_bool_specializations = 0) {
 #ifdef DEBUG_ENABLED
@@ -86,6 +126,10 @@ public:
 				return result;
 			}
 		}
+		if (fallback && ShaderRD::is_shader_compiling(shader)) {
+			spin_lock.unlock();
+			return fallback->get_render_pipeline(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+		}
 		result = _generate_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
 		spin_lock.unlock();
 		return result;
@@ -94,6 +138,9 @@ public:
 	_FORCE_INLINE_ uint64_t get_vertex_input_mask() {
 		if (input_mask == 0) {
 			ERR_FAIL_COND_V(shader.is_null(), 0);
+			if (fallback && ShaderRD::is_shader_compiling(shader)) {
+				return fallback->get_vertex_input_mask();
+			}
 			input_mask = RD::get_singleton()->shader_get_vertex_input_attribute_mask(shader);
 		}
 		return input_mask;
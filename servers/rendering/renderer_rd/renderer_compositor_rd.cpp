@@ -100,6 +100,9 @@ void RendererCompositorRD::begin_frame(double frame_step) {
 
 	canvas->set_time(time);
 	scene->set_time(time, frame_step);
+
+	// Finish shader groups that were compiled in the background, so their results are cached.
+	ShaderRD::process_background_compilations();
 }
 
 void RendererCompositorRD::end_frame(bool p_swap_buffers) {
@@ -162,6 +165,8 @@ void RendererCompositorRD::finalize() {
 	blit.shader.version_free(blit.shader_version);
 	RD::get_singleton()->free(blit.index_buffer);
 	RD::get_singleton()->free(blit.sampler);
+
+	PipelineCacheRD::save_warmup_manifest();
 }
 
 void RendererCompositorRD::set_boot_image(const Ref<Image> &p_image, const Color &p_color, bool p_scale, bool p_use_filter) {
@@ -294,11 +299,32 @@ RendererCompositorRD::RendererCompositorRD() {
 					ShaderRD::set_shader_cache_save_compressed(compress);
 					ShaderRD::set_shader_cache_save_compressed_zstd(use_zstd);
 					ShaderRD::set_shader_cache_save_debug(!strip_debug);
+
+					// Exported projects may contain a shader cache baked by the editor.
+					String baked_cache_dir = ProjectSettings::get_singleton()->get_project_data_path().path_join("shader_cache");
+					if (!Engine::get_singleton()->is_editor_hint() && DirAccess::dir_exists_absolute(baked_cache_dir)) {
+						ShaderRD::set_shader_cache_res_dir(baked_cache_dir);
+					}
 				}
 			}
 		}
 	}
 
+	if (GLOBAL_GET("rendering/rendering_device/pipeline_cache/enable_warmup")) {
+		// Pipelines created during previous runs are compiled in the background as soon as their cache is set up.
+		String warmup_path = vformat("user://vulkan/pipelines.%s.%s",
+				OS::get_singleton()->get_current_rendering_method(),
+				RD::get_singleton()->get_device_name().validate_filename().replace(" ", "_").to_lower());
+		if (Engine::get_singleton()->is_editor_hint()) {
+			warmup_path += ".editor";
+		}
+		warmup_path += ".warmup";
+
+		DirAccess::make_dir_recursive_absolute(warmup_path.get_base_dir());
+		PipelineCacheRD::set_warmup_manifest_path(warmup_path);
+		PipelineCacheRD::load_warmup_manifest();
+	}
+
 	ERR_FAIL_COND_MSG(singleton != nullptr, "A RendererCompositorRD singleton already exists.");
 	singleton = this;
 
@@ -335,4 +361,6 @@ RendererCompositorRD::~RendererCompositorRD() {
 	memdelete(uniform_set_cache);
 	memdelete(framebuffer_cache);
 	ShaderRD::set_shader_cache_dir(String());
+	ShaderRD::set_shader_cache_res_dir(String());
+	PipelineCacheRD::set_warmup_manifest_path(String());
 }
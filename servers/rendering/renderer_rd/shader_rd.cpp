@@ -140,12 +140,9 @@ RID ShaderRD::version_create() {
 	//initialize() was never called
 	ERR_FAIL_COND_V(group_to_variant_map.is_empty(), RID());
 
-	Version version;
-	version.dirty = true;
-	version.valid = false;
-	version.initialize_needed = true;
-	version.variants = nullptr;
-	return version_owner.make_rid(version);
+	// Locked so pending compilations of all versions can be finished from another thread.
+	MutexLock lock(compile_mutex);
+	return version_owner.make_rid();
 }
 
 void ShaderRD::_initialize_version(Version *p_version) {
@@ -153,11 +150,23 @@ void ShaderRD::_initialize_version(Version *p_version) {
 
 	p_version->valid = false;
 	p_version->dirty = false;
+	p_version->compile_failed = false;
 
 	p_version->variants = memnew_arr(RID, variant_defines.size());
+	typedef Vector<uint8_t> ShaderStageData;
+	p_version->variant_data = memnew_arr(ShaderStageData, variant_defines.size());
+
+	p_version->group_compilation_tasks.resize(group_enabled.size());
+	for (WorkerThreadPool::GroupID &task : p_version->group_compilation_tasks) {
+		task = WorkerThreadPool::INVALID_TASK_ID;
+	}
 }
 
 void ShaderRD::_clear_version(Version *p_version) {
+	// Background tasks write into the arrays below, make sure they are done.
+	_compile_version_abort(p_version);
+	p_version->finished_groups.set(0);
+
 	// Clear versions if they exist.
 	if (p_version->variants) {
 		for (int i = 0; i < variant_defines.size(); i++) {
@@ -167,11 +176,13 @@ void ShaderRD::_clear_version(Version *p_version) {
 		}
 
 		memdelete_arr(p_version->variants);
-		if (p_version->variant_data) {
-			memdelete_arr(p_version->variant_data);
-		}
 		p_version->variants = nullptr;
 	}
+
+	if (p_version->variant_data) {
+		memdelete_arr(p_version->variant_data);
+		p_version->variant_data = nullptr;
+	}
 }
 
 void ShaderRD::_build_variant_code(StringBuilder &builder, uint32_t p_variant, const Version *p_version, const StageTemplate &p_template) {
@@ -220,10 +231,11 @@ void ShaderRD::_build_variant_code(StringBuilder &builder, uint32_t p_variant, c
 	}
 }
 
-void ShaderRD::_compile_variant(uint32_t p_variant, const CompileData *p_data) {
-	uint32_t variant = group_to_variant_map[p_data->group][p_variant];
+void ShaderRD::_compile_variant(uint32_t p_variant, CompileData p_data) {
+	uint32_t variant = group_to_variant_map[p_data.group][p_variant];
 
 	if (!variants_enabled[variant]) {
+		pending_variants.decrement();
 		return; // Variant is disabled, return.
 	}
 
@@ -238,7 +250,7 @@ void ShaderRD::_compile_variant(uint32_t p_variant, const CompileData *p_data) {
 		//vertex stage
 
 		StringBuilder builder;
-		_build_variant_code(builder, variant, p_data->version, stage_templates[STAGE_TYPE_VERTEX]);
+		_build_variant_code(builder, variant, p_data.version, stage_templates[STAGE_TYPE_VERTEX]);
 
 		current_source = builder.as_string();
 		RD::ShaderStageSPIRVData stage;
@@ -256,7 +268,7 @@ void ShaderRD::_compile_variant(uint32_t p_variant, const CompileData *p_data) {
 		current_stage = RD::SHADER_STAGE_FRAGMENT;
 
 		StringBuilder builder;
-		_build_variant_code(builder, variant, p_data->version, stage_templates[STAGE_TYPE_FRAGMENT]);
+		_build_variant_code(builder, variant, p_data.version, stage_templates[STAGE_TYPE_FRAGMENT]);
 
 		current_source = builder.as_string();
 		RD::ShaderStageSPIRVData stage;
@@ -274,7 +286,7 @@ void ShaderRD::_compile_variant(uint32_t p_variant, const CompileData *p_data) {
 		current_stage = RD::SHADER_STAGE_COMPUTE;
 
 		StringBuilder builder;
-		_build_variant_code(builder, variant, p_data->version, stage_templates[STAGE_TYPE_COMPUTE]);
+		_build_variant_code(builder, variant, p_data.version, stage_templates[STAGE_TYPE_COMPUTE]);
 
 		current_source = builder.as_string();
 
@@ -296,19 +308,25 @@ void ShaderRD::_compile_variant(uint32_t p_variant, const CompileData *p_data) {
 #ifdef DEBUG_ENABLED
 		ERR_PRINT("code:\n" + current_source.get_with_code_lines());
 #endif
+		pending_variants.decrement();
 		return;
 	}
 
 	Vector<uint8_t> shader_data = RD::get_singleton()->shader_compile_binary_from_spirv(stages, name + ":" + itos(variant));
 
-	ERR_FAIL_COND(shader_data.is_empty());
+	if (shader_data.is_empty()) {
+		pending_variants.decrement();
+		ERR_FAIL_MSG("Error compiling shader binary, variant #" + itos(variant) + " (" + variant_defines[variant].text.get_data() + ").");
+	}
 
 	{
 		MutexLock lock(variant_set_mutex);
 
-		p_data->version->variants[variant] = RD::get_singleton()->shader_create_from_bytecode(shader_data, p_data->version->variants[variant]);
-		p_data->version->variant_data[variant] = shader_data;
+		p_data.version->variants[variant] = RD::get_singleton()->shader_create_from_bytecode(shader_data, p_data.version->variants[variant]);
+		p_data.version->variant_data[variant] = shader_data;
 	}
+
+	pending_variants.decrement();
 }
 
 RS::ShaderNativeSourceCode ShaderRD::version_get_native_source_code(RID p_version) {
@@ -395,16 +413,22 @@ String ShaderRD::_version_get_sha1(Version *p_version) const {
 static const char *shader_file_header = "GDSC";
 static const uint32_t cache_file_version = 3;
 
-String ShaderRD::_get_cache_file_path(Version *p_version, int p_group) {
+String ShaderRD::_get_cache_file_relative_path(Version *p_version, int p_group) {
 	const String &sha1 = _version_get_sha1(p_version);
 	const String &api_safe_name = String(RD::get_singleton()->get_device_api_name()).validate_filename().to_lower();
-	const String &path = shader_cache_dir.path_join(name).path_join(group_sha256[p_group]).path_join(sha1) + "." + api_safe_name + ".cache";
+	const String &path = name.path_join(group_sha256[p_group]).path_join(sha1) + "." + api_safe_name + ".cache";
 	return path;
 }
 
 bool ShaderRD::_load_from_cache(Version *p_version, int p_group) {
-	const String &path = _get_cache_file_path(p_version, p_group);
+	const String &relative_path = _get_cache_file_relative_path(p_version, p_group);
+	String path = shader_cache_dir.path_join(relative_path);
 	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	if (f.is_null() && !shader_cache_res_dir.is_empty()) {
+		// Not compiled on this machine yet, try the cache baked at export time.
+		path = shader_cache_res_dir.path_join(relative_path);
+		f = FileAccess::open(path, FileAccess::READ);
+	}
 	if (f.is_null()) {
 		return false;
 	}
@@ -461,17 +485,36 @@ bool ShaderRD::_load_from_cache(Version *p_version, int p_group) {
 		}
 	}
 
-	memdelete_arr(p_version->variant_data); //clear stages
-	p_version->variant_data = nullptr;
-	p_version->valid = true;
+	for (uint32_t i = 0; i < variant_count; i++) {
+		p_version->variant_data[group_to_variant_map[p_group][i]] = Vector<uint8_t>(); //clear stages
+	}
+	if (!p_version->compile_failed) {
+		p_version->valid = true;
+	}
+
+#ifdef TOOLS_ENABLED
+	{
+		MutexLock lock(cache_files_mutex);
+		cache_files_used.insert(path);
+	}
+#endif
+
 	return true;
 }
 
 void ShaderRD::_save_to_cache(Version *p_version, int p_group) {
 	ERR_FAIL_COND(!shader_cache_dir_valid);
-	const String &path = _get_cache_file_path(p_version, p_group);
+	const String &path = shader_cache_dir.path_join(_get_cache_file_relative_path(p_version, p_group));
 	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
 	ERR_FAIL_COND(f.is_null());
+
+#ifdef TOOLS_ENABLED
+	{
+		MutexLock lock(cache_files_mutex);
+		cache_files_used.insert(path);
+	}
+#endif
+
 	f->store_buffer((const uint8_t *)shader_file_header, 4);
 	f->store_32(cache_file_version); // File version.
 	uint32_t variant_count = group_to_variant_map[p_group].size();
@@ -495,77 +538,145 @@ void ShaderRD::_allocate_placeholders(Version *p_version, int p_group) {
 	}
 }
 
+void ShaderRD::_start_version_compilation(Version *p_version) {
+	_initialize_version(p_version);
+	for (int i = 0; i < group_enabled.size(); i++) {
+		if (!group_enabled[i]) {
+			_allocate_placeholders(p_version, i);
+			continue;
+		}
+		_compile_version_start(p_version, i, true);
+	}
+}
+
 // Try to compile all variants for a given group.
 // Will skip variants that are disabled.
-void ShaderRD::_compile_version(Version *p_version, int p_group) {
-	if (!group_enabled[p_group]) {
+// The group is compiled by worker threads, _compile_version_end() must be called to wait for it and validate the results.
+void ShaderRD::_compile_version_start(Version *p_version, int p_group, bool p_high_priority) {
+	if (!group_enabled[p_group] || !p_version->variants) {
 		return;
 	}
 
-	typedef Vector<uint8_t> ShaderStageData;
-	p_version->variant_data = memnew_arr(ShaderStageData, variant_defines.size());
-
-	p_version->dirty = false;
+	if (p_version->group_compilation_tasks[p_group] != WorkerThreadPool::INVALID_TASK_ID) {
+		return; // Already compiling.
+	}
 
 	if (shader_cache_dir_valid) {
 		if (_load_from_cache(p_version, p_group)) {
+			cache_hits.increment();
+			p_version->finished_groups.bit_or(uint64_t(1) << p_group);
 			return;
 		}
+		cache_misses.increment();
 	}
 
+	const LocalVector<int> &group_variants = group_to_variant_map[p_group];
+
 	CompileData compile_data;
 	compile_data.version = p_version;
 	compile_data.group = p_group;
 
-#if 1
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ShaderRD::_compile_variant, &compile_data, group_to_variant_map[p_group].size(), -1, true, SNAME("ShaderCompilation"));
+	pending_variants.add(group_variants.size());
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ShaderRD::_compile_variant, compile_data, group_variants.size(), -1, p_high_priority, SNAME("ShaderCompilation"));
+	p_version->group_compilation_tasks[p_group] = group_task;
+
+	// Placeholders handed out before the group was enabled get filled in place, let pipeline creation know about them.
+	MutexLock lock(compiling_shaders_mutex);
+	for (int variant_id : group_variants) {
+		if (p_version->variants[variant_id].is_null()) {
+			continue;
+		}
+		CompilingShader compiling_shader;
+		compiling_shader.shader_rd = this;
+		compiling_shader.version = p_version;
+		compiling_shader.group = p_group;
+		compiling_shader.task = group_task;
+		compiling_shaders[p_version->variants[variant_id]] = compiling_shader;
+	}
+}
+
+void ShaderRD::_compile_version_end(Version *p_version, int p_group) {
+	if (p_group >= (int)p_version->group_compilation_tasks.size()) {
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = p_version->group_compilation_tasks[p_group];
+	if (group_task == WorkerThreadPool::INVALID_TASK_ID) {
+		return;
+	}
+
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	p_version->group_compilation_tasks[p_group] = WorkerThreadPool::INVALID_TASK_ID;
 
-#else
-	for (uint32_t i = 0; i < group_to_variant_map[p_group].size(); i++) {
-		_compile_variant(i, &compile_data);
+	const LocalVector<int> &group_variants = group_to_variant_map[p_group];
+
+	{
+		MutexLock lock(compiling_shaders_mutex);
+		for (int variant_id : group_variants) {
+			compiling_shaders.erase(p_version->variants[variant_id]);
+		}
 	}
-#endif
 
 	bool all_valid = true;
 
-	for (uint32_t i = 0; i < group_to_variant_map[p_group].size(); i++) {
-		int variant_id = group_to_variant_map[p_group][i];
+	for (int variant_id : group_variants) {
 		if (!variants_enabled[variant_id]) {
 			continue; // Disabled.
 		}
-		if (p_version->variants[variant_id].is_null()) {
+		// Placeholders keep their RID when compilation fails, so check for the bytecode instead.
+		if (p_version->variants[variant_id].is_null() || p_version->variant_data[variant_id].is_empty()) {
 			all_valid = false;
 			break;
 		}
 	}
 
 	if (!all_valid) {
-		// Clear versions if they exist.
-		for (int i = 0; i < variant_defines.size(); i++) {
-			if (!variants_enabled[i] || !group_enabled[variant_defines[i].group]) {
-				continue; // Disabled.
-			}
-			if (!p_version->variants[i].is_null()) {
-				RD::get_singleton()->free(p_version->variants[i]);
+		// Only invalidate this group, variants of other groups may already be in use by pipelines.
+		// Tasks of other groups never write into the variants of this one.
+		for (int variant_id : group_variants) {
+			if (p_version->variants[variant_id].is_valid()) {
+				RD::get_singleton()->free(p_version->variants[variant_id]);
+				p_version->variants[variant_id] = RID();
 			}
 		}
-		memdelete_arr(p_version->variants);
-		if (p_version->variant_data) {
-			memdelete_arr(p_version->variant_data);
-		}
-		p_version->variants = nullptr;
-		p_version->variant_data = nullptr;
-		return;
+		p_version->compile_failed = true;
+		p_version->valid = false;
 	} else if (shader_cache_dir_valid) {
 		// Save shader cache.
 		_save_to_cache(p_version, p_group);
 	}
 
-	memdelete_arr(p_version->variant_data); //clear stages
-	p_version->variant_data = nullptr;
+	for (int variant_id : group_variants) {
+		p_version->variant_data[variant_id] = Vector<uint8_t>(); //clear stages
+	}
 
-	p_version->valid = true;
+	if (!p_version->compile_failed) {
+		p_version->valid = true;
+	}
+	p_version->finished_groups.bit_or(uint64_t(1) << p_group);
+}
+
+void ShaderRD::_compile_version_abort(Version *p_version) {
+	for (uint32_t i = 0; i < p_version->group_compilation_tasks.size(); i++) {
+		WorkerThreadPool::GroupID group_task = p_version->group_compilation_tasks[i];
+		if (group_task == WorkerThreadPool::INVALID_TASK_ID) {
+			continue;
+		}
+
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		p_version->group_compilation_tasks[i] = WorkerThreadPool::INVALID_TASK_ID;
+
+		MutexLock lock(compiling_shaders_mutex);
+		for (int variant_id : group_to_variant_map[i]) {
+			compiling_shaders.erase(p_version->variants[variant_id]);
+		}
+	}
+}
+
+void ShaderRD::_compile_ensure_finished(Version *p_version) {
+	for (uint32_t i = 0; i < p_version->group_compilation_tasks.size(); i++) {
+		_compile_version_end(p_version, i);
+	}
 }
 
 void ShaderRD::version_set_code(RID p_version, const HashMap<String, String> &p_code, const String &p_uniforms, const String &p_vertex_globals, const String &p_fragment_globals, const Vector<String> &p_custom_defines) {
@@ -573,6 +684,12 @@ void ShaderRD::version_set_code(RID p_version, const HashMap<String, String> &p_
 
 	Version *version = version_owner.get_or_null(p_version);
 	ERR_FAIL_NULL(version);
+
+	MutexLock lock(compile_mutex);
+
+	// Compilation tasks read the code below.
+	_compile_version_abort(version);
+
 	version->vertex_globals = p_vertex_globals.utf8();
 	version->fragment_globals = p_fragment_globals.utf8();
 	version->uniforms = p_uniforms.utf8();
@@ -587,15 +704,9 @@ void ShaderRD::version_set_code(RID p_version, const HashMap<String, String> &p_
 	}
 
 	version->dirty = true;
+	version->finished_groups.set(0);
 	if (version->initialize_needed) {
-		_initialize_version(version);
-		for (int i = 0; i < group_enabled.size(); i++) {
-			if (!group_enabled[i]) {
-				_allocate_placeholders(version, i);
-				continue;
-			}
-			_compile_version(version, i);
-		}
+		_start_version_compilation(version);
 		version->initialize_needed = false;
 	}
 }
@@ -606,6 +717,11 @@ void ShaderRD::version_set_compute_code(RID p_version, const HashMap<String, Str
 	Version *version = version_owner.get_or_null(p_version);
 	ERR_FAIL_NULL(version);
 
+	MutexLock lock(compile_mutex);
+
+	// Compilation tasks read the code below.
+	_compile_version_abort(version);
+
 	version->compute_globals = p_compute_globals.utf8();
 	version->uniforms = p_uniforms.utf8();
 
@@ -620,40 +736,50 @@ void ShaderRD::version_set_compute_code(RID p_version, const HashMap<String, Str
 	}
 
 	version->dirty = true;
+	version->finished_groups.set(0);
 	if (version->initialize_needed) {
-		_initialize_version(version);
-		for (int i = 0; i < group_enabled.size(); i++) {
-			if (!group_enabled[i]) {
-				_allocate_placeholders(version, i);
-				continue;
-			}
-			_compile_version(version, i);
-		}
+		_start_version_compilation(version);
 		version->initialize_needed = false;
 	}
 }
 
+RID ShaderRD::_version_get_shader_wait(Version *p_version, int p_variant) {
+	MutexLock lock(compile_mutex);
+
+	if (p_version->dirty) {
+		_start_version_compilation(p_version);
+	}
+
+	// Only wait for the group of this variant, the others keep compiling.
+	_compile_version_end(p_version, variant_defines[p_variant].group);
+
+	if (!p_version->variants) {
+		return RID();
+	}
+
+	// Null if the group failed to compile, or a placeholder if the group is not enabled yet.
+	return p_version->variants[p_variant];
+}
+
 bool ShaderRD::version_is_valid(RID p_version) {
 	Version *version = version_owner.get_or_null(p_version);
 	ERR_FAIL_NULL_V(version, false);
 
+	MutexLock lock(compile_mutex);
+
 	if (version->dirty) {
-		_initialize_version(version);
-		for (int i = 0; i < group_enabled.size(); i++) {
-			if (!group_enabled[i]) {
-				_allocate_placeholders(version, i);
-				continue;
-			}
-			_compile_version(version, i);
-		}
+		_start_version_compilation(version);
 	}
 
+	_compile_ensure_finished(version);
+
 	return version->valid;
 }
 
 bool ShaderRD::version_free(RID p_version) {
 	if (version_owner.owns(p_version)) {
 		Version *version = version_owner.get_or_null(p_version);
+		MutexLock lock(compile_mutex);
 		_clear_version(version);
 		version_owner.free(p_version);
 	} else {
@@ -684,12 +810,19 @@ void ShaderRD::enable_group(int p_group) {
 
 	group_enabled.write[p_group] = true;
 
-	// Compile all versions again to include the new group.
+	MutexLock lock(compile_mutex);
+
+	// Compile all versions again to include the new group. This happens in the background with low priority,
+	// the placeholders are filled in place and pipelines using them wait for (or fall back from) them as needed.
+	// Dirty versions will include the group once they are compiled.
 	List<RID> all_versions;
 	version_owner.get_owned_list(&all_versions);
 	for (const RID &E : all_versions) {
 		Version *version = version_owner.get_or_null(E);
-		_compile_version(version, p_group);
+		if (version->dirty) {
+			continue;
+		}
+		_compile_version_start(version, p_group, false);
 	}
 }
 
@@ -713,6 +846,9 @@ ShaderRD::ShaderRD() {
 	}
 
 	base_compute_defines = base_compute_define_text.ascii();
+
+	MutexLock lock(shaders_mutex);
+	shaders.insert(this);
 }
 
 void ShaderRD::initialize(const Vector<String> &p_variant_defines, const String &p_general_defines) {
@@ -802,6 +938,9 @@ void ShaderRD::initialize(const Vector<VariantDefine> &p_variant_defines, const
 		}
 	}
 
+	// Finished groups are tracked as bits of a 64-bit mask.
+	ERR_FAIL_COND_MSG(max_group_id >= 64, "Shaders can't have more than 64 compilation groups.");
+
 	// Set all to groups to false, then enable those that should be default.
 	group_enabled.resize_zeroed(max_group_id + 1);
 	bool *enabled_ptr = group_enabled.ptrw();
@@ -821,6 +960,10 @@ void ShaderRD::set_shader_cache_dir(const String &p_dir) {
 	shader_cache_dir = p_dir;
 }
 
+void ShaderRD::set_shader_cache_res_dir(const String &p_dir) {
+	shader_cache_res_dir = p_dir;
+}
+
 void ShaderRD::set_shader_cache_save_compressed(bool p_enable) {
 	shader_cache_save_compressed = p_enable;
 }
@@ -834,11 +977,149 @@ void ShaderRD::set_shader_cache_save_debug(bool p_enable) {
 }
 
 String ShaderRD::shader_cache_dir;
+String ShaderRD::shader_cache_res_dir;
 bool ShaderRD::shader_cache_save_compressed = true;
 bool ShaderRD::shader_cache_save_compressed_zstd = true;
 bool ShaderRD::shader_cache_save_debug = true;
 
+Mutex ShaderRD::compiling_shaders_mutex;
+HashMap<RID, ShaderRD::CompilingShader> ShaderRD::compiling_shaders;
+Mutex ShaderRD::shaders_mutex;
+HashSet<ShaderRD *> ShaderRD::shaders;
+SafeNumeric<uint64_t> ShaderRD::cache_hits;
+SafeNumeric<uint64_t> ShaderRD::cache_misses;
+SafeNumeric<uint64_t> ShaderRD::pending_variants;
+
+bool ShaderRD::is_shader_compiling(RID p_shader) {
+	{
+		MutexLock lock(compiling_shaders_mutex);
+		if (!compiling_shaders.has(p_shader)) {
+			return false;
+		}
+	}
+
+	// A placeholder gets its bytecode as soon as its own variant is done, even if the rest of the group is still compiling.
+	return RD::get_singleton()->shader_get_bytecode_hash(p_shader) == 0;
+}
+
+void ShaderRD::wait_for_shader(RID p_shader) {
+	if (!is_shader_compiling(p_shader)) {
+		return;
+	}
+
+	ShaderRD *shader_rd = nullptr;
+	{
+		MutexLock lock(compiling_shaders_mutex);
+		const CompilingShader *compiling_shader = compiling_shaders.getptr(p_shader);
+		if (!compiling_shader) {
+			return;
+		}
+		shader_rd = compiling_shader->shader_rd;
+	}
+
+	MutexLock lock(shader_rd->compile_mutex);
+
+	// Check again, another thread may have finished the group meanwhile.
+	CompilingShader compiling_shader;
+	{
+		MutexLock registry_lock(compiling_shaders_mutex);
+		const CompilingShader *E = compiling_shaders.getptr(p_shader);
+		if (!E) {
+			return;
+		}
+		compiling_shader = *E;
+	}
+
+	shader_rd->_compile_version_end(compiling_shader.version, compiling_shader.group);
+}
+
+void ShaderRD::process_background_compilations() {
+	LocalVector<RID> shaders;
+	{
+		MutexLock lock(compiling_shaders_mutex);
+		if (compiling_shaders.is_empty()) {
+			return;
+		}
+		for (const KeyValue<RID, CompilingShader> &E : compiling_shaders) {
+			shaders.push_back(E.key);
+		}
+	}
+
+	for (const RID &shader : shaders) {
+		CompilingShader compiling_shader;
+		{
+			MutexLock lock(compiling_shaders_mutex);
+			const CompilingShader *E = compiling_shaders.getptr(shader);
+			if (!E) {
+				continue; // Finished along with another variant of its group.
+			}
+			compiling_shader = *E;
+		}
+
+		MutexLock lock(compiling_shader.shader_rd->compile_mutex);
+
+		// Groups are only finished with the compile mutex held, so the task is still valid if the entry still exists.
+		{
+			MutexLock registry_lock(compiling_shaders_mutex);
+			if (!compiling_shaders.has(shader)) {
+				continue;
+			}
+		}
+
+		if (WorkerThreadPool::get_singleton()->is_group_task_completed(compiling_shader.task)) {
+			compiling_shader.shader_rd->_compile_version_end(compiling_shader.version, compiling_shader.group);
+		}
+	}
+}
+
+// Waits for every group still compiling, so their results are validated and saved to the shader cache.
+void ShaderRD::finish_background_compilations() {
+	MutexLock lock(shaders_mutex);
+	for (ShaderRD *shader_rd : shaders) {
+		MutexLock compile_lock(shader_rd->compile_mutex);
+
+		List<RID> versions;
+		shader_rd->version_owner.get_owned_list(&versions);
+		for (const RID &E : versions) {
+			shader_rd->_compile_ensure_finished(shader_rd->version_owner.get_or_null(E));
+		}
+	}
+}
+
+uint64_t ShaderRD::get_cache_hit_count() {
+	return cache_hits.get();
+}
+
+uint64_t ShaderRD::get_cache_miss_count() {
+	return cache_misses.get();
+}
+
+uint64_t ShaderRD::get_pending_variant_count() {
+	return pending_variants.get();
+}
+
+#ifdef TOOLS_ENABLED
+Mutex ShaderRD::cache_files_mutex;
+HashSet<String> ShaderRD::cache_files_used;
+#endif
+
+Vector<String> ShaderRD::get_cache_files_used() {
+	Vector<String> files;
+#ifdef TOOLS_ENABLED
+	MutexLock lock(cache_files_mutex);
+	for (const String &E : cache_files_used) {
+		files.push_back(E);
+	}
+#endif
+	return files;
+}
+
 ShaderRD::~ShaderRD() {
+	{
+		MutexLock lock(shaders_mutex);
+		shaders.erase(this);
+	}
+
 	List<RID> remaining;
 	version_owner.get_owned_list(&remaining);
 	if (remaining.size()) {
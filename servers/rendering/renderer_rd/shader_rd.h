@@ -31,12 +31,15 @@
 #ifndef SHADER_RD_H
 #define SHADER_RD_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 #include "core/string/string_builder.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/rid_owner.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 #include "servers/rendering_server.h"
 
@@ -72,25 +75,54 @@ private:
 
 		Vector<uint8_t> *variant_data = nullptr;
 		RID *variants = nullptr; // Same size as variant defines.
+		LocalVector<WorkerThreadPool::GroupID> group_compilation_tasks; // One per group, INVALID_TASK_ID when not compiling.
+		SafeNumeric<uint64_t> finished_groups; // One bit per group whose variants can be returned without waiting.
 
-		bool valid;
-		bool dirty;
-		bool initialize_needed;
+		bool valid = false;
+		bool dirty = true;
+		bool initialize_needed = true;
+		bool compile_failed = false; // A group failed to compile, its variants are null.
 	};
 
 	Mutex variant_set_mutex;
+	Mutex compile_mutex; // Protects the compilation state of versions; held while waiting for group tasks.
 
 	struct CompileData {
 		Version *version;
 		int group = 0;
 	};
 
-	void _compile_variant(uint32_t p_variant, const CompileData *p_data);
+	// Placeholders that are being filled by a background compilation, so pipeline creation can wait for them
+	// (or use a fallback) no matter which ShaderRD they belong to.
+	struct CompilingShader {
+		ShaderRD *shader_rd = nullptr;
+		Version *version = nullptr;
+		int group = 0;
+		WorkerThreadPool::GroupID task = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	static Mutex compiling_shaders_mutex;
+	static HashMap<RID, CompilingShader> compiling_shaders;
+
+	// All shaders, so every pending compilation can be finished at once.
+	static Mutex shaders_mutex;
+	static HashSet<ShaderRD *> shaders;
+
+	static SafeNumeric<uint64_t> cache_hits;
+	static SafeNumeric<uint64_t> cache_misses;
+	static SafeNumeric<uint64_t> pending_variants;
+
+	void _compile_variant(uint32_t p_variant, CompileData p_data);
 
 	void _initialize_version(Version *p_version);
 	void _clear_version(Version *p_version);
-	void _compile_version(Version *p_version, int p_group);
+	void _start_version_compilation(Version *p_version);
+	void _compile_version_start(Version *p_version, int p_group, bool p_high_priority);
+	void _compile_version_end(Version *p_version, int p_group);
+	void _compile_version_abort(Version *p_version);
+	void _compile_ensure_finished(Version *p_version);
 	void _allocate_placeholders(Version *p_version, int p_group);
+	RID _version_get_shader_wait(Version *p_version, int p_variant);
 
 	RID_Owner<Version> version_owner;
 
@@ -123,12 +155,19 @@ private:
 	LocalVector<String> group_sha256;
 
 	static String shader_cache_dir;
+	static String shader_cache_res_dir; // Read-only cache baked into the exported project.
 	static bool shader_cache_cleanup_on_start;
 	static bool shader_cache_save_compressed;
 	static bool shader_cache_save_compressed_zstd;
 	static bool shader_cache_save_debug;
 	bool shader_cache_dir_valid = false;
 
+#ifdef TOOLS_ENABLED
+	// Cache files loaded or saved during this session, so they can be packed on export.
+	static Mutex cache_files_mutex;
+	static HashSet<String> cache_files_used;
+#endif
+
 	enum StageType {
 		STAGE_TYPE_VERTEX,
 		STAGE_TYPE_FRAGMENT,
@@ -143,7 +182,7 @@ private:
 	void _add_stage(const char *p_code, StageType p_stage_type);
 
 	String _version_get_sha1(Version *p_version) const;
-	String _get_cache_file_path(Version *p_version, int p_group);
+	String _get_cache_file_relative_path(Version *p_version, int p_group);
 	bool _load_from_cache(Version *p_version, int p_group);
 	void _save_to_cache(Version *p_version, int p_group);
 	void _initialize_cache();
@@ -165,22 +204,12 @@ public:
 		Version *version = version_owner.get_or_null(p_version);
 		ERR_FAIL_NULL_V(version, RID());
 
-		if (version->dirty) {
-			_initialize_version(version);
-			for (int i = 0; i < group_enabled.size(); i++) {
-				if (!group_enabled[i]) {
-					_allocate_placeholders(version, i);
-					continue;
-				}
-				_compile_version(version, i);
-			}
-		}
-
-		if (!version->valid) {
-			return RID();
+		// Finished groups don't change until the code is set again, so they can be read without locking.
+		if (version->finished_groups.get() & (uint64_t(1) << variant_defines[p_variant].group)) {
+			return version->variants[p_variant];
 		}
 
-		return version->variants[p_variant];
+		return _version_get_shader_wait(version, p_variant);
 	}
 
 	bool version_is_valid(RID p_version);
@@ -196,10 +225,23 @@ public:
 	bool is_group_enabled(int p_group) const;
 
 	static void set_shader_cache_dir(const String &p_dir);
+	static void set_shader_cache_res_dir(const String &p_dir);
 	static void set_shader_cache_save_compressed(bool p_enable);
 	static void set_shader_cache_save_compressed_zstd(bool p_enable);
 	static void set_shader_cache_save_debug(bool p_enable);
 
+	// Background compilation of groups enabled at run time.
+	static bool is_shader_compiling(RID p_shader);
+	static void wait_for_shader(RID p_shader);
+	static void process_background_compilations();
+	static void finish_background_compilations();
+
+	static uint64_t get_cache_hit_count();
+	static uint64_t get_cache_miss_count();
+	static uint64_t get_pending_variant_count();
+
+	static Vector<String> get_cache_files_used();
+
 	RS::ShaderNativeSourceCode version_get_native_source_code(RID p_version);
 
 	void initialize(const Vector<String> &p_variant_defines, const String &p_general_defines = "");
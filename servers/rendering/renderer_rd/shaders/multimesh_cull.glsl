@@ -0,0 +1,128 @@
+#[compute]
+
+#version 450
+
+#VERSION_DEFINES
+
+#define MAX_LODS 4
+#define COMMAND_SIZE 5
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+layout(set = 0, binding = 0, std140) uniform Params {
+	vec4 frustum_planes[6]; // In multimesh space, normals point outwards.
+
+	vec3 aabb_position;
+	uint instance_count;
+
+	vec3 aabb_size;
+	uint stride; // In vec4 units.
+
+	vec3 camera_position; // In multimesh space.
+	uint lod_count;
+
+	vec4 lod_distances; // Minimum distance (divided by instance scale) to use LOD i + 1.
+
+	uint surface_count;
+	bool orthogonal;
+	uint source_offset; // In vec4 units, skips the previous transforms when motion vectors were used.
+	uint pad;
+}
+params;
+
+layout(set = 0, binding = 1, std430) buffer restrict readonly SrcInstances {
+	vec4 data[];
+}
+src_instances;
+
+// One indexed indirect command per LOD and surface, instance_count is the second value.
+layout(set = 0, binding = 2, std430) buffer restrict DrawCommands {
+	uint data[];
+}
+draw_commands;
+
+layout(set = 0, binding = 3, std430) buffer restrict writeonly DstInstancesLOD0 {
+	vec4 data[];
+}
+dst_instances_lod_0;
+
+layout(set = 0, binding = 4, std430) buffer restrict writeonly DstInstancesLOD1 {
+	vec4 data[];
+}
+dst_instances_lod_1;
+
+layout(set = 0, binding = 5, std430) buffer restrict writeonly DstInstancesLOD2 {
+	vec4 data[];
+}
+dst_instances_lod_2;
+
+layout(set = 0, binding = 6, std430) buffer restrict writeonly DstInstancesLOD3 {
+	vec4 data[];
+}
+dst_instances_lod_3;
+
+void main() {
+	uint instance = gl_GlobalInvocationID.x;
+	if (instance >= params.instance_count) {
+		return;
+	}
+
+	uint src_offset = params.source_offset + instance * params.stride;
+
+	// Rows of the 3x4 instance transform.
+	vec4 row_x = src_instances.data[src_offset + 0];
+	vec4 row_y = src_instances.data[src_offset + 1];
+	vec4 row_z = src_instances.data[src_offset + 2];
+
+	vec3 extents = params.aabb_size * 0.5;
+	vec3 center = params.aabb_position + extents;
+
+	vec3 instance_center = vec3(dot(row_x.xyz, center), dot(row_y.xyz, center), dot(row_z.xyz, center)) + vec3(row_x.w, row_y.w, row_z.w);
+	vec3 instance_extents = vec3(dot(abs(row_x.xyz), extents), dot(abs(row_y.xyz), extents), dot(abs(row_z.xyz), extents));
+
+	for (uint i = 0; i < 6; i++) {
+		vec4 plane = params.frustum_planes[i];
+		if (dot(plane.xyz, instance_center) - plane.w > dot(abs(plane.xyz), instance_extents)) {
+			return; // Outside the frustum.
+		}
+	}
+
+	uint lod = 0;
+	if (params.lod_count > 1) {
+		float distance = 1.0;
+		float scale = 1.0;
+		if (!params.orthogonal) {
+			distance = max(length(instance_center - params.camera_position) - length(instance_extents), 0.0);
+			scale = max(length(vec3(row_x.x, row_y.x, row_z.x)), max(length(vec3(row_x.y, row_y.y, row_z.y)), length(vec3(row_x.z, row_y.z, row_z.z))));
+		}
+
+		while (lod < params.lod_count - 1 && distance >= params.lod_distances[lod] * scale) {
+			lod++;
+		}
+	}
+
+	uint command_offset = lod * params.surface_count * COMMAND_SIZE;
+	uint dst_offset = atomicAdd(draw_commands.data[command_offset + 1], 1) * params.stride;
+	for (uint i = 1; i < params.surface_count; i++) {
+		// All surfaces draw the same instances.
+		atomicAdd(draw_commands.data[command_offset + i * COMMAND_SIZE + 1], 1);
+	}
+
+	for (uint i = 0; i < params.stride; i++) {
+		vec4 value = src_instances.data[src_offset + i];
+		switch (lod) {
+			case 0: {
+				dst_instances_lod_0.data[dst_offset + i] = value;
+			} break;
+			case 1: {
+				dst_instances_lod_1.data[dst_offset + i] = value;
+			} break;
+			case 2: {
+				dst_instances_lod_2.data[dst_offset + i] = value;
+			} break;
+			default: {
+				dst_instances_lod_3.data[dst_offset + i] = value;
+			} break;
+		}
+	}
+}
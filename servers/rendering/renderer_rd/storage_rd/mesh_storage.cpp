@@ -181,6 +181,16 @@ MeshStorage::MeshStorage() {
 			skeleton_shader.default_skeleton_uniform_set = RD::get_singleton()->uniform_set_create(uniforms, skeleton_shader.version_shader[0], SkeletonShader::UNIFORM_SET_SKELETON);
 		}
 	}
+
+	{
+		Vector<String> multimesh_cull_modes;
+		multimesh_cull_modes.push_back("");
+
+		multimesh_cull_shader.shader.initialize(multimesh_cull_modes);
+		multimesh_cull_shader.version = multimesh_cull_shader.shader.version_create();
+		multimesh_cull_shader.version_shader = multimesh_cull_shader.shader.version_get_shader(multimesh_cull_shader.version, 0);
+		multimesh_cull_shader.pipeline = RD::get_singleton()->compute_pipeline_create(multimesh_cull_shader.version_shader);
+	}
 }
 
 MeshStorage::~MeshStorage() {
@@ -190,6 +200,7 @@ MeshStorage::~MeshStorage() {
 	}
 
 	skeleton_shader.shader.version_free(skeleton_shader.version);
+	multimesh_cull_shader.shader.version_free(multimesh_cull_shader.version);
 
 	RD::get_singleton()->free(default_rd_storage_buffer);
 
@@ -1410,6 +1421,8 @@ void MeshStorage::multimesh_allocate_data(RID p_multimesh, int p_instances, RS::
 		multimesh->uniform_set_3d = RID(); //cleared by dependency
 	}
 
+	_multimesh_free_gpu_cull_data(multimesh);
+
 	if (multimesh->data_cache_dirty_regions) {
 		memdelete_arr(multimesh->data_cache_dirty_regions);
 		multimesh->data_cache_dirty_regions = nullptr;
@@ -1507,6 +1520,224 @@ bool MeshStorage::_multimesh_uses_motion_vectors_offsets(RID p_multimesh) {
 	return _multimesh_uses_motion_vectors(multimesh);
 }
 
+void MeshStorage::multimesh_set_gpu_culling(RID p_multimesh, bool p_enable) {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL(multimesh);
+	if (multimesh->gpu_culling == p_enable) {
+		return;
+	}
+
+	multimesh->gpu_culling = p_enable;
+	if (!p_enable) {
+		_multimesh_free_gpu_cull_data(multimesh);
+	}
+
+	multimesh->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MULTIMESH);
+}
+
+bool MeshStorage::multimesh_is_gpu_culling_enabled(RID p_multimesh) const {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL_V(multimesh, false);
+	return multimesh->gpu_culling;
+}
+
+void MeshStorage::_multimesh_free_gpu_cull_data(MultiMesh *multimesh) {
+	for (uint32_t i = 0; i < MULTIMESH_GPU_CULL_MAX_LODS; i++) {
+		if (multimesh->gpu_cull_buffers[i].is_valid()) {
+			RD::get_singleton()->free(multimesh->gpu_cull_buffers[i]);
+			multimesh->gpu_cull_buffers[i] = RID();
+		}
+		multimesh->gpu_cull_uniform_sets_3d[i] = RID(); //cleared by dependency
+	}
+
+	if (multimesh->gpu_cull_command_buffer.is_valid()) {
+		RD::get_singleton()->free(multimesh->gpu_cull_command_buffer);
+		multimesh->gpu_cull_command_buffer = RID();
+		multimesh->gpu_cull_command_buffer_size = 0;
+	}
+
+	if (multimesh->gpu_cull_params_buffer.is_valid()) {
+		RD::get_singleton()->free(multimesh->gpu_cull_params_buffer);
+		multimesh->gpu_cull_params_buffer = RID();
+	}
+
+	multimesh->gpu_cull_uniform_set = RID(); //cleared by dependency
+	multimesh->gpu_cull_lod_count = 0;
+	multimesh->gpu_cull_surface_count = 0;
+	multimesh->gpu_cull_pass = 0;
+}
+
+bool MeshStorage::multimesh_gpu_cull_setup(RID p_multimesh, uint64_t p_pass, const Transform3D &p_transform, const Projection &p_cam_projection, const Transform3D &p_cam_transform, bool p_cam_orthogonal, float p_lod_distance_multiplier, float p_screen_mesh_lod_threshold, float p_lod_bias) {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL_V(multimesh, false);
+
+	if (!multimesh->gpu_culling || multimesh->gpu_cull_pass == p_pass) {
+		// Already culled for another instance in this pass, its results would be overwritten.
+		// The renderer only culls multimeshes used by a single instance.
+		return false;
+	}
+
+	if (multimesh->xform_format != RS::MULTIMESH_TRANSFORM_3D || !multimesh->buffer.is_valid() || _multimesh_uses_motion_vectors(multimesh)) {
+		// The compacted buffers only hold the current transforms.
+		return false;
+	}
+
+	Mesh *mesh = mesh_owner.get_or_null(multimesh->mesh);
+	uint32_t instance_count = multimesh_get_instances_to_draw(p_multimesh);
+	if (!mesh || mesh->surface_count == 0 || mesh->has_bone_weights || instance_count == 0) {
+		return false;
+	}
+
+	// Instances pick their LOD bucket from the thresholds of the first surface, the other surfaces use their matching LOD.
+	const Mesh::Surface *first_surface = mesh->surfaces[0];
+	uint32_t lod_count = p_screen_mesh_lod_threshold > 0.0 ? MIN(first_surface->lod_count + 1, (uint32_t)MULTIMESH_GPU_CULL_MAX_LODS) : 1;
+
+	// The source buffer is replaced when motion vectors get enabled, which frees the uniform set.
+	bool uniform_set_dirty = !multimesh->gpu_cull_uniform_set.is_valid() || !RD::get_singleton()->uniform_set_is_valid(multimesh->gpu_cull_uniform_set);
+
+	uint32_t buffer_size = multimesh->instances * multimesh->stride_cache * sizeof(float);
+	for (uint32_t i = 0; i < lod_count; i++) {
+		if (!multimesh->gpu_cull_buffers[i].is_valid()) {
+			multimesh->gpu_cull_buffers[i] = RD::get_singleton()->storage_buffer_create(buffer_size);
+			uniform_set_dirty = true;
+		}
+	}
+
+	uint32_t command_buffer_size = lod_count * mesh->surface_count * MULTIMESH_GPU_CULL_COMMAND_SIZE;
+	if (multimesh->gpu_cull_command_buffer_size != command_buffer_size) {
+		if (multimesh->gpu_cull_command_buffer.is_valid()) {
+			RD::get_singleton()->free(multimesh->gpu_cull_command_buffer);
+		}
+		multimesh->gpu_cull_command_buffer = RD::get_singleton()->storage_buffer_create(command_buffer_size, Vector<uint8_t>(), RD::STORAGE_BUFFER_USAGE_DISPATCH_INDIRECT);
+		multimesh->gpu_cull_command_buffer_size = command_buffer_size;
+		uniform_set_dirty = true;
+	}
+
+	if (!multimesh->gpu_cull_params_buffer.is_valid()) {
+		multimesh->gpu_cull_params_buffer = RD::get_singleton()->uniform_buffer_create(sizeof(MultiMeshCullShader::Params));
+		uniform_set_dirty = true;
+	}
+
+	if (uniform_set_dirty) {
+		if (multimesh->gpu_cull_uniform_set.is_valid() && RD::get_singleton()->uniform_set_is_valid(multimesh->gpu_cull_uniform_set)) {
+			RD::get_singleton()->free(multimesh->gpu_cull_uniform_set);
+		}
+
+		Vector<RD::Uniform> uniforms;
+		{
+			RD::Uniform u;
+			u.binding = 0;
+			u.uniform_type = RD::UNIFORM_TYPE_UNIFORM_BUFFER;
+			u.append_id(multimesh->gpu_cull_params_buffer);
+			uniforms.push_back(u);
+		}
+		{
+			RD::Uniform u;
+			u.binding = 1;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.append_id(multimesh->buffer);
+			uniforms.push_back(u);
+		}
+		{
+			RD::Uniform u;
+			u.binding = 2;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.append_id(multimesh->gpu_cull_command_buffer);
+			uniforms.push_back(u);
+		}
+		for (uint32_t i = 0; i < MULTIMESH_GPU_CULL_MAX_LODS; i++) {
+			RD::Uniform u;
+			u.binding = 3 + i;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			// Unused LODs are never written to, bind any valid buffer.
+			u.append_id(multimesh->gpu_cull_buffers[i].is_valid() ? multimesh->gpu_cull_buffers[i] : multimesh->gpu_cull_buffers[0]);
+			uniforms.push_back(u);
+		}
+		multimesh->gpu_cull_uniform_set = RD::get_singleton()->uniform_set_create(uniforms, multimesh_cull_shader.version_shader, 0);
+	}
+
+	// Reset the draw commands, the compute shader counts the instances.
+	LocalVector<uint32_t> commands;
+	commands.resize(command_buffer_size / sizeof(uint32_t));
+	for (uint32_t i = 0; i < lod_count; i++) {
+		for (uint32_t j = 0; j < mesh->surface_count; j++) {
+			const Mesh::Surface *surface = mesh->surfaces[j];
+			uint32_t surface_lod = MIN(i, surface->lod_count);
+			uint32_t *command = &commands[(i * mesh->surface_count + j) * MULTIMESH_GPU_CULL_COMMAND_SIZE / sizeof(uint32_t)];
+
+			if (surface->index_count) {
+				command[0] = surface_lod > 0 ? surface->lods[surface_lod - 1].index_count : surface->index_count;
+			} else {
+				command[0] = surface->vertex_count;
+			}
+			command[1] = 0; // Instance count.
+			command[2] = 0;
+			command[3] = 0;
+			command[4] = 0;
+		}
+	}
+	RD::get_singleton()->buffer_update(multimesh->gpu_cull_command_buffer, 0, command_buffer_size, commands.ptr());
+
+	MultiMeshCullShader::Params params;
+	memset(&params, 0, sizeof(MultiMeshCullShader::Params));
+
+	// Cull in multimesh space, so the instance transforms can be used as they are.
+	Transform3D inverse_transform = p_transform.affine_inverse();
+	Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	ERR_FAIL_COND_V(planes.size() != 6, false);
+	for (int i = 0; i < 6; i++) {
+		Plane plane = inverse_transform.xform(planes[i]);
+		params.frustum_planes[i][0] = plane.normal.x;
+		params.frustum_planes[i][1] = plane.normal.y;
+		params.frustum_planes[i][2] = plane.normal.z;
+		params.frustum_planes[i][3] = plane.d;
+	}
+
+	AABB aabb = mesh->custom_aabb != AABB() ? mesh->custom_aabb : mesh->aabb;
+	params.aabb_position[0] = aabb.position.x;
+	params.aabb_position[1] = aabb.position.y;
+	params.aabb_position[2] = aabb.position.z;
+	params.aabb_size[0] = aabb.size.x;
+	params.aabb_size[1] = aabb.size.y;
+	params.aabb_size[2] = aabb.size.z;
+
+	Vector3 camera_position = inverse_transform.xform(p_cam_transform.origin);
+	params.camera_position[0] = camera_position.x;
+	params.camera_position[1] = camera_position.y;
+	params.camera_position[2] = camera_position.z;
+
+	params.instance_count = instance_count;
+	params.stride = multimesh->stride_cache / 4;
+	params.source_offset = multimesh->motion_vectors_current_offset * params.stride;
+	params.surface_count = mesh->surface_count;
+	params.orthogonal = p_cam_orthogonal;
+	params.lod_count = lod_count;
+
+	// Same criteria as RenderForwardClustered::_fill_render_list() uses for whole instances. Distances are in multimesh space,
+	// so the scale of the node cancels out with the one it applies to the model.
+	for (uint32_t i = 0; i + 1 < lod_count; i++) {
+		params.lod_distances[i] = first_surface->lods[i].edge_length * p_lod_bias / (p_lod_distance_multiplier * p_screen_mesh_lod_threshold);
+	}
+
+	RD::get_singleton()->buffer_update(multimesh->gpu_cull_params_buffer, 0, sizeof(MultiMeshCullShader::Params), &params);
+
+	multimesh->gpu_cull_pass = p_pass;
+	multimesh->gpu_cull_lod_count = lod_count;
+	multimesh->gpu_cull_surface_count = mesh->surface_count;
+
+	return true;
+}
+
+void MeshStorage::multimesh_gpu_cull_dispatch(RD::ComputeListID p_compute_list, RID p_multimesh) {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL(multimesh);
+	ERR_FAIL_COND(!multimesh->gpu_cull_uniform_set.is_valid());
+
+	RD::get_singleton()->compute_list_bind_compute_pipeline(p_compute_list, multimesh_cull_shader.pipeline);
+	RD::get_singleton()->compute_list_bind_uniform_set(p_compute_list, multimesh->gpu_cull_uniform_set, 0);
+	RD::get_singleton()->compute_list_dispatch_threads(p_compute_list, multimesh_get_instances_to_draw(p_multimesh), 1, 1);
+}
+
 int MeshStorage::multimesh_get_instance_count(RID p_multimesh) const {
 	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 	ERR_FAIL_NULL_V(multimesh, 0);
@@ -1541,7 +1772,8 @@ void MeshStorage::multimesh_set_mesh(RID p_multimesh, RID p_mesh) {
 	multimesh->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MESH);
 }
 
-#define MULTIMESH_DIRTY_REGION_SIZE 512
+#define MULTIMESH_DIRTY_REGION_SIZE 128
+#define MULTIMESH_MAX_DIRTY_RUNS 32
 
 void MeshStorage::_multimesh_make_local(MultiMesh *multimesh) const {
 	if (multimesh->data_cache.size() > 0) {
@@ -1605,6 +1837,9 @@ void MeshStorage::_multimesh_update_motion_vectors_data_cache(MultiMesh *multime
 					memcpy(data + current_ofs + offset, data + previous_ofs + offset, MIN(region_size, size - offset));
 				}
 			}
+
+			// The regions changed last frame must be uploaded to the new current half even if nothing else changes.
+			_multimesh_mark_all_dirty(multimesh, false, false);
 		}
 	}
 }
@@ -1939,6 +2174,13 @@ void MeshStorage::multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_b
 		_multimesh_enable_motion_vectors(multimesh);
 	}
 
+	if (multimesh->data_cache.size()) {
+		// The cache mirrors the buffer, so only the regions that differ from it need to be uploaded.
+		_multimesh_update_motion_vectors_data_cache(multimesh);
+		_multimesh_update_data_cache(multimesh, 0, p_buffer.ptr(), multimesh->instances);
+		return;
+	}
+
 	if (multimesh->motion_vectors_enabled) {
 		uint32_t frame = RSG::rasterizer->get_frame_number();
 
@@ -1955,11 +2197,7 @@ void MeshStorage::multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_b
 		multimesh->buffer_set = true;
 	}
 
-	if (multimesh->data_cache.size()) {
-		float *cache_data = multimesh->data_cache.ptrw();
-		memcpy(cache_data + (multimesh->motion_vectors_current_offset * multimesh->stride_cache), p_buffer.ptr(), p_buffer.size() * sizeof(float));
-		_multimesh_mark_all_dirty(multimesh, true, true); //update AABB
-	} else if (multimesh->mesh.is_valid()) {
+	if (multimesh->mesh.is_valid()) {
 		//if we have a mesh set, we need to re-generate the AABB from the new data
 		const float *data = p_buffer.ptr();
 
@@ -1970,6 +2208,55 @@ void MeshStorage::multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_b
 	}
 }
 
+void MeshStorage::multimesh_set_buffer_range(RID p_multimesh, int p_from_instance, const Vector<float> &p_buffer) {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL(multimesh);
+	ERR_FAIL_COND(multimesh->stride_cache == 0 || p_buffer.size() % multimesh->stride_cache != 0);
+
+	int instance_count = p_buffer.size() / multimesh->stride_cache;
+	ERR_FAIL_COND(p_from_instance < 0 || p_from_instance + instance_count > multimesh->instances);
+	if (instance_count == 0) {
+		return;
+	}
+
+	// Updates go through the CPU copy, so the changed regions are uploaded together once per frame.
+	_multimesh_make_local(multimesh);
+
+	bool uses_motion_vectors = (RSG::viewport->get_num_viewports_with_motion_vectors() > 0) || (RendererCompositorStorage::get_singleton()->get_num_compositor_effects_with_motion_vectors() > 0);
+	if (uses_motion_vectors) {
+		_multimesh_enable_motion_vectors(multimesh);
+	}
+
+	_multimesh_update_motion_vectors_data_cache(multimesh);
+	_multimesh_update_data_cache(multimesh, p_from_instance, p_buffer.ptr(), instance_count);
+}
+
+void MeshStorage::_multimesh_update_data_cache(MultiMesh *multimesh, int p_from_instance, const float *p_data, int p_instance_count) {
+	if (!multimesh->buffer_set) {
+		// Nothing was uploaded yet, so the cache doesn't mirror the buffer.
+		_multimesh_mark_all_dirty(multimesh, true, true);
+		multimesh->buffer_set = true;
+	}
+
+	float *cache_data = multimesh->data_cache.ptrw() + multimesh->motion_vectors_current_offset * multimesh->stride_cache;
+	int to_instance = p_from_instance + p_instance_count;
+	int from_instance = p_from_instance;
+
+	while (from_instance < to_instance) {
+		int region_end = MIN((from_instance / MULTIMESH_DIRTY_REGION_SIZE + 1) * MULTIMESH_DIRTY_REGION_SIZE, to_instance);
+		float *dst = cache_data + from_instance * multimesh->stride_cache;
+		const float *src = p_data + (from_instance - p_from_instance) * multimesh->stride_cache;
+		size_t size = (region_end - from_instance) * multimesh->stride_cache * sizeof(float);
+
+		if (memcmp(dst, src, size) != 0) {
+			memcpy(dst, src, size);
+			_multimesh_mark_dirty(multimesh, from_instance, true);
+		}
+
+		from_instance = region_end;
+	}
+}
+
 Vector<float> MeshStorage::multimesh_get_buffer(RID p_multimesh) const {
 	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 	ERR_FAIL_NULL_V(multimesh, Vector<float>());
@@ -2062,17 +2349,36 @@ void MeshStorage::_update_dirty_multimeshes() {
 				uint32_t visible_region_count = visible_instances == 0 ? 0 : Math::division_round_up(visible_instances, (uint32_t)MULTIMESH_DIRTY_REGION_SIZE);
 
 				uint32_t region_size = multimesh->stride_cache * MULTIMESH_DIRTY_REGION_SIZE * sizeof(float);
-				if (total_dirty_regions > 32 || total_dirty_regions > visible_region_count / 2) {
-					//if there too many dirty regions, or represent the majority of regions, just copy all, else transfer cost piles up too much
-					RD::get_singleton()->buffer_update(multimesh->buffer, buffer_offset * sizeof(float), MIN(visible_region_count * region_size, multimesh->instances * (uint32_t)multimesh->stride_cache * (uint32_t)sizeof(float)), data);
-				} else {
-					//not that many regions? update them all
-					for (uint32_t i = 0; i < visible_region_count; i++) {
-						if (multimesh->data_cache_dirty_regions[i] || multimesh->previous_data_cache_dirty_regions[i]) {
-							uint32_t offset = i * region_size;
-							uint32_t size = multimesh->stride_cache * (uint32_t)multimesh->instances * (uint32_t)sizeof(float);
-							uint32_t region_start_index = multimesh->stride_cache * MULTIMESH_DIRTY_REGION_SIZE * i;
-							RD::get_singleton()->buffer_update(multimesh->buffer, buffer_offset * sizeof(float) + offset, MIN(region_size, size - offset), &data[region_start_index]);
+				uint32_t size = multimesh->stride_cache * (uint32_t)multimesh->instances * (uint32_t)sizeof(float);
+
+				// Adjacent dirty regions are uploaded as a single run.
+				uint32_t dirty_region_count = 0;
+				uint32_t dirty_run_count = 0;
+				for (uint32_t i = 0; i < visible_region_count; i++) {
+					if (multimesh->data_cache_dirty_regions[i] || multimesh->previous_data_cache_dirty_regions[i]) {
+						if (i == 0 || !(multimesh->data_cache_dirty_regions[i - 1] || multimesh->previous_data_cache_dirty_regions[i - 1])) {
+							dirty_run_count++;
+						}
+						dirty_region_count++;
+					}
+				}
+
+				if (dirty_run_count > MULTIMESH_MAX_DIRTY_RUNS || dirty_region_count > visible_region_count / 2) {
+					//if there too many dirty runs, or represent the majority of regions, just copy all, else transfer cost piles up too much
+					RD::get_singleton()->buffer_update(multimesh->buffer, buffer_offset * sizeof(float), MIN(visible_region_count * region_size, size), data);
+				} else if (dirty_region_count > 0) {
+					uint32_t run_start = 0;
+					bool in_run = false;
+					for (uint32_t i = 0; i <= visible_region_count; i++) {
+						bool region_dirty = i < visible_region_count && (multimesh->data_cache_dirty_regions[i] || multimesh->previous_data_cache_dirty_regions[i]);
+						if (region_dirty && !in_run) {
+							run_start = i;
+							in_run = true;
+						} else if (!region_dirty && in_run) {
+							uint32_t offset = run_start * region_size;
+							uint32_t region_start_index = multimesh->stride_cache * MULTIMESH_DIRTY_REGION_SIZE * run_start;
+							RD::get_singleton()->buffer_update(multimesh->buffer, buffer_offset * sizeof(float) + offset, MIN((i - run_start) * region_size, size - offset), &data[region_start_index]);
+							in_run = false;
 						}
 					}
 				}
@@ -35,6 +35,7 @@
 #include "core/templates/local_vector.h"
 #include "core/templates/rid_owner.h"
 #include "core/templates/self_list.h"
+#include "servers/rendering/renderer_rd/shaders/multimesh_cull.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/skeleton.glsl.gen.h"
 #include "servers/rendering/storage/mesh_storage.h"
 #include "servers/rendering/storage/utilities.h"
@@ -212,6 +213,11 @@ private:
 
 	/* MultiMesh */
 
+	enum {
+		MULTIMESH_GPU_CULL_MAX_LODS = 4,
+		MULTIMESH_GPU_CULL_COMMAND_SIZE = 5 * sizeof(uint32_t),
+	};
+
 	struct MultiMesh {
 		RID mesh;
 		int instances = 0;
@@ -241,6 +247,18 @@ private:
 		RID uniform_set_3d;
 		RID uniform_set_2d;
 
+		// GPU culling, visible instances are compacted into one buffer per LOD and drawn indirectly.
+		bool gpu_culling = false;
+		uint64_t gpu_cull_pass = 0;
+		uint32_t gpu_cull_lod_count = 0;
+		uint32_t gpu_cull_surface_count = 0;
+		RID gpu_cull_params_buffer;
+		RID gpu_cull_command_buffer;
+		uint32_t gpu_cull_command_buffer_size = 0;
+		RID gpu_cull_buffers[MULTIMESH_GPU_CULL_MAX_LODS];
+		RID gpu_cull_uniform_sets_3d[MULTIMESH_GPU_CULL_MAX_LODS];
+		RID gpu_cull_uniform_set;
+
 		bool dirty = false;
 		MultiMesh *dirty_list = nullptr;
 
@@ -258,6 +276,35 @@ private:
 	_FORCE_INLINE_ void _multimesh_mark_dirty(MultiMesh *multimesh, int p_index, bool p_aabb);
 	_FORCE_INLINE_ void _multimesh_mark_all_dirty(MultiMesh *multimesh, bool p_data, bool p_aabb);
 	_FORCE_INLINE_ void _multimesh_re_create_aabb(MultiMesh *multimesh, const float *p_data, int p_instances);
+	void _multimesh_update_data_cache(MultiMesh *multimesh, int p_from_instance, const float *p_data, int p_instance_count);
+	void _multimesh_free_gpu_cull_data(MultiMesh *multimesh);
+
+	struct MultiMeshCullShader {
+		struct Params {
+			float frustum_planes[6][4];
+
+			float aabb_position[3];
+			uint32_t instance_count;
+
+			float aabb_size[3];
+			uint32_t stride;
+
+			float camera_position[3];
+			uint32_t lod_count;
+
+			float lod_distances[4];
+
+			uint32_t surface_count;
+			uint32_t orthogonal;
+			uint32_t source_offset;
+			uint32_t pad;
+		};
+
+		MultimeshCullShaderRD shader;
+		RID version;
+		RID version_shader;
+		RID pipeline;
+	} multimesh_cull_shader;
 
 	/* Skeleton */
 
@@ -430,6 +477,11 @@ public:
 		return s->lod_count > 0;
 	}
 
+	_FORCE_INLINE_ uint32_t mesh_surface_get_lod_count(void *p_surface) const {
+		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
+		return s->lod_count;
+	}
+
 	_FORCE_INLINE_ uint32_t mesh_surface_get_vertices_drawn_count(void *p_surface) const {
 		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
 		return s->index_count ? s->index_count : s->vertex_count;
@@ -642,6 +694,7 @@ public:
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const override;
 
 	virtual void multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_buffer) override;
+	virtual void multimesh_set_buffer_range(RID p_multimesh, int p_from_instance, const Vector<float> &p_buffer) override;
 	virtual Vector<float> multimesh_get_buffer(RID p_multimesh) const override;
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible) override;
@@ -652,7 +705,52 @@ public:
 
 	virtual AABB multimesh_get_aabb(RID p_multimesh) const override;
 
+	virtual void multimesh_set_gpu_culling(RID p_multimesh, bool p_enable) override;
+	virtual bool multimesh_is_gpu_culling_enabled(RID p_multimesh) const override;
+
 	void _update_dirty_multimeshes();
+
+	bool multimesh_gpu_cull_setup(RID p_multimesh, uint64_t p_pass, const Transform3D &p_transform, const Projection &p_cam_projection, const Transform3D &p_cam_transform, bool p_cam_orthogonal, float p_lod_distance_multiplier, float p_screen_mesh_lod_threshold, float p_lod_bias);
+	void multimesh_gpu_cull_dispatch(RD::ComputeListID p_compute_list, RID p_multimesh);
+
+	_FORCE_INLINE_ bool multimesh_is_gpu_culled(RID p_multimesh, uint64_t p_pass) const {
+		MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+		return multimesh && p_pass != 0 && multimesh->gpu_cull_pass == p_pass;
+	}
+
+	_FORCE_INLINE_ uint32_t multimesh_get_gpu_cull_lod_count(RID p_multimesh) const {
+		MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+		return multimesh->gpu_cull_lod_count;
+	}
+
+	_FORCE_INLINE_ RID multimesh_get_gpu_cull_command_buffer(RID p_multimesh) const {
+		MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+		return multimesh->gpu_cull_command_buffer;
+	}
+
+	_FORCE_INLINE_ uint32_t multimesh_get_gpu_cull_command_offset(RID p_multimesh, uint32_t p_lod, uint32_t p_surface) const {
+		MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+		return (p_lod * multimesh->gpu_cull_surface_count + p_surface) * MULTIMESH_GPU_CULL_COMMAND_SIZE;
+	}
+
+	_FORCE_INLINE_ RID multimesh_get_gpu_cull_3d_uniform_set(RID p_multimesh, uint32_t p_lod, RID p_shader, uint32_t p_set) const {
+		MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+		if (multimesh == nullptr || p_lod >= multimesh->gpu_cull_lod_count) {
+			return RID();
+		}
+		if (!multimesh->gpu_cull_uniform_sets_3d[p_lod].is_valid()) {
+			Vector<RD::Uniform> uniforms;
+			RD::Uniform u;
+			u.binding = 0;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.append_id(multimesh->gpu_cull_buffers[p_lod]);
+			uniforms.push_back(u);
+			multimesh->gpu_cull_uniform_sets_3d[p_lod] = RD::get_singleton()->uniform_set_create(uniforms, p_shader, p_set);
+		}
+
+		return multimesh->gpu_cull_uniform_sets_3d[p_lod];
+	}
+
 	void _multimesh_get_motion_vectors_offsets(RID p_multimesh, uint32_t &r_current_offset, uint32_t &r_prev_offset);
 	bool _multimesh_uses_motion_vectors_offsets(RID p_multimesh);
 	bool _multimesh_uses_motion_vectors(RID p_multimesh);
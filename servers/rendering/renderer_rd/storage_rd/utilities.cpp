@@ -31,6 +31,8 @@
 #include "utilities.h"
 #include "../environment/fog.h"
 #include "../environment/gi.h"
+#include "../pipeline_cache_rd.h"
+#include "../shader_rd.h"
 #include "light_storage.h"
 #include "mesh_storage.h"
 #include "particles_storage.h"
@@ -302,6 +304,16 @@ uint64_t Utilities::get_rendering_info(RS::RenderingInfo p_info) {
 		return buffer_mem_cache;
 	} else if (p_info == RS::RENDERING_INFO_VIDEO_MEM_USED) {
 		return total_mem_cache;
+	} else if (p_info == RS::RENDERING_INFO_PIPELINE_WARMUP_PENDING) {
+		return PipelineCacheRD::get_warmup_pending_count();
+	} else if (p_info == RS::RENDERING_INFO_PIPELINE_WARMUP_COMPILED) {
+		return PipelineCacheRD::get_warmup_compiled_count();
+	} else if (p_info == RS::RENDERING_INFO_SHADER_CACHE_HITS) {
+		return ShaderRD::get_cache_hit_count();
+	} else if (p_info == RS::RENDERING_INFO_SHADER_CACHE_MISSES) {
+		return ShaderRD::get_cache_miss_count();
+	} else if (p_info == RS::RENDERING_INFO_SHADER_COMPILATIONS_PENDING) {
+		return ShaderRD::get_pending_variant_count();
 	}
 	return 0;
 }
@@ -329,3 +341,9 @@ Size2i Utilities::get_maximum_viewport_size() const {
 	int max_y = device->limit_get(RenderingDevice::LIMIT_MAX_VIEWPORT_DIMENSIONS_Y);
 	return Size2i(max_x, max_y);
 }
+
+Vector<String> Utilities::get_shader_cache_files() const {
+	// Groups still compiling in the background are only saved once they are finished.
+	ShaderRD::finish_background_compilations();
+	return ShaderRD::get_cache_files_used();
+}
@@ -117,6 +117,8 @@ public:
 	virtual String get_video_adapter_api_version() const override;
 
 	virtual Size2i get_maximum_viewport_size() const override;
+
+	virtual Vector<String> get_shader_cache_files() const override;
 };
 
 } // namespace RendererRD
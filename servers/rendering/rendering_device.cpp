@@ -2234,6 +2234,19 @@ RenderingDevice::TextureSamples RenderingDevice::framebuffer_format_get_texture_
 	return E->value.pass_samples[p_pass];
 }
 
+bool RenderingDevice::framebuffer_format_get_description(FramebufferFormatID p_format, Vector<AttachmentFormat> &r_attachments, Vector<FramebufferPass> &r_passes, uint32_t &r_view_count) {
+	_THREAD_SAFE_METHOD_
+
+	HashMap<FramebufferFormatID, FramebufferFormat>::Iterator E = framebuffer_formats.find(p_format);
+	ERR_FAIL_COND_V(!E, false);
+
+	const FramebufferFormatKey &key = E->value.E->key();
+	r_attachments = key.attachments;
+	r_passes = key.passes;
+	r_view_count = key.view_count;
+	return true;
+}
+
 RID RenderingDevice::framebuffer_create_empty(const Size2i &p_size, TextureSamples p_samples, FramebufferFormatID p_format_check) {
 	_THREAD_SAFE_METHOD_
 	Framebuffer framebuffer;
@@ -2469,6 +2482,14 @@ RenderingDevice::VertexFormatID RenderingDevice::vertex_format_create(const Vect
 	return id;
 }
 
+Vector<RenderingDevice::VertexAttribute> RenderingDevice::vertex_format_get_attributes(VertexFormatID p_vertex_format) {
+	_THREAD_SAFE_METHOD_
+
+	const VertexDescriptionCache *vd = vertex_formats.getptr(p_vertex_format);
+	ERR_FAIL_NULL_V(vd, Vector<VertexAttribute>());
+	return vd->vertex_formats;
+}
+
 RID RenderingDevice::vertex_array_create(uint32_t p_vertex_count, VertexFormatID p_vertex_format, const Vector<RID> &p_src_buffers, const Vector<uint64_t> &p_offsets) {
 	_THREAD_SAFE_METHOD_
 
@@ -2683,6 +2704,7 @@ RID RenderingDevice::shader_create_from_bytecode(const Vector<uint8_t> &p_shader
 	shader->name = name;
 	shader->driver_id = shader_id;
 	shader->layout_hash = driver->shader_get_layout_hash(shader_id);
+	shader->bytecode_hash = hash_murmur3_buffer(p_shader_binary.ptr(), p_shader_binary.size());
 
 	for (int i = 0; i < shader->uniform_sets.size(); i++) {
 		uint32_t format = 0; // No format, default.
@@ -2748,6 +2770,14 @@ uint64_t RenderingDevice::shader_get_vertex_input_attribute_mask(RID p_shader) {
 	return shader->vertex_input_mask;
 }
 
+uint32_t RenderingDevice::shader_get_bytecode_hash(RID p_shader) {
+	_THREAD_SAFE_METHOD_
+
+	const Shader *shader = shader_owner.get_or_null(p_shader);
+	ERR_FAIL_NULL_V(shader, 0);
+	return shader->bytecode_hash;
+}
+
 /******************/
 /**** UNIFORMS ****/
 /******************/
@@ -4039,34 +4069,39 @@ void RenderingDevice::draw_list_set_push_constant(DrawListID p_list, const void
 #endif
 }
 
-void RenderingDevice::draw_list_draw(DrawListID p_list, bool p_use_indices, uint32_t p_instances, uint32_t p_procedural_vertices) {
-	DrawList *dl = _get_draw_list_ptr(p_list);
-	ERR_FAIL_NULL(dl);
+// Validates the draw list state shared by direct and indirect draws, then binds the uniform sets the pipeline expects.
+bool RenderingDevice::_draw_list_prepare_draw(DrawList *p_draw_list, bool p_use_indices) {
+	DrawList *dl = p_draw_list;
+
 #ifdef DEBUG_ENABLED
-	ERR_FAIL_COND_MSG(!dl->validation.active, "Submitted Draw Lists can no longer be modified.");
+	ERR_FAIL_COND_V_MSG(!dl->validation.active, false, "Submitted Draw Lists can no longer be modified.");
 #endif
 
 #ifdef DEBUG_ENABLED
-	ERR_FAIL_COND_MSG(!dl->validation.pipeline_active,
+	ERR_FAIL_COND_V_MSG(!dl->validation.pipeline_active, false,
 			"No render pipeline was set before attempting to draw.");
 	if (dl->validation.pipeline_vertex_format != INVALID_ID) {
 		// Pipeline uses vertices, validate format.
-		ERR_FAIL_COND_MSG(dl->validation.vertex_format == INVALID_ID,
+		ERR_FAIL_COND_V_MSG(dl->validation.vertex_format == INVALID_ID, false,
 				"No vertex array was bound, and render pipeline expects vertices.");
 		// Make sure format is right.
-		ERR_FAIL_COND_MSG(dl->validation.pipeline_vertex_format != dl->validation.vertex_format,
+		ERR_FAIL_COND_V_MSG(dl->validation.pipeline_vertex_format != dl->validation.vertex_format, false,
 				"The vertex format used to create the pipeline does not match the vertex format bound.");
-		// Make sure number of instances is valid.
-		ERR_FAIL_COND_MSG(p_instances > dl->validation.vertex_max_instances_allowed,
-				"Number of instances requested (" + itos(p_instances) + " is larger than the maximum number supported by the bound vertex array (" + itos(dl->validation.vertex_max_instances_allowed) + ").");
 	}
 
 	if (dl->validation.pipeline_push_constant_size > 0) {
 		// Using push constants, check that they were supplied.
-		ERR_FAIL_COND_MSG(!dl->validation.pipeline_push_constant_supplied,
+		ERR_FAIL_COND_V_MSG(!dl->validation.pipeline_push_constant_supplied, false,
 				"The shader in this pipeline requires a push constant to be set before drawing, but it's not present.");
 	}
 
+	if (p_use_indices) {
+		ERR_FAIL_COND_V_MSG(!dl->validation.index_array_count, false,
+				"Draw command requested indices, but no index buffer was set.");
+
+		ERR_FAIL_COND_V_MSG(dl->validation.pipeline_uses_restart_indices != dl->validation.index_buffer_uses_restart_indices, false,
+				"The usage of restart indices in index buffer does not match the render primitive in the pipeline.");
+	}
 #endif
 
 #ifdef DEBUG_ENABLED
@@ -4078,12 +4113,12 @@ void RenderingDevice::draw_list_draw(DrawListID p_list, bool p_use_indices, uint
 
 		if (dl->state.sets[i].pipeline_expected_format != dl->state.sets[i].uniform_set_format) {
 			if (dl->state.sets[i].uniform_set_format == 0) {
-				ERR_FAIL_MSG("Uniforms were never supplied for set (" + itos(i) + ") at the time of drawing, which are required by the pipeline.");
+				ERR_FAIL_V_MSG(false, "Uniforms were never supplied for set (" + itos(i) + ") at the time of drawing, which are required by the pipeline.");
 			} else if (uniform_set_owner.owns(dl->state.sets[i].uniform_set)) {
 				UniformSet *us = uniform_set_owner.get_or_null(dl->state.sets[i].uniform_set);
-				ERR_FAIL_MSG("Uniforms supplied for set (" + itos(i) + "):\n" + _shader_uniform_debug(us->shader_id, us->shader_set) + "\nare not the same format as required by the pipeline shader. Pipeline shader requires the following bindings:\n" + _shader_uniform_debug(dl->state.pipeline_shader));
+				ERR_FAIL_V_MSG(false, "Uniforms supplied for set (" + itos(i) + "):\n" + _shader_uniform_debug(us->shader_id, us->shader_set) + "\nare not the same format as required by the pipeline shader. Pipeline shader requires the following bindings:\n" + _shader_uniform_debug(dl->state.pipeline_shader));
 			} else {
-				ERR_FAIL_MSG("Uniforms supplied for set (" + itos(i) + ", which was just freed) are not the same format as required by the pipeline shader. Pipeline shader requires the following bindings:\n" + _shader_uniform_debug(dl->state.pipeline_shader));
+				ERR_FAIL_V_MSG(false, "Uniforms supplied for set (" + itos(i) + ", which was just freed) are not the same format as required by the pipeline shader. Pipeline shader requires the following bindings:\n" + _shader_uniform_debug(dl->state.pipeline_shader));
 			}
 		}
 	}
@@ -4119,17 +4154,31 @@ void RenderingDevice::draw_list_draw(DrawListID p_list, bool p_use_indices, uint
 		}
 	}
 
-	if (p_use_indices) {
+	return true;
+}
+
+void RenderingDevice::draw_list_draw(DrawListID p_list, bool p_use_indices, uint32_t p_instances, uint32_t p_procedural_vertices) {
+	DrawList *dl = _get_draw_list_ptr(p_list);
+	ERR_FAIL_NULL(dl);
+
 #ifdef DEBUG_ENABLED
+	if (dl->validation.pipeline_vertex_format != INVALID_ID) {
+		// Make sure number of instances is valid.
+		ERR_FAIL_COND_MSG(p_instances > dl->validation.vertex_max_instances_allowed,
+				"Number of instances requested (" + itos(p_instances) + " is larger than the maximum number supported by the bound vertex array (" + itos(dl->validation.vertex_max_instances_allowed) + ").");
+	}
+
+	if (p_use_indices) {
 		ERR_FAIL_COND_MSG(p_procedural_vertices > 0,
 				"Procedural vertices can't be used together with indices.");
+	}
+#endif
 
-		ERR_FAIL_COND_MSG(!dl->validation.index_array_count,
-				"Draw command requested indices, but no index buffer was set.");
+	if (!_draw_list_prepare_draw(dl, p_use_indices)) {
+		return;
+	}
 
-		ERR_FAIL_COND_MSG(dl->validation.pipeline_uses_restart_indices != dl->validation.index_buffer_uses_restart_indices,
-				"The usage of restart indices in index buffer does not match the render primitive in the pipeline.");
-#endif
+	if (p_use_indices) {
 		uint32_t to_draw = dl->validation.index_array_count;
 
 #ifdef DEBUG_ENABLED
@@ -4172,6 +4221,35 @@ void RenderingDevice::draw_list_draw(DrawListID p_list, bool p_use_indices, uint
 	dl->state.draw_count++;
 }
 
+void RenderingDevice::draw_list_draw_indirect(DrawListID p_list, bool p_use_indices, RID p_buffer, uint32_t p_offset, uint32_t p_draw_count, uint32_t p_stride) {
+	DrawList *dl = _get_draw_list_ptr(p_list);
+	ERR_FAIL_NULL(dl);
+
+	Buffer *buffer = storage_buffer_owner.get_or_null(p_buffer);
+	ERR_FAIL_NULL(buffer);
+
+	ERR_FAIL_COND_MSG(!buffer->usage.has_flag(RDD::BUFFER_USAGE_INDIRECT_BIT), "Buffer provided was not created to do indirect draws.");
+
+	// Indexed commands are 5 integers, non indexed ones 4.
+	uint32_t command_size = p_use_indices ? 20 : 16;
+	uint32_t stride = p_stride > 0 ? p_stride : command_size;
+	ERR_FAIL_COND_MSG(p_draw_count == 0, "Draw count must be greater than zero.");
+	ERR_FAIL_COND_MSG(stride < command_size, "Stride provided is smaller than a draw command.");
+	ERR_FAIL_COND_MSG(p_offset + stride * (p_draw_count - 1) + command_size > buffer->size, "Offset, stride and draw count provided go past the end of buffer.");
+
+	if (!_draw_list_prepare_draw(dl, p_use_indices)) {
+		return;
+	}
+
+	draw_graph.add_draw_list_draw_indirect(buffer->driver_id, p_offset, p_draw_count, stride, p_use_indices);
+
+	if (buffer->draw_tracker != nullptr) {
+		draw_graph.add_draw_list_usage(buffer->draw_tracker, RDG::RESOURCE_USAGE_INDIRECT_BUFFER_READ);
+	}
+
+	dl->state.draw_count++;
+}
+
 void RenderingDevice::draw_list_enable_scissor(DrawListID p_list, const Rect2 &p_rect) {
 	DrawList *dl = _get_draw_list_ptr(p_list);
 
@@ -5952,6 +6030,7 @@ void RenderingDevice::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("draw_list_set_push_constant", "draw_list", "buffer", "size_bytes"), &RenderingDevice::_draw_list_set_push_constant);
 
 	ClassDB::bind_method(D_METHOD("draw_list_draw", "draw_list", "use_indices", "instances", "procedural_vertex_count"), &RenderingDevice::draw_list_draw, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("draw_list_draw_indirect", "draw_list", "use_indices", "buffer", "offset", "draw_count", "stride"), &RenderingDevice::draw_list_draw_indirect, DEFVAL(0), DEFVAL(1), DEFVAL(0));
 
 	ClassDB::bind_method(D_METHOD("draw_list_enable_scissor", "draw_list", "rect"), &RenderingDevice::draw_list_enable_scissor, DEFVAL(Rect2()));
 	ClassDB::bind_method(D_METHOD("draw_list_disable_scissor", "draw_list"), &RenderingDevice::draw_list_disable_scissor);
@@ -359,6 +359,14 @@ Size2i RenderingServerDefault::get_maximum_viewport_size() const {
 	}
 }
 
+Vector<String> RenderingServerDefault::get_shader_cache_files() const {
+	if (RSG::utilities) {
+		return RSG::utilities->get_shader_cache_files();
+	} else {
+		return Vector<String>();
+	}
+}
+
 void RenderingServerDefault::_assign_mt_ids(WorkerThreadPool::TaskID p_pump_task_id) {
 	server_thread = Thread::get_caller_id();
 	server_task_id = p_pump_task_id;
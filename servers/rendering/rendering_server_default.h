@@ -333,6 +333,9 @@ public:
 	FUNC2(multimesh_set_custom_aabb, RID, const AABB &)
 	FUNC1RC(AABB, multimesh_get_custom_aabb, RID)
 
+	FUNC2(multimesh_set_gpu_culling, RID, bool)
+	FUNC1RC(bool, multimesh_is_gpu_culling_enabled, RID)
+
 	FUNC1RC(RID, multimesh_get_mesh, RID)
 	FUNC1RC(AABB, multimesh_get_aabb, RID)
 
@@ -342,6 +345,7 @@ public:
 	FUNC2RC(Color, multimesh_instance_get_custom_data, RID, int)
 
 	FUNC2(multimesh_set_buffer, RID, const Vector<float> &)
+	FUNC3(multimesh_set_buffer_range, RID, int, const Vector<float> &)
 	FUNC1RC(Vector<float>, multimesh_get_buffer, RID)
 
 	FUNC2(multimesh_set_visible_instances, RID, int)
@@ -1095,6 +1099,7 @@ public:
 	virtual void set_print_gpu_profile(bool p_enable) override;
 
 	virtual Size2i get_maximum_viewport_size() const override;
+	virtual Vector<String> get_shader_cache_files() const override;
 
 	RenderingServerDefault(bool p_create_thread = false);
 	~RenderingServerDefault();
@@ -115,11 +115,15 @@ public:
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const = 0;
 
 	virtual void multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_buffer) = 0;
+	virtual void multimesh_set_buffer_range(RID p_multimesh, int p_from_instance, const Vector<float> &p_buffer) = 0;
 	virtual Vector<float> multimesh_get_buffer(RID p_multimesh) const = 0;
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible) = 0;
 	virtual int multimesh_get_visible_instances(RID p_multimesh) const = 0;
 
+	virtual void multimesh_set_gpu_culling(RID p_multimesh, bool p_enable) = 0;
+	virtual bool multimesh_is_gpu_culling_enabled(RID p_multimesh) const = 0;
+
 	virtual AABB multimesh_get_aabb(RID p_multimesh) const = 0;
 
 	/* SKELETON API */
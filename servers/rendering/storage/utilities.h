@@ -184,6 +184,8 @@ public:
 	virtual String get_video_adapter_api_version() const = 0;
 
 	virtual Size2i get_maximum_viewport_size() const = 0;
+
+	virtual Vector<String> get_shader_cache_files() const = 0;
 };
 
 #endif // RENDERER_UTILITIES_H
@@ -2436,7 +2436,10 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("multimesh_instance_get_custom_data", "multimesh", "index"), &RenderingServer::multimesh_instance_get_custom_data);
 	ClassDB::bind_method(D_METHOD("multimesh_set_visible_instances", "multimesh", "visible"), &RenderingServer::multimesh_set_visible_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_get_visible_instances", "multimesh"), &RenderingServer::multimesh_get_visible_instances);
+	ClassDB::bind_method(D_METHOD("multimesh_set_gpu_culling", "multimesh", "enable"), &RenderingServer::multimesh_set_gpu_culling);
+	ClassDB::bind_method(D_METHOD("multimesh_is_gpu_culling_enabled", "multimesh"), &RenderingServer::multimesh_is_gpu_culling_enabled);
 	ClassDB::bind_method(D_METHOD("multimesh_set_buffer", "multimesh", "buffer"), &RenderingServer::multimesh_set_buffer);
+	ClassDB::bind_method(D_METHOD("multimesh_set_buffer_range", "multimesh", "from_instance", "buffer"), &RenderingServer::multimesh_set_buffer_range);
 	ClassDB::bind_method(D_METHOD("multimesh_get_buffer", "multimesh"), &RenderingServer::multimesh_get_buffer);
 
 	BIND_ENUM_CONSTANT(MULTIMESH_TRANSFORM_2D);
@@ -3430,6 +3433,11 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(RENDERING_INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_BUFFER_MEM_USED);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_VIDEO_MEM_USED);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_PIPELINE_WARMUP_PENDING);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_PIPELINE_WARMUP_COMPILED);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_SHADER_CACHE_HITS);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_SHADER_CACHE_MISSES);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_SHADER_COMPILATIONS_PENDING);
 
 	ADD_SIGNAL(MethodInfo("frame_pre_draw"));
 	ADD_SIGNAL(MethodInfo("frame_post_draw"));
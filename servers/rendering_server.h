@@ -447,11 +447,15 @@ public:
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const = 0;
 
 	virtual void multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_buffer) = 0;
+	virtual void multimesh_set_buffer_range(RID p_multimesh, int p_from_instance, const Vector<float> &p_buffer) = 0;
 	virtual Vector<float> multimesh_get_buffer(RID p_multimesh) const = 0;
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible) = 0;
 	virtual int multimesh_get_visible_instances(RID p_multimesh) const = 0;
 
+	virtual void multimesh_set_gpu_culling(RID p_multimesh, bool p_enable) = 0;
+	virtual bool multimesh_is_gpu_culling_enabled(RID p_multimesh) const = 0;
+
 	/* SKELETON API */
 
 	virtual RID skeleton_create() = 0;
@@ -1669,6 +1673,11 @@ public:
 		RENDERING_INFO_TEXTURE_MEM_USED,
 		RENDERING_INFO_BUFFER_MEM_USED,
 		RENDERING_INFO_VIDEO_MEM_USED,
+		RENDERING_INFO_PIPELINE_WARMUP_PENDING,
+		RENDERING_INFO_PIPELINE_WARMUP_COMPILED,
+		RENDERING_INFO_SHADER_CACHE_HITS,
+		RENDERING_INFO_SHADER_CACHE_MISSES,
+		RENDERING_INFO_SHADER_COMPILATIONS_PENDING,
 		RENDERING_INFO_MAX
 	};
 
@@ -1730,6 +1739,9 @@ public:
 
 	virtual Size2i get_maximum_viewport_size() const = 0;
 
+	// Shader cache files loaded or saved so far, used by the editor to bake them into exported projects.
+	virtual Vector<String> get_shader_cache_files() const = 0;
+
 	RenderingDevice *get_rendering_device() const;
 	RenderingDevice *create_local_rendering_device() const;
 
@@ -0,0 +1,167 @@
+/**************************************************************************/
+/*  test_compression.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COMPRESSION_H
+#define TEST_COMPRESSION_H
+
+#include "core/io/compression.h"
+#include "core/io/file_access_compressed.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestCompression {
+
+static Vector<uint8_t> get_compressible_data(int p_size) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	for (int i = 0; i < p_size; i++) {
+		data.write[i] = ((i / 16) * 7 + (i % 5)) % 97;
+	}
+	return data;
+}
+
+TEST_CASE("[Compression] Zstandard in parallel frames") {
+	// Restored even if a check below aborts the test.
+	struct FrameSizeRestorer {
+		const int frame_size = Compression::zstd_frame_size;
+		~FrameSizeRestorer() { Compression::zstd_frame_size = frame_size; }
+	} frame_size_restorer;
+	Compression::zstd_frame_size = 64 * 1024;
+
+	// The last frame is partial.
+	const Vector<uint8_t> data = get_compressible_data(Compression::zstd_frame_size * 5 + 1000);
+	Vector<uint8_t> compressed;
+	compressed.resize(Compression::get_max_compressed_buffer_size(data.size(), Compression::MODE_ZSTD));
+	const int compressed_size = Compression::compress(compressed.ptrw(), data.ptr(), data.size(), Compression::MODE_ZSTD);
+	REQUIRE(compressed_size > 0);
+	CHECK(compressed_size < data.size());
+	compressed.resize(compressed_size);
+
+	Vector<uint8_t> decompressed;
+	decompressed.resize(data.size());
+	CHECK(Compression::decompress(decompressed.ptrw(), decompressed.size(), compressed.ptr(), compressed.size(), Compression::MODE_ZSTD) == data.size());
+	CHECK(decompressed == data);
+
+	// Other decoders read the frames one after another.
+	Compression::zstd_frame_size = 0;
+	decompressed.fill(0);
+	CHECK(Compression::decompress(decompressed.ptrw(), decompressed.size(), compressed.ptr(), compressed.size(), Compression::MODE_ZSTD) == data.size());
+	CHECK(decompressed == data);
+}
+
+TEST_CASE("[Compression] Zstandard with a trained dictionary") {
+	// Small payloads that look alike, like network snapshots.
+	Vector<Vector<uint8_t>> samples;
+	for (int i = 0; i < 200; i++) {
+		const String snapshot = vformat("{\"player\": %d, \"name\": \"Player %d\", \"position\": [%d, 12, %d], \"health\": 100, \"state\": \"running\"}", i % 8, i % 8, i * 3, i * 5);
+		const CharString utf8 = snapshot.utf8();
+		Vector<uint8_t> sample;
+		sample.resize(utf8.length());
+		memcpy(sample.ptrw(), utf8.get_data(), utf8.length());
+		samples.push_back(sample);
+	}
+
+	const Vector<uint8_t> dictionary = Compression::train_zstd_dictionary(samples, 1024);
+	REQUIRE(dictionary.size() > 0);
+	CHECK(dictionary.size() <= 1024);
+
+	const Vector<uint8_t> &payload = samples[123];
+	Vector<uint8_t> compressed;
+	compressed.resize(Compression::get_max_compressed_buffer_size(payload.size(), Compression::MODE_ZSTD));
+	const int size_with_dictionary = Compression::compress_zstd_with_dictionary(compressed.ptrw(), compressed.size(), payload.ptr(), payload.size(), dictionary);
+	REQUIRE(size_with_dictionary > 0);
+
+	// Fails instead of writing past a buffer too small.
+	Vector<uint8_t> too_small;
+	too_small.resize(size_with_dictionary - 1);
+	ERR_PRINT_OFF;
+	CHECK(Compression::compress_zstd_with_dictionary(too_small.ptrw(), too_small.size(), payload.ptr(), payload.size(), dictionary) == -1);
+	ERR_PRINT_ON;
+
+	Vector<uint8_t> compressed_without_dictionary;
+	compressed_without_dictionary.resize(Compression::get_max_compressed_buffer_size(payload.size(), Compression::MODE_ZSTD));
+	const int size_without_dictionary = Compression::compress(compressed_without_dictionary.ptrw(), payload.ptr(), payload.size(), Compression::MODE_ZSTD);
+	CHECK_MESSAGE(size_with_dictionary < size_without_dictionary, "The dictionary should make small payloads smaller.");
+
+	Vector<uint8_t> decompressed;
+	decompressed.resize(payload.size());
+	CHECK(Compression::decompress_zstd_with_dictionary(decompressed.ptrw(), decompressed.size(), compressed.ptr(), size_with_dictionary, dictionary) == payload.size());
+	CHECK(decompressed == payload);
+}
+
+TEST_CASE("[Compression] Zstandard dictionary from samples that fit") {
+	// Starts with the magic number of trained dictionaries, which is left out so zstd reads it as raw content.
+	Vector<uint8_t> sample = { 0x37, 0xA4, 0x30, 0xEC };
+	sample.append_array(get_compressible_data(500));
+	Vector<Vector<uint8_t>> samples;
+	samples.push_back(sample);
+
+	const Vector<uint8_t> dictionary = Compression::train_zstd_dictionary(samples, 1024);
+	CHECK(dictionary == sample.slice(4));
+}
+
+TEST_CASE("[FileAccessCompressed] Write and read many blocks") {
+	const String path = TestUtils::get_temp_path("compressed_blocks.bin");
+	const Vector<uint8_t> data = get_compressible_data(4096 * 40 + 123);
+	{
+		Ref<FileAccess> f = FileAccess::open_compressed(path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data);
+	}
+
+	Ref<FileAccess> f = FileAccess::open_compressed(path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == (uint64_t)data.size());
+
+	// Starts within a block, then spans enough whole blocks to decompress them in parallel.
+	CHECK(f->get_buffer(100) == data.slice(0, 100));
+	CHECK(f->get_buffer(4096 * 30) == data.slice(100, 100 + 4096 * 30));
+	CHECK(f->get_position() == 100 + 4096 * 30);
+	CHECK(f->get_8() == data[100 + 4096 * 30]);
+
+	// Seeking within the current block after a parallel read.
+	f->seek(4096 * 30 + 10);
+	CHECK(f->get_8() == data[4096 * 30 + 10]);
+
+	f->seek(0);
+	CHECK(f->get_buffer(data.size()) == data);
+	CHECK_FALSE(f->eof_reached());
+	CHECK(f->get_buffer(10).size() == 0);
+	CHECK(f->eof_reached());
+
+	f->seek(4096 * 2);
+	Vector<uint8_t> rest = f->get_buffer(data.size());
+	CHECK(rest == data.slice(4096 * 2));
+	CHECK(f->eof_reached());
+}
+} // namespace TestCompression
+
+#endif // TEST_COMPRESSION_H
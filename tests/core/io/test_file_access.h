@@ -107,6 +107,48 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+static void async_read_callback(void *p_userdata, Error p_error, uint64_t p_read) {
+	((SafeNumeric<uint64_t> *)p_userdata)->add(p_read);
+}
+
+TEST_CASE("[FileAccess] Asynchronous reads") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+	f->seek(6);
+
+	// Several reads in flight at once, the last one goes past the end of the file.
+	uint8_t first[14] = {};
+	uint8_t second[13] = {};
+	uint8_t last[64] = {};
+	SafeNumeric<uint64_t> total_read;
+	FileAccess::AsyncReadID first_id = f->read_async(0, first, 14, &async_read_callback, &total_read);
+	FileAccess::AsyncReadID second_id = f->read_async(15, second, 13, &async_read_callback, &total_read);
+	FileAccess::AsyncReadID last_id = f->read_async(47, last, 64, &async_read_callback, &total_read);
+	REQUIRE(first_id != FileAccess::INVALID_ASYNC_READ_ID);
+	REQUIRE(second_id != FileAccess::INVALID_ASYNC_READ_ID);
+	REQUIRE(last_id != FileAccess::INVALID_ASYNC_READ_ID);
+
+	uint64_t read = 0;
+	CHECK(FileAccess::wait_for_async_read(last_id, &read) == OK);
+	CHECK(read == 15);
+	CHECK(String::utf8((const char *)last, read) == "With you again\n");
+	CHECK(FileAccess::wait_for_async_read(first_id, &read) == OK);
+	CHECK(read == 14);
+	CHECK(String::utf8((const char *)first, read) == "Hello darkness");
+	CHECK(FileAccess::wait_for_async_read(second_id) == OK);
+	CHECK(String::utf8((const char *)second, 13) == "My old friend");
+	CHECK(total_read.get() == 14 + 13 + 15);
+
+	// Waiting releases the read.
+	ERR_PRINT_OFF;
+	CHECK(FileAccess::wait_for_async_read(first_id) == ERR_INVALID_PARAMETER);
+	ERR_PRINT_ON;
+
+	// The file position is not used.
+	CHECK(f->get_position() == 6);
+	CHECK(f->get_line() == "darkness");
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
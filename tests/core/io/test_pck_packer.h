@@ -80,6 +80,18 @@ TEST_CASE("[PCKPacker] Pack empty with invalid key") {
 	ERR_PRINT_ON;
 }
 
+TEST_CASE("[PCKPacker] Add compressed file with invalid compression mode") {
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_invalid_compression.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	const String source_path = OS::get_singleton()->get_executable_path().get_base_dir().path_join("../icon.svg");
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(pck_packer.add_file_compressed("icon.svg", source_path, FileAccess::COMPRESSION_BROTLI) == ERR_INVALID_PARAMETER, "Brotli compression isn't supported.");
+	CHECK_MESSAGE(pck_packer.add_file_compressed("icon.svg", source_path, FileAccess::CompressionMode(42)) == ERR_INVALID_PARAMETER, "Unknown compression modes should be rejected.");
+	ERR_PRINT_ON;
+	CHECK(pck_packer.flush() == OK);
+}
+
 TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 	PCKPacker pck_packer;
 	const String output_pck_path = TestUtils::get_temp_path("output_with_files.pck");
@@ -117,6 +129,180 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+// Packs `p_payload` and loads the pack, memory-mapped in one subcase and through regular file access in the other.
+// Loaded packs can't be removed, so each pack gets its own res:// directory to not shadow files of other tests.
+static String pack_and_load_payload(const String &p_name, const Vector<uint8_t> &p_payload, bool p_compressed, bool &r_memory_mapping) {
+	r_memory_mapping = true;
+	SUBCASE("With memory mapping") {
+		r_memory_mapping = true;
+	}
+	SUBCASE("Without memory mapping") {
+		r_memory_mapping = false;
+	}
+
+	const String scope = p_name + (r_memory_mapping ? "_mapped" : "_not_mapped");
+	const String source_path = TestUtils::get_temp_path("pck_" + scope + ".bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(p_payload);
+	}
+
+	const String packed_path = "res://pck_packer_test/" + scope + "/payload.bin";
+	const String output_pck_path = TestUtils::get_temp_path("output_" + scope + ".pck");
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	if (p_compressed) {
+		REQUIRE(pck_packer.add_file_compressed(packed_path, source_path) == OK);
+	} else {
+		REQUIRE(pck_packer.add_file(packed_path, source_path) == OK);
+	}
+	REQUIRE(pck_packer.flush() == OK);
+	if (p_compressed) {
+		CHECK_MESSAGE(FileAccess::get_file_as_bytes(output_pck_path).size() < p_payload.size(), "The compressed file should make the PCK smaller than its contents.");
+	}
+
+	PackedData *packed_data = PackedData::get_singleton();
+	const bool was_memory_mapping_enabled = packed_data->is_memory_mapping_enabled();
+	packed_data->set_memory_mapping_enabled(r_memory_mapping);
+	CHECK(packed_data->add_pack(output_pck_path, true, 0) == OK);
+	packed_data->set_memory_mapping_enabled(was_memory_mapping_enabled);
+
+	return packed_path;
+}
+
+TEST_CASE("[PCKPacker] Read files from a loaded PCK") {
+	Vector<uint8_t> payload;
+	payload.resize(100000);
+	for (int i = 0; i < payload.size(); i++) {
+		payload.write[i] = (i * 7) % 251;
+	}
+
+	bool memory_mapping = true;
+	const String packed_path = pack_and_load_payload("uncompressed", payload, false, memory_mapping);
+
+	Ref<FileAccess> f = FileAccess::open(packed_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == (uint64_t)payload.size());
+	CHECK_MESSAGE(f->get_buffer(payload.size()) == payload, "The file read from the PCK should have the packed contents.");
+
+	f->seek(1000);
+	CHECK(f->get_8() == payload[1000]);
+
+	f->seek(10);
+	const uint8_t *ptr = f->get_buffer_ptr(16);
+	if (!memory_mapping) {
+		CHECK(ptr == nullptr);
+	}
+#ifdef UNIX_ENABLED
+	if (memory_mapping) {
+		REQUIRE_MESSAGE(ptr != nullptr, "Memory-mapped PCK files should be readable without copying.");
+		CHECK(memcmp(ptr, payload.ptr() + 10, 16) == 0);
+		CHECK(f->get_position() == 26);
+	}
+#endif
+
+	// Asynchronous reads stop at the end of the packed file, not of the pack.
+	const uint64_t position = f->get_position();
+	uint8_t async_data[1000] = {};
+	FileAccess::AsyncReadID first_id = f->read_async(5000, async_data, 500);
+	FileAccess::AsyncReadID last_id = f->read_async(payload.size() - 100, async_data + 500, 500);
+	REQUIRE(first_id != FileAccess::INVALID_ASYNC_READ_ID);
+	REQUIRE(last_id != FileAccess::INVALID_ASYNC_READ_ID);
+	uint64_t read = 0;
+	CHECK(FileAccess::wait_for_async_read(first_id, &read) == OK);
+	CHECK(read == 500);
+	CHECK(memcmp(async_data, payload.ptr() + 5000, 500) == 0);
+	CHECK(FileAccess::wait_for_async_read(last_id, &read) == OK);
+	CHECK(read == 100);
+	CHECK(memcmp(async_data + 500, payload.ptr() + payload.size() - 100, 100) == 0);
+	CHECK(f->get_position() == position);
+}
+
+TEST_CASE("[PCKPacker] Read compressed files from a loaded PCK") {
+	// Spans several blocks, the last one partially.
+	Vector<uint8_t> payload;
+	payload.resize(PACK_COMPRESSED_BLOCK_SIZE * 3 + 1000);
+	for (int i = 0; i < payload.size(); i++) {
+		payload.write[i] = (i / 64) % 7;
+	}
+
+	bool memory_mapping = true;
+	const String packed_path = pack_and_load_payload("compressed", payload, true, memory_mapping);
+
+	Ref<FileAccess> f = FileAccess::open(packed_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == (uint64_t)payload.size());
+	CHECK_MESSAGE(f->get_buffer(payload.size()) == payload, "The compressed file read from the PCK should have the packed contents.");
+	CHECK(f->eof_reached() == false);
+
+	f->seek(PACK_COMPRESSED_BLOCK_SIZE * 2 + 5);
+	CHECK(f->get_8() == payload[PACK_COMPRESSED_BLOCK_SIZE * 2 + 5]);
+	f->seek(3);
+	CHECK(f->get_8() == payload[3]);
+
+	// Starts and ends within blocks, with whole blocks in between.
+	const uint64_t from = PACK_COMPRESSED_BLOCK_SIZE / 2;
+	const uint64_t length = PACK_COMPRESSED_BLOCK_SIZE * 2 + 100;
+	f->seek(from);
+	CHECK(f->get_buffer(length) == payload.slice(from, from + length));
+	CHECK(f->get_position() == from + length);
+	CHECK(f->get_buffer_ptr(16) == nullptr);
+
+	f->seek(payload.size() - 10);
+	CHECK(f->get_buffer(100).size() == 10);
+	CHECK(f->eof_reached());
+
+	// Asynchronous reads decompress through another handle, so the file can be read meanwhile.
+	f->seek(100);
+	Vector<uint8_t> async_data;
+	async_data.resize(PACK_COMPRESSED_BLOCK_SIZE * 2);
+	FileAccess::AsyncReadID id = f->read_async(PACK_COMPRESSED_BLOCK_SIZE, async_data.ptrw(), async_data.size());
+	REQUIRE(id != FileAccess::INVALID_ASYNC_READ_ID);
+	CHECK(f->get_buffer(1000) == payload.slice(100, 1100));
+	uint64_t read = 0;
+	CHECK(FileAccess::wait_for_async_read(id, &read) == OK);
+	CHECK(read == (uint64_t)async_data.size());
+	CHECK(async_data == payload.slice(PACK_COMPRESSED_BLOCK_SIZE, PACK_COMPRESSED_BLOCK_SIZE * 3));
+	CHECK(f->get_position() == 1100);
+}
+
+TEST_CASE("[PCKPacker] Identical files share their data") {
+	Vector<uint8_t> payload;
+	payload.resize(50000);
+	for (int i = 0; i < payload.size(); i++) {
+		payload.write[i] = (i * 13) % 251;
+	}
+	const String source_path = TestUtils::get_temp_path("pck_duplicate_a.bin");
+	const String copy_path = TestUtils::get_temp_path("pck_duplicate_b.bin");
+	for (const String &path : { source_path, copy_path }) {
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(payload);
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_deduplicated.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("res://pck_packer_test/deduplicated/a.bin", source_path) == OK);
+	REQUIRE(pck_packer.add_file("res://pck_packer_test/deduplicated/b.bin", copy_path) == OK);
+	REQUIRE(pck_packer.add_file("res://pck_packer_test/deduplicated/c.bin", source_path) == OK);
+	// Stored differently, so not shared.
+	REQUIRE(pck_packer.add_file_compressed("res://pck_packer_test/deduplicated/compressed.bin", source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	CHECK(pck_packer.get_deduplicated_file_count() == 2);
+	CHECK(pck_packer.get_deduplicated_size() >= (uint64_t)payload.size() * 2);
+	CHECK_MESSAGE(FileAccess::get_file_as_bytes(output_pck_path).size() < payload.size() * 3, "Identical files should be stored once.");
+
+	CHECK(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+	for (const String path : { "res://pck_packer_test/deduplicated/a.bin", "res://pck_packer_test/deduplicated/b.bin", "res://pck_packer_test/deduplicated/c.bin", "res://pck_packer_test/deduplicated/compressed.bin" }) {
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK_MESSAGE(f->get_buffer(payload.size()) == payload, vformat("%s should have the packed contents.", path));
+	}
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
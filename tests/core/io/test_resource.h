@@ -32,8 +32,10 @@
 #define TEST_RESOURCE_H
 
 #include "core/io/resource.h"
+#include "core/io/resource_format_binary.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #include "thirdparty/doctest/doctest.h"
@@ -112,6 +114,518 @@ TEST_CASE("[Resource] Saving and loading") {
 			"The loaded child resource name should be equal to the expected value.");
 }
 
+TEST_CASE("[Resource] Saving and loading packed arrays in binary format") {
+	// The odd sizes move the arrays that follow out of alignment, so their contents need padding.
+	PackedByteArray bytes;
+	PackedInt64Array ints;
+	PackedFloat32Array floats;
+	PackedVector3Array vectors;
+	PackedColorArray colors;
+	for (int i = 0; i < 1001; i++) {
+		bytes.push_back(i % 256);
+		ints.push_back(int64_t(i) * 1000000007);
+		floats.push_back(i * 0.5);
+		vectors.push_back(Vector3(i, -i, i * 0.25));
+		colors.push_back(Color(i / 1000.0, 0.5, 1.0, 0.25));
+	}
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_meta("bytes", bytes);
+	resource->set_meta("ints", ints);
+	resource->set_meta("floats", floats);
+	resource->set_meta("vectors", vectors);
+	resource->set_meta("colors", colors);
+	resource->set_meta("empty", PackedVector2Array());
+	const String save_path_binary = TestUtils::get_temp_path("resource_packed_arrays.res");
+	REQUIRE(ResourceSaver::save(resource, save_path_binary) == OK);
+
+	const Ref<Resource> &loaded_resource = ResourceLoader::load(save_path_binary, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(PackedByteArray(loaded_resource->get_meta("bytes")) == bytes);
+	CHECK(PackedInt64Array(loaded_resource->get_meta("ints")) == ints);
+	CHECK(PackedFloat32Array(loaded_resource->get_meta("floats")) == floats);
+	CHECK(PackedVector3Array(loaded_resource->get_meta("vectors")) == vectors);
+	CHECK(PackedColorArray(loaded_resource->get_meta("colors")) == colors);
+	CHECK(PackedVector2Array(loaded_resource->get_meta("empty")).is_empty());
+}
+
+TEST_CASE("[Resource] Loading sub-resources in parallel in binary format") {
+	Ref<Resource> external_resource = memnew(Resource);
+	external_resource->set_name("External");
+	const String save_path_external = TestUtils::get_temp_path("resource_sub_resources_external.res");
+	REQUIRE(ResourceSaver::save(external_resource, save_path_external) == OK);
+	external_resource->set_path(save_path_external);
+
+	Ref<Resource> shared_resource = memnew(Resource);
+	shared_resource->set_name("Shared");
+	Array children;
+	for (int i = 0; i < 16; i++) {
+		Ref<Resource> child_resource = memnew(Resource);
+		child_resource->set_name(vformat("Child %d", i));
+		child_resource->set_meta("shared", shared_resource);
+		child_resource->set_meta("external", external_resource);
+		children.push_back(child_resource);
+	}
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Main");
+	resource->set_meta("children", children);
+	const String save_path_binary = TestUtils::get_temp_path("resource_sub_resources.res");
+	REQUIRE(ResourceSaver::save(resource, save_path_binary) == OK);
+
+	// Decodes the children in parallel, then sets them in file order.
+	Ref<ResourceFormatLoaderBinary> loader;
+	loader.instantiate();
+	Error err = FAILED;
+	const Ref<Resource> loaded_resource = loader->load(save_path_binary, "", &err, true, nullptr, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(err == OK);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(loaded_resource->get_name() == "Main");
+
+	const Array loaded_children = loaded_resource->get_meta("children");
+	REQUIRE(loaded_children.size() == 16);
+	const Ref<Resource> loaded_shared_resource = Ref<Resource>(loaded_children[0])->get_meta("shared");
+	REQUIRE(loaded_shared_resource.is_valid());
+	CHECK(loaded_shared_resource->get_name() == "Shared");
+	for (int i = 0; i < 16; i++) {
+		const Ref<Resource> loaded_child_resource = loaded_children[i];
+		CHECK(loaded_child_resource->get_name() == vformat("Child %d", i));
+		CHECK_MESSAGE(
+				Ref<Resource>(loaded_child_resource->get_meta("shared")) == loaded_shared_resource,
+				"The children should reference the same sub-resource.");
+		const Ref<Resource> loaded_external_resource = loaded_child_resource->get_meta("external");
+		REQUIRE(loaded_external_resource.is_valid());
+		CHECK(loaded_external_resource->get_name() == "External");
+	}
+}
+
+TEST_CASE("[Resource] Saving and loading packed arrays in text format") {
+	PackedVector3Array vertices;
+	PackedFloat32Array weights;
+	PackedInt32Array indices;
+	for (int i = 0; i < 1000; i++) {
+		// Values with few digits, the text format doesn't store floats exactly.
+		vertices.push_back(Vector3(i % 1024, -(i % 512) * 0.5, (i % 8) * 0.25));
+		weights.push_back((i % 64) * 0.125);
+		indices.push_back(1000 - i);
+	}
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_meta("vertices", vertices);
+	resource->set_meta("weights", weights);
+	resource->set_meta("indices", indices);
+	resource->set_meta("empty", PackedVector2Array());
+	const String save_path_text = TestUtils::get_temp_path("resource_packed_arrays.tres");
+	REQUIRE(ResourceSaver::save(resource, save_path_text) == OK);
+
+	const Ref<Resource> &loaded_resource = ResourceLoader::load(save_path_text, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(PackedVector3Array(loaded_resource->get_meta("vertices")) == vertices);
+	CHECK(PackedFloat32Array(loaded_resource->get_meta("weights")) == weights);
+	CHECK(PackedInt32Array(loaded_resource->get_meta("indices")) == indices);
+	CHECK(PackedVector2Array(loaded_resource->get_meta("empty")).is_empty());
+}
+
+TEST_CASE_BENCHMARK("[Resource][Benchmark] Loading large text resources against binary") {
+	const int element_count = 50000;
+	PackedVector3Array vertices;
+	PackedFloat32Array weights;
+	PackedInt32Array indices;
+	vertices.resize(element_count);
+	weights.resize(element_count);
+	indices.resize(element_count);
+	for (int i = 0; i < element_count; i++) {
+		// Values with few digits, the text format doesn't store floats exactly.
+		vertices.write[i] = Vector3(i % 1024, -(i % 512) * 0.5, (i % 8) * 0.25);
+		weights.write[i] = (i % 64) * 0.125;
+		indices.write[i] = element_count - i;
+	}
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Generated");
+	resource->set_meta("vertices", vertices);
+	resource->set_meta("weights", weights);
+	resource->set_meta("indices", indices);
+	Array children;
+	for (int i = 0; i < 500; i++) {
+		Ref<Resource> child_resource = memnew(Resource);
+		child_resource->set_name(vformat("Child %d", i));
+		child_resource->set_meta("transform", Transform3D(Basis(), Vector3(i, i, i)));
+		children.push_back(child_resource);
+	}
+	resource->set_meta("children", children);
+
+	const String save_path_binary = TestUtils::get_temp_path("resource_benchmark.res");
+	const String save_path_text = TestUtils::get_temp_path("resource_benchmark.tres");
+	REQUIRE(ResourceSaver::save(resource, save_path_binary) == OK);
+	REQUIRE(ResourceSaver::save(resource, save_path_text) == OK);
+
+	const int iterations = 5;
+	uint64_t binary_usec = 0;
+	uint64_t text_usec = 0;
+	for (int i = 0; i < iterations; i++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		const Ref<Resource> loaded_resource_binary = ResourceLoader::load(save_path_binary, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		binary_usec += OS::get_singleton()->get_ticks_usec() - begin;
+		REQUIRE(loaded_resource_binary.is_valid());
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		const Ref<Resource> loaded_resource_text = ResourceLoader::load(save_path_text, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		text_usec += OS::get_singleton()->get_ticks_usec() - begin;
+		REQUIRE(loaded_resource_text.is_valid());
+
+		CHECK(loaded_resource_text->get_meta("vertices") == Variant(vertices));
+		CHECK(loaded_resource_text->get_meta("weights") == Variant(weights));
+		CHECK(loaded_resource_text->get_meta("indices") == Variant(indices));
+		CHECK(Array(loaded_resource_text->get_meta("children")).size() == 500);
+	}
+
+	MESSAGE(vformat("Loading %d elements per packed array and 500 sub-resources: %d usec from binary, %d usec from text.", element_count, binary_usec / iterations, text_usec / iterations));
+}
+
+TEST_CASE("[Resource] Threaded load queue without requests") {
+	CHECK(ResourceLoader::load_threaded_set_priority("res://not_requested.res", ResourceLoader::LOAD_PRIORITY_HIGH) == ERR_INVALID_PARAMETER);
+	CHECK(ResourceLoader::load_threaded_cancel("res://not_requested.res") == ERR_INVALID_PARAMETER);
+	CHECK_FALSE(ResourceLoader::is_current_load_canceled());
+
+	const Dictionary stats = ResourceLoader::load_threaded_get_stats();
+	CHECK(int(stats["queued"]) == 0);
+	CHECK(int(stats["running"]) == 0);
+	CHECK(stats.has("finished"));
+	CHECK(stats.has("canceled"));
+	CHECK(stats.has("canceling"));
+	CHECK(stats.has("average_wait_usec"));
+	CHECK(stats.has("max_wait_usec"));
+}
+
+// Loads ".blocking" paths, holding the ones named "block*" until released.
+class BlockingResourceFormatLoader : public ResourceFormatLoader {
+	Mutex mutex;
+	HashSet<String> released_paths;
+	LocalVector<String> started_paths;
+
+	bool is_released(const String &p_path) {
+		MutexLock lock(mutex);
+		return released_paths.has(p_path);
+	}
+
+public:
+	virtual Ref<Resource> load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr, bool p_use_sub_threads = false, float *r_progress = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE) override {
+		{
+			MutexLock lock(mutex);
+			started_paths.push_back(p_path);
+		}
+		if (p_path.get_file().begins_with("block")) {
+			// Gives up after a while, so a failed check can't hang the tests.
+			for (int i = 0; i < 10000 && !is_released(p_path); i++) {
+				OS::get_singleton()->delay_usec(1000);
+			}
+		}
+		if (ResourceLoader::is_current_load_canceled()) {
+			if (r_error) {
+				*r_error = ERR_SKIP;
+			}
+			return Ref<Resource>();
+		}
+
+		Ref<Resource> resource = memnew(Resource);
+		resource->set_name(p_path.get_file().get_basename());
+		if (r_error) {
+			*r_error = OK;
+		}
+		return resource;
+	}
+
+	virtual void get_recognized_extensions(List<String> *p_extensions) const override {
+		p_extensions->push_back("blocking");
+	}
+
+	virtual bool handles_type(const String &p_type) const override {
+		return p_type == "Resource";
+	}
+
+	virtual String get_resource_type(const String &p_path) const override {
+		return p_path.get_extension() == "blocking" ? "Resource" : "";
+	}
+
+	void release(const String &p_path) {
+		MutexLock lock(mutex);
+		released_paths.insert(p_path);
+	}
+
+	LocalVector<String> get_started_paths() {
+		MutexLock lock(mutex);
+		return started_paths;
+	}
+
+	bool wait_for_started(uint32_t p_count) {
+		for (int i = 0; i < 10000; i++) {
+			if (get_started_paths().size() >= p_count) {
+				return true;
+			}
+			OS::get_singleton()->delay_usec(1000);
+		}
+		return false;
+	}
+};
+
+static bool wait_for_canceled_loads_to_stop() {
+	for (int i = 0; i < 10000; i++) {
+		if (int(ResourceLoader::load_threaded_get_stats()["canceling"]) == 0) {
+			return true;
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+	return false;
+}
+
+TEST_CASE("[Resource] Threaded load queue") {
+	Ref<BlockingResourceFormatLoader> loader;
+	loader.instantiate();
+	ResourceLoader::add_resource_format_loader(loader, true);
+
+	// Keep all the loads allowed to run at once busy, so new requests wait in the queue.
+	const uint32_t max_running = MAX(1u, WorkerThreadPool::get_singleton()->get_max_low_priority_threads());
+	Vector<String> blocking_paths;
+	for (uint32_t i = 0; i < max_running; i++) {
+		blocking_paths.push_back(vformat("res://block_%d.blocking", i));
+		REQUIRE(ResourceLoader::load_threaded_request(blocking_paths[i]) == OK);
+	}
+	REQUIRE(loader->wait_for_started(max_running));
+	const String &blocking_path = blocking_paths[0];
+
+	const Dictionary initial_stats = ResourceLoader::load_threaded_get_stats();
+	CHECK(int(initial_stats["running"]) == int(max_running));
+	CHECK(int(initial_stats["queued"]) == 0);
+
+	SUBCASE("Queued loads start by priority, then in request order") {
+		REQUIRE(ResourceLoader::load_threaded_request("res://first.blocking") == OK);
+		REQUIRE(ResourceLoader::load_threaded_request("res://second.blocking") == OK);
+		REQUIRE(ResourceLoader::load_threaded_request("res://third.blocking") == OK);
+		CHECK(int(ResourceLoader::load_threaded_get_stats()["queued"]) == 3);
+		CHECK(ResourceLoader::load_threaded_get_status("res://first.blocking") == ResourceLoader::THREAD_LOAD_IN_PROGRESS);
+
+		CHECK(ResourceLoader::load_threaded_set_priority("res://first.blocking", ResourceLoader::LOAD_PRIORITY_LOW) == OK);
+		CHECK(int(ResourceLoader::load_threaded_get_stats()["queued"]) == 3);
+
+		// Frees a single slot, so the queued loads run one after another.
+		loader->release(blocking_path);
+		REQUIRE(loader->wait_for_started(max_running + 3));
+		const LocalVector<String> started_paths = loader->get_started_paths();
+		CHECK(started_paths[max_running] == "res://second.blocking");
+		CHECK(started_paths[max_running + 1] == "res://third.blocking");
+		CHECK(started_paths[max_running + 2] == "res://first.blocking");
+
+		for (const String path : { "res://first.blocking", "res://second.blocking", "res://third.blocking" }) {
+			const Ref<Resource> resource = ResourceLoader::load_threaded_get(path);
+			REQUIRE(resource.is_valid());
+			CHECK(resource->get_name() == path.get_file().get_basename());
+		}
+		CHECK(ResourceLoader::load_threaded_get(blocking_path).is_valid());
+
+		const Dictionary stats = ResourceLoader::load_threaded_get_stats();
+		CHECK(int(stats["queued"]) == 0);
+		CHECK(int(stats["running"]) == int(max_running) - 1);
+		CHECK(int64_t(stats["finished"]) == int64_t(initial_stats["finished"]) + 4);
+		CHECK(int64_t(stats["canceled"]) == int64_t(initial_stats["canceled"]));
+		CHECK(int64_t(stats["max_wait_usec"]) >= int64_t(stats["average_wait_usec"]));
+	}
+
+	SUBCASE("High priority loads skip the queue") {
+		REQUIRE(ResourceLoader::load_threaded_request("res://waiting.blocking") == OK);
+		REQUIRE(ResourceLoader::load_threaded_request("res://block_urgent.blocking") == OK);
+		CHECK(int(ResourceLoader::load_threaded_get_stats()["queued"]) == 2);
+
+		CHECK(ResourceLoader::load_threaded_set_priority("res://block_urgent.blocking", ResourceLoader::LOAD_PRIORITY_HIGH) == OK);
+		REQUIRE(loader->wait_for_started(max_running + 1));
+		CHECK(loader->get_started_paths()[max_running] == "res://block_urgent.blocking");
+		// Runs as a high priority task, without taking the place of a queued load.
+		CHECK(int(ResourceLoader::load_threaded_get_stats()["running"]) == int(max_running));
+		loader->release("res://block_urgent.blocking");
+		CHECK(ResourceLoader::load_threaded_get("res://block_urgent.blocking").is_valid());
+		CHECK(int(ResourceLoader::load_threaded_get_stats()["running"]) == int(max_running));
+
+		// The other loads are still busy.
+		CHECK(int(ResourceLoader::load_threaded_get_stats()["queued"]) == 1);
+		CHECK(ResourceLoader::load_threaded_get_status("res://waiting.blocking") == ResourceLoader::THREAD_LOAD_IN_PROGRESS);
+	}
+
+	SUBCASE("Canceling a queued load") {
+		// Canceling one of two requests keeps the load.
+		REQUIRE(ResourceLoader::load_threaded_request("res://canceled.blocking") == OK);
+		REQUIRE(ResourceLoader::load_threaded_request("res://canceled.blocking") == OK);
+		CHECK(ResourceLoader::load_threaded_cancel("res://canceled.blocking") == OK);
+		CHECK(ResourceLoader::load_threaded_get_status("res://canceled.blocking") == ResourceLoader::THREAD_LOAD_IN_PROGRESS);
+		CHECK(int(ResourceLoader::load_threaded_get_stats()["queued"]) == 1);
+
+		CHECK(ResourceLoader::load_threaded_cancel("res://canceled.blocking") == OK);
+		CHECK(ResourceLoader::load_threaded_get_status("res://canceled.blocking") == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+		const Dictionary stats = ResourceLoader::load_threaded_get_stats();
+		CHECK(int(stats["queued"]) == 0);
+		CHECK(int64_t(stats["canceled"]) == int64_t(initial_stats["canceled"]) + 1);
+
+		// Never started.
+		loader->release(blocking_path);
+		CHECK(ResourceLoader::load_threaded_get(blocking_path).is_valid());
+		CHECK(loader->get_started_paths().size() == max_running);
+		CHECK(int64_t(ResourceLoader::load_threaded_get_stats()["finished"]) == int64_t(initial_stats["finished"]) + 1);
+	}
+
+	SUBCASE("Canceling a running load") {
+		CHECK(ResourceLoader::load_threaded_cancel(blocking_path) == OK);
+		CHECK(ResourceLoader::load_threaded_get_status(blocking_path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+		Dictionary stats = ResourceLoader::load_threaded_get_stats();
+		CHECK(int(stats["canceling"]) == 1);
+		CHECK(int64_t(stats["canceled"]) == int64_t(initial_stats["canceled"]) + 1);
+
+		// The loader gives up, which releases the load.
+		loader->release(blocking_path);
+		REQUIRE(wait_for_canceled_loads_to_stop());
+		stats = ResourceLoader::load_threaded_get_stats();
+		CHECK(int(stats["running"]) == int(max_running) - 1);
+		CHECK(int64_t(stats["finished"]) == int64_t(initial_stats["finished"]) + 1);
+
+		// So requesting it again loads it anew.
+		REQUIRE(ResourceLoader::load_threaded_request(blocking_path) == OK);
+		CHECK(ResourceLoader::load_threaded_get(blocking_path).is_valid());
+		CHECK(loader->get_started_paths().size() == max_running + 1);
+	}
+
+	SUBCASE("Requesting a canceled running load again") {
+		CHECK(ResourceLoader::load_threaded_cancel(blocking_path) == OK);
+		REQUIRE(ResourceLoader::load_threaded_request(blocking_path) == OK);
+		CHECK(ResourceLoader::load_threaded_get_status(blocking_path) == ResourceLoader::THREAD_LOAD_IN_PROGRESS);
+
+		// The loader doesn't give up, the load goes on as if never canceled.
+		loader->release(blocking_path);
+		const Ref<Resource> resource = ResourceLoader::load_threaded_get(blocking_path);
+		REQUIRE(resource.is_valid());
+		CHECK(resource->get_name() == "block_0");
+		CHECK(loader->get_started_paths().size() == max_running);
+		CHECK(wait_for_canceled_loads_to_stop());
+	}
+
+	for (const String &path : blocking_paths) {
+		loader->release(path);
+	}
+	for (const String &path : blocking_paths) {
+		ResourceLoader::load_threaded_get(path);
+	}
+	ResourceLoader::load_threaded_get("res://waiting.blocking"); // Still queued after skipping the queue.
+	CHECK(wait_for_canceled_loads_to_stop());
+	CHECK(int(ResourceLoader::load_threaded_get_stats()["running"]) == 0);
+	ResourceLoader::remove_resource_format_loader(loader);
+}
+
+TEST_CASE("[Resource] Loading packed arrays from binary format version 6") {
+	// Version 6 stored packed arrays right after their length, without the padding that aligns them since version 7.
+	// Written by hand in that layout, as the saver only writes the current version.
+	const uint32_t VARIANT_PACKED_BYTE_ARRAY = 31;
+	const uint32_t VARIANT_PACKED_INT32_ARRAY = 32;
+	const uint32_t VARIANT_PACKED_VECTOR3_ARRAY = 35;
+	const uint32_t VARIANT_PACKED_COLOR_ARRAY = 36;
+
+	PackedByteArray bytes;
+	PackedInt32Array ints;
+	PackedVector3Array vectors;
+	PackedColorArray colors;
+	for (int i = 0; i < 1001; i++) {
+		bytes.push_back(i % 256);
+		ints.push_back(i * 1000003);
+		vectors.push_back(Vector3(i, -i, i * 0.25));
+		colors.push_back(Color(i / 1000.0, 0.5, 1.0, 0.25));
+	}
+
+	const String v6_path = TestUtils::get_temp_path("resource_packed_arrays_v6.res");
+	{
+		Ref<FileAccess> f = FileAccess::open(v6_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		const auto store_string = [&](const String &p_string) {
+			CharString utf8 = p_string.utf8();
+			f->store_32(utf8.length() + 1);
+			f->store_buffer((const uint8_t *)utf8.get_data(), utf8.length() + 1);
+		};
+
+		f->store_buffer((const uint8_t *)"RSRC", 4);
+		f->store_32(0); // Little endian.
+		f->store_32(0); // 32-bit reals.
+		f->store_32(4);
+		f->store_32(2);
+		f->store_32(6); // Format version.
+		store_string("Resource");
+		f->store_64(0); // Import metadata offset.
+		f->store_32(ResourceFormatSaverBinaryInstance::FORMAT_FLAG_NAMED_SCENE_IDS | ResourceFormatSaverBinaryInstance::FORMAT_FLAG_UIDS);
+		f->store_64(ResourceUID::INVALID_ID);
+		for (int i = 0; i < ResourceFormatSaverBinaryInstance::RESERVED_FIELDS; i++) {
+			f->store_32(0);
+		}
+
+		const char *names[] = { "metadata/bytes", "metadata/ints", "metadata/vectors", "metadata/colors" };
+		f->store_32(4);
+		for (const char *name : names) {
+			store_string(name);
+		}
+		f->store_32(0); // External resources.
+		f->store_32(1); // Internal resources.
+		store_string("local://1");
+		f->store_64(f->get_position() + 8); // Right after this offset.
+
+		store_string("Resource");
+		f->store_32(4); // Properties.
+
+		f->store_32(0);
+		f->store_32(VARIANT_PACKED_BYTE_ARRAY);
+		f->store_32(bytes.size());
+		f->store_buffer(bytes);
+		for (int i = bytes.size(); i % 4; i++) {
+			f->store_8(0);
+		}
+
+		f->store_32(1);
+		f->store_32(VARIANT_PACKED_INT32_ARRAY);
+		f->store_32(ints.size());
+		for (int32_t value : ints) {
+			f->store_32(value);
+		}
+
+		f->store_32(2);
+		f->store_32(VARIANT_PACKED_VECTOR3_ARRAY);
+		f->store_32(vectors.size());
+		for (const Vector3 &value : vectors) {
+			f->store_float(value.x);
+			f->store_float(value.y);
+			f->store_float(value.z);
+		}
+
+		f->store_32(3);
+		f->store_32(VARIANT_PACKED_COLOR_ARRAY);
+		f->store_32(colors.size());
+		for (const Color &value : colors) {
+			f->store_float(value.r);
+			f->store_float(value.g);
+			f->store_float(value.b);
+			f->store_float(value.a);
+		}
+
+		f->store_buffer((const uint8_t *)"RSRC", 4);
+	}
+
+	const auto check_arrays = [&](const Ref<Resource> &p_resource) {
+		REQUIRE(p_resource.is_valid());
+		CHECK(PackedByteArray(p_resource->get_meta("bytes")) == bytes);
+		CHECK(PackedInt32Array(p_resource->get_meta("ints")) == ints);
+		CHECK(PackedVector3Array(p_resource->get_meta("vectors")) == vectors);
+		CHECK(PackedColorArray(p_resource->get_meta("colors")) == colors);
+	};
+
+	const Ref<Resource> &loaded_resource = ResourceLoader::load(v6_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	check_arrays(loaded_resource);
+
+	// Saved again in the current version, with aligned arrays.
+	const String resaved_path = TestUtils::get_temp_path("resource_packed_arrays_resaved.res");
+	REQUIRE(ResourceSaver::save(loaded_resource, resaved_path) == OK);
+	check_arrays(ResourceLoader::load(resaved_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE));
+}
+
 TEST_CASE("[Resource] Breaking circular references on save") {
 	Ref<Resource> resource_a = memnew(Resource);
 	resource_a->set_name("A");
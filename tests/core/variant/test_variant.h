@@ -1755,6 +1755,42 @@ TEST_CASE("[Variant] Writer and parser array") {
 	CHECK_MESSAGE(a_parsed == Variant(a), "Should parse back.");
 }
 
+TEST_CASE("[Variant] Writer and parser packed arrays") {
+	const auto parse = [](const String &p_str, Variant &r_value, int &r_line) {
+		VariantParser::StreamString ss;
+		ss.s = p_str;
+		String errs;
+		r_line = 1;
+		return VariantParser::parse(&ss, r_value, errs, r_line);
+	};
+
+	PackedInt32Array int32_array = { 0, -1, 2147483647, -2147483648 };
+	PackedInt64Array int64_array = { 0, -1, 9223372036854775807 };
+	PackedFloat32Array float32_array = { 0.0f, -1.5f, 0.125f, (float)INFINITY };
+	PackedFloat64Array float64_array = { 0.0, -1.5, 1.0e100 };
+	PackedVector3Array vector3_array = { Vector3(1, 2, 3), Vector3(-0.5, 0.25, 0.125) };
+	const Array arrays = build_array(int32_array, int64_array, float32_array, float64_array, vector3_array, PackedInt32Array());
+
+	int line = 1;
+	Variant array_parsed;
+	for (int i = 0; i < arrays.size(); i++) {
+		String array_str;
+		VariantWriter::write_to_string(arrays[i], array_str);
+
+		CHECK(parse(array_str, array_parsed, line) == OK);
+		CHECK_MESSAGE(array_parsed == arrays[i], vformat("Should parse back: %s", array_str));
+	}
+
+	// Whitespace, comments and special values are mixed with the numbers read right from the stream.
+	CHECK(parse("PackedFloat32Array( 1,\n-2.5e2 ; comment\n, inf,inf_neg ,3 )", array_parsed, line) == OK);
+	CHECK(line == 3);
+	CHECK(array_parsed == Variant(PackedFloat32Array({ 1.0f, -250.0f, (float)INFINITY, (float)-INFINITY, 3.0f })));
+
+	CHECK(parse("PackedInt32Array(1 2)", array_parsed, line) == ERR_PARSE_ERROR);
+	CHECK(parse("PackedInt32Array(1, )", array_parsed, line) == ERR_PARSE_ERROR);
+	CHECK(parse("PackedInt32Array(1, 2", array_parsed, line) == ERR_PARSE_ERROR);
+}
+
 TEST_CASE("[Variant] Writer recursive array") {
 	// There is no way to accurately represent a recursive array,
 	// the only thing we can do is make sure the writer doesn't blow up
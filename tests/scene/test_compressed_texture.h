@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*  test_compressed_texture.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COMPRESSED_TEXTURE_H
+#define TEST_COMPRESSED_TEXTURE_H
+
+#include "core/io/file_access.h"
+#include "core/io/file_access_memory.h"
+#include "core/io/image.h"
+#include "scene/resources/compressed_texture.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestCompressedTexture {
+
+TEST_CASE("[CompressedTexture2D] Load PNG data from files and from memory") {
+	Ref<Image> image = Image::create_empty(16, 8, false, Image::FORMAT_RGBA8);
+	for (int y = 0; y < image->get_height(); y++) {
+		for (int x = 0; x < image->get_width(); x++) {
+			image->set_pixel(x, y, Color(x / 16.0, y / 8.0, 0.5, 1.0));
+		}
+	}
+	REQUIRE(Image::png_packer);
+	const Vector<uint8_t> png = Image::png_packer(image);
+
+	// Same layout as the image data of a `.ctex` file.
+	const String path = TestUtils::get_temp_path("compressed_texture_png.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_32(CompressedTexture2D::DATA_FORMAT_PNG);
+		f->store_16(image->get_width());
+		f->store_16(image->get_height());
+		f->store_32(0); // Mipmaps.
+		f->store_32(image->get_format());
+		f->store_32(png.size());
+		f->store_buffer(png);
+	}
+	const Vector<uint8_t> bytes = FileAccess::get_file_as_bytes(path);
+
+	Ref<FileAccess> f;
+	SUBCASE("From a file, with a copy of the data") {
+		f = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_buffer_ptr(1) == nullptr);
+		f->seek(0);
+	}
+	SUBCASE("From memory, in place") {
+		Ref<FileAccessMemory> memory_file;
+		memory_file.instantiate();
+		memory_file->open_custom(bytes.ptr(), bytes.size());
+		f = memory_file;
+	}
+
+	Ref<Image> loaded = CompressedTexture2D::load_image_from_file(f, 0);
+	REQUIRE(loaded.is_valid());
+	CHECK(f->get_position() == (uint64_t)bytes.size());
+	CHECK(loaded->get_width() == image->get_width());
+	CHECK(loaded->get_height() == image->get_height());
+	CHECK(loaded->get_format() == image->get_format());
+	CHECK(loaded->get_data() == image->get_data());
+}
+
+} // namespace TestCompressedTexture
+
+#endif // TEST_COMPRESSED_TEXTURE_H
@@ -0,0 +1,130 @@
+/**************************************************************************/
+/*  test_resource_format_text.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RESOURCE_FORMAT_TEXT_H
+#define TEST_RESOURCE_FORMAT_TEXT_H
+
+#include "core/io/dir_access.h"
+#include "core/io/resource_format_binary.h"
+#include "core/io/resource_saver.h"
+#include "core/object/script_language.h"
+#include "scene/resources/resource_format_text.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestResourceFormatText {
+
+#ifdef TOOLS_ENABLED
+static Ref<Resource> load_text_resource(const String &p_path) {
+	Error err = FAILED;
+	Ref<Resource> resource = ResourceFormatLoaderText::singleton->load(p_path, "", &err, false, nullptr, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	CHECK(err == OK);
+	return resource;
+}
+
+TEST_CASE("[ResourceFormatLoaderText] Binary cache of text resources") {
+	const String cache_dir = TestUtils::get_temp_path("text_resource_cache");
+	if (DirAccess::exists(cache_dir)) {
+		Ref<DirAccess> da = DirAccess::open(cache_dir);
+		REQUIRE(da->erase_contents_recursive() == OK);
+	}
+	ResourceFormatLoaderText::set_binary_cache_dir(cache_dir);
+
+	const String path = TestUtils::get_temp_path("binary_cache.tres");
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("First");
+	REQUIRE(ResourceSaver::save(resource, path) == OK);
+
+	// A miss parses the text, then saves the binary copy and its key.
+	Ref<Resource> loaded_resource = load_text_resource(path);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(loaded_resource->get_name() == "First");
+
+	PackedStringArray cache_files = DirAccess::get_files_at(cache_dir);
+	CHECK_MESSAGE(cache_files.size() == 2, "Only the copy and its key should be left, without temporary files.");
+	String copy_path;
+	for (const String &file : cache_files) {
+		if (file.get_extension() == "res") {
+			copy_path = cache_dir.path_join(file);
+		}
+	}
+	REQUIRE(!copy_path.is_empty());
+
+	// A hit loads the copy, changed here to tell it apart from the text.
+	Ref<Resource> cached_resource = memnew(Resource);
+	cached_resource->set_name("Cached");
+	REQUIRE(ResourceFormatSaverBinary::singleton->save(cached_resource, copy_path) == OK);
+	loaded_resource = load_text_resource(path);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(loaded_resource->get_name() == "Cached");
+
+	// Changing the text invalidates the copy, which is saved again.
+	resource->set_name("Second");
+	REQUIRE(ResourceSaver::save(resource, path) == OK);
+	loaded_resource = load_text_resource(path);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(loaded_resource->get_name() == "Second");
+
+	Ref<ResourceFormatLoaderBinary> binary_loader;
+	binary_loader.instantiate();
+	const Ref<Resource> copy = binary_loader->load(copy_path, "", nullptr, false, nullptr, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(copy.is_valid());
+	CHECK(copy->get_name() == "Second");
+	CHECK(DirAccess::get_files_at(cache_dir).size() == 2);
+
+	// Other global classes invalidate the copy too.
+	REQUIRE(ResourceFormatSaverBinary::singleton->save(cached_resource, copy_path) == OK);
+	ScriptServer::add_global_class("BinaryCacheTestClass", "Resource", "GDScript", "res://binary_cache_test_class.gd");
+	loaded_resource = load_text_resource(path);
+	ScriptServer::remove_global_class("BinaryCacheTestClass");
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(loaded_resource->get_name() == "Second");
+
+	ResourceFormatLoaderText::remove_from_binary_cache(path);
+	CHECK(DirAccess::get_files_at(cache_dir).is_empty());
+
+	// Pruning keeps the copies of the files given, and removes the others.
+	load_text_resource(path);
+	CHECK(DirAccess::get_files_at(cache_dir).size() == 2);
+	HashSet<String> existing_paths;
+	existing_paths.insert(path);
+	ResourceFormatLoaderText::prune_binary_cache(existing_paths);
+	CHECK(DirAccess::get_files_at(cache_dir).size() == 2);
+	ResourceFormatLoaderText::prune_binary_cache(HashSet<String>());
+	CHECK(DirAccess::get_files_at(cache_dir).is_empty());
+
+	ResourceFormatLoaderText::set_binary_cache_dir(String());
+}
+#endif // TOOLS_ENABLED
+
+} // namespace TestResourceFormatText
+
+#endif // TEST_RESOURCE_FORMAT_TEXT_H